@@ -202,6 +202,14 @@ struct _n_PetscEvent {
   PetscErrorCode (*destroy)(PetscEvent);
 };
 
+struct _n_PetscDeviceGraph {
+  PetscDeviceType dtype;  // the type of the context it was captured from
+  PetscInt        nops;   // the number of operations captured
+  PetscInt        ntasks; // the number of tasks a launch queues
+  void           *data;   // graph handle
+  PetscErrorCode (*destroy)(PetscDeviceGraph);
+};
+
 typedef struct _DeviceContextOps *DeviceContextOps;
 struct _DeviceContextOps {
   PetscErrorCode (*destroy)(PetscDeviceContext);
@@ -222,6 +230,10 @@ struct _DeviceContextOps {
   PetscErrorCode (*createevent)(PetscDeviceContext, PetscEvent);                                                                // optional
   PetscErrorCode (*recordevent)(PetscDeviceContext, PetscEvent);                                                                // optional
   PetscErrorCode (*waitforevent)(PetscDeviceContext, PetscEvent);                                                               // optional
+  PetscErrorCode (*launchhost)(PetscDeviceContext, PetscErrorCode (*)(void *), void *);                                         // optional
+  PetscErrorCode (*begincapture)(PetscDeviceContext);                                                                          // optional
+  PetscErrorCode (*endcapture)(PetscDeviceContext, PetscDeviceGraph);                                                           // optional
+  PetscErrorCode (*launchgraph)(PetscDeviceContext, PetscDeviceGraph);                                                          // optional
 };
 
 struct _p_PetscDeviceContext {
@@ -130,6 +130,7 @@ typedef struct {
   PetscSection coneSection;      /* Layout of cones (inedges for DAG) */
   PetscInt    *cones;            /* Cone for each point */
   PetscInt    *coneOrientations; /* Orientation of each cone point, means cone traveral should start on point 'o', and if negative start on -(o+1) and go in reverse */
+  PetscInt    *coneOrientationsZero; /* Identity orientations handed out while coneOrientations is not allocated, which means all orientations are 0 */
   PetscSection supportSection;   /* Layout of cones (inedges for DAG) */
   PetscInt    *supports;         /* Cone for each point */
   PetscInt    *facesTmp;         /* Work space for faces operation */
@@ -351,6 +352,7 @@ PETSC_INTERN PetscErrorCode DMPlexDistributeGetDefault_Plex(DM, PetscBool *);
 PETSC_INTERN PetscErrorCode DMPlexDistributeSetDefault_Plex(DM, PetscBool);
 PETSC_INTERN PetscErrorCode DMPlexReorderGetDefault_Plex(DM, DMPlexReorderDefaultFlag *);
 PETSC_INTERN PetscErrorCode DMPlexReorderSetDefault_Plex(DM, DMPlexReorderDefaultFlag);
+PETSC_INTERN PetscErrorCode DMPlexCreateConeOrientations_Internal(DM);
 
 #if 1
 static inline PetscInt DihedralInvert(PetscInt N, PetscInt a)
@@ -443,6 +445,7 @@ PETSC_EXTERN PetscErrorCode DMPlexComputeJacobian_Internal(DM, PetscFormKey, IS,
 PETSC_EXTERN PetscErrorCode DMPlexComputeJacobian_Hybrid_Internal(DM, PetscFormKey[], IS, PetscReal, PetscReal, Vec, Vec, Mat, Mat, void *);
 PETSC_EXTERN PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM, PetscFormKey, IS, PetscReal, PetscReal, Vec, Vec, Vec, Vec, void *);
 PETSC_EXTERN PetscErrorCode DMPlexReconstructGradients_Internal(DM, PetscFV, PetscInt, PetscInt, Vec, Vec, Vec, Vec);
+PETSC_EXTERN PetscErrorCode DMPlexAccumulateFluxesFVM_Internal(DM, PetscInt, const PetscInt[], Vec, Vec, Vec, PetscReal, Vec);
 
 /* Matvec with A in row-major storage, x and y can be aliased */
 static inline void DMPlex_Mult2D_Internal(const PetscScalar A[], PetscInt ldx, const PetscScalar x[], PetscScalar y[])
@@ -165,6 +165,19 @@ PETSC_EXTERN PetscErrorCode PetscEventRegLogGetEvent(PetscEventRegLog, const cha
 
 PETSC_INTERN PetscErrorCode PetscLogView_Nested(PetscViewer);
 PETSC_INTERN PetscErrorCode PetscLogNestedEnd(void);
+PETSC_INTERN PetscErrorCode PetscLogTimelineEnd(void);
+PETSC_INTERN PetscErrorCode PetscLogCallPathEnd(void);
+PETSC_INTERN PetscErrorCode PetscLogHWCountersEnd(void);
+PETSC_INTERN PetscErrorCode PetscLogCommEnd(void);
+/* Position of the last level cache misses in the hardware counters; their traffic is estimated as the misses times the cache line size */
+#define PETSC_LOG_HW_LLC_MISSES 2
+#if defined(PETSC_LEVEL1_DCACHE_LINESIZE)
+  #define PETSC_LOG_HW_CACHE_LINE PETSC_LEVEL1_DCACHE_LINESIZE
+#else
+  #define PETSC_LOG_HW_CACHE_LINE 64
+#endif
+PETSC_INTERN PetscErrorCode PetscLogHWCountersRead_Internal(PetscLogDouble[]);
+PETSC_INTERN PetscErrorCode PetscLogHWCountersGetAvailable_Internal(PetscBool[]);
 PETSC_INTERN PetscErrorCode PetscLogView_Flamegraph(PetscViewer);
 
 PETSC_INTERN PetscErrorCode PetscLogGetCurrentEvent_Internal(PetscLogEvent *);
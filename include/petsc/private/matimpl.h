@@ -655,6 +655,10 @@ struct _p_MatFDColoring {
   PetscBool    fset;                              /* indicates that the initial function value F(X) is set */
   PetscErrorCode (*f)(void);                      /* function that defines Jacobian */
   void          *fctx;                            /* optional user-defined context for use by the function f */
+  PetscErrorCode (*fbatch)(void *, PetscInt, const Vec[], Vec[], void *); /* optional function evaluated at several points at once */
+  void          *fbatchctx;                       /* optional user-defined context for use by the function fbatch */
+  PetscInt       nbatch;                          /* number of vectors in xbatch and ybatch */
+  Vec           *xbatch, *ybatch;                 /* points of a block of colors and their function values, ybatch share the array dy */
   Vec            vscale;                          /* holds FD scaling, i.e. 1/dx for each perturbed column */
   PetscInt       currentcolor;                    /* color for which function evaluation is being done now */
   const char    *htype;                           /* "wp" or "ds" */
@@ -1728,4 +1732,21 @@ PETSC_EXTERN PetscLogEvent MAT_H2Opus_Compress;
 PETSC_EXTERN PetscLogEvent MAT_H2Opus_Orthog;
 PETSC_EXTERN PetscLogEvent MAT_H2Opus_LR;
 
+/*
+   Unchecked entry point to MatMult(), for callers that know the matrix is assembled and preallocated and the vectors
+   have the right sizes, see VecAXPYUnchecked(). The values are not checked for MatSetErrorIfFailure().
+*/
+static inline PetscErrorCode MatMultUnchecked(Mat mat, Vec x, Vec y)
+{
+  PetscFunctionBegin;
+#if PetscDefined(USE_DEBUG)
+  PetscCall(MatMult(mat, x, y));
+#else
+  PetscCall(PetscLogEventBeginUnchecked(MAT_Mult, mat, x, y, 0));
+  PetscCall((*mat->ops->mult)(mat, x, y));
+  PetscCall(PetscLogEventEndUnchecked(MAT_Mult, mat, x, y, 0));
+#endif
+  PetscFunctionReturn(0);
+}
+
 #endif
@@ -261,6 +261,22 @@ struct _p_TS {
     PetscReal shift; /* The derivative of the lhs wrt to Xdot */
   } ijacobian;
 
+  /* Reuse of the Jacobian of the nonlinear solves across Newton iterations, stages and steps, see TSSetJacobianLag() */
+  struct {
+    PetscBool        on;
+    PetscReal        rate;     /* rebuild when Newton's method contracts the residual by less than this */
+    PetscInt         maxsteps; /* rebuild after this many steps, -1 for never */
+    PetscBool        insnes;   /* TSComputeIJacobian() is forming the Jacobian of the nonlinear solver */
+    PetscBool        valid;    /* the matrices hold a Jacobian that may be reused */
+    PetscBool        used;     /* the current nonlinear solve reuses a Jacobian */
+    PetscReal        shift;    /* the shift of the Jacobian held by the matrices */
+    PetscInt         step;     /* the step at which it was built */
+    PetscObjectId    Aid;      /* the matrix holding it, to detect changes made by others */
+    PetscObjectState Astate;
+    PetscReal        fnorm; /* the residual norm at the previous Newton iteration */
+    PetscInt         nbuild, nreuse, nshift, nretry;
+  } lagjacobian;
+
   MatStructure axpy_pattern; /* information about the nonzero pattern of the RHS Jacobian in reference to the implicit Jacobian */
   /* --------------------Nonlinear Iteration------------------------------*/
   SNES      snes;
@@ -460,6 +476,8 @@ struct _n_TSEvent {
   PetscReal    *vtol;                                                                       /* Vector tolerances for event zero check */
   TSEventStatus status;                                                                     /* Event status */
   PetscInt      iterctr;                                                                    /* Iteration counter */
+  PetscBool     interpolate;                                                                /* Locate the events on the interpolant of the step rather than by rolling the step back */
+  Vec           work;                                                                       /* Interpolated solution */
   PetscViewer   monitor;
   /* Struct to record the events */
   struct {
@@ -539,6 +557,8 @@ PETSC_EXTERN PetscErrorCode TSAdaptHistorySetTSHistory(TSAdapt, TSHistory, Petsc
 
 PETSC_INTERN PetscErrorCode TSTrajectoryReconstruct_Private(TSTrajectory, TS, PetscReal, Vec, Vec);
 PETSC_INTERN PetscErrorCode TSTrajectorySetUp_Basic(TSTrajectory, TS);
+PETSC_INTERN PetscErrorCode TSRKGetTableauByName_Internal(TSRKType, PetscInt *, const PetscReal **, const PetscReal **, const PetscReal **, const PetscReal **, PetscInt *);
+PETSC_INTERN PetscErrorCode TSARKIMEXGetTableauByName_Internal(TSARKIMEXType, PetscInt *, const PetscReal **, const PetscReal **, const PetscReal **, const PetscReal **, PetscInt *);
 
 PETSC_EXTERN PetscLogEvent TSTrajectory_Set;
 PETSC_EXTERN PetscLogEvent TSTrajectory_Get;
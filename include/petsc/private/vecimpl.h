@@ -335,6 +335,58 @@ PETSC_EXTERN PetscErrorCode PetscSectionRestoreField_Internal(PetscSection, Pets
     VecCheckLocalSize(x, ar1, n); \
   } while (0)
 
+/*
+   Unchecked entry points to the vector operations of the inner loops of the solvers, for callers that know their
+   arguments are valid. In optimized builds they go straight to the implementation, without validating the arguments,
+   which costs as much as the operation itself on vectors of a few thousand entries. In debug builds they are the usual
+   routines. Their logging is compiled out with -DPETSC_SKIP_UNCHECKED_LOG.
+*/
+static inline PetscErrorCode VecAXPYUnchecked(Vec y, PetscScalar alpha, Vec x)
+{
+  PetscFunctionBegin;
+#if PetscDefined(USE_DEBUG)
+  PetscCall(VecAXPY(y, alpha, x));
+#else
+  if (alpha == (PetscScalar)0.0) PetscFunctionReturn(0);
+  PetscCall(PetscLogEventBeginUnchecked(VEC_AXPY, x, y, 0, 0));
+  PetscCall((*y->ops->axpy)(y, alpha, x));
+  PetscCall(PetscLogEventEndUnchecked(VEC_AXPY, x, y, 0, 0));
+  PetscCall(PetscObjectStateIncrease((PetscObject)y));
+#endif
+  PetscFunctionReturn(0);
+}
+
+static inline PetscErrorCode VecAYPXUnchecked(Vec y, PetscScalar beta, Vec x)
+{
+  PetscFunctionBegin;
+#if PetscDefined(USE_DEBUG)
+  PetscCall(VecAYPX(y, beta, x));
+#else
+  if (beta == (PetscScalar)0.0) {
+    PetscCall(VecCopy(x, y));
+    PetscFunctionReturn(0);
+  }
+  PetscCall(PetscLogEventBeginUnchecked(VEC_AYPX, x, y, 0, 0));
+  PetscCall((*y->ops->aypx)(y, beta, x));
+  PetscCall(PetscLogEventEndUnchecked(VEC_AYPX, x, y, 0, 0));
+  PetscCall(PetscObjectStateIncrease((PetscObject)y));
+#endif
+  PetscFunctionReturn(0);
+}
+
+static inline PetscErrorCode VecDotUnchecked(Vec x, Vec y, PetscScalar *val)
+{
+  PetscFunctionBegin;
+#if PetscDefined(USE_DEBUG)
+  PetscCall(VecDot(x, y, val));
+#else
+  PetscCall(PetscLogEventBeginUnchecked(VEC_Dot, x, y, 0, 0));
+  PetscCall((*x->ops->dot)(x, y, val));
+  PetscCall(PetscLogEventEndUnchecked(VEC_Dot, x, y, 0, 0));
+#endif
+  PetscFunctionReturn(0);
+}
+
 typedef struct _VecTaggerOps *VecTaggerOps;
 struct _VecTaggerOps {
   PetscErrorCode (*create)(VecTagger);
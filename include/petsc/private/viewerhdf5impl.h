@@ -38,6 +38,8 @@
       PetscCheck(ret >= 0, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in HDF5 call %s() Status %d", #func, (int)ret); \
     } while (0)
 
+  #define PETSC_HDF5_MAX_FILTER_PARAMS 8
+
 typedef struct PetscViewerHDF5GroupList {
   const char                      *name;
   struct PetscViewerHDF5GroupList *next;
@@ -55,10 +57,19 @@ typedef struct {
   PetscBool                 basedimension2; /* save vectors and DMDA vectors with a dimension of at least 2 even if the bs/dof is 1 */
   PetscBool                 spoutput;       /* write data in single precision even if PETSc is compiled with double precision PetscReal */
   PetscBool                 horizontal;     /* store column vectors as blocks (needed for MATDENSE I/O) */
+  PetscInt                  chunksize;      /* maximum number of entries in a dataset chunk, PETSC_DECIDE aligns chunks with the parallel layout */
+  PetscInt                  compress;       /* deflate compression level, 0 for none */
+  PetscBool                 shuffle;        /* apply the byte shuffle filter before compression */
+  PetscInt                  filter;         /* HDF5 filter identifier applied to new datasets, 0 for none */
+  PetscInt                  nfilterparams;
+  PetscInt                  filterparams[PETSC_HDF5_MAX_FILTER_PARAMS];
 } PetscViewer_HDF5;
 
 PETSC_EXTERN PetscErrorCode PetscViewerHDF5CheckTimestepping_Internal(PetscViewer, const char[]); /* currently used in src/dm/impls/da/gr2.c so needs to be extern */
 PETSC_INTERN PetscErrorCode PetscViewerHDF5GetGroup_Internal(PetscViewer, const char *[]);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetRankChunk_Internal(PetscInt, const PetscInt[], PetscInt, hsize_t *);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5CreateDatasetProperties_Internal(PetscViewer, int, const hsize_t[], hsize_t[], hid_t *);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5CreateTransferProperties_Internal(PetscViewer, hid_t, hid_t *);
 
   /* DMPlex-specific support */
   #define DMPLEX_STORAGE_VERSION_READING_KEY "_dm_plex_storage_version_reading"
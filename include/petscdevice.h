@@ -74,6 +74,11 @@ PETSC_EXTERN PetscErrorCode PetscDeviceContextForkWithStreamType(PetscDeviceCont
 PETSC_EXTERN PetscErrorCode PetscDeviceContextFork(PetscDeviceContext, PetscInt, PetscDeviceContext **);
 PETSC_EXTERN PetscErrorCode PetscDeviceContextJoin(PetscDeviceContext, PetscInt, PetscDeviceContextJoinMode, PetscDeviceContext **);
 PETSC_EXTERN PetscErrorCode PetscDeviceContextSynchronize(PetscDeviceContext);
+PETSC_EXTERN PetscErrorCode PetscDeviceContextLaunchHost(PetscDeviceContext, PetscErrorCode (*)(void *), void *);
+PETSC_EXTERN PetscErrorCode PetscDeviceContextBeginCapture(PetscDeviceContext);
+PETSC_EXTERN PetscErrorCode PetscDeviceContextEndCapture(PetscDeviceContext, PetscDeviceGraph *);
+PETSC_EXTERN PetscErrorCode PetscDeviceGraphLaunch(PetscDeviceGraph, PetscDeviceContext);
+PETSC_EXTERN PetscErrorCode PetscDeviceGraphDestroy(PetscDeviceGraph *);
 PETSC_EXTERN PetscErrorCode PetscDeviceContextSetFromOptions(MPI_Comm, PetscDeviceContext);
 PETSC_EXTERN PetscErrorCode PetscDeviceContextView(PetscDeviceContext, PetscViewer);
 PETSC_EXTERN PetscErrorCode PetscDeviceContextViewFromOptions(PetscDeviceContext, PetscObject, const char name[]);
@@ -95,6 +100,7 @@ PETSC_EXTERN PetscErrorCode PetscDeviceContextSetCurrentContext(PetscDeviceConte
   #define PetscDeviceContextFork(PetscDeviceContextp, PetscInt, PetscDeviceContextc)                                (*(PetscDeviceContextc) = PETSC_NULLPTR, 0)
   #define PetscDeviceContextJoin(PetscDeviceContextp, PetscInt, PetscDeviceContextJoinMode, PetscDeviceContextc)    (*(PetscDeviceContextc) = PETSC_NULLPTR, 0)
   #define PetscDeviceContextSynchronize(PetscDeviceContext)                                                         0
+  #define PetscDeviceContextLaunchHost(PetscDeviceContext, kernel, ctx)                                             ((*(kernel))(ctx))
   #define PetscDeviceContextSetFromOptions(MPI_Comm, PetscDeviceContext)                                            0
   #define PetscDeviceContextView(PetscDeviceContext, PetscViewer)                                                   0
   #define PetscDeviceContextViewFromOptions(PetscDeviceContext, PetscObject, PetscViewer)                           0
@@ -342,6 +342,18 @@ PETSC_EXTERN const char *const PetscDeviceContextJoinModes[];
 S*/
 typedef struct _p_PetscDeviceContext *PetscDeviceContext;
 
+/*S
+  PetscDeviceGraph - The work queued on a `PetscDeviceContext` (and the contexts forked from it)
+  between `PetscDeviceContextBeginCapture()` and `PetscDeviceContextEndCapture()`, which can be
+  queued again, as a whole, by `PetscDeviceGraphLaunch()`
+
+  Level: advanced
+
+.seealso: `PetscDeviceContext`, `PetscDeviceContextBeginCapture()`, `PetscDeviceContextEndCapture()`,
+`PetscDeviceGraphLaunch()`, `PetscDeviceGraphDestroy()`
+S*/
+typedef struct _n_PetscDeviceGraph *PetscDeviceGraph;
+
 /*E
   PetscDeviceCopyMode - Describes the copy direction of a device-aware memcpy
 
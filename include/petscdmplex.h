@@ -273,6 +273,10 @@ typedef enum {
   DMPLEX_REORDER_DEFAULT_FALSE  = 0,
   DMPLEX_REORDER_DEFAULT_TRUE
 } DMPlexReorderDefaultFlag;
+/* Space-filling curve cell orderings accepted by DMPlexGetOrdering() in addition to the MatOrderingType values */
+#define DMPLEX_ORDERING_HILBERT "hilbert"
+#define DMPLEX_ORDERING_MORTON  "morton"
+
 PETSC_EXTERN PetscErrorCode DMPlexGetOrdering(DM, MatOrderingType, DMLabel, IS *);
 PETSC_EXTERN PetscErrorCode DMPlexGetOrdering1D(DM, IS *);
 PETSC_EXTERN PetscErrorCode DMPlexPermute(DM, IS, DM *);
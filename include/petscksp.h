@@ -950,6 +950,9 @@ PETSC_EXTERN PetscErrorCode MatLMVMGetUpdateCount(Mat, PetscInt *);
 PETSC_EXTERN PetscErrorCode MatLMVMGetRejectCount(Mat, PetscInt *);
 PETSC_EXTERN PetscErrorCode MatLMVMSymBroydenSetDelta(Mat, PetscScalar);
 PETSC_EXTERN PetscErrorCode MatLMVMSymBroydenSetScaleType(Mat, MatLMVMSymBroydenScaleType);
+PETSC_EXTERN PetscErrorCode MatLMVMBFGSSetCompact(Mat, PetscBool);
+PETSC_EXTERN PetscErrorCode MatLMVMBFGSGetCompact(Mat, PetscBool *);
+PETSC_EXTERN PetscErrorCode MatLMVMBFGSGetCompactInUse(Mat, PetscBool *);
 
 PETSC_EXTERN PetscErrorCode KSPSetDM(KSP, DM);
 PETSC_EXTERN PetscErrorCode KSPSetDMActive(KSP, PetscBool);
@@ -167,6 +167,8 @@ typedef struct {
 #endif
 } PetscEventRegInfo;
 
+#define PETSC_LOG_HW_NUM_COUNTERS 3
+
 typedef struct {
   int            id;                  /* The integer identifying this event */
   PetscBool      active;              /* The flag to activate logging */
@@ -189,6 +191,8 @@ typedef struct {
   PetscLogDouble mallocIncrease;      /* How much the maximum malloced space has increased in this event */
   PetscLogDouble mallocSpace;         /* How much the space was malloced and kept during this event */
   PetscLogDouble mallocIncreaseEvent; /* Maximum of the high water mark with in event minus memory available at the end of the event */
+  /* The hardware counters in this event: cycles, instructions, last level cache misses */
+  PetscLogDouble hwCounters[PETSC_LOG_HW_NUM_COUNTERS];
 #if defined(PETSC_HAVE_DEVICE)
   PetscLogDouble CpuToGpuCount; /* The total number of CPU to GPU copies */
   PetscLogDouble GpuToCpuCount; /* The total number of GPU to CPU copies */
@@ -283,6 +287,10 @@ PETSC_EXTERN PetscErrorCode PetscLogDefaultBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogAllBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogNestedBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogTraceBegin(FILE *);
+PETSC_EXTERN PetscErrorCode PetscLogTimelineBegin(PetscInt);
+PETSC_EXTERN PetscErrorCode PetscLogCallPathBegin(PetscInt, PetscReal);
+PETSC_EXTERN PetscErrorCode PetscLogHWCountersBegin(void);
+PETSC_EXTERN PetscErrorCode PetscLogCommBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogActions(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogObjects(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogSetThreshold(PetscLogDouble, PetscLogDouble *);
@@ -292,6 +300,9 @@ PETSC_EXTERN PetscErrorCode PetscLogSet(PetscErrorCode (*)(int, int, PetscObject
 PETSC_EXTERN PetscErrorCode PetscLogView(PetscViewer);
 PETSC_EXTERN PetscErrorCode PetscLogViewFromOptions(void);
 PETSC_EXTERN PetscErrorCode PetscLogDump(const char[]);
+PETSC_EXTERN PetscErrorCode PetscLogTimelineDump(const char[]);
+PETSC_EXTERN PetscErrorCode PetscLogCallPathDump(const char[]);
+PETSC_EXTERN PetscErrorCode PetscLogCommDump(const char[]);
 
 /* Status checking functions */
 PETSC_EXTERN PetscErrorCode PetscLogIsActive(PetscBool *);
@@ -326,6 +337,14 @@ PETSC_EXTERN PetscErrorCode PetscLogPushCurrentEvent_Internal(PetscLogEvent);
 PETSC_EXTERN PetscErrorCode PetscLogPopCurrentEvent_Internal(void);
 
 PETSC_EXTERN PetscBool PetscLogMemory;
+PETSC_EXTERN PetscBool PetscLogHWCounters;
+
+/* Rank-to-rank communication logging, see PetscLogCommBegin() */
+  #define PETSC_LOG_COMM_FILE_CLASSID 1211226
+  #define PETSC_LOG_COMM_BINS         32
+PETSC_EXTERN PetscBool      PetscLogCommOn;
+PETSC_EXTERN PetscErrorCode PetscLogCommSend_Internal(MPI_Comm, PetscMPIInt, PetscCount, MPI_Datatype);
+PETSC_EXTERN PetscErrorCode PetscLogCommCollective_Internal(MPI_Comm, PetscCount, MPI_Datatype);
 
 PETSC_EXTERN PetscBool      PetscLogSyncOn; /* true if logging synchronization is enabled */
 PETSC_EXTERN PetscErrorCode PetscLogEventSynchronize(PetscLogEvent, MPI_Comm);
@@ -465,6 +484,12 @@ static inline int PetscMPIParallelComm(MPI_Comm comm)
   return size > 1;
 }
 
+/*
+    Adds a message to the communication matrix and histograms of PetscLogCommBegin()
+*/
+    #define PetscMPILogCommSend(comm, dest, count, datatype)  (PetscLogCommOn ? PetscLogCommSend_Internal((comm), (dest), (PetscCount)(count), (datatype)) : 0)
+    #define PetscMPILogCommCollective(comm, count, datatype) (PetscLogCommOn ? PetscLogCommCollective_Internal((comm), (PetscCount)(count), (datatype)) : 0)
+
     #define MPI_Irecv(buf, count, datatype, source, tag, comm, request) \
       (PetscAddLogDouble(&petsc_irecv_ct, &petsc_irecv_ct_th, 1) || PetscMPITypeSize((count), (datatype), &(petsc_irecv_len), &(petsc_irecv_len_th)) || MPI_Irecv((buf), (count), (datatype), (source), (tag), (comm), (request)))
 
@@ -472,10 +497,10 @@ static inline int PetscMPIParallelComm(MPI_Comm comm)
       (PetscAddLogDouble(&petsc_irecv_ct, &petsc_irecv_ct_th, 1) || PetscMPITypeSize((count), (datatype), &(petsc_irecv_len), &(petsc_irecv_len_th)) || MPI_Irecv_c((buf), (count), (datatype), (source), (tag), (comm), (request)))
 
     #define MPI_Isend(buf, count, datatype, dest, tag, comm, request) \
-      (PetscAddLogDouble(&petsc_isend_ct, &petsc_isend_ct_th, 1) || PetscMPITypeSize((count), (datatype), &(petsc_isend_len), &(petsc_isend_len_th)) || MPI_Isend((buf), (count), (datatype), (dest), (tag), (comm), (request)))
+      (PetscAddLogDouble(&petsc_isend_ct, &petsc_isend_ct_th, 1) || PetscMPITypeSize((count), (datatype), &(petsc_isend_len), &(petsc_isend_len_th)) || PetscMPILogCommSend((comm), (dest), (count), (datatype)) || MPI_Isend((buf), (count), (datatype), (dest), (tag), (comm), (request)))
 
     #define MPI_Isend_c(buf, count, datatype, dest, tag, comm, request) \
-      (PetscAddLogDouble(&petsc_isend_ct, &petsc_isend_ct_th, 1) || PetscMPITypeSize((count), (datatype), &(petsc_isend_len), &(petsc_isend_len_th)) || MPI_Isend_c((buf), (count), (datatype), (dest), (tag), (comm), (request)))
+      (PetscAddLogDouble(&petsc_isend_ct, &petsc_isend_ct_th, 1) || PetscMPITypeSize((count), (datatype), &(petsc_isend_len), &(petsc_isend_len_th)) || PetscMPILogCommSend((comm), (dest), (count), (datatype)) || MPI_Isend_c((buf), (count), (datatype), (dest), (tag), (comm), (request)))
 
     #define MPI_Startall_irecv(count, datatype, number, requests) \
       (PetscAddLogDouble(&petsc_irecv_ct, &petsc_irecv_ct_th, number) || PetscMPITypeSize((count), (datatype), &(petsc_irecv_len), &(petsc_irecv_len_th)) || ((number) && MPI_Startall((number), (requests))))
@@ -492,10 +517,10 @@ static inline int PetscMPIParallelComm(MPI_Comm comm)
       (PetscAddLogDouble(&petsc_recv_ct, &petsc_recv_ct_th, 1) || PetscMPITypeSize((count), (datatype), (&petsc_recv_len), &(petsc_recv_len_th)) || MPI_Recv_c((buf), (count), (datatype), (source), (tag), (comm), (status)))
 
     #define MPI_Send(buf, count, datatype, dest, tag, comm) \
-      (PetscAddLogDouble(&petsc_send_ct, &petsc_send_ct_th, 1) || PetscMPITypeSize((count), (datatype), (&petsc_send_len), (&petsc_send_len_th)) || MPI_Send((buf), (count), (datatype), (dest), (tag), (comm)))
+      (PetscAddLogDouble(&petsc_send_ct, &petsc_send_ct_th, 1) || PetscMPITypeSize((count), (datatype), (&petsc_send_len), (&petsc_send_len_th)) || PetscMPILogCommSend((comm), (dest), (count), (datatype)) || MPI_Send((buf), (count), (datatype), (dest), (tag), (comm)))
 
     #define MPI_Send_c(buf, count, datatype, dest, tag, comm) \
-      (PetscAddLogDouble(&petsc_send_ct, &petsc_send_ct_th, 1) || PetscMPITypeSize((count), (datatype), (&petsc_send_len), (&petsc_send_len_th)) || MPI_Send_c((buf), (count), (datatype), (dest), (tag), (comm)))
+      (PetscAddLogDouble(&petsc_send_ct, &petsc_send_ct_th, 1) || PetscMPITypeSize((count), (datatype), (&petsc_send_len), (&petsc_send_len_th)) || PetscMPILogCommSend((comm), (dest), (count), (datatype)) || MPI_Send_c((buf), (count), (datatype), (dest), (tag), (comm)))
 
     #define MPI_Wait(request, status) (PetscAddLogDouble(&petsc_wait_ct, &petsc_wait_ct_th, 1) || PetscAddLogDouble(&petsc_sum_of_waits_ct, &petsc_sum_of_waits_ct_th, 1) || MPI_Wait((request), (status)))
 
@@ -504,12 +529,12 @@ static inline int PetscMPIParallelComm(MPI_Comm comm)
     #define MPI_Waitall(count, array_of_requests, array_of_statuses) \
       (PetscAddLogDouble(&petsc_wait_all_ct, &petsc_wait_all_ct_th, 1) || PetscAddLogDouble(&petsc_sum_of_waits_ct, &petsc_sum_of_waits_ct_th, count) || MPI_Waitall((count), (array_of_requests), (array_of_statuses)))
 
-    #define MPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm) (PetscAddLogDouble(&petsc_allreduce_ct, &petsc_allreduce_ct_th, PetscMPIParallelComm(comm)) || MPI_Allreduce((sendbuf), (recvbuf), (count), (datatype), (op), (comm)))
+    #define MPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm) (PetscAddLogDouble(&petsc_allreduce_ct, &petsc_allreduce_ct_th, PetscMPIParallelComm(comm)) || PetscMPILogCommCollective((comm), (count), (datatype)) || MPI_Allreduce((sendbuf), (recvbuf), (count), (datatype), (op), (comm)))
 
-    #define MPI_Bcast(buffer, count, datatype, root, comm) (PetscAddLogDouble(&petsc_allreduce_ct, &petsc_allreduce_ct_th, PetscMPIParallelComm(comm)) || MPI_Bcast((buffer), (count), (datatype), (root), (comm)))
+    #define MPI_Bcast(buffer, count, datatype, root, comm) (PetscAddLogDouble(&petsc_allreduce_ct, &petsc_allreduce_ct_th, PetscMPIParallelComm(comm)) || PetscMPILogCommCollective((comm), (count), (datatype)) || MPI_Bcast((buffer), (count), (datatype), (root), (comm)))
 
     #define MPI_Reduce_scatter_block(sendbuf, recvbuf, recvcount, datatype, op, comm) \
-      (PetscAddLogDouble(&petsc_allreduce_ct, &petsc_allreduce_ct_th, PetscMPIParallelComm(comm)) || MPI_Reduce_scatter_block((sendbuf), (recvbuf), (recvcount), (datatype), (op), (comm)))
+      (PetscAddLogDouble(&petsc_allreduce_ct, &petsc_allreduce_ct_th, PetscMPIParallelComm(comm)) || PetscMPILogCommCollective((comm), (recvcount), (datatype)) || MPI_Reduce_scatter_block((sendbuf), (recvbuf), (recvcount), (datatype), (op), (comm)))
 
     #define MPI_Alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm) \
       (PetscAddLogDouble(&petsc_allreduce_ct, &petsc_allreduce_ct_th, PetscMPIParallelComm(comm)) || PetscMPITypeSize((sendcount), (sendtype), (&petsc_send_len), (&petsc_send_len_th)) || MPI_Alltoall((sendbuf), (sendcount), (sendtype), (recvbuf), (recvcount), (recvtype), (comm)))
@@ -571,7 +596,9 @@ static inline int PetscMPIParallelComm(MPI_Comm comm)
 
 #else /* ---Logging is turned off --------------------------------------------*/
 
-  #define PetscLogMemory PETSC_FALSE
+  #define PetscLogMemory     PETSC_FALSE
+  #define PetscLogHWCounters PETSC_FALSE
+  #define PetscLogCommOn     PETSC_FALSE
 
   #define PetscLogFlops(n) 0
   #define PetscGetFlops(a) (*(a) = 0.0, 0)
@@ -611,19 +638,26 @@ static inline int PetscMPIParallelComm(MPI_Comm comm)
   #define PetscLogObjectDestroy(h)       0
 PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject, const char[], ...) PETSC_ATTRIBUTE_FORMAT(2, 3);
 
-  #define PetscLogDefaultBegin()     0
-  #define PetscLogAllBegin()         0
-  #define PetscLogNestedBegin()      0
-  #define PetscLogTraceBegin(file)   0
-  #define PetscLogActions(a)         0
-  #define PetscLogObjects(a)         0
-  #define PetscLogSetThreshold(a, b) 0
-  #define PetscLogSet(lb, le)        0
-  #define PetscLogIsActive(flag)     (*(flag) = PETSC_FALSE, 0)
+  #define PetscLogDefaultBegin()      0
+  #define PetscLogAllBegin()          0
+  #define PetscLogNestedBegin()       0
+  #define PetscLogTraceBegin(file)    0
+  #define PetscLogTimelineBegin(n)    0
+  #define PetscLogCallPathBegin(n, t) 0
+  #define PetscLogHWCountersBegin()   0
+  #define PetscLogCommBegin()         0
+  #define PetscLogActions(a)          0
+  #define PetscLogObjects(a)          0
+  #define PetscLogSetThreshold(a, b)  0
+  #define PetscLogSet(lb, le)         0
+  #define PetscLogIsActive(flag)      (*(flag) = PETSC_FALSE, 0)
 
   #define PetscLogView(viewer)      0
   #define PetscLogViewFromOptions() 0
   #define PetscLogDump(c)           0
+  #define PetscLogTimelineDump(c)   0
+  #define PetscLogCallPathDump(c)   0
+  #define PetscLogCommDump(c)       0
 
   #define PetscLogEventSync(e, comm)                            0
   #define PetscLogEventBegin(e, o1, o2, o3, o4)                 0
@@ -636,6 +670,15 @@ PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject, const char[], ...)
 
 #endif /* PETSC_USE_LOG */
 
+/* the logging of the unchecked entry points, such as VecAXPYUnchecked(), can be compiled out on its own */
+#if defined(PETSC_SKIP_UNCHECKED_LOG)
+  #define PetscLogEventBeginUnchecked(e, o1, o2, o3, o4) 0
+  #define PetscLogEventEndUnchecked(e, o1, o2, o3, o4)   0
+#else
+  #define PetscLogEventBeginUnchecked(e, o1, o2, o3, o4) PetscLogEventBegin(e, o1, o2, o3, o4)
+  #define PetscLogEventEndUnchecked(e, o1, o2, o3, o4)   PetscLogEventEnd(e, o1, o2, o3, o4)
+#endif
+
 #define PetscPreLoadBegin(flag, name) \
   do { \
     PetscBool     PetscPreLoading = flag; \
@@ -1061,6 +1061,12 @@ PETSC_EXTERN                PetscErrorCode (*PetscTrRealloc)(size_t, int, const
 PETSC_EXTERN PetscErrorCode PetscMallocSetCoalesce(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscMallocSet(PetscErrorCode (*)(size_t, PetscBool, int, const char[], const char[], void **), PetscErrorCode (*)(void *, int, const char[], const char[]), PetscErrorCode (*)(size_t, int, const char[], const char[], void **));
 PETSC_EXTERN PetscErrorCode PetscMallocClear(void);
+PETSC_EXTERN PetscErrorCode PetscMallocPool(size_t, PetscBool, int, const char[], const char[], void **);
+PETSC_EXTERN PetscErrorCode PetscFreePool(void *, int, const char[], const char[]);
+PETSC_EXTERN PetscErrorCode PetscReallocPool(size_t, int, const char[], const char[], void **);
+PETSC_EXTERN PetscErrorCode PetscMallocPoolTrim(void);
+PETSC_EXTERN const char *const PetscMallocNUMAPolicies[];
+PETSC_EXTERN PetscErrorCode    PetscMallocSetLargePolicy(size_t, PetscMallocNUMAPolicy, PetscBool);
 
 /*
   Unlike PetscMallocSet and PetscMallocClear which overwrite the existing settings, these two functions save the previous choice of allocator, and should be used in pair.
@@ -680,6 +680,24 @@ typedef enum {
   PETSC_BINARY_SEEK_END = 2
 } PetscBinarySeekType;
 
+/*E
+  PetscMallocNUMAPolicy - where the pages of large allocations are placed on machines with several NUMA nodes
+
+$  `PETSC_MALLOC_NUMA_DEFAULT` - the operating system default, usually the node of the thread that first touches a page
+$  `PETSC_MALLOC_NUMA_INTERLEAVE` - the pages are spread round-robin over all the nodes the process may use
+$  `PETSC_MALLOC_NUMA_FIRST_TOUCH` - the pages are touched at allocation by the OpenMP threads, in the same static
+$      partition as the OpenMP loops of PETSc, so that each thread works on memory of its own node
+
+  Level: advanced
+
+.seealso: `PetscMallocSetLargePolicy()`
+E*/
+typedef enum {
+  PETSC_MALLOC_NUMA_DEFAULT,
+  PETSC_MALLOC_NUMA_INTERLEAVE,
+  PETSC_MALLOC_NUMA_FIRST_TOUCH
+} PetscMallocNUMAPolicy;
+
 /*E
     PetscBuildTwoSidedType - algorithm for setting up two-sided communication
 
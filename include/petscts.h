@@ -50,6 +50,9 @@ typedef const char *TSType;
 #define TSMPRK            "mprk"
 #define TSDISCGRAD        "discgrad"
 #define TSIRK             "irk"
+#define TSBATCH           "batch"
+#define TSLTS             "lts"
+#define TSPARAREAL        "parareal"
 
 /*E
     TSProblemType - Determines the type of problem this `TS` object is to be used to solve
@@ -454,6 +457,9 @@ PETSC_EXTERN PetscErrorCode TSGetRHSFunction(TS, Vec *, TSRHSFunction *, void **
 PETSC_EXTERN PetscErrorCode TSSetRHSJacobian(TS, Mat, Mat, TSRHSJacobian, void *);
 PETSC_EXTERN PetscErrorCode TSGetRHSJacobian(TS, Mat *, Mat *, TSRHSJacobian *, void **);
 PETSC_EXTERN PetscErrorCode TSRHSJacobianSetReuse(TS, PetscBool);
+PETSC_EXTERN PetscErrorCode TSSetJacobianLag(TS, PetscBool);
+PETSC_EXTERN PetscErrorCode TSSetJacobianLagTolerances(TS, PetscReal, PetscInt);
+PETSC_EXTERN PetscErrorCode TSGetJacobianLagCounts(TS, PetscInt *, PetscInt *, PetscInt *, PetscInt *);
 
 PETSC_EXTERN_TYPEDEF typedef PetscErrorCode (*TSSolutionFunction)(TS, PetscReal, Vec, void *);
 PETSC_EXTERN PetscErrorCode TSSetSolutionFunction(TS, TSSolutionFunction, void *);
@@ -676,6 +682,7 @@ PETSC_EXTERN PetscErrorCode       TSMonitorSPSwarmSolution(TS, PetscInt, PetscRe
 PETSC_EXTERN PetscErrorCode TSSetEventHandler(TS, PetscInt, PetscInt[], PetscBool[], PetscErrorCode (*)(TS, PetscReal, Vec, PetscScalar[], void *), PetscErrorCode (*)(TS, PetscInt, PetscInt[], PetscReal, Vec, PetscBool, void *), void *);
 PETSC_EXTERN PetscErrorCode TSSetPostEventIntervalStep(TS, PetscReal);
 PETSC_EXTERN PetscErrorCode TSSetEventTolerances(TS, PetscReal, PetscReal[]);
+PETSC_EXTERN PetscErrorCode TSSetEventInterpolation(TS, PetscBool);
 PETSC_EXTERN PetscErrorCode TSGetNumEvents(TS, PetscInt *);
 
 /*J
@@ -865,11 +872,29 @@ PETSC_EXTERN PetscErrorCode TSRKSetType(TS, TSRKType);
 PETSC_EXTERN PetscErrorCode TSRKGetTableau(TS, PetscInt *, const PetscReal **, const PetscReal **, const PetscReal **, const PetscReal **, PetscInt *, const PetscReal **, PetscBool *);
 PETSC_EXTERN PetscErrorCode TSRKSetMultirate(TS, PetscBool);
 PETSC_EXTERN PetscErrorCode TSRKGetMultirate(TS, PetscBool *);
+PETSC_EXTERN PetscErrorCode TSRKSetMultirateStability(TS, PetscErrorCode (*)(TS, PetscReal, Vec, Vec, void *), void *);
+PETSC_EXTERN PetscErrorCode TSRKSetMultirateLevels(TS, PetscInt, PetscInt);
 PETSC_EXTERN PetscErrorCode TSRKRegister(TSRKType, PetscInt, PetscInt, const PetscReal[], const PetscReal[], const PetscReal[], const PetscReal[], PetscInt, const PetscReal[]);
 PETSC_EXTERN PetscErrorCode TSRKInitializePackage(void);
 PETSC_EXTERN PetscErrorCode TSRKFinalizePackage(void);
 PETSC_EXTERN PetscErrorCode TSRKRegisterDestroy(void);
 
+PETSC_EXTERN_TYPEDEF typedef PetscErrorCode (*TSBatchRHSFunction)(TS, PetscInt, PetscInt, const PetscInt[], const PetscReal[], const PetscScalar[], PetscScalar[], void *);
+PETSC_EXTERN_TYPEDEF typedef PetscErrorCode (*TSBatchRHSJacobian)(TS, PetscInt, PetscInt, const PetscInt[], const PetscReal[], const PetscScalar[], PetscScalar[], void *);
+PETSC_EXTERN PetscErrorCode TSBatchSetRHSFunction(TS, PetscInt, TSBatchRHSFunction, void *);
+PETSC_EXTERN PetscErrorCode TSBatchSetRHSJacobian(TS, TSBatchRHSJacobian, void *);
+PETSC_EXTERN PetscErrorCode TSBatchSetImplicit(TS, PetscBool);
+
+PETSC_EXTERN PetscErrorCode TSLTSSetMaxClasses(TS, PetscInt);
+PETSC_EXTERN PetscErrorCode TSLTSGetNumClasses(TS, PetscInt *);
+
+PETSC_EXTERN PetscErrorCode TSPararealSetTimeCommunicator(TS, MPI_Comm);
+PETSC_EXTERN PetscErrorCode TSPararealGetFineTS(TS, TS *);
+PETSC_EXTERN PetscErrorCode TSPararealGetCoarseTS(TS, TS *);
+PETSC_EXTERN PetscErrorCode TSPararealSetTolerances(TS, PetscReal, PetscInt);
+PETSC_EXTERN PetscErrorCode TSPararealSetCoarseSteps(TS, PetscInt);
+PETSC_EXTERN PetscErrorCode TSPararealGetIterationNumber(TS, PetscInt *);
+
 /*J
    TSMPRKType - String with the name of a Partitioned Runge-Kutta method
 
@@ -887,6 +912,7 @@ typedef const char *TSMPRKType;
 
 PETSC_EXTERN PetscErrorCode TSMPRKGetType(TS ts, TSMPRKType *);
 PETSC_EXTERN PetscErrorCode TSMPRKSetType(TS ts, TSMPRKType);
+PETSC_EXTERN PetscErrorCode TSMPRKSetMultirateStability(TS, PetscErrorCode (*)(TS, PetscReal, Vec, Vec, void *), void *);
 PETSC_EXTERN PetscErrorCode TSMPRKRegister(TSMPRKType, PetscInt, PetscInt, PetscInt, PetscInt, const PetscReal[], const PetscReal[], const PetscReal[], const PetscInt[], const PetscReal[], const PetscReal[], const PetscReal[], const PetscInt[], const PetscReal[], const PetscReal[], const PetscReal[]);
 PETSC_EXTERN PetscErrorCode TSMPRKInitializePackage(void);
 PETSC_EXTERN PetscErrorCode TSMPRKFinalizePackage(void);
@@ -78,5 +78,12 @@ PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetSPOutput(PetscViewer, PetscBool *)
 
 PETSC_EXTERN PetscErrorCode PetscViewerHDF5SetCollective(PetscViewer, PetscBool);
 PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetCollective(PetscViewer, PetscBool *);
+
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5SetChunkSize(PetscViewer, PetscInt);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetChunkSize(PetscViewer, PetscInt *);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5SetCompression(PetscViewer, PetscInt, PetscBool);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetCompression(PetscViewer, PetscInt *, PetscBool *);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5SetFilter(PetscViewer, PetscInt, PetscInt, const PetscInt[]);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetFilter(PetscViewer, PetscInt *, PetscInt *, PetscInt[]);
 #endif /* defined(PETSC_HAVE_HDF5) */
 #endif
@@ -0,0 +1,94 @@
+/*
+   Cost of a call to VecAXPY(), VecDot() and MatMult() beyond the arithmetic, compared with the unchecked entry points
+   and with plain loops over the arrays, for the small local sizes of strong scaling
+*/
+#include <petsc/private/vecimpl.h>
+#include <petsc/private/matimpl.h>
+#include <petsctime.h>
+
+/* the time of one call, in nanoseconds */
+#define TimeCalls(its, ns, call) \
+  do { \
+    PetscLogDouble t0_, t1_; \
+    PetscCall(PetscTime(&t0_)); \
+    for (PetscInt k_ = 0; k_ < (its); k_++) PetscCall(call); \
+    PetscCall(PetscTime(&t1_)); \
+    (ns) = 1.e9 * (t1_ - t0_) / (its); \
+  } while (0)
+
+static PetscErrorCode AXPYLoop(PetscInt n, PetscScalar alpha, const PetscScalar *x, PetscScalar *y)
+{
+  for (PetscInt i = 0; i < n; i++) y[i] += alpha * x[i];
+  return 0;
+}
+
+static PetscErrorCode DotLoop(PetscInt n, const PetscScalar *x, const PetscScalar *y, PetscScalar *d)
+{
+  PetscScalar sum = 0.0;
+
+  for (PetscInt i = 0; i < n; i++) sum += y[i] * PetscConj(x[i]);
+  *d = sum;
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  Vec            x, y;
+  Mat            A;
+  PetscInt       n = 1000, its = 100000;
+  PetscScalar    d, *ya;
+  PetscLogDouble axpy[3] = {0, 0, 0}, dot[3] = {0, 0, 0}, mult[2] = {0, 0};
+
+  PetscCall(PetscInitialize(&argc, &argv, 0, 0));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-its", &its, NULL));
+
+  PetscCall(VecCreate(PETSC_COMM_SELF, &x));
+  PetscCall(VecSetSizes(x, n, n));
+  PetscCall(VecSetFromOptions(x));
+  PetscCall(VecDuplicate(x, &y));
+  PetscCall(VecSet(x, 1.0));
+  PetscCall(VecSet(y, 0.0));
+
+  /* the 1d Laplacian */
+  PetscCall(MatCreateSeqAIJ(PETSC_COMM_SELF, n, n, 3, NULL, &A));
+  PetscCall(MatSetFromOptions(A));
+  for (PetscInt i = 0; i < n; i++) {
+    if (i > 0) PetscCall(MatSetValue(A, i, i - 1, -1.0, INSERT_VALUES));
+    if (i < n - 1) PetscCall(MatSetValue(A, i, i + 1, -1.0, INSERT_VALUES));
+    PetscCall(MatSetValue(A, i, i, 2.0, INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+  PetscPreLoadBegin(PETSC_TRUE, "Dispatch");
+  TimeCalls(its, axpy[0], VecAXPY(y, 1.e-9, x));
+  TimeCalls(its, axpy[1], VecAXPYUnchecked(y, 1.e-9, x));
+  TimeCalls(its, dot[0], VecDot(x, y, &d));
+  TimeCalls(its, dot[1], VecDotUnchecked(x, y, &d));
+  TimeCalls(its, mult[0], MatMult(A, x, y));
+  TimeCalls(its, mult[1], MatMultUnchecked(A, x, y));
+  {
+    const PetscScalar *xa;
+
+    PetscCall(VecGetArrayRead(x, &xa));
+    PetscCall(VecGetArray(y, &ya));
+    TimeCalls(its, axpy[2], AXPYLoop(n, 1.e-9, xa, ya));
+    TimeCalls(its, dot[2], DotLoop(n, xa, ya, &d));
+    PetscCall(VecRestoreArray(y, &ya));
+    PetscCall(VecRestoreArrayRead(x, &xa));
+  }
+  PetscPreLoadEnd();
+
+  PetscCall(PetscPrintf(PETSC_COMM_SELF, "Time of a call in nanoseconds, n %" PetscInt_FMT "%s\n", n, PetscDefined(USE_DEBUG) ? " (debug build, the unchecked calls are checked)" : ""));
+  PetscCall(PetscPrintf(PETSC_COMM_SELF, "  %-8s %12s %12s %12s\n", "", "checked", "unchecked", "loop"));
+  PetscCall(PetscPrintf(PETSC_COMM_SELF, "  %-8s %12.1f %12.1f %12.1f\n", "VecAXPY", axpy[0], axpy[1], axpy[2]));
+  PetscCall(PetscPrintf(PETSC_COMM_SELF, "  %-8s %12.1f %12.1f %12.1f\n", "VecDot", dot[0], dot[1], dot[2]));
+  PetscCall(PetscPrintf(PETSC_COMM_SELF, "  %-8s %12.1f %12.1f %12s\n", "MatMult", mult[0], mult[1], "-"));
+
+  PetscCall(MatDestroy(&A));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(PetscFinalize());
+  return 0;
+}
@@ -409,11 +409,11 @@ static PetscErrorCode VecGetHDF5ChunkSize(DM_DA *da, Vec xin, PetscInt dimension
 #if defined(PETSC_HAVE_HDF5)
 PetscErrorCode VecView_MPI_HDF5_DA(Vec xin, PetscViewer viewer)
 {
-  PetscViewer_HDF5  *hdf5 = (PetscViewer_HDF5 *)viewer->data;
   DM                 dm;
   DM_DA             *da;
   hid_t              filespace;  /* file dataspace identifier */
   hid_t              chunkspace; /* chunk dataset property identifier */
+  hid_t              dxpl;       /* transfer property identifier */
   hid_t              dset_id;    /* dataset identifier */
   hid_t              memspace;   /* memory dataspace identifier */
   hid_t              file_id;
@@ -421,7 +421,7 @@ PetscErrorCode VecView_MPI_HDF5_DA(Vec xin, PetscViewer viewer)
   hid_t              memscalartype;  /* scalar type for mem (H5T_NATIVE_FLOAT or H5T_NATIVE_DOUBLE) */
   hid_t              filescalartype; /* scalar type for file (H5T_NATIVE_FLOAT or H5T_NATIVE_DOUBLE) */
   hsize_t            dim;
-  hsize_t            maxDims[6] = {0}, dims[6] = {0}, chunkDims[6] = {0}, count[6] = {0}, offset[6] = {0}; /* we depend on these being sane later on  */
+  hsize_t            maxDims[6] = {0}, dims[6] = {0}, chunkDims[6] = {0}, rankChunkDims[6] = {0}, count[6] = {0}, offset[6] = {0}; /* we depend on these being sane later on  */
   PetscBool          timestepping = PETSC_FALSE, dim2, spoutput;
   PetscInt           timestep     = PETSC_MIN_INT, dimension;
   const PetscScalar *x;
@@ -487,6 +487,24 @@ PetscErrorCode VecView_MPI_HDF5_DA(Vec xin, PetscViewer viewer)
   #endif
 
   PetscCall(VecGetHDF5ChunkSize(da, xin, dimension, timestep, chunkDims));
+  /* The chunk aligned with the boxes of the processes, used when the chunk size is PETSC_DECIDE */
+  PetscCall(PetscArraycpy(rankChunkDims, dims, dim));
+  {
+    const PetscInt *l[3]  = {da->lx, da->ly, da->lz};
+    const PetscInt  np[3] = {da->m, da->n, da->p};
+    PetscInt       *range;
+    hsize_t         d = timestep >= 0 ? 1 : 0;
+
+    if (timestep >= 0) rankChunkDims[0] = 1;
+    PetscCall(PetscMalloc1(PetscMax(PetscMax(da->m, da->n), da->p) + 1, &range));
+    /* the slowest varying dimension of the dataset is the last one of the DMDA */
+    for (PetscInt k = dimension - 1; k >= 0; --k, ++d) {
+      range[0] = 0;
+      for (PetscInt r = 0; r < np[k]; ++r) range[r + 1] = range[r] + l[k][r];
+      PetscCall(PetscViewerHDF5GetRankChunk_Internal(np[k], range, 1, rankChunkDims + d));
+    }
+    PetscCall(PetscFree(range));
+  }
 
   PetscCallHDF5Return(filespace, H5Screate_simple, (dim, dims, maxDims));
 
@@ -507,10 +525,10 @@ PetscErrorCode VecView_MPI_HDF5_DA(Vec xin, PetscViewer viewer)
   PetscCall(PetscObjectGetName((PetscObject)xin, &vecname));
   if (!H5Lexists(group, vecname, H5P_DEFAULT)) {
     /* Create chunk */
-    PetscCallHDF5Return(chunkspace, H5Pcreate, (H5P_DATASET_CREATE));
-    PetscCallHDF5(H5Pset_chunk, (chunkspace, dim, chunkDims));
+    PetscCall(PetscViewerHDF5CreateDatasetProperties_Internal(viewer, (int)dim, rankChunkDims, chunkDims, &chunkspace));
 
     PetscCallHDF5Return(dset_id, H5Dcreate2, (group, vecname, filescalartype, filespace, H5P_DEFAULT, chunkspace, H5P_DEFAULT));
+    PetscCallHDF5(H5Pclose, (chunkspace));
   } else {
     PetscCallHDF5Return(dset_id, H5Dopen2, (group, vecname, H5P_DEFAULT));
     PetscCallHDF5(H5Dset_extent, (dset_id, dims));
@@ -547,7 +565,9 @@ PetscErrorCode VecView_MPI_HDF5_DA(Vec xin, PetscViewer viewer)
   PetscCallHDF5(H5Sselect_hyperslab, (filespace, H5S_SELECT_SET, offset, NULL, count, NULL));
 
   PetscCall(VecGetArrayRead(xin, &x));
-  PetscCallHDF5(H5Dwrite, (dset_id, memscalartype, memspace, filespace, hdf5->dxpl_id, x));
+  PetscCall(PetscViewerHDF5CreateTransferProperties_Internal(viewer, dset_id, &dxpl));
+  PetscCallHDF5(H5Dwrite, (dset_id, memscalartype, memspace, filespace, dxpl, x));
+  PetscCallHDF5(H5Pclose, (dxpl));
   PetscCallHDF5(H5Fflush, (file_id, H5F_SCOPE_GLOBAL));
   PetscCall(VecRestoreArrayRead(xin, &x));
 
@@ -866,7 +866,7 @@ static PetscErrorCode DMPlexView_Ascii(DM dm, PetscViewer viewer)
 
       PetscCall(PetscSectionGetDof(mesh->coneSection, p, &dof));
       PetscCall(PetscSectionGetOffset(mesh->coneSection, p, &off));
-      for (c = off; c < off + dof; ++c) PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, "[%d]: %" PetscInt_FMT " <---- %" PetscInt_FMT " (%" PetscInt_FMT ")\n", rank, p, mesh->cones[c], mesh->coneOrientations[c]));
+      for (c = off; c < off + dof; ++c) PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, "[%d]: %" PetscInt_FMT " <---- %" PetscInt_FMT " (%" PetscInt_FMT ")\n", rank, p, mesh->cones[c], mesh->coneOrientations ? mesh->coneOrientations[c] : 0));
     }
     PetscCall(PetscViewerFlush(viewer));
     PetscCall(PetscViewerASCIIPopSynchronized(viewer));
@@ -2542,6 +2542,7 @@ PetscErrorCode DMDestroy_Plex(DM dm)
   PetscCall(PetscSectionDestroy(&mesh->coneSection));
   PetscCall(PetscFree(mesh->cones));
   PetscCall(PetscFree(mesh->coneOrientations));
+  PetscCall(PetscFree(mesh->coneOrientationsZero));
   PetscCall(PetscSectionDestroy(&mesh->supportSection));
   PetscCall(PetscSectionDestroy(&mesh->subdomainSection));
   PetscCall(PetscFree(mesh->supports));
@@ -3079,6 +3080,35 @@ PetscErrorCode DMPlexSetCone(DM dm, PetscInt p, const PetscInt cone[])
   PetscFunctionReturn(0);
 }
 
+/* Allocate storage for cone orientations, which are implicitly 0 until this is called */
+PetscErrorCode DMPlexCreateConeOrientations_Internal(DM dm)
+{
+  DM_Plex *mesh = (DM_Plex *)dm->data;
+  PetscInt size;
+
+  PetscFunctionBegin;
+  if (mesh->coneOrientations) PetscFunctionReturn(0);
+  PetscCall(PetscSectionGetStorageSize(mesh->coneSection, &size));
+  PetscCall(PetscCalloc1(size, &mesh->coneOrientations));
+  PetscFunctionReturn(0);
+}
+
+/* Return identity orientations for any cone when orientations are not stored */
+static inline PetscErrorCode DMPlexGetZeroConeOrientation_Static(DM dm, const PetscInt *coneOrientation[])
+{
+  DM_Plex *mesh = (DM_Plex *)dm->data;
+
+  PetscFunctionBegin;
+  if (!mesh->coneOrientationsZero) {
+    PetscInt maxConeSize;
+
+    PetscCall(PetscSectionGetMaxDof(mesh->coneSection, &maxConeSize));
+    PetscCall(PetscCalloc1(PetscMax(maxConeSize, 1), &mesh->coneOrientationsZero));
+  }
+  *coneOrientation = mesh->coneOrientationsZero;
+  PetscFunctionReturn(0);
+}
+
 /*@C
   DMPlexGetConeOrientation - Return the orientations on the in-edges for this point in the DAG
 
@@ -3118,9 +3148,11 @@ PetscErrorCode DMPlexGetConeOrientation(DM dm, PetscInt p, const PetscInt *coneO
     PetscCall(PetscSectionGetDof(mesh->coneSection, p, &dof));
     if (dof) PetscValidPointer(coneOrientation, 3);
   }
-  PetscCall(PetscSectionGetOffset(mesh->coneSection, p, &off));
-
-  *coneOrientation = &mesh->coneOrientations[off];
+  if (PetscUnlikely(!mesh->coneOrientations)) PetscCall(DMPlexGetZeroConeOrientation_Static(dm, coneOrientation));
+  else {
+    PetscCall(PetscSectionGetOffset(mesh->coneSection, p, &off));
+    *coneOrientation = &mesh->coneOrientations[off];
+  }
   PetscFunctionReturn(0);
 }
 
@@ -3161,6 +3193,10 @@ PetscErrorCode DMPlexSetConeOrientation(DM dm, PetscInt p, const PetscInt coneOr
 
     PetscCall(PetscSectionGetDof(mesh->coneSection, mesh->cones[off + c], &cdof));
     PetscCheck(!o || (o >= -(cdof + 1) && o < cdof), PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone orientation %" PetscInt_FMT " is not in the valid range [%" PetscInt_FMT ". %" PetscInt_FMT ")", o, -(cdof + 1), cdof);
+    if (!mesh->coneOrientations) {
+      if (!o) continue;
+      PetscCall(DMPlexCreateConeOrientations_Internal(dm));
+    }
     mesh->coneOrientations[off + c] = o;
   }
   PetscFunctionReturn(0);
@@ -3230,6 +3266,10 @@ PetscErrorCode DMPlexInsertConeOrientation(DM dm, PetscInt p, PetscInt conePos,
   PetscCall(PetscSectionGetDof(mesh->coneSection, p, &dof));
   PetscCall(PetscSectionGetOffset(mesh->coneSection, p, &off));
   PetscCheck(!(conePos < 0) && !(conePos >= dof), PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone position %" PetscInt_FMT " of point %" PetscInt_FMT " is not in the valid range [0, %" PetscInt_FMT ")", conePos, p, dof);
+  if (!mesh->coneOrientations) {
+    if (!coneOrientation) PetscFunctionReturn(0);
+    PetscCall(DMPlexCreateConeOrientations_Internal(dm));
+  }
   mesh->coneOrientations[off + conePos] = coneOrientation;
   PetscFunctionReturn(0);
 }
@@ -3284,7 +3324,10 @@ PetscErrorCode DMPlexGetOrientedCone(DM dm, PetscInt p, const PetscInt *cone[],
     }
     PetscCall(PetscSectionGetOffset(mesh->coneSection, p, &off));
     if (cone) *cone = &mesh->cones[off];
-    if (ornt) *ornt = &mesh->coneOrientations[off];
+    if (ornt) {
+      if (PetscUnlikely(!mesh->coneOrientations)) PetscCall(DMPlexGetZeroConeOrientation_Static(dm, ornt));
+      else *ornt = &mesh->coneOrientations[off];
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -3885,7 +3928,9 @@ PetscErrorCode DMSetUp_Plex(DM dm)
   PetscCall(PetscSectionSetUp(mesh->coneSection));
   PetscCall(PetscSectionGetStorageSize(mesh->coneSection, &size));
   PetscCall(PetscMalloc1(size, &mesh->cones));
-  PetscCall(PetscCalloc1(size, &mesh->coneOrientations));
+  /* Orientations are only stored once a nonzero orientation is set */
+  PetscCall(PetscFree(mesh->coneOrientations));
+  PetscCall(PetscFree(mesh->coneOrientationsZero));
   PetscCall(PetscSectionGetMaxDof(mesh->supportSection, &maxSupportSize));
   if (maxSupportSize) {
     PetscCall(PetscSectionSetUp(mesh->supportSection));
@@ -5330,6 +5375,8 @@ PetscErrorCode DMPlexGetCones(DM dm, PetscInt *cones[])
 
   The meaning of coneOrientations values is detailed in `DMPlexGetConeOrientation()`.
 
+  Orientations are not stored while they are all 0, as for a mesh which is not interpolated, so this call allocates the array if necessary.
+
 .seealso: [](chapter_unstructured), `DM`, `DMPLEX`, `DMPlexGetConeSection()`, `DMPlexGetConeOrientation()`, `PetscSection`
 @*/
 PetscErrorCode DMPlexGetConeOrientations(DM dm, PetscInt *coneOrientations[])
@@ -5338,7 +5385,10 @@ PetscErrorCode DMPlexGetConeOrientations(DM dm, PetscInt *coneOrientations[])
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
-  if (coneOrientations) *coneOrientations = mesh->coneOrientations;
+  if (coneOrientations) {
+    if (!mesh->coneOrientations) PetscCall(DMPlexCreateConeOrientations_Internal(dm));
+    *coneOrientations = mesh->coneOrientations;
+  }
   PetscFunctionReturn(0);
 }
 
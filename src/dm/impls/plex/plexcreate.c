@@ -4129,7 +4129,7 @@ static PetscErrorCode DMSetFromOptions_Plex(DM dm, PetscOptionItems *PetscOption
   char                     oname[256];
   PetscReal                volume    = -1.0;
   PetscInt                 prerefine = 0, refine = 0, r, coarsen = 0, overlap = 0, extLayers = 0, dim;
-  PetscBool                uniformOrig, created = PETSC_FALSE, uniform = PETSC_TRUE, distribute, interpolate = PETSC_TRUE, coordSpace = PETSC_TRUE, remap = PETSC_TRUE, ghostCells = PETSC_FALSE, isHierarchy, ignoreModel = PETSC_FALSE, flg;
+  PetscBool                uniformOrig, created = PETSC_FALSE, uniform = PETSC_TRUE, distribute, interpolate = PETSC_TRUE, coordSpace = PETSC_TRUE, remap = PETSC_TRUE, ghostCells = PETSC_FALSE, isHierarchy, ignoreModel = PETSC_FALSE, reorderDist = PETSC_FALSE, flg;
   DMPlexReorderDefaultFlag reorder;
 
   PetscFunctionBegin;
@@ -4204,7 +4204,7 @@ static PetscErrorCode DMSetFromOptions_Plex(DM dm, PetscOptionItems *PetscOption
   PetscCall(DMPlexReorderGetDefault(dm, &reorder));
   PetscCall(MatGetOrderingList(&ordlist));
   PetscCall(PetscStrncpy(oname, MATORDERINGNATURAL, sizeof(oname)));
-  PetscCall(PetscOptionsFList("-dm_plex_reorder", "Set mesh reordering type", "DMPlexGetOrdering", ordlist, MATORDERINGNATURAL, oname, sizeof(oname), &flg));
+  PetscCall(PetscOptionsFList("-dm_plex_reorder", "Set mesh reordering type, a MatOrderingType or hilbert or morton", "DMPlexGetOrdering", ordlist, MATORDERINGNATURAL, oname, sizeof(oname), &flg));
   if (reorder == DMPLEX_REORDER_DEFAULT_TRUE || flg) {
     DM pdm;
     IS perm;
@@ -4228,6 +4228,19 @@ static PetscErrorCode DMSetFromOptions_Plex(DM dm, PetscOptionItems *PetscOption
     PetscCall(DMPlexDistribute(dm, overlap, NULL, &pdm));
     if (pdm) PetscCall(DMPlexReplace_Internal(dm, &pdm));
   }
+  /* Handle DMPlex reordering of the local meshes after distribution */
+  PetscCall(PetscOptionsBool("-dm_plex_reorder_distributed", "Reorder the local meshes after distribution", "DMPlexGetOrdering", reorderDist, &reorderDist, NULL));
+  if (reorderDist) {
+    DM pdm;
+    IS perm;
+
+    PetscCheck(flg, PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_INCOMP, "-dm_plex_reorder_distributed needs the ordering given with -dm_plex_reorder");
+    PetscCall(DMPlexGetOrdering(dm, oname, NULL, &perm));
+    PetscCall(DMPlexPermute(dm, perm, &pdm));
+    PetscCall(ISDestroy(&perm));
+    PetscCall(DMPlexReplace_Internal(dm, &pdm));
+    PetscCall(DMSetFromOptions_NonRefinement_Plex(dm, PetscOptionsObject));
+  }
   /* Create coordinate space */
   if (created) {
     DM_Plex  *mesh   = (DM_Plex *)dm->data;
@@ -4541,6 +4554,8 @@ PETSC_INTERN PetscErrorCode DMClone_Plex(DM dm, DM *newdm)
 + -dm_refine_volume_limit_pre        - Cell volume limit after pre-refinement using generator
 . -dm_distribute                     - Distribute mesh across processes
 . -dm_distribute_overlap             - Number of cells to overlap for distribution
+. -dm_plex_reorder <order>           - Reorder the mesh before distribution, e.g. rcm, hilbert, or morton
+. -dm_plex_reorder_distributed       - Also reorder each local mesh after distribution with the ordering given by -dm_plex_reorder, renumbering the point `PetscSF`
 . -dm_refine                         - Refine mesh after distribution
 . -dm_plex_hash_location             - Use grid hashing for point location
 . -dm_plex_hash_box_faces <n,m,p>    - The number of divisions in each direction of the grid hash
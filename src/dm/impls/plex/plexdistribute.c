@@ -1172,10 +1172,18 @@ static PetscErrorCode DMPlexDistributeCones(DM dm, PetscSF migrationSF, ISLocalT
     PetscCall(PetscSectionView(newConeSection, PETSC_VIEWER_STDOUT_(comm)));
     PetscCall(PetscSFView(coneSF, NULL));
   }
-  PetscCall(DMPlexGetConeOrientations(dm, &cones));
-  PetscCall(DMPlexGetConeOrientations(dmParallel, &newCones));
-  PetscCall(PetscSFBcastBegin(coneSF, MPIU_INT, cones, newCones, MPI_REPLACE));
-  PetscCall(PetscSFBcastEnd(coneSF, MPIU_INT, cones, newCones, MPI_REPLACE));
+  /* Orientations are only stored when some are nonzero, so only communicate them if needed */
+  {
+    PetscBool lhasOrnt = ((DM_Plex *)dm->data)->coneOrientations ? PETSC_TRUE : PETSC_FALSE, hasOrnt;
+
+    PetscCall(MPIU_Allreduce(&lhasOrnt, &hasOrnt, 1, MPIU_BOOL, MPI_LOR, comm));
+    if (hasOrnt) {
+      PetscCall(DMPlexGetConeOrientations(dm, &cones));
+      PetscCall(DMPlexGetConeOrientations(dmParallel, &newCones));
+      PetscCall(PetscSFBcastBegin(coneSF, MPIU_INT, cones, newCones, MPI_REPLACE));
+      PetscCall(PetscSFBcastEnd(coneSF, MPIU_INT, cones, newCones, MPI_REPLACE));
+    }
+  }
   PetscCall(PetscSFDestroy(&coneSF));
   PetscCall(PetscLogEventEnd(DMPLEX_DistributeCones, dm, 0, 0, 0));
   /* Create supports and stratify DMPlex */
@@ -191,3 +191,119 @@ PetscErrorCode DMPlexReconstructGradientsFVM(DM dm, Vec locX, Vec grad)
   PetscCall(DMPlexReconstructGradients_Internal(dm, fvm, fStart, fEnd, faceGeometryFVM, cellGeometryFVM, locX, grad));
   PetscFunctionReturn(0);
 }
+
+/*
+  DMPlexAccumulateFluxesFVM_Internal - Adds dt times the finite volume fluxes through a list of faces to the cells on both sides of them
+
+  The cell values are used on both sides of the faces, without gradient reconstruction. The faces must have two supporting
+  cells and no children, and must not be ghost faces. As in DMPlexComputeResidual_Internal(), the cells which are ghosts of
+  another process do not receive the fluxes; without a "ghost" label all cells receive them.
+*/
+PetscErrorCode DMPlexAccumulateFluxesFVM_Internal(DM dm, PetscInt numFaces, const PetscInt faces[], Vec faceGeometry, Vec cellGeometry, Vec locX, PetscReal dt, Vec locF)
+{
+  DM                 dmFace, dmCell;
+  DMLabel            ghostLabel = NULL;
+  PetscDS            ds;
+  const PetscScalar *facegeom, *cellgeom, *x;
+  PetscScalar       *fa, *uL, *uR, *fluxL, *fluxR;
+  PetscFVFaceGeom   *fgeom;
+  PetscReal         *vol;
+  PetscInt           dim, Nf, Nc, totDim;
+
+  PetscFunctionBegin;
+  if (!numFaces) PetscFunctionReturn(0);
+  PetscCall(DMGetDimension(dm, &dim));
+  PetscCall(DMGetDS(dm, &ds));
+  PetscCall(PetscDSGetNumFields(ds, &Nf));
+  PetscCall(PetscDSGetTotalComponents(ds, &Nc));
+  PetscCall(PetscDSGetTotalDimension(ds, &totDim));
+  PetscCall(DMGetLabel(dm, "ghost", &ghostLabel));
+  PetscCall(VecGetDM(faceGeometry, &dmFace));
+  PetscCall(VecGetDM(cellGeometry, &dmCell));
+  PetscCall(VecGetArrayRead(faceGeometry, &facegeom));
+  PetscCall(VecGetArrayRead(cellGeometry, &cellgeom));
+  PetscCall(VecGetArrayRead(locX, &x));
+  PetscCall(PetscMalloc1(numFaces, &fgeom));
+  PetscCall(DMGetWorkArray(dm, numFaces * 2, MPIU_REAL, &vol));
+  PetscCall(DMGetWorkArray(dm, numFaces * Nc, MPIU_SCALAR, &uL));
+  PetscCall(DMGetWorkArray(dm, numFaces * Nc, MPIU_SCALAR, &uR));
+  PetscCall(DMGetWorkArray(dm, numFaces * totDim, MPIU_SCALAR, &fluxL));
+  PetscCall(DMGetWorkArray(dm, numFaces * totDim, MPIU_SCALAR, &fluxR));
+  PetscCall(PetscArrayzero(fluxL, numFaces * totDim));
+  PetscCall(PetscArrayzero(fluxR, numFaces * totDim));
+  /* Gather the geometry and the states on both sides of the faces */
+  for (PetscInt iface = 0; iface < numFaces; ++iface) {
+    const PetscInt  *cells;
+    PetscFVFaceGeom *fg;
+    PetscFVCellGeom *cgL, *cgR;
+
+    PetscCall(DMPlexGetSupport(dm, faces[iface], &cells));
+    PetscCall(DMPlexPointLocalRead(dmFace, faces[iface], facegeom, &fg));
+    PetscCall(DMPlexPointLocalRead(dmCell, cells[0], cellgeom, &cgL));
+    PetscCall(DMPlexPointLocalRead(dmCell, cells[1], cellgeom, &cgR));
+    for (PetscInt d = 0; d < dim; ++d) {
+      fgeom[iface].centroid[d] = fg->centroid[d];
+      fgeom[iface].normal[d]   = fg->normal[d];
+    }
+    vol[iface * 2 + 0] = cgL->volume;
+    vol[iface * 2 + 1] = cgR->volume;
+    for (PetscInt f = 0; f < Nf; ++f) {
+      const PetscScalar *xL, *xR;
+      PetscFV            fv;
+      PetscInt           off, numComp;
+
+      PetscCall(PetscDSGetComponentOffset(ds, f, &off));
+      PetscCall(PetscDSGetDiscretization(ds, f, (PetscObject *)&fv));
+      PetscCall(PetscFVGetNumComponents(fv, &numComp));
+      PetscCall(DMPlexPointLocalFieldRead(dm, cells[0], f, x, &xL));
+      PetscCall(DMPlexPointLocalFieldRead(dm, cells[1], f, x, &xR));
+      for (PetscInt c = 0; c < numComp; ++c) {
+        uL[iface * Nc + off + c] = xL[c];
+        uR[iface * Nc + off + c] = xR[c];
+      }
+    }
+  }
+  /* Riemann solve over faces */
+  for (PetscInt f = 0; f < Nf; ++f) {
+    PetscFV fv;
+
+    PetscCall(PetscDSGetDiscretization(ds, f, (PetscObject *)&fv));
+    PetscCall(PetscFVIntegrateRHSFunction(fv, ds, f, numFaces, fgeom, vol, uL, uR, fluxL, fluxR));
+  }
+  /* Accumulate fluxes to cells */
+  PetscCall(VecGetArray(locF, &fa));
+  for (PetscInt f = 0; f < Nf; ++f) {
+    PetscFV  fv;
+    PetscInt foff, pdim;
+
+    PetscCall(PetscDSGetDiscretization(ds, f, (PetscObject *)&fv));
+    PetscCall(PetscDSGetFieldOffset(ds, f, &foff));
+    PetscCall(PetscFVGetNumComponents(fv, &pdim));
+    for (PetscInt iface = 0; iface < numFaces; ++iface) {
+      const PetscInt *cells;
+      PetscScalar    *fL = NULL, *fR = NULL;
+      PetscInt        ghost = -1;
+
+      PetscCall(DMPlexGetSupport(dm, faces[iface], &cells));
+      if (ghostLabel) PetscCall(DMLabelGetValue(ghostLabel, cells[0], &ghost));
+      if (ghost <= 0) PetscCall(DMPlexPointLocalFieldRef(dm, cells[0], f, fa, &fL));
+      if (ghostLabel) PetscCall(DMLabelGetValue(ghostLabel, cells[1], &ghost));
+      if (ghost <= 0) PetscCall(DMPlexPointLocalFieldRef(dm, cells[1], f, fa, &fR));
+      for (PetscInt d = 0; d < pdim; ++d) {
+        if (fL) fL[d] -= dt * fluxL[iface * totDim + foff + d];
+        if (fR) fR[d] += dt * fluxR[iface * totDim + foff + d];
+      }
+    }
+  }
+  PetscCall(VecRestoreArray(locF, &fa));
+  PetscCall(DMRestoreWorkArray(dm, numFaces * totDim, MPIU_SCALAR, &fluxR));
+  PetscCall(DMRestoreWorkArray(dm, numFaces * totDim, MPIU_SCALAR, &fluxL));
+  PetscCall(DMRestoreWorkArray(dm, numFaces * Nc, MPIU_SCALAR, &uR));
+  PetscCall(DMRestoreWorkArray(dm, numFaces * Nc, MPIU_SCALAR, &uL));
+  PetscCall(DMRestoreWorkArray(dm, numFaces * 2, MPIU_REAL, &vol));
+  PetscCall(PetscFree(fgeom));
+  PetscCall(VecRestoreArrayRead(locX, &x));
+  PetscCall(VecRestoreArrayRead(cellGeometry, &cellgeom));
+  PetscCall(VecRestoreArrayRead(faceGeometry, &facegeom));
+  PetscFunctionReturn(0);
+}
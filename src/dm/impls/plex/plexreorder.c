@@ -45,6 +45,129 @@ static PetscErrorCode DMPlexCreateOrderingClosure_Static(DM dm, PetscInt numPoin
   PetscFunctionReturn(0);
 }
 
+/* Compute the bandwidth of the cell adjacency graph when cell cperm[c] is given the new number c */
+static PetscErrorCode DMPlexGetCellGraphBandwidth_Static(PetscInt numCells, const PetscInt start[], const PetscInt adjacency[], const PetscInt cperm[], PetscInt work[], PetscInt *bw)
+{
+  PetscInt c, a;
+
+  PetscFunctionBegin;
+  *bw = 0;
+  for (c = 0; c < numCells; ++c) work[cperm[c]] = c;
+  for (c = 0; c < numCells; ++c) {
+    for (a = start[c]; a < start[c + 1]; ++a) *bw = PetscMax(*bw, PetscAbsInt(work[c] - work[adjacency[a]]));
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Neighbors closer than this many cells are counted as local, about the cells whose closures fit in a few cache lines */
+#define DMPLEX_ORDERING_LOCALITY_WINDOW 16
+
+/* Compute the fraction of the cell adjacencies whose two cells are less than window apart when cell cperm[c] is given the new number c */
+static PetscErrorCode DMPlexGetCellGraphLocality_Static(PetscInt numCells, const PetscInt start[], const PetscInt adjacency[], const PetscInt cperm[], PetscInt window, PetscInt work[], PetscReal *locality)
+{
+  PetscInt c, a, near = 0;
+
+  PetscFunctionBegin;
+  for (c = 0; c < numCells; ++c) work[cperm[c]] = c;
+  for (c = 0; c < numCells; ++c) {
+    for (a = start[c]; a < start[c + 1]; ++a)
+      if (PetscAbsInt(work[c] - work[adjacency[a]]) < window) ++near;
+  }
+  *locality = numCells && start[numCells] ? (PetscReal)near / (PetscReal)start[numCells] : 1.0;
+  PetscFunctionReturn(0);
+}
+
+static int DMPlexCompareSFCKeys_Static(const void *a, const void *b, void *ctx)
+{
+  const PetscInt64 ka = *(const PetscInt64 *)a, kb = *(const PetscInt64 *)b;
+
+  return ka < kb ? -1 : (ka > kb ? 1 : 0);
+}
+
+/*
+  Convert integer coordinates X[] with b bits per dimension to the transposed Hilbert index, following
+  J. Skilling, Programming the Hilbert curve, AIP Conference Proceedings 707, 2004.
+*/
+static void DMPlexHilbertTranspose_Static(PetscInt dim, PetscInt b, PetscInt64 X[])
+{
+  const PetscInt64 M = (PetscInt64)1 << (b - 1);
+  PetscInt64       P, Q, t;
+  PetscInt         d;
+
+  /* Inverse undo */
+  for (Q = M; Q > 1; Q >>= 1) {
+    P = Q - 1;
+    for (d = 0; d < dim; ++d) {
+      if (X[d] & Q) X[0] ^= P;
+      else {
+        t = (X[0] ^ X[d]) & P;
+        X[0] ^= t;
+        X[d] ^= t;
+      }
+    }
+  }
+  /* Gray encode */
+  for (d = 1; d < dim; ++d) X[d] ^= X[d - 1];
+  t = 0;
+  for (Q = M; Q > 1; Q >>= 1)
+    if (X[dim - 1] & Q) t ^= Q - 1;
+  for (d = 0; d < dim; ++d) X[d] ^= t;
+}
+
+/* Order the cells along a Hilbert or Morton curve through their vertex centroids */
+static PetscErrorCode DMPlexGetOrderingSFC_Static(DM dm, PetscBool hilbert, PetscInt numCells, PetscInt cperm[])
+{
+  PetscReal  *centroids, lower[3], upper[3];
+  PetscInt64 *keys;
+  PetscInt    cdim, cStart, b, c, d;
+
+  PetscFunctionBegin;
+  PetscCall(DMGetCoordinateDim(dm, &cdim));
+  PetscCheck(cdim <= 3, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Space-filling curve ordering not supported in dimension %" PetscInt_FMT, cdim);
+  PetscCall(DMPlexGetHeightStratum(dm, 0, &cStart, NULL));
+  PetscCall(DMGetCoordinatesLocalSetUp(dm));
+  PetscCall(PetscMalloc2(numCells * cdim, &centroids, numCells, &keys));
+  for (d = 0; d < cdim; ++d) {
+    lower[d] = PETSC_MAX_REAL;
+    upper[d] = PETSC_MIN_REAL;
+  }
+  for (c = 0; c < numCells; ++c) {
+    const PetscScalar *array;
+    PetscScalar       *coords = NULL;
+    PetscBool          isDG;
+    PetscInt           Nc, v;
+
+    PetscCall(DMPlexGetCellCoordinates(dm, cStart + c, &isDG, &Nc, &array, &coords));
+    for (d = 0; d < cdim; ++d) {
+      centroids[c * cdim + d] = 0.;
+      for (v = 0; v < Nc / cdim; ++v) centroids[c * cdim + d] += PetscRealPart(coords[v * cdim + d]);
+      centroids[c * cdim + d] /= PetscMax(Nc / cdim, 1);
+      lower[d] = PetscMin(lower[d], centroids[c * cdim + d]);
+      upper[d] = PetscMax(upper[d], centroids[c * cdim + d]);
+    }
+    PetscCall(DMPlexRestoreCellCoordinates(dm, cStart + c, &isDG, &Nc, &array, &coords));
+  }
+  /* Keep the interleaved key inside a signed 64-bit integer */
+  b = 62 / cdim;
+  for (c = 0; c < numCells; ++c) {
+    PetscInt64 X[3];
+    PetscInt   bit;
+
+    keys[c] = 0;
+    for (d = 0; d < cdim; ++d) {
+      const PetscReal h = upper[d] > lower[d] ? (centroids[c * cdim + d] - lower[d]) / (upper[d] - lower[d]) : 0.;
+
+      X[d] = (PetscInt64)(h * (PetscReal)(((PetscInt64)1 << b) - 1));
+    }
+    if (hilbert) DMPlexHilbertTranspose_Static(cdim, b, X);
+    for (bit = b - 1; bit >= 0; --bit)
+      for (d = 0; d < cdim; ++d) keys[c] = (keys[c] << 1) | ((X[d] >> bit) & 1);
+  }
+  if (numCells) PetscCall(PetscTimSortWithArray(numCells, keys, sizeof(PetscInt64), cperm, sizeof(PetscInt), DMPlexCompareSFCKeys_Static, NULL));
+  PetscCall(PetscFree2(centroids, keys));
+  PetscFunctionReturn(0);
+}
+
 /*@
   DMPlexGetOrdering - Calculate a reordering of the mesh
 
@@ -58,38 +181,66 @@ $     MATORDERINGND - Nested Dissection
 $     MATORDERING1WD - One-way Dissection
 $     MATORDERINGRCM - Reverse Cuthill-McKee
 $     MATORDERINGQMD - Quotient Minimum Degree
+$     DMPLEX_ORDERING_HILBERT - Hilbert space-filling curve through the cell centroids
+$     DMPLEX_ORDERING_MORTON - Morton (Z-order) space-filling curve through the cell centroids
 - label - [Optional] Label used to segregate ordering into sets, or NULL
 
   Output Parameter:
 . perm - The point permutation as an IS, perm[old point number] = new point number
 
-  Note: The label is used to group sets of points together by label value. This makes it easy to reorder a mesh which
+  Notes:
+  The label is used to group sets of points together by label value. This makes it easy to reorder a mesh which
   has different types of cells, and then loop over each set of reordered cells for assembly.
 
+  Only the cells are ordered by the chosen method. Faces, edges, and vertices are numbered in the order in which the
+  reordered cells first visit them, so that the closure of consecutive cells is close in memory. The bandwidth of the
+  cell adjacency graph before and after reordering is reported with `PetscInfo()`, together with its locality, the
+  fraction of the pairs of neighboring cells that are less than 16 cells apart.
+
+  RCM reduces the bandwidth. The space-filling curves do not, a few neighbors end up far apart, but they keep most
+  neighbors within a few cells of each other in every direction, which is what matters for caches. They improve the
+  locality of meshes whose numbering follows lines or planes longer than that window, and of unstructured meshes numbered
+  in no particular order.
+
   Level: intermediate
 
-.seealso: `DMPlexPermute()`, `MatGetOrdering()`
+.seealso: `DMPlexPermute()`, `MatGetOrdering()`, `DMPlexReorderSetDefault()`
 @*/
 PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS *perm)
 {
   PetscInt  numCells = 0;
   PetscInt *start = NULL, *adjacency = NULL, *cperm, *clperm = NULL, *invclperm = NULL, *mask, *xls, pStart, pEnd, c, i;
+  PetscInt  bw, bwNew;
+  PetscReal loc, locNew;
+  PetscBool hilbert, morton;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   PetscValidPointer(perm, 4);
+  PetscCall(PetscStrcmp(otype, DMPLEX_ORDERING_HILBERT, &hilbert));
+  PetscCall(PetscStrcmp(otype, DMPLEX_ORDERING_MORTON, &morton));
   PetscCall(DMPlexCreateNeighborCSR(dm, 0, &numCells, &start, &adjacency));
   PetscCall(PetscMalloc3(numCells, &cperm, numCells, &mask, numCells * 2, &xls));
-  if (numCells) {
+  for (c = 0; c < numCells; ++c) cperm[c] = c;
+  PetscCall(DMPlexGetCellGraphBandwidth_Static(numCells, start, adjacency, cperm, mask, &bw));
+  PetscCall(DMPlexGetCellGraphLocality_Static(numCells, start, adjacency, cperm, DMPLEX_ORDERING_LOCALITY_WINDOW, mask, &loc));
+  if (hilbert || morton) {
+    PetscCall(DMPlexGetOrderingSFC_Static(dm, hilbert, numCells, cperm));
+  } else if (numCells) {
     /* Shift for Fortran numbering */
     for (i = 0; i < start[numCells]; ++i) ++adjacency[i];
     for (i = 0; i <= numCells; ++i) ++start[i];
     PetscCall(SPARSEPACKgenrcm(&numCells, start, adjacency, cperm, mask, xls));
+    /* Shift for Fortran numbering */
+    for (i = 0; i < start[numCells] - 1; ++i) --adjacency[i];
+    for (i = 0; i <= numCells; ++i) --start[i];
+    for (c = 0; c < numCells; ++c) --cperm[c];
   }
+  PetscCall(DMPlexGetCellGraphBandwidth_Static(numCells, start, adjacency, cperm, mask, &bwNew));
+  PetscCall(DMPlexGetCellGraphLocality_Static(numCells, start, adjacency, cperm, DMPLEX_ORDERING_LOCALITY_WINDOW, mask, &locNew));
+  PetscCall(PetscInfo(dm, "Ordering %s changed cell graph bandwidth from %" PetscInt_FMT " to %" PetscInt_FMT ", neighbors less than %d cells apart from %.0f%% to %.0f%%\n", otype, bw, bwNew, DMPLEX_ORDERING_LOCALITY_WINDOW, (double)(100 * loc), (double)(100 * locNew)));
   PetscCall(PetscFree(start));
   PetscCall(PetscFree(adjacency));
-  /* Shift for Fortran numbering */
-  for (c = 0; c < numCells; ++c) --cperm[c];
   /* Segregate */
   if (label) {
     IS              valueIS;
@@ -274,7 +425,7 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
   }
   plexNew = (DM_Plex *)(*pdm)->data;
   /* Ignore ltogmap, ltogmapb */
-  /* Ignore sf, sectionSF */
+  /* Ignore sectionSF */
   /* Ignore globalVertexNumbers, globalCellNumbers */
   /* Reorder labels */
   {
@@ -307,7 +458,7 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
     PetscCall(PetscSectionPermute(plex->coneSection, perm, &plexNew->coneSection));
     PetscCall(PetscSectionGetStorageSize(plexNew->coneSection, &n));
     PetscCall(PetscMalloc1(n, &plexNew->cones));
-    PetscCall(PetscMalloc1(n, &plexNew->coneOrientations));
+    if (plex->coneOrientations) PetscCall(PetscMalloc1(n, &plexNew->coneOrientations));
     PetscCall(ISGetIndices(perm, &pperm));
     PetscCall(PetscSectionGetChart(plex->coneSection, &pStart, &pEnd));
     for (p = pStart; p < pEnd; ++p) {
@@ -316,10 +467,9 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
       PetscCall(PetscSectionGetDof(plexNew->coneSection, pperm[p], &dof));
       PetscCall(PetscSectionGetOffset(plex->coneSection, p, &off));
       PetscCall(PetscSectionGetOffset(plexNew->coneSection, pperm[p], &offNew));
-      for (d = 0; d < dof; ++d) {
-        plexNew->cones[offNew + d]            = pperm[plex->cones[off + d]];
-        plexNew->coneOrientations[offNew + d] = plex->coneOrientations[off + d];
-      }
+      for (d = 0; d < dof; ++d) plexNew->cones[offNew + d] = pperm[plex->cones[off + d]];
+      if (plex->coneOrientations)
+        for (d = 0; d < dof; ++d) plexNew->coneOrientations[offNew + d] = plex->coneOrientations[off + d];
     }
     PetscCall(PetscSectionDestroy(&plexNew->supportSection));
     PetscCall(PetscSectionPermute(plex->supportSection, perm, &plexNew->supportSection));
@@ -336,6 +486,40 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
     }
     PetscCall(ISRestoreIndices(perm, &pperm));
   }
+  /* Renumber the point SF, since roots are permuted on their owning process */
+  {
+    PetscSF            sf, sfNew;
+    const PetscSFNode *remote;
+    const PetscInt    *local, *pperm;
+    PetscSFNode       *remoteNew, tmp;
+    PetscInt          *localNew, *rperm, nroots, nleaves, l;
+
+    PetscCall(DMGetPointSF(dm, &sf));
+    PetscCall(PetscSFGetGraph(sf, &nroots, &nleaves, &local, &remote));
+    if (nroots >= 0) {
+      PetscCall(ISGetIndices(perm, &pperm));
+      PetscCall(PetscMalloc1(nroots, &rperm));
+      PetscCall(PetscSFBcastBegin(sf, MPIU_INT, pperm, rperm, MPI_REPLACE));
+      PetscCall(PetscSFBcastEnd(sf, MPIU_INT, pperm, rperm, MPI_REPLACE));
+      PetscCall(PetscMalloc1(nleaves, &localNew));
+      PetscCall(PetscMalloc1(nleaves, &remoteNew));
+      for (l = 0; l < nleaves; ++l) {
+        const PetscInt leaf = local ? local[l] : l;
+
+        localNew[l]        = pperm[leaf];
+        remoteNew[l].rank  = remote[l].rank;
+        remoteNew[l].index = rperm[leaf];
+      }
+      PetscCall(ISRestoreIndices(perm, &pperm));
+      PetscCall(PetscFree(rperm));
+      /* The permutation does not preserve the leaf order, so sort the leaves and carry the remote points along */
+      PetscCall(PetscSortIntWithDataArray(nleaves, localNew, remoteNew, sizeof(PetscSFNode), &tmp));
+      PetscCall(PetscSFCreate(PetscObjectComm((PetscObject)dm), &sfNew));
+      PetscCall(PetscSFSetGraph(sfNew, nroots, nleaves, localNew, PETSC_OWN_POINTER, remoteNew, PETSC_OWN_POINTER));
+      PetscCall(DMSetPointSF(*pdm, sfNew));
+      PetscCall(PetscSFDestroy(&sfNew));
+    }
+  }
   /* Remap coordinates */
   {
     DM           cdm, cdmNew;
@@ -9,6 +9,7 @@ typedef struct {
   PetscInt *numComponents;   /* The number of field components */
   PetscInt *numDof;          /* The dof signature for the section */
   PetscInt  numGroups;       /* If greater than 1, use grouping in test */
+  char      order[256];      /* The cell ordering to test */
 } AppCtx;
 
 PetscErrorCode ProcessOptions(AppCtx *options)
@@ -21,6 +22,7 @@ PetscErrorCode ProcessOptions(AppCtx *options)
   options->numComponents = NULL;
   options->numDof        = NULL;
   options->numGroups     = 0;
+  PetscCall(PetscStrncpy(options->order, MATORDERINGRCM, sizeof(options->order)));
 
   PetscOptionsBegin(PETSC_COMM_SELF, "", "Meshing Problem Options", "DMPLEX");
   PetscCall(PetscOptionsBoundedInt("-num_fields", "The number of section fields", "ex10.c", options->numFields, &options->numFields, NULL, 1));
@@ -31,6 +33,7 @@ PetscErrorCode ProcessOptions(AppCtx *options)
     PetscCheck(!flg || !(len != options->numFields), PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Length of components array is %" PetscInt_FMT " should be %" PetscInt_FMT, len, options->numFields);
   }
   PetscCall(PetscOptionsBoundedInt("-num_groups", "Group permutation by this many label values", "ex10.c", options->numGroups, &options->numGroups, NULL, 0));
+  PetscCall(PetscOptionsString("-order", "The cell ordering to test", "ex10.c", options->order, options->order, sizeof(options->order), NULL));
   PetscOptionsEnd();
   PetscFunctionReturn(0);
 }
@@ -54,13 +57,32 @@ PetscErrorCode CreateTestMesh(MPI_Comm comm, DM *dm, AppCtx *options)
   PetscFunctionReturn(0);
 }
 
+/* The fraction of the pairs of neighboring cells that are less than window cells apart */
+PetscErrorCode ComputeLocality(DM dm, PetscInt window, PetscReal *locality)
+{
+  PetscInt *start, *adjacency, numCells, near = 0;
+
+  PetscFunctionBegin;
+  PetscCall(DMPlexCreateNeighborCSR(dm, 0, &numCells, &start, &adjacency));
+  for (PetscInt c = 0; c < numCells; ++c) {
+    for (PetscInt a = start[c]; a < start[c + 1]; ++a)
+      if (PetscAbsInt(c - adjacency[a]) < window) ++near;
+  }
+  *locality = numCells && start[numCells] ? (PetscReal)near / (PetscReal)start[numCells] : 1.0;
+  PetscCall(PetscFree(start));
+  PetscCall(PetscFree(adjacency));
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode TestReordering(DM dm, AppCtx *user)
 {
   DM              pdm;
   IS              perm;
   Mat             A, pA;
   PetscInt        bw, pbw;
-  MatOrderingType order = MATORDERINGRCM;
+  PetscReal       loc, ploc;
+  PetscBool       hilbert, morton;
+  MatOrderingType order = user->order;
 
   PetscFunctionBegin;
   PetscCall(DMPlexGetOrdering(dm, order, NULL, &perm));
@@ -78,12 +100,21 @@ PetscErrorCode TestReordering(DM dm, AppCtx *user)
   PetscCall(MatViewFromOptions(pA, NULL, "-perm_mat_view"));
   PetscCall(MatDestroy(&A));
   PetscCall(MatDestroy(&pA));
+  PetscCall(ComputeLocality(dm, 16, &loc));
+  PetscCall(ComputeLocality(pdm, 16, &ploc));
   PetscCall(DMDestroy(&pdm));
   if (pbw > bw) {
     PetscCall(PetscPrintf(PetscObjectComm((PetscObject)dm), "Ordering method %s increased bandwidth from %" PetscInt_FMT " to %" PetscInt_FMT "\n", order, bw, pbw));
   } else {
     PetscCall(PetscPrintf(PetscObjectComm((PetscObject)dm), "Ordering method %s reduced bandwidth from %" PetscInt_FMT " to %" PetscInt_FMT "\n", order, bw, pbw));
   }
+  /* The space-filling curves do not reduce the bandwidth, they must keep more neighbors close */
+  PetscCall(PetscStrcmp(order, DMPLEX_ORDERING_HILBERT, &hilbert));
+  PetscCall(PetscStrcmp(order, DMPLEX_ORDERING_MORTON, &morton));
+  if (hilbert || morton) {
+    PetscCall(PetscPrintf(PetscObjectComm((PetscObject)dm), "Ordering method %s changed neighbors less than 16 cells apart from %.0f%% to %.0f%%\n", order, (double)(100 * loc), (double)(100 * ploc)));
+    PetscCheck(ploc > loc, PetscObjectComm((PetscObject)dm), PETSC_ERR_PLIB, "Ordering method %s did not improve the locality", order);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -215,6 +246,13 @@ int main(int argc, char **argv)
   test:
     suffix: 7
     args: -dm_plex_dim 3 -dm_plex_simplex 0 -dm_refine 1 -num_dof 1,0,0,0
+  # Space-filling curve tests
+  test:
+    suffix: hilbert_0
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 16,16 -num_dof 1,0,0 -order hilbert
+  test:
+    suffix: morton_0
+    args: -dm_plex_dim 3 -dm_plex_simplex 0 -dm_plex_box_faces 4,4,4 -num_dof 1,0,0,0 -order morton
   # Parallel tests
   # Grouping tests
   test:
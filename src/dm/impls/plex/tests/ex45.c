@@ -1,6 +1,24 @@
 static char help[] = "Tests mesh reordering\n\n";
 
 #include <petscdmplex.h>
+#include <petscsf.h>
+
+/* The point SF of a reordered mesh must still be valid, with sorted leaves */
+static PetscErrorCode CheckPointSF(DM dm)
+{
+  PetscSF         sf;
+  const PetscInt *leaves;
+  PetscInt        nleaves;
+  PetscBool       sorted = PETSC_TRUE;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMPlexCheckPointSF(dm, NULL, PETSC_FALSE));
+  PetscCall(DMGetPointSF(dm, &sf));
+  PetscCall(PetscSFGetGraph(sf, NULL, &nleaves, &leaves, NULL));
+  if (leaves) PetscCall(PetscSortedInt(nleaves, leaves, &sorted));
+  PetscCheck(sorted, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Point SF leaves are not sorted");
+  PetscFunctionReturn(0);
+}
 
 int main(int argc, char **argv)
 {
@@ -11,6 +29,7 @@ int main(int argc, char **argv)
   PetscCall(DMCreate(PETSC_COMM_WORLD, &dm));
   PetscCall(DMSetType(dm, DMPLEX));
   PetscCall(DMSetFromOptions(dm));
+  PetscCall(CheckPointSF(dm));
   PetscCall(DMViewFromOptions(dm, NULL, "-dm_view"));
   PetscCall(DMDestroy(&dm));
   PetscCall(PetscFinalize());
@@ -42,4 +61,16 @@ int main(int argc, char **argv)
       nsize: 2
       args: -petscpartitioner_type simple
 
+  test:
+    suffix: 4
+    nsize: 2
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 4,4 -petscpartitioner_type simple \
+          -dm_plex_reorder hilbert -dm_plex_reorder_distributed -dm_view ::ascii_info_detail
+
+  test:
+    suffix: 5
+    nsize: 3
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 6,6 -petscpartitioner_type simple -dm_distribute_overlap 1 \
+          -dm_plex_reorder morton -dm_plex_reorder_distributed -dm_plex_check_interface_cones -dm_view
+
 TEST*/
@@ -0,0 +1,129 @@
+static const char help[] = "Tests that cone orientations are only stored once one of them is not 0.\n\n";
+
+#include <petsc/private/dmpleximpl.h>
+
+/* Count the nonzero orientations, checking that the shared identity orientations are returned while none is stored */
+static PetscErrorCode CheckOrientations(DM dm, const char name[], PetscInt *nnz)
+{
+  DM_Plex        *mesh = (DM_Plex *)dm->data;
+  const PetscInt *zero = NULL;
+  PetscInt        pStart, pEnd, lnnz = 0;
+  PetscBool       stored = mesh->coneOrientations ? PETSC_TRUE : PETSC_FALSE, anyStored;
+
+  PetscFunctionBegin;
+  PetscCall(DMPlexGetChart(dm, &pStart, &pEnd));
+  for (PetscInt p = pStart; p < pEnd; ++p) {
+    const PetscInt *cone, *ornt, *ornt2;
+    PetscInt        coneSize;
+
+    PetscCall(DMPlexGetConeSize(dm, p, &coneSize));
+    if (!coneSize) continue;
+    PetscCall(DMPlexGetConeOrientation(dm, p, &ornt));
+    PetscCall(DMPlexGetOrientedCone(dm, p, &cone, &ornt2));
+    PetscCheck(ornt == ornt2, PETSC_COMM_SELF, PETSC_ERR_PLIB, "%s: point %" PetscInt_FMT " has different orientations from DMPlexGetConeOrientation() and DMPlexGetOrientedCone()", name, p);
+    PetscCall(DMPlexRestoreOrientedCone(dm, p, &cone, &ornt2));
+    if (!stored) {
+      if (!zero) zero = ornt;
+      PetscCheck(ornt == zero, PETSC_COMM_SELF, PETSC_ERR_PLIB, "%s: point %" PetscInt_FMT " does not get the shared identity orientations", name, p);
+    }
+    for (PetscInt c = 0; c < coneSize; ++c) {
+      if (ornt[c]) ++lnnz;
+    }
+  }
+  PetscCheck(stored || !lnnz, PETSC_COMM_SELF, PETSC_ERR_PLIB, "%s: the shared identity orientations are not 0", name);
+  PetscCall(MPIU_Allreduce(&lnnz, nnz, 1, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject)dm)));
+  PetscCall(MPIU_Allreduce(&stored, &anyStored, 1, MPIU_BOOL, MPI_LOR, PetscObjectComm((PetscObject)dm)));
+  PetscCall(PetscPrintf(PetscObjectComm((PetscObject)dm), "%s: orientations %s, %" PetscInt_FMT " nonzero\n", name, anyStored ? "stored" : "not stored", *nnz));
+  PetscFunctionReturn(0);
+}
+
+/* Permute with the RCM ordering and distribute, the number of nonzero orientations must not change */
+static PetscErrorCode CheckPermuteDistribute(DM dm, const char name[], PetscInt nnz)
+{
+  DM       pdm, ddm;
+  IS       perm;
+  char     pname[PETSC_MAX_PATH_LEN];
+  PetscInt pnnz;
+
+  PetscFunctionBegin;
+  PetscCall(DMPlexGetOrdering(dm, MATORDERINGRCM, NULL, &perm));
+  PetscCall(DMPlexPermute(dm, perm, &pdm));
+  PetscCall(ISDestroy(&perm));
+  PetscCall(PetscSNPrintf(pname, sizeof(pname), "%s permuted", name));
+  PetscCall(CheckOrientations(pdm, pname, &pnnz));
+  PetscCheck(pnnz == nnz, PETSC_COMM_SELF, PETSC_ERR_PLIB, "%s: %" PetscInt_FMT " nonzero orientations instead of %" PetscInt_FMT, pname, pnnz, nnz);
+  PetscCall(DMPlexDistribute(pdm, 0, NULL, &ddm));
+  if (ddm) {
+    PetscCall(PetscSNPrintf(pname, sizeof(pname), "%s distributed", name));
+    PetscCall(CheckOrientations(ddm, pname, &pnnz));
+    PetscCheck(pnnz == nnz, PETSC_COMM_SELF, PETSC_ERR_PLIB, "%s: %" PetscInt_FMT " nonzero orientations instead of %" PetscInt_FMT, pname, pnnz, nnz);
+    PetscCall(DMDestroy(&ddm));
+  }
+  PetscCall(DMDestroy(&pdm));
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM          dm;
+  PetscMPIInt rank;
+  PetscInt    cStart, cEnd, nnz;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  /* A cell-vertex mesh, the cones of the cells are vertices whose orientations are all 0 */
+  PetscCall(DMCreate(PETSC_COMM_WORLD, &dm));
+  PetscCall(DMSetType(dm, DMPLEX));
+  PetscCall(DMPlexDistributeSetDefault(dm, PETSC_FALSE));
+  PetscCall(DMSetFromOptions(dm));
+  PetscCall(DMViewFromOptions(dm, NULL, "-dm_view"));
+  PetscCall(CheckOrientations(dm, "Mesh", &nnz));
+  PetscCheck(!nnz, PETSC_COMM_SELF, PETSC_ERR_PLIB, "A cell-vertex mesh has %" PetscInt_FMT " nonzero orientations", nnz);
+  PetscCall(CheckPermuteDistribute(dm, "Mesh", nnz));
+
+  /* Setting identity orientations does not store them */
+  PetscCall(DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd));
+  for (PetscInt c = cStart; c < cEnd; ++c) {
+    const PetscInt *ornt;
+
+    PetscCall(DMPlexGetConeOrientation(dm, c, &ornt));
+    PetscCall(DMPlexSetConeOrientation(dm, c, ornt));
+  }
+  PetscCall(CheckOrientations(dm, "Mesh with identity orientations set", &nnz));
+
+  /* The first nonzero orientation allocates the storage, -1 is the reversal of a vertex */
+  if (!rank && cEnd > cStart) PetscCall(DMPlexInsertConeOrientation(dm, cStart, 0, -1));
+  PetscCall(CheckOrientations(dm, "Mesh with one orientation set", &nnz));
+  PetscCheck(nnz == 1, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Setting one orientation gives %" PetscInt_FMT " nonzero orientations", nnz);
+  PetscCall(CheckPermuteDistribute(dm, "Mesh with one orientation set", nnz));
+  PetscCall(DMDestroy(&dm));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  testset:
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 3,3 -dm_plex_interpolate 0
+
+    test:
+      suffix: 0
+
+    test:
+      suffix: 1
+      nsize: 2
+
+    test:
+      suffix: hex
+      nsize: 2
+      args: -dm_plex_dim 3 -dm_plex_box_faces 2,2,2
+
+  test:
+    suffix: tri
+    requires: triangle
+    nsize: 2
+    args: -dm_plex_box_faces 3,3 -dm_plex_interpolate 0
+    output_file: output/ex66_1.out
+
+TEST*/
@@ -1282,14 +1282,19 @@ static PetscErrorCode DMPlexTransformSetCones(DMPlexTransform tr, DM rdm)
 {
   DM             dm;
   DMPolytopeType ct;
-  PetscInt      *coneNew, *orntNew;
+  PetscSection   coneSection;
+  PetscInt      *coneNew, *orntNew, *ornt;
   PetscInt       maxConeSize = 0, pStart, pEnd, p, pNew;
 
   PetscFunctionBegin;
   PetscCall(DMPlexTransformGetDM(tr, &dm));
+  /* Cone sizes are fixed by the cell types, so new cones are written directly into the storage of rdm */
+  PetscCall(DMPlexGetConeSection(rdm, &coneSection));
+  PetscCall(DMPlexGetCones(rdm, &coneNew));
+  /* Orientations are only stored once some are nonzero, so they go through a work array */
+  orntNew = ((DM_Plex *)rdm->data)->coneOrientations;
   for (p = 0; p < DM_NUM_POLYTOPES; ++p) maxConeSize = PetscMax(maxConeSize, DMPolytopeTypeGetConeSize((DMPolytopeType)p));
-  PetscCall(DMGetWorkArray(rdm, maxConeSize, MPIU_INT, &coneNew));
-  PetscCall(DMGetWorkArray(rdm, maxConeSize, MPIU_INT, &orntNew));
+  PetscCall(DMGetWorkArray(dm, maxConeSize, MPIU_INT, &ornt));
   PetscCall(DMPlexGetChart(dm, &pStart, &pEnd));
   for (p = pStart; p < pEnd; ++p) {
     PetscInt        coff, ooff;
@@ -1303,15 +1308,23 @@ static PetscErrorCode DMPlexTransformSetCones(DMPlexTransform tr, DM rdm)
       const DMPolytopeType ctNew = rct[n];
 
       for (r = 0; r < rsize[n]; ++r) {
+        PetscInt dof, off, c;
+
         PetscCall(DMPlexTransformGetTargetPoint(tr, ct, rct[n], p, r, &pNew));
-        PetscCall(DMPlexTransformGetCone_Internal(tr, p, 0, ct, ctNew, rcone, &coff, rornt, &ooff, coneNew, orntNew));
-        PetscCall(DMPlexSetCone(rdm, pNew, coneNew));
-        PetscCall(DMPlexSetConeOrientation(rdm, pNew, orntNew));
+        PetscCall(PetscSectionGetDof(coneSection, pNew, &dof));
+        PetscCall(PetscSectionGetOffset(coneSection, pNew, &off));
+        PetscCall(DMPlexTransformGetCone_Internal(tr, p, 0, ct, ctNew, rcone, &coff, rornt, &ooff, &coneNew[off], ornt));
+        if (!orntNew) {
+          for (c = 0; c < dof; ++c)
+            if (ornt[c]) break;
+          if (c == dof) continue;
+          PetscCall(DMPlexGetConeOrientations(rdm, &orntNew));
+        }
+        for (c = 0; c < dof; ++c) orntNew[off + c] = ornt[c];
       }
     }
   }
-  PetscCall(DMRestoreWorkArray(rdm, maxConeSize, MPIU_INT, &coneNew));
-  PetscCall(DMRestoreWorkArray(rdm, maxConeSize, MPIU_INT, &orntNew));
+  PetscCall(DMRestoreWorkArray(dm, maxConeSize, MPIU_INT, &ornt));
   PetscCall(DMViewFromOptions(rdm, NULL, "-rdm_view"));
   PetscCall(DMPlexSymmetrize(rdm));
   PetscCall(DMPlexStratify(rdm));
@@ -1711,45 +1724,88 @@ PetscErrorCode DMPlexTransformCreateDiscLabels(DMPlexTransform tr, DM rdm)
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode DMPlexTransformCreateSF(DMPlexTransform tr, DM rdm)
+/*
+  When there is no transform type label, a point p of type ct produces the point
+
+    ctStartNew[ctNew] + offset[ct][ctNew] + (p - ctStart[ct]) * size + r
+
+  on the process owning p, so we only need the cell type offsets from each neighboring process, rather than
+  communicating every new point number.
+*/
+static PetscErrorCode DMPlexTransformCreateSFUniform_Internal(DMPlexTransform tr, PetscInt localPointsNew[], PetscSFNode remotePointsNew[])
 {
+  const PetscInt     Nt = DM_NUM_POLYTOPES + 1, K = 2 * Nt + DM_NUM_POLYTOPES * DM_NUM_POLYTOPES;
   DM                 dm;
-  PetscSF            sf, sfNew;
-  PetscInt           numRoots, numLeaves, numLeavesNew = 0, l, m;
-  const PetscInt    *localPoints;
-  const PetscSFNode *remotePoints;
-  PetscInt          *localPointsNew;
-  PetscSFNode       *remotePointsNew;
-  PetscInt           pStartNew, pEndNew, pNew;
-  /* Brute force algorithm */
-  PetscSF         rsf;
-  PetscSection    s;
-  const PetscInt *rootdegree;
-  PetscInt       *rootPointsNew, *remoteOffsets;
-  PetscInt        numPointsNew, pStart, pEnd, p;
+  PetscSF            sf, osf;
+  PetscSFNode       *oremote;
+  PetscInt          *table, *rtables, m = 0;
+  const PetscInt    *roffset, *rmine, *rremote;
+  const PetscMPIInt *ranks;
+  PetscInt           nranks, i, k;
 
   PetscFunctionBegin;
   PetscCall(DMPlexTransformGetDM(tr, &dm));
-  PetscCall(DMPlexGetChart(rdm, &pStartNew, &pEndNew));
   PetscCall(DMGetPointSF(dm, &sf));
-  PetscCall(DMGetPointSF(rdm, &sfNew));
-  /* Calculate size of new SF */
-  PetscCall(PetscSFGetGraph(sf, &numRoots, &numLeaves, &localPoints, &remotePoints));
-  if (numRoots < 0) PetscFunctionReturn(0);
-  for (l = 0; l < numLeaves; ++l) {
-    const PetscInt  p = localPoints[l];
-    DMPolytopeType  ct;
-    DMPolytopeType *rct;
-    PetscInt       *rsize, *rcone, *rornt;
-    PetscInt        Nct, n;
+  PetscCall(PetscSFSetUp(sf));
+  PetscCall(PetscSFGetRootRanks(sf, &nranks, &ranks, &roffset, &rmine, &rremote));
+  /* Gather the cell type offsets of each root process */
+  PetscCall(PetscMalloc2(K, &table, nranks * K, &rtables));
+  PetscCall(PetscArraycpy(table, tr->ctStart, Nt));
+  PetscCall(PetscArraycpy(&table[Nt], tr->ctStartNew, Nt));
+  PetscCall(PetscArraycpy(&table[2 * Nt], tr->offset, DM_NUM_POLYTOPES * DM_NUM_POLYTOPES));
+  PetscCall(PetscMalloc1(nranks * K, &oremote));
+  for (i = 0; i < nranks; ++i) {
+    for (k = 0; k < K; ++k) {
+      oremote[i * K + k].rank  = ranks[i];
+      oremote[i * K + k].index = k;
+    }
+  }
+  PetscCall(PetscSFCreate(PetscObjectComm((PetscObject)dm), &osf));
+  PetscCall(PetscSFSetGraph(osf, K, nranks * K, NULL, PETSC_OWN_POINTER, oremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFBcastBegin(osf, MPIU_INT, table, rtables, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(osf, MPIU_INT, table, rtables, MPI_REPLACE));
+  PetscCall(PetscSFDestroy(&osf));
+  /* Number the new leaves using the offsets of the owning process */
+  for (i = 0; i < nranks; ++i) {
+    const PetscInt *rctStart = &rtables[i * K], *rctStartNew = &rtables[i * K + Nt], *roff = &rtables[i * K + 2 * Nt];
+
+    for (k = roffset[i]; k < roffset[i + 1]; ++k) {
+      const PetscInt  p = rmine[k], q = rremote[k];
+      DMPolytopeType  ct;
+      DMPolytopeType *rct;
+      PetscInt       *rsize, *rcone, *rornt;
+      PetscInt        Nct, n, r;
 
-    PetscCall(DMPlexGetCellType(dm, p, &ct));
-    PetscCall(DMPlexTransformCellTransform(tr, ct, p, NULL, &Nct, &rct, &rsize, &rcone, &rornt));
-    for (n = 0; n < Nct; ++n) numLeavesNew += rsize[n];
+      PetscCall(DMPlexGetCellType(dm, p, &ct));
+      PetscCall(DMPlexTransformCellTransform(tr, ct, p, NULL, &Nct, &rct, &rsize, &rcone, &rornt));
+      for (n = 0; n < Nct; ++n) {
+        for (r = 0; r < rsize[n]; ++r, ++m) {
+          PetscCall(DMPlexTransformGetTargetPoint(tr, ct, rct[n], p, r, &localPointsNew[m]));
+          remotePointsNew[m].index = rctStartNew[rct[n]] + roff[ct * DM_NUM_POLYTOPES + rct[n]] + (q - rctStart[ct]) * rsize[n] + r;
+          remotePointsNew[m].rank  = ranks[i];
+        }
+      }
+    }
   }
-  /* Send new root point numbers
-       It is possible to optimize for regular transforms by sending only the cell type offsets, but it seems a needless complication
-  */
+  PetscCall(PetscFree2(table, rtables));
+  PetscFunctionReturn(0);
+}
+
+/* Brute force algorithm: send the new point numbers for every shared point */
+static PetscErrorCode DMPlexTransformCreateSFBruteForce_Internal(DMPlexTransform tr, PetscInt localPointsNew[], PetscSFNode remotePointsNew[])
+{
+  DM                 dm;
+  PetscSF            sf, rsf;
+  PetscSection       s;
+  const PetscInt    *localPoints, *rootdegree;
+  const PetscSFNode *remotePoints;
+  PetscInt          *rootPointsNew, *remoteOffsets;
+  PetscInt           numLeaves, numPointsNew, pStart, pEnd, p, pNew, l, m;
+
+  PetscFunctionBegin;
+  PetscCall(DMPlexTransformGetDM(tr, &dm));
+  PetscCall(DMGetPointSF(dm, &sf));
+  PetscCall(PetscSFGetGraph(sf, NULL, &numLeaves, &localPoints, &remotePoints));
   PetscCall(DMPlexGetChart(dm, &pStart, &pEnd));
   PetscCall(PetscSectionCreate(PetscObjectComm((PetscObject)dm), &s));
   PetscCall(PetscSectionSetChart(s, pStart, pEnd));
@@ -1792,8 +1848,6 @@ static PetscErrorCode DMPlexTransformCreateSF(DMPlexTransform tr, DM rdm)
   PetscCall(PetscSFBcastBegin(rsf, MPIU_INT, rootPointsNew, rootPointsNew, MPI_REPLACE));
   PetscCall(PetscSFBcastEnd(rsf, MPIU_INT, rootPointsNew, rootPointsNew, MPI_REPLACE));
   PetscCall(PetscSFDestroy(&rsf));
-  PetscCall(PetscMalloc1(numLeavesNew, &localPointsNew));
-  PetscCall(PetscMalloc1(numLeavesNew, &remotePointsNew));
   for (l = 0, m = 0; l < numLeaves; ++l) {
     const PetscInt  p = localPoints[l];
     DMPolytopeType  ct;
@@ -1815,6 +1869,43 @@ static PetscErrorCode DMPlexTransformCreateSF(DMPlexTransform tr, DM rdm)
   }
   PetscCall(PetscSectionDestroy(&s));
   PetscCall(PetscFree(rootPointsNew));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexTransformCreateSF(DMPlexTransform tr, DM rdm)
+{
+  DM                 dm;
+  PetscSF            sf, sfNew;
+  PetscInt           numRoots, numLeaves, numLeavesNew = 0, l;
+  const PetscInt    *localPoints;
+  const PetscSFNode *remotePoints;
+  PetscInt          *localPointsNew;
+  PetscSFNode       *remotePointsNew;
+  PetscInt           pStartNew, pEndNew;
+
+  PetscFunctionBegin;
+  PetscCall(DMPlexTransformGetDM(tr, &dm));
+  PetscCall(DMPlexGetChart(rdm, &pStartNew, &pEndNew));
+  PetscCall(DMGetPointSF(dm, &sf));
+  PetscCall(DMGetPointSF(rdm, &sfNew));
+  /* Calculate size of new SF */
+  PetscCall(PetscSFGetGraph(sf, &numRoots, &numLeaves, &localPoints, &remotePoints));
+  if (numRoots < 0) PetscFunctionReturn(0);
+  for (l = 0; l < numLeaves; ++l) {
+    const PetscInt  p = localPoints[l];
+    DMPolytopeType  ct;
+    DMPolytopeType *rct;
+    PetscInt       *rsize, *rcone, *rornt;
+    PetscInt        Nct, n;
+
+    PetscCall(DMPlexGetCellType(dm, p, &ct));
+    PetscCall(DMPlexTransformCellTransform(tr, ct, p, NULL, &Nct, &rct, &rsize, &rcone, &rornt));
+    for (n = 0; n < Nct; ++n) numLeavesNew += rsize[n];
+  }
+  PetscCall(PetscMalloc1(numLeavesNew, &localPointsNew));
+  PetscCall(PetscMalloc1(numLeavesNew, &remotePointsNew));
+  if (!tr->trType) PetscCall(DMPlexTransformCreateSFUniform_Internal(tr, localPointsNew, remotePointsNew));
+  else PetscCall(DMPlexTransformCreateSFBruteForce_Internal(tr, localPointsNew, remotePointsNew));
   /* SF needs sorted leaves to correctly calculate Gather */
   {
     PetscSFNode *rp, *rtmp;
@@ -858,6 +858,7 @@ PetscErrorCode DMSetUp(DM dm)
 . -dm_plex_cylinder_bd <bz>         - Boundary type in the z direction
 . -dm_plex_cylinder_num_wedges <n>  - Number of wedges around the cylinder
 . -dm_plex_reorder <order>          - Reorder the mesh using the specified algorithm
+. -dm_plex_reorder_distributed      - Reorder the local meshes again after distribution, with the ordering given by -dm_plex_reorder
 . -dm_refine_pre <n>                - The number of refinements before distribution
 . -dm_refine_uniform_pre <bool>     - Flag for uniform refinement before distribution
 . -dm_refine_volume_limit_pre <v>   - The maximum cell volume after refinement before distribution
@@ -0,0 +1,125 @@
+static char help[] = "Tests MatSolve() of MATLMVMBFGS with the compact representation against the recursive formula.\n\n";
+
+#include <petscksp.h>
+
+/* The iterates are deterministic, the function is the diagonal SPD map F(x) = D x so that every update is accepted */
+static PetscErrorCode FormIterate(PetscInt k, Vec D, Vec X, Vec F)
+{
+  PetscScalar *x;
+  PetscInt     rstart, rend;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecGetOwnershipRange(X, &rstart, &rend));
+  PetscCall(VecGetArray(X, &x));
+  for (PetscInt i = rstart; i < rend; i++) x[i - rstart] = PetscSinReal((PetscReal)(i + 1) * (PetscReal)(k + 1)) + 1.0 / (PetscReal)(k + 1);
+  PetscCall(VecRestoreArray(X, &x));
+  PetscCall(VecPointwiseMult(F, D, X));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CreateBFGS(Vec X, Vec F, PetscInt m, MatLMVMSymBroydenScaleType stype, PetscBool compact, Mat *B)
+{
+  PetscInt n, N;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(VecGetSize(X, &N));
+  /* the history size is set before the matrix is set up, as SNESQN does */
+  PetscCall(MatCreate(PetscObjectComm((PetscObject)X), B));
+  PetscCall(MatSetSizes(*B, n, n, N, N));
+  PetscCall(MatSetType(*B, MATLMVMBFGS));
+  PetscCall(MatLMVMSetHistorySize(*B, m));
+  PetscCall(MatLMVMSymBroydenSetScaleType(*B, stype));
+  PetscCall(MatLMVMBFGSSetCompact(*B, compact));
+  PetscCall(MatLMVMAllocate(*B, X, F));
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  Mat                        Bc, Br, Bs;
+  Vec                        D, X, F, b, yc, yr, ys;
+  PetscInt                   n = 20, m = 4, nupdates = 10, rstart, rend;
+  PetscScalar               *d;
+  PetscReal                  norm, errc, errs;
+  MatLMVMSymBroydenScaleType stype = MAT_LMVM_SYMBROYDEN_SCALE_SCALAR;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(KSPInitializePackage()); /* registers the LMVM matrix types */
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nupdates", &nupdates, NULL));
+  PetscCall(PetscOptionsGetEnum(NULL, NULL, "-scale_type", MatLMVMSymBroydenScaleTypes, (PetscEnum *)&stype, NULL));
+
+  PetscCall(VecCreateMPI(PETSC_COMM_WORLD, PETSC_DECIDE, n, &D));
+  PetscCall(VecDuplicate(D, &X));
+  PetscCall(VecDuplicate(D, &F));
+  PetscCall(VecDuplicate(D, &b));
+  PetscCall(VecDuplicate(D, &yc));
+  PetscCall(VecDuplicate(D, &yr));
+  PetscCall(VecDuplicate(D, &ys));
+  PetscCall(VecGetOwnershipRange(D, &rstart, &rend));
+  PetscCall(VecGetArray(D, &d));
+  for (PetscInt i = rstart; i < rend; i++) d[i - rstart] = 1.0 + (PetscReal)(i % 7);
+  PetscCall(VecRestoreArray(D, &d));
+  PetscCall(VecSet(b, 1.0));
+
+  /* Bs switches to the compact representation halfway, when its history is already filled */
+  PetscCall(CreateBFGS(D, F, m, stype, PETSC_TRUE, &Bc));
+  PetscCall(CreateBFGS(D, F, m, stype, PETSC_FALSE, &Br));
+  PetscCall(CreateBFGS(D, F, m, stype, PETSC_FALSE, &Bs));
+  for (PetscInt k = 0; k < nupdates; k++) {
+    PetscInt nupdc, nupdr;
+
+    PetscCall(FormIterate(k, D, X, F));
+    PetscCall(MatLMVMUpdate(Bc, X, F));
+    PetscCall(MatLMVMUpdate(Br, X, F));
+    PetscCall(MatLMVMUpdate(Bs, X, F));
+    if (k == nupdates / 2) PetscCall(MatLMVMBFGSSetCompact(Bs, PETSC_TRUE));
+    PetscCall(MatSolve(Bc, b, yc));
+    PetscCall(MatSolve(Br, b, yr));
+    PetscCall(MatSolve(Bs, b, ys));
+    PetscCall(MatLMVMGetUpdateCount(Bc, &nupdc));
+    PetscCall(MatLMVMGetUpdateCount(Br, &nupdr));
+    PetscCheck(nupdc == nupdr, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Compact and recursive matrices accepted different updates");
+    PetscCall(VecNorm(yr, NORM_2, &norm));
+    PetscCall(VecAXPY(yc, -1.0, yr));
+    PetscCall(VecAXPY(ys, -1.0, yr));
+    PetscCall(VecNorm(yc, NORM_2, &errc));
+    PetscCall(VecNorm(ys, NORM_2, &errs));
+    errc /= norm;
+    errs /= norm;
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Update %" PetscInt_FMT ": %" PetscInt_FMT " pairs stored, compact %s recursive, switched to compact %s recursive\n", k, PetscMin(nupdc, m), errc < 1.e-10 ? "matches" : "differs from", errs < 1.e-10 ? "matches" : "differs from"));
+  }
+
+  PetscCall(MatDestroy(&Bc));
+  PetscCall(MatDestroy(&Br));
+  PetscCall(MatDestroy(&Bs));
+  PetscCall(VecDestroy(&D));
+  PetscCall(VecDestroy(&X));
+  PetscCall(VecDestroy(&F));
+  PetscCall(VecDestroy(&b));
+  PetscCall(VecDestroy(&yc));
+  PetscCall(VecDestroy(&yr));
+  PetscCall(VecDestroy(&ys));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   build:
+     requires: !single
+
+   test:
+     suffix: scalar
+     nsize: {{1 2}}
+     output_file: output/ex84_scalar.out
+
+   test:
+     suffix: none
+     args: -scale_type none
+     output_file: output/ex84_scalar.out
+
+TEST*/
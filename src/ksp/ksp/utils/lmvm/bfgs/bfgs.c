@@ -8,6 +8,129 @@
 
 /*------------------------------------------------------------*/
 
+/*
+  The compact form of the inverse is only available for a scalar J0, since
+  it needs the product of J0^{-1} with the whole Y history.
+*/
+static PetscBool MatLBFGSUseCompact_Private(Mat B)
+{
+  Mat_LMVM    *lmvm  = (Mat_LMVM *)B->data;
+  Mat_SymBrdn *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+
+  if (!lbfgs->compact || lmvm->J0 || lmvm->user_pc || lmvm->user_ksp || lmvm->user_scale) return PETSC_FALSE;
+  return (PetscBool)(lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_SCALAR || lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_NONE);
+}
+
+/*
+  Computes column j of the inner-product matrices of the compact form,
+  S[i]^T Y[j] for i <= j and Y[i]^T Y[j], with a single reduction.
+*/
+static PetscErrorCode MatLBFGSCompactColumn_Private(Mat B, PetscInt j)
+{
+  Mat_LMVM    *lmvm  = (Mat_LMVM *)B->data;
+  Mat_SymBrdn *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+  PetscInt     i, m = lmvm->m;
+
+  PetscFunctionBegin;
+  PetscCall(VecMDotBegin(lmvm->Y[j], j + 1, lmvm->S, lbfgs->cdots));
+  PetscCall(VecMDotBegin(lmvm->Y[j], j + 1, lmvm->Y, lbfgs->cdots + m));
+  PetscCall(VecMDotEnd(lmvm->Y[j], j + 1, lmvm->S, lbfgs->cdots));
+  PetscCall(VecMDotEnd(lmvm->Y[j], j + 1, lmvm->Y, lbfgs->cdots + m));
+  for (i = 0; i <= j; ++i) {
+    lbfgs->StY[i + j * m] = PetscRealPart(lbfgs->cdots[i]);
+    lbfgs->YtY[i + j * m] = PetscRealPart(lbfgs->cdots[m + i]);
+    lbfgs->YtY[j + i * m] = lbfgs->YtY[i + j * m];
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+  Adds the newest pair to the inner-product matrices of the compact form,
+  shifting out the oldest one if the history was already full.
+*/
+static PetscErrorCode MatLBFGSCompactUpdate_Private(Mat B, PetscBool shift)
+{
+  Mat_LMVM    *lmvm  = (Mat_LMVM *)B->data;
+  Mat_SymBrdn *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+  PetscInt     i, j, m = lmvm->m;
+
+  PetscFunctionBegin;
+  if (shift) {
+    for (j = 0; j < lmvm->k; ++j) {
+      for (i = 0; i < lmvm->k; ++i) {
+        lbfgs->StY[i + j * m] = lbfgs->StY[i + 1 + (j + 1) * m];
+        lbfgs->YtY[i + j * m] = lbfgs->YtY[i + 1 + (j + 1) * m];
+      }
+    }
+  }
+  PetscCall(MatLBFGSCompactColumn_Private(B, lmvm->k));
+  PetscFunctionReturn(0);
+}
+
+/*
+  The compact representation of the inverse from Byrd, Nocedal and Schnabel,
+  "Representations of quasi-Newton matrices and their use in limited memory
+  methods" (https://doi.org/10.1007/BF01582063), Theorem 2.2, with J0^{-1} = gamma I
+
+    H = gamma I + [S  gamma Y] [ R^{-T} (D + gamma Y^T Y) R^{-1}   -R^{-T} ] [   S^T   ]
+                               [        -R^{-1}                       0    ] [ gamma Y^T ]
+
+  where R is the upper triangle of S^T Y and D its diagonal. R and Y^T Y are
+  updated incrementally with each accepted pair, so the application costs one
+  fused reduction for S^T F and Y^T F, two small triangular solves, and two
+  multi-vector updates, instead of 2(k+1) reductions for the two-loop recursion.
+
+    a <- S^T F, b <- Y^T F
+    u <- R^{-1} a
+    w <- R^{-T} (D u + gamma (Y^T Y) u - gamma b)
+    dX <- gamma F + S w - gamma Y u
+*/
+static PetscErrorCode MatSolve_LMVMBFGS_Compact(Mat B, Vec F, Vec dX)
+{
+  Mat_LMVM    *lmvm  = (Mat_LMVM *)B->data;
+  Mat_SymBrdn *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+  PetscInt     i, j, n = lmvm->k + 1, m = lmvm->m;
+  PetscReal    gamma = lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_SCALAR ? lbfgs->sigma : 1.0;
+  PetscReal   *u = lbfgs->cwork, *w = lbfgs->cwork + m;
+  PetscScalar *a = lbfgs->cdots, *b = lbfgs->cdots + m;
+
+  PetscFunctionBegin;
+  PetscCall(VecCopy(F, dX));
+  PetscCall(VecScale(dX, gamma));
+  if (!n) PetscFunctionReturn(0);
+
+  PetscCall(VecMDotBegin(F, n, lmvm->S, a));
+  PetscCall(VecMDotBegin(F, n, lmvm->Y, b));
+  PetscCall(VecMDotEnd(F, n, lmvm->S, a));
+  PetscCall(VecMDotEnd(F, n, lmvm->Y, b));
+
+  /* u <- R^{-1} a */
+  for (i = n - 1; i >= 0; --i) {
+    u[i] = PetscRealPart(a[i]);
+    for (j = i + 1; j < n; ++j) u[i] -= lbfgs->StY[i + j * m] * u[j];
+    u[i] /= lbfgs->StY[i + i * m];
+  }
+  /* w <- D u + gamma (Y^T Y u - b) */
+  for (i = 0; i < n; ++i) {
+    w[i] = lbfgs->StY[i + i * m] * u[i] - gamma * PetscRealPart(b[i]);
+    for (j = 0; j < n; ++j) w[i] += gamma * lbfgs->YtY[i + j * m] * u[j];
+  }
+  /* w <- R^{-T} w */
+  for (i = 0; i < n; ++i) {
+    for (j = 0; j < i; ++j) w[i] -= lbfgs->StY[j + i * m] * w[j];
+    w[i] /= lbfgs->StY[i + i * m];
+  }
+  for (i = 0; i < n; ++i) {
+    a[i] = w[i];
+    b[i] = -gamma * u[i];
+  }
+  PetscCall(VecMAXPY(dX, n, a, lmvm->S));
+  PetscCall(VecMAXPY(dX, n, b, lmvm->Y));
+  PetscFunctionReturn(0);
+}
+
+/*------------------------------------------------------------*/
+
 /*
   The solution method (approximate inverse Jacobian application) is adapted
    from Algorithm 7.4 on page 178 of Nocedal and Wright "Numerical Optimization"
@@ -43,6 +166,11 @@ PetscErrorCode MatSolve_LMVMBFGS(Mat B, Vec F, Vec dX)
   VecCheckSameSize(F, 2, dX, 3);
   VecCheckMatCompatible(B, dX, 3, F, 2);
 
+  if (MatLBFGSUseCompact_Private(B)) {
+    PetscCall(MatSolve_LMVMBFGS_Compact(B, F, dX));
+    PetscFunctionReturn(0);
+  }
+
   /* Copy the function into the work vector for the first loop */
   PetscCall(VecCopy(F, lbfgs->work));
 
@@ -184,7 +312,13 @@ static PetscErrorCode MatUpdate_LMVMBFGS(Mat B, Vec X, Vec F)
         }
       }
       /* Update history of useful scalars */
-      PetscCall(VecDot(lmvm->Y[lmvm->k], lmvm->Y[lmvm->k], &ytytmp));
+      if (lbfgs->compact) {
+        /* the inner products of the new pair with the history include Y[k]^T Y[k] */
+        PetscCall(MatLBFGSCompactUpdate_Private(B, (PetscBool)(old_k == lmvm->k)));
+        ytytmp = lbfgs->YtY[lmvm->k * (lmvm->m + 1)];
+      } else {
+        PetscCall(VecDot(lmvm->Y[lmvm->k], lmvm->Y[lmvm->k], &ytytmp));
+      }
       lbfgs->yts[lmvm->k] = PetscRealPart(curvature);
       lbfgs->yty[lmvm->k] = PetscRealPart(ytytmp);
       lbfgs->sts[lmvm->k] = PetscRealPart(ststmp);
@@ -245,6 +379,11 @@ static PetscErrorCode MatCopy_LMVMBFGS(Mat B, Mat M, MatStructure str)
     mctx->yts[i] = bctx->yts[i];
     PetscCall(VecCopy(bctx->P[i], mctx->P[i]));
   }
+  mctx->compact = bctx->compact;
+  if (bctx->compact) {
+    PetscCall(PetscArraycpy(mctx->StY, bctx->StY, bdata->m * bdata->m));
+    PetscCall(PetscArraycpy(mctx->YtY, bctx->YtY, bdata->m * bdata->m));
+  }
   mctx->scale_type      = bctx->scale_type;
   mctx->alpha           = bctx->alpha;
   mctx->beta            = bctx->beta;
@@ -285,6 +424,7 @@ static PetscErrorCode MatReset_LMVMBFGS(Mat B, PetscBool destructive)
     if (destructive) {
       PetscCall(VecDestroy(&lbfgs->work));
       PetscCall(PetscFree4(lbfgs->stp, lbfgs->yts, lbfgs->yty, lbfgs->sts));
+      PetscCall(PetscFree4(lbfgs->StY, lbfgs->YtY, lbfgs->cwork, lbfgs->cdots));
       PetscCall(VecDestroyVecs(lmvm->m, &lbfgs->P));
       switch (lbfgs->scale_type) {
       case MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL:
@@ -329,6 +469,7 @@ static PetscErrorCode MatAllocate_LMVMBFGS(Mat B, Vec X, Vec F)
   if (!lbfgs->allocated) {
     PetscCall(VecDuplicate(X, &lbfgs->work));
     PetscCall(PetscMalloc4(lmvm->m, &lbfgs->stp, lmvm->m, &lbfgs->yts, lmvm->m, &lbfgs->yty, lmvm->m, &lbfgs->sts));
+    PetscCall(PetscMalloc4(lmvm->m * lmvm->m, &lbfgs->StY, lmvm->m * lmvm->m, &lbfgs->YtY, 2 * lmvm->m, &lbfgs->cwork, 2 * lmvm->m, &lbfgs->cdots));
     if (lmvm->m > 0) PetscCall(VecDuplicateVecs(X, lmvm->m, &lbfgs->P));
     switch (lbfgs->scale_type) {
     case MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL:
@@ -353,6 +494,7 @@ static PetscErrorCode MatDestroy_LMVMBFGS(Mat B)
   if (lbfgs->allocated) {
     PetscCall(VecDestroy(&lbfgs->work));
     PetscCall(PetscFree4(lbfgs->stp, lbfgs->yts, lbfgs->yty, lbfgs->sts));
+    PetscCall(PetscFree4(lbfgs->StY, lbfgs->YtY, lbfgs->cwork, lbfgs->cdots));
     PetscCall(VecDestroyVecs(lmvm->m, &lbfgs->P));
     lbfgs->allocated = PETSC_FALSE;
   }
@@ -376,6 +518,7 @@ static PetscErrorCode MatSetUp_LMVMBFGS(Mat B)
   if (!lbfgs->allocated) {
     PetscCall(VecDuplicate(lmvm->Xprev, &lbfgs->work));
     PetscCall(PetscMalloc4(lmvm->m, &lbfgs->stp, lmvm->m, &lbfgs->yts, lmvm->m, &lbfgs->yty, lmvm->m, &lbfgs->sts));
+    PetscCall(PetscMalloc4(lmvm->m * lmvm->m, &lbfgs->StY, lmvm->m * lmvm->m, &lbfgs->YtY, 2 * lmvm->m, &lbfgs->cwork, 2 * lmvm->m, &lbfgs->cdots));
     if (lmvm->m > 0) PetscCall(VecDuplicateVecs(lmvm->Xprev, lmvm->m, &lbfgs->P));
     switch (lbfgs->scale_type) {
     case MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL:
@@ -396,11 +539,17 @@ static PetscErrorCode MatSetUp_LMVMBFGS(Mat B)
 
 static PetscErrorCode MatSetFromOptions_LMVMBFGS(Mat B, PetscOptionItems *PetscOptionsObject)
 {
+  Mat_LMVM    *lmvm    = (Mat_LMVM *)B->data;
+  Mat_SymBrdn *lbfgs   = (Mat_SymBrdn *)lmvm->ctx;
+  PetscBool    compact = lbfgs->compact;
+
   PetscFunctionBegin;
   PetscCall(MatSetFromOptions_LMVM(B, PetscOptionsObject));
   PetscOptionsHeadBegin(PetscOptionsObject, "L-BFGS method for approximating SPD Jacobian actions (MATLMVMBFGS)");
   PetscCall(MatSetFromOptions_LMVMSymBrdn_Private(B, PetscOptionsObject));
+  PetscCall(PetscOptionsBool("-mat_lmvm_compact", "Apply the inverse with the compact representation of the update history", "", compact, &compact, NULL));
   PetscOptionsHeadEnd();
+  PetscCall(MatLMVMBFGSSetCompact(B, compact));
   PetscFunctionReturn(0);
 }
 
@@ -434,6 +583,121 @@ PetscErrorCode MatCreate_LMVMBFGS(Mat B)
 
 /*------------------------------------------------------------*/
 
+/*@
+   MatLMVMBFGSSetCompact - Sets whether the inverse of the L-BFGS matrix is applied with the compact
+   representation of the update history.
+
+   Logically Collective
+
+   Input Parameters:
++  B - the `MATLMVMBFGS` matrix
+-  flg - `PETSC_TRUE` to use the compact representation
+
+   Options Database Key:
+.  -mat_lmvm_compact - apply the inverse with the compact representation
+
+   Level: advanced
+
+   Notes:
+   The compact representation of Byrd, Nocedal and Schnabel keeps the inner products S^T Y and Y^T Y of the
+   stored pairs, which are updated with one reduction per accepted update. `MatSolve()` then needs a single
+   reduction and two multi-vector updates instead of the two reductions per stored pair of the recursive formula.
+
+   It is only used with a scalar or no J0 scaling and without a user J0, preconditioner, `KSP` or scale; otherwise
+   `MatSolve()` falls back to the recursive formula. `MatLMVMBFGSGetCompactInUse()` tells which one is applied.
+
+   Only `MATLMVMBFGS` has a compact form. The other restricted Broyden matrices (`MATLMVMSYMBROYDEN`, `MATLMVMSYMBADBROYDEN`, `MATLMVMDFP`,
+   `MATLMVMDIAGBROYDEN`), the Broyden matrices (`MATLMVMBROYDEN`, `MATLMVMBADBROYDEN`) and the other `MATLMVM` types
+   always use their recursive formulas.
+
+.seealso: [](chapter_ksp), `MATLMVMBFGS`, `MatCreateLMVMBFGS()`, `MatLMVMBFGSGetCompact()`, `MatLMVMBFGSGetCompactInUse()`, `MatLMVMSymBroydenSetScaleType()`
+@*/
+PetscErrorCode MatLMVMBFGSSetCompact(Mat B, PetscBool flg)
+{
+  Mat_LMVM    *lmvm;
+  Mat_SymBrdn *lbfgs;
+  PetscBool    is_bfgs;
+  PetscInt     j;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(B, MAT_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(B, flg, 2);
+  PetscCall(PetscObjectTypeCompare((PetscObject)B, MATLMVMBFGS, &is_bfgs));
+  PetscCheck(is_bfgs, PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_INCOMP, "compact representation is only available for BFGS matrices");
+  lmvm  = (Mat_LMVM *)B->data;
+  lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+  /* the inner products are only kept up to date in compact form, so compute them for the current history */
+  if (flg && !lbfgs->compact && lbfgs->allocated) {
+    for (j = 0; j <= lmvm->k; ++j) PetscCall(MatLBFGSCompactColumn_Private(B, j));
+  }
+  lbfgs->compact = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatLMVMBFGSGetCompact - Returns whether the inverse of the L-BFGS matrix is applied with the compact
+   representation of the update history.
+
+   Not Collective
+
+   Input Parameter:
+.  B - the `MATLMVMBFGS` matrix
+
+   Output Parameter:
+.  flg - `PETSC_TRUE` if the compact representation is used
+
+   Level: advanced
+
+.seealso: [](chapter_ksp), `MATLMVMBFGS`, `MatLMVMBFGSSetCompact()`
+@*/
+PetscErrorCode MatLMVMBFGSGetCompact(Mat B, PetscBool *flg)
+{
+  Mat_LMVM    *lmvm;
+  Mat_SymBrdn *lbfgs;
+  PetscBool    is_bfgs;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(B, MAT_CLASSID, 1);
+  PetscValidBoolPointer(flg, 2);
+  PetscCall(PetscObjectTypeCompare((PetscObject)B, MATLMVMBFGS, &is_bfgs));
+  PetscCheck(is_bfgs, PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_INCOMP, "compact representation is only available for BFGS matrices");
+  lmvm  = (Mat_LMVM *)B->data;
+  lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+  *flg  = lbfgs->compact;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatLMVMBFGSGetCompactInUse - Returns whether `MatSolve()` with the L-BFGS matrix currently applies the compact
+   representation, which requires it to be set with `MatLMVMBFGSSetCompact()` and a scaling that supports it.
+
+   Not Collective
+
+   Input Parameter:
+.  B - the `MATLMVMBFGS` matrix
+
+   Output Parameter:
+.  flg - `PETSC_TRUE` if the compact representation is applied, `PETSC_FALSE` if the recursive formula is
+
+   Level: advanced
+
+.seealso: [](chapter_ksp), `MATLMVMBFGS`, `MatLMVMBFGSSetCompact()`, `MatLMVMBFGSGetCompact()`
+@*/
+PetscErrorCode MatLMVMBFGSGetCompactInUse(Mat B, PetscBool *flg)
+{
+  PetscBool is_bfgs;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(B, MAT_CLASSID, 1);
+  PetscValidBoolPointer(flg, 2);
+  PetscCall(PetscObjectTypeCompare((PetscObject)B, MATLMVMBFGS, &is_bfgs));
+  PetscCheck(is_bfgs, PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_INCOMP, "compact representation is only available for BFGS matrices");
+  *flg = MatLBFGSUseCompact_Private(B);
+  PetscFunctionReturn(0);
+}
+
+/*------------------------------------------------------------*/
+
 /*@
    MatCreateLMVMBFGS - Creates a limited-memory Broyden-Fletcher-Goldfarb-Shano (BFGS)
    matrix used for approximating Jacobians. L-BFGS is symmetric positive-definite by
@@ -464,7 +728,8 @@ PetscErrorCode MatCreate_LMVMBFGS(Mat B)
 .   -mat_lmvm_rho - (developer) update limiter for the J0 scaling
 .   -mat_lmvm_alpha - (developer) coefficient factor for the quadratic subproblem in J0 scaling
 .   -mat_lmvm_beta - (developer) exponential factor for the diagonal J0 scaling
--   -mat_lmvm_sigma_hist - (developer) number of past updates to use in J0 scaling
+.   -mat_lmvm_sigma_hist - (developer) number of past updates to use in J0 scaling
+-   -mat_lmvm_compact - apply the inverse with the compact representation of the update history, see `MatLMVMBFGSSetCompact()`
 
    Level: intermediate
 
@@ -473,7 +738,7 @@ PetscErrorCode MatCreate_LMVMBFGS(Mat B)
    paradigm instead of this routine directly.
 
 .seealso: [](chapter_ksp), `MatCreate()`, `MATLMVM`, `MATLMVMBFGS`, `MatCreateLMVMDFP()`, `MatCreateLMVMSR1()`,
-          `MatCreateLMVMBrdn()`, `MatCreateLMVMBadBrdn()`, `MatCreateLMVMSymBrdn()`
+          `MatCreateLMVMBrdn()`, `MatCreateLMVMBadBrdn()`, `MatCreateLMVMSymBrdn()`, `MatLMVMBFGSSetCompact()`
 @*/
 PetscErrorCode MatCreateLMVMBFGS(MPI_Comm comm, PetscInt n, PetscInt N, Mat *B)
 {
@@ -18,6 +18,9 @@ typedef struct {
   PetscInt                   sigma_hist; /* length of update history to be used for scaling */
   MatLMVMSymBroydenScaleType scale_type;
   PetscInt                   watchdog, max_seq_rejects; /* tracker to reset after a certain # of consecutive rejects */
+  PetscBool                  compact;                   /* apply the L-BFGS inverse in compact form */
+  PetscReal                 *StY, *YtY, *cwork;         /* S^T Y (upper triangle) and Y^T Y in column-major order, and workspace for the compact form */
+  PetscScalar               *cdots;                     /* inner products and coefficients of the compact form */
 } Mat_SymBrdn;
 
 PETSC_INTERN PetscErrorCode MatSymBrdnApplyJ0Fwd(Mat, Vec, Vec);
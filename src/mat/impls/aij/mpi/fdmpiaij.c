@@ -3,16 +3,32 @@
 #include <../src/mat/impls/baij/mpi/mpibaij.h>
 #include <petsc/private/isimpl.h>
 
-PetscErrorCode MatFDColoringApply_BAIJ(Mat J, MatFDColoring coloring, Vec x1, void *sctx)
+/*
+   evaluates the function at n points, with a single call of the batched function if there is one; the unperturbed
+   point (perturbed is false) is only given to the batched function when no function was set with MatFDColoringSetFunction()
+*/
+static PetscErrorCode MatFDColoringEvaluate_Private(MatFDColoring coloring, void *sctx, PetscBool perturbed, PetscInt n, Vec x[], Vec y[])
 {
   PetscErrorCode (*f)(void *, Vec, Vec, void *) = (PetscErrorCode(*)(void *, Vec, Vec, void *))coloring->f;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(MAT_FDColoringFunction, coloring, 0, 0, 0));
+  if (coloring->fbatch && (perturbed || !f)) PetscCall((*coloring->fbatch)(sctx, n, (const Vec *)x, y, coloring->fbatchctx));
+  else {
+    for (PetscInt i = 0; i < n; i++) PetscCall((*f)(sctx, x[i], y[i], coloring->fctx));
+  }
+  PetscCall(PetscLogEventEnd(MAT_FDColoringFunction, coloring, 0, 0, 0));
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatFDColoringApply_BAIJ(Mat J, MatFDColoring coloring, Vec x1, void *sctx)
+{
   PetscInt           k, cstart, cend, l, row, col, nz, spidx, i, j;
   PetscScalar        dx = 0.0, *w3_array, *dy_i, *dy = coloring->dy;
   PetscScalar       *vscale_array;
   const PetscScalar *xx;
   PetscReal          epsilon = coloring->error_rel, umin = coloring->umin, unorm;
   Vec                w1 = coloring->w1, w2 = coloring->w2, w3, vscale = coloring->vscale;
-  void              *fctx  = coloring->fctx;
   PetscInt           ctype = coloring->ctype, nxloc, nrows_k;
   PetscScalar       *valaddr;
   MatEntry          *Jentry  = coloring->matentry;
@@ -24,9 +40,7 @@ PetscErrorCode MatFDColoringApply_BAIJ(Mat J, MatFDColoring coloring, Vec x1, vo
   PetscCall(VecBindToCPU(x1, PETSC_TRUE));
   /* (1) Set w1 = F(x1) */
   if (!coloring->fset) {
-    PetscCall(PetscLogEventBegin(MAT_FDColoringFunction, coloring, 0, 0, 0));
-    PetscCall((*f)(sctx, x1, w1, fctx));
-    PetscCall(PetscLogEventEnd(MAT_FDColoringFunction, coloring, 0, 0, 0));
+    PetscCall(MatFDColoringEvaluate_Private(coloring, sctx, PETSC_FALSE, 1, &x1, &w1));
   } else {
     coloring->fset = PETSC_FALSE;
   }
@@ -102,10 +116,8 @@ PetscErrorCode MatFDColoringApply_BAIJ(Mat J, MatFDColoring coloring, Vec x1, vo
        (3-2) Evaluate function at w3 = x1 + dx (here dx is a vector of perturbations)
                            w2 = F(x1 + dx) - F(x1)
        */
-      PetscCall(PetscLogEventBegin(MAT_FDColoringFunction, 0, 0, 0, 0));
       PetscCall(VecPlaceArray(w2, dy_i)); /* place w2 to the array dy_i */
-      PetscCall((*f)(sctx, w3, w2, fctx));
-      PetscCall(PetscLogEventEnd(MAT_FDColoringFunction, 0, 0, 0, 0));
+      PetscCall(MatFDColoringEvaluate_Private(coloring, sctx, PETSC_TRUE, 1, &w3, &w2));
       PetscCall(VecAXPY(w2, -1.0, w1));
       PetscCall(VecResetArray(w2));
       dy_i += nxloc; /* points to dy+i*nxloc */
@@ -156,14 +168,12 @@ PetscErrorCode MatFDColoringApply_BAIJ(Mat J, MatFDColoring coloring, Vec x1, vo
 /* this is declared PETSC_EXTERN because it is used by MatFDColoringUseDM() which is in the DM library */
 PetscErrorCode MatFDColoringApply_AIJ(Mat J, MatFDColoring coloring, Vec x1, void *sctx)
 {
-  PetscErrorCode (*f)(void *, Vec, Vec, void *) = (PetscErrorCode(*)(void *, Vec, Vec, void *))coloring->f;
   PetscInt           k, cstart, cend, l, row, col, nz;
   PetscScalar        dx = 0.0, *y, *w3_array;
   const PetscScalar *xx;
   PetscScalar       *vscale_array;
   PetscReal          epsilon = coloring->error_rel, umin = coloring->umin, unorm;
   Vec                w1 = coloring->w1, w2 = coloring->w2, w3, vscale = coloring->vscale;
-  void              *fctx  = coloring->fctx;
   ISColoringType     ctype = coloring->ctype;
   PetscInt           nxloc, nrows_k;
   MatEntry          *Jentry  = coloring->matentry;
@@ -177,9 +187,7 @@ PetscErrorCode MatFDColoringApply_AIJ(Mat J, MatFDColoring coloring, Vec x1, voi
   PetscCheck(!(ctype == IS_COLORING_LOCAL) || !(J->ops->fdcoloringapply == MatFDColoringApply_AIJ), PetscObjectComm((PetscObject)J), PETSC_ERR_SUP, "Must call MatColoringUseDM() with IS_COLORING_LOCAL");
   /* (1) Set w1 = F(x1) */
   if (!coloring->fset) {
-    PetscCall(PetscLogEventBegin(MAT_FDColoringFunction, 0, 0, 0, 0));
-    PetscCall((*f)(sctx, x1, w1, fctx));
-    PetscCall(PetscLogEventEnd(MAT_FDColoringFunction, 0, 0, 0, 0));
+    PetscCall(MatFDColoringEvaluate_Private(coloring, sctx, PETSC_FALSE, 1, &x1, &w1));
   } else {
     coloring->fset = PETSC_FALSE;
   }
@@ -221,7 +229,20 @@ PetscErrorCode MatFDColoringApply_AIJ(Mat J, MatFDColoring coloring, Vec x1, voi
   if (coloring->bcols > 1) { /* use blocked insertion of Jentry */
     PetscInt     i, m = J->rmap->n, nbcols, bcols = coloring->bcols;
     PetscScalar *dy = coloring->dy, *dy_k;
-
+    Vec          xk;
+
+    /* ybatch[i] wraps the block dy + i * m on purpose: the batched function writes its values in place, where the insertion
+       into the Jacobian reads them, so no copy is needed */
+    if (coloring->fbatch && coloring->nbatch != bcols) { /* the points of a block of colors and their function values in dy */
+      if (coloring->nbatch) {
+        PetscCall(VecDestroyVecs(coloring->nbatch, &coloring->xbatch));
+        PetscCall(VecDestroyVecs(coloring->nbatch, &coloring->ybatch));
+      }
+      PetscCall(VecDuplicateVecs(x1, bcols, &coloring->xbatch));
+      PetscCall(PetscMalloc1(bcols, &coloring->ybatch));
+      for (i = 0; i < bcols; i++) PetscCall(VecCreateMPIWithArray(PetscObjectComm((PetscObject)w2), 1, m, PETSC_DECIDE, dy + i * m, &coloring->ybatch[i]));
+      coloring->nbatch = bcols;
+    }
     nbcols = 0;
     for (k = 0; k < ncolors; k += bcols) {
       /*
@@ -233,9 +254,10 @@ PetscErrorCode MatFDColoringApply_AIJ(Mat J, MatFDColoring coloring, Vec x1, voi
       if (k + bcols > ncolors) bcols = ncolors - k;
       for (i = 0; i < bcols; i++) {
         coloring->currentcolor = k + i;
+        xk                     = coloring->fbatch ? coloring->xbatch[i] : w3;
 
-        PetscCall(VecCopy(x1, w3));
-        PetscCall(VecGetArray(w3, &w3_array));
+        PetscCall(VecCopy(x1, xk));
+        PetscCall(VecGetArray(xk, &w3_array));
         if (ctype == IS_COLORING_GLOBAL) w3_array -= cstart; /* shift pointer so global index can be used */
         if (coloring->htype[0] == 'w') {
           for (l = 0; l < ncolumns[k + i]; l++) {
@@ -251,20 +273,23 @@ PetscErrorCode MatFDColoringApply_AIJ(Mat J, MatFDColoring coloring, Vec x1, voi
           vscale_array += cstart;
         }
         if (ctype == IS_COLORING_GLOBAL) w3_array += cstart;
-        PetscCall(VecRestoreArray(w3, &w3_array));
+        PetscCall(VecRestoreArray(xk, &w3_array));
+        if (coloring->fbatch) continue;
 
         /*
          (3-2) Evaluate function at w3 = x1 + dx (here dx is a vector of perturbations)
                            w2 = F(x1 + dx) - F(x1)
          */
-        PetscCall(PetscLogEventBegin(MAT_FDColoringFunction, 0, 0, 0, 0));
         PetscCall(VecPlaceArray(w2, dy_k)); /* place w2 to the array dy_i */
-        PetscCall((*f)(sctx, w3, w2, fctx));
-        PetscCall(PetscLogEventEnd(MAT_FDColoringFunction, 0, 0, 0, 0));
+        PetscCall(MatFDColoringEvaluate_Private(coloring, sctx, PETSC_TRUE, 1, &w3, &w2));
         PetscCall(VecAXPY(w2, -1.0, w1));
         PetscCall(VecResetArray(w2));
         dy_k += m; /* points to dy+i*nxloc */
       }
+      if (coloring->fbatch) { /* all the colors of the block at once */
+        PetscCall(MatFDColoringEvaluate_Private(coloring, sctx, PETSC_TRUE, bcols, coloring->xbatch, coloring->ybatch));
+        for (i = 0; i < bcols; i++) PetscCall(VecAXPY(coloring->ybatch[i], -1.0, w1));
+      }
 
       /*
        (3-3) Loop over block rows of vector, putting results into Jacobian matrix
@@ -329,9 +354,7 @@ PetscErrorCode MatFDColoringApply_AIJ(Mat J, MatFDColoring coloring, Vec x1, voi
        (3-2) Evaluate function at w3 = x1 + dx (here dx is a vector of perturbations)
                            w2 = F(x1 + dx) - F(x1)
        */
-      PetscCall(PetscLogEventBegin(MAT_FDColoringFunction, 0, 0, 0, 0));
-      PetscCall((*f)(sctx, w3, w2, fctx));
-      PetscCall(PetscLogEventEnd(MAT_FDColoringFunction, 0, 0, 0, 0));
+      PetscCall(MatFDColoringEvaluate_Private(coloring, sctx, PETSC_TRUE, 1, &w3, &w2));
       PetscCall(VecAXPY(w2, -1.0, w1));
 
       /*
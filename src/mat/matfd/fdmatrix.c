@@ -115,6 +115,7 @@ PetscErrorCode MatFDColoringView(MatFDColoring c, PetscViewer viewer)
     PetscCall(PetscViewerASCIIPrintf(viewer, "  Error tolerance=%g\n", (double)c->error_rel));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  Umin=%g\n", (double)c->umin));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  Number of colors=%" PetscInt_FMT "\n", c->ncolors));
+    if (c->fbatch) PetscCall(PetscViewerASCIIPrintf(viewer, "  Batched function evaluations of %" PetscInt_FMT " colors\n", c->bcols));
 
     PetscCall(PetscViewerGetFormat(viewer, &format));
     if (format != PETSC_VIEWER_ASCII_INFO) {
@@ -288,7 +289,7 @@ PetscErrorCode MatFDColoringGetFunction(MatFDColoring matfd, PetscErrorCode (**f
     In Fortran you must call `MatFDColoringSetFunction()` for a coloring object to
   be used without `SNES` or within the `SNES` solvers.
 
-.seealso: `MatFDColoring`, `MatFDColoringCreate()`, `MatFDColoringGetFunction()`, `MatFDColoringSetFromOptions()`
+.seealso: `MatFDColoring`, `MatFDColoringCreate()`, `MatFDColoringGetFunction()`, `MatFDColoringSetFunctionBatch()`, `MatFDColoringSetFromOptions()`
 @*/
 PetscErrorCode MatFDColoringSetFunction(MatFDColoring matfd, PetscErrorCode (*f)(void), void *fctx)
 {
@@ -299,6 +300,51 @@ PetscErrorCode MatFDColoringSetFunction(MatFDColoring matfd, PetscErrorCode (*f)
   PetscFunctionReturn(0);
 }
 
+/*@C
+   MatFDColoringSetFunctionBatch - Sets a function evaluating the function defining the Jacobian at several points at once
+
+   Logically Collective
+
+   Input Parameters:
++  coloring - the coloring context
+.  fbatch - the function
+-  fctx - the optional user-defined function context
+
+   Calling sequence of fbatch:
+$   PetscErrorCode fbatch(void *sctx, PetscInt n, const Vec X[], Vec F[], void *fctx)
++  sctx - the context passed to `MatFDColoringApply()`, the `SNES` when used through `SNESComputeJacobianDefaultColor()`
+.  n - the number of points
+.  X - the points
+.  F - the function values to compute at the points
+-  fctx - the optional user-defined function context
+
+   Level: advanced
+
+   Notes:
+   The function values at the perturbed points of a block of colors, of size given by `MatFDColoringSetBlockSize()` or
+   -mat_fd_coloring_bcols, are then computed with a single call of fbatch instead of one call of the function set with
+   `MatFDColoringSetFunction()` per color, so that an application can evaluate them concurrently, for example with threads
+   or as a single batched computation on a device. The points and function values are kept by the coloring context and
+   reused by every `MatFDColoringApply()`, in particular across all the Newton steps of a `SNES`.
+
+   The blocks of colors are only used with `MATAIJ` matrices, with `MATBAIJ` matrices fbatch is called with a single point.
+
+   The function at the unperturbed point is computed with the function set with `MatFDColoringSetFunction()`, fbatch is
+   only called for it, with a single point, if no such function is set.
+
+   `MatFDColoringGetPerturbedColumns()` cannot be used within fbatch.
+
+.seealso: `MatFDColoring`, `MatFDColoringCreate()`, `MatFDColoringSetFunction()`, `MatFDColoringSetBlockSize()`, `MatFDColoringApply()`
+@*/
+PetscErrorCode MatFDColoringSetFunctionBatch(MatFDColoring matfd, PetscErrorCode (*fbatch)(void *, PetscInt, const Vec[], Vec[], void *), void *fctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(matfd, MAT_FDCOLORING_CLASSID, 1);
+  matfd->fbatch    = fbatch;
+  matfd->fbatchctx = fctx;
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatFDColoringSetFromOptions - Sets coloring finite difference parameters from
    the options database.
@@ -513,6 +559,10 @@ PetscErrorCode MatFDColoringDestroy(MatFDColoring *c)
   PetscCall(VecDestroy(&color->w1));
   PetscCall(VecDestroy(&color->w2));
   PetscCall(VecDestroy(&color->w3));
+  if (color->nbatch) {
+    PetscCall(VecDestroyVecs(color->nbatch, &color->xbatch));
+    PetscCall(VecDestroyVecs(color->nbatch, &color->ybatch));
+  }
   PetscCall(PetscHeaderDestroy(c));
   PetscFunctionReturn(0);
 }
@@ -592,7 +642,7 @@ PetscErrorCode MatFDColoringApply(Mat J, MatFDColoring coloring, Vec x1, void *s
   PetscValidHeaderSpecific(x1, VEC_CLASSID, 3);
   PetscCall(PetscObjectCompareId((PetscObject)J, coloring->matid, &eq));
   PetscCheck(eq, PetscObjectComm((PetscObject)J), PETSC_ERR_ARG_WRONG, "Matrix used with MatFDColoringApply() must be that used with MatFDColoringCreate()");
-  PetscCheck(coloring->f, PetscObjectComm((PetscObject)J), PETSC_ERR_ARG_WRONGSTATE, "Must call MatFDColoringSetFunction()");
+  PetscCheck(coloring->f || coloring->fbatch, PetscObjectComm((PetscObject)J), PETSC_ERR_ARG_WRONGSTATE, "Must call MatFDColoringSetFunction()");
   PetscCheck(coloring->setupcalled, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Must call MatFDColoringSetUp()");
 
   PetscCall(MatSetUnfactored(J));
@@ -18,6 +18,8 @@ typedef struct {
   SNESQNType        type;         /* the type of quasi-newton method used */
   SNESQNScaleType   scale_type;   /* the type of scaling used */
   SNESQNRestartType restart_type; /* determine the frequency and type of restart conditions */
+  PetscBool         compact;      /* apply L-BFGS in compact representation */
+  PetscBool         compact_set;  /* -snes_qn_compact was given, it then takes precedence over -mat_lmvm_compact */
 } SNES_QN;
 
 static PetscErrorCode SNESSolve_QN(SNES snes)
@@ -285,6 +287,7 @@ static PetscErrorCode SNESSetUp_QN(SNES snes)
     default:
       break;
     }
+    if (qn->compact_set) PetscCall(MatLMVMBFGSSetCompact(qn->B, qn->compact));
     break;
   }
   PetscCall(VecGetLocalSize(snes->vec_sol, &n));
@@ -334,6 +337,8 @@ static PetscErrorCode SNESSetFromOptions_QN(SNES snes, PetscOptionItems *PetscOp
   PetscCall(PetscOptionsInt("-snes_qn_m", "Number of past states saved for L-BFGS methods", "SNESQN", qn->m, &qn->m, NULL));
   PetscCall(PetscOptionsReal("-snes_qn_powell_gamma", "Powell angle tolerance", "SNESQN", qn->powell_gamma, &qn->powell_gamma, NULL));
   PetscCall(PetscOptionsBool("-snes_qn_monitor", "Monitor for the QN methods", "SNESQN", qn->monflg, &qn->monflg, NULL));
+  PetscCall(PetscOptionsBool("-snes_qn_compact", "Apply L-BFGS in compact representation", "MatLMVMBFGSSetCompact", qn->compact, &qn->compact, &flg));
+  if (flg) qn->compact_set = PETSC_TRUE;
   PetscCall(PetscOptionsEnum("-snes_qn_scale_type", "Scaling type", "SNESQNSetScaleType", SNESQNScaleTypes, (PetscEnum)stype, (PetscEnum *)&stype, &flg));
   if (flg) PetscCall(SNESQNSetScaleType(snes, stype));
 
@@ -342,6 +347,8 @@ static PetscErrorCode SNESSetFromOptions_QN(SNES snes, PetscOptionItems *PetscOp
 
   PetscCall(PetscOptionsEnum("-snes_qn_type", "Quasi-Newton update type", "", SNESQNTypes, (PetscEnum)qtype, (PetscEnum *)&qtype, &flg));
   if (flg) PetscCall(SNESQNSetType(snes, qtype));
+  /* the options of the LMVM matrix, such as -mat_lmvm_compact, are those of its type */
+  PetscCall(MatSetType(qn->B, qn->type == SNES_QN_BROYDEN ? MATLMVMBROYDEN : (qn->type == SNES_QN_BADBROYDEN ? MATLMVMBADBROYDEN : MATLMVMBFGS)));
   PetscCall(MatSetFromOptions(qn->B));
   PetscOptionsHeadEnd();
   if (!snes->linesearch) {
@@ -370,6 +377,13 @@ static PetscErrorCode SNESView_QN(SNES snes, PetscViewer viewer)
   if (iascii) {
     PetscCall(PetscViewerASCIIPrintf(viewer, "  type is %s, restart type is %s, scale type is %s\n", SNESQNTypes[qn->type], SNESQNRestartTypes[qn->restart_type], SNESQNScaleTypes[qn->scale_type]));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  Stored subspace size: %" PetscInt_FMT "\n", qn->m));
+    if (qn->type == SNES_QN_LBFGS) {
+      PetscBool is_bfgs, compact = PETSC_FALSE;
+
+      PetscCall(PetscObjectTypeCompare((PetscObject)qn->B, MATLMVMBFGS, &is_bfgs));
+      if (is_bfgs) PetscCall(MatLMVMBFGSGetCompactInUse(qn->B, &compact));
+      if (compact) PetscCall(PetscViewerASCIIPrintf(viewer, "  Using compact representation\n"));
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -505,7 +519,8 @@ PetscErrorCode SNESQNSetType_QN(SNES snes, SNESQNType qtype)
 .     -snes_qn_type <lbfgs,broyden,badbroyden> - QN type
 .     -snes_qn_scale_type <diagonal,none,scalar,jacobian> - scaling performed on inner Jacobian
 .     -snes_linesearch_type <cp, l2, basic> - Type of line search.
--     -snes_qn_monitor - Monitors the quasi-newton Jacobian.
+.     -snes_qn_monitor - Monitors the quasi-newton Jacobian.
+-     -snes_qn_compact - apply L-BFGS in compact representation, see `MatLMVMBFGSSetCompact()`; overrides -mat_lmvm_compact
 
       References:
 +   * -   Kelley, C.T., Iterative Methods for Linear and Nonlinear Equations, Chapter 8, SIAM, 1995.
@@ -533,6 +548,10 @@ PetscErrorCode SNESQNSetType_QN(SNES snes, SNESQNType qtype)
       iteration as the current iteration's values when constructing the approximate Jacobian.  The second, composed,
       perturbs the problem the Jacobian represents to be P(x, b) - x = 0, where P(x, b) is the preconditioner.
 
+      With -snes_qn_compact and the scalar or no scaling, the L-BFGS update history is applied through its compact representation
+      (Byrd, Nocedal and Schnabel), which gives the same iterates as the recursive formula with a single global reduction per
+      application.
+
       Uses left nonlinear preconditioning by default.
 
 .seealso: `SNESQNRestartType`, `SNESQNSetRestartType()`, `SNESCreate()`, `SNES`, `SNESSetType()`, `SNESNEWTONLS`, `SNESNEWTONTR`,
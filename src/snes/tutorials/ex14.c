@@ -52,6 +52,7 @@ typedef struct {
 */
 extern PetscErrorCode FormFunctionLocal(SNES, Vec, Vec, void *);
 extern PetscErrorCode FormFunction(SNES, Vec, Vec, void *);
+extern PetscErrorCode FormFunctionBatch(void *, PetscInt, const Vec[], Vec[], void *);
 extern PetscErrorCode FormInitialGuess(AppCtx *, Vec);
 extern PetscErrorCode FormJacobian(SNES, Vec, Mat, Mat, void *);
 
@@ -63,7 +64,7 @@ int main(int argc, char **argv)
   AppCtx        user;     /* user-defined work context */
   PetscInt      its;      /* iterations for convergence */
   MatFDColoring matfdcoloring = NULL;
-  PetscBool     matrix_free = PETSC_FALSE, coloring = PETSC_FALSE, coloring_ds = PETSC_FALSE, local_coloring = PETSC_FALSE;
+  PetscBool     matrix_free = PETSC_FALSE, coloring = PETSC_FALSE, coloring_ds = PETSC_FALSE, local_coloring = PETSC_FALSE, batch = PETSC_FALSE;
   PetscReal     bratu_lambda_max = 6.81, bratu_lambda_min = 0., fnorm;
 
   /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -117,11 +118,15 @@ int main(int argc, char **argv)
 
      Note one can use -matfd_coloring wp or ds the only reason for the -fdcoloring_ds option
      below is to test the call to MatFDColoringSetType().
+
+     -fdcoloring_batch : evaluate the function at the perturbed points of a block of colors at once
+
      - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-snes_mf", &matrix_free, NULL));
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-fdcoloring", &coloring, NULL));
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-fdcoloring_ds", &coloring_ds, NULL));
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-fdcoloring_local", &local_coloring, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-fdcoloring_batch", &batch, NULL));
   if (!matrix_free) {
     PetscCall(DMSetMatType(user.da, MATAIJ));
     PetscCall(DMCreateMatrix(user.da, &J));
@@ -131,6 +136,7 @@ int main(int argc, char **argv)
         PetscCall(DMCreateColoring(user.da, IS_COLORING_GLOBAL, &iscoloring));
         PetscCall(MatFDColoringCreate(J, iscoloring, &matfdcoloring));
         PetscCall(MatFDColoringSetFunction(matfdcoloring, (PetscErrorCode(*)(void))FormFunction, &user));
+        if (batch) PetscCall(MatFDColoringSetFunctionBatch(matfdcoloring, FormFunctionBatch, &user));
       } else {
         PetscCall(DMCreateColoring(user.da, IS_COLORING_LOCAL, &iscoloring));
         PetscCall(MatFDColoringCreate(J, iscoloring, &matfdcoloring));
@@ -368,6 +374,36 @@ PetscErrorCode FormFunction(SNES snes, Vec X, Vec F, void *ptr)
   PetscFunctionReturn(0);
 }
 /* ------------------------------------------------------------------- */
+/*
+   FormFunctionBatch - Evaluates nonlinear function at n points with a single call
+
+   Input Parameters:
+.  ctx - the SNES context
+.  n - number of points
+.  X - input vectors
+.  ptr - optional user-defined context, as set by MatFDColoringSetFunctionBatch()
+
+   Output Parameter:
+.  F - function vectors
+ */
+PetscErrorCode FormFunctionBatch(void *ctx, PetscInt n, const Vec X[], Vec F[], void *ptr)
+{
+  SNES snes = (SNES)ctx;
+  Vec  localX;
+  DM   da;
+
+  PetscFunctionBeginUser;
+  PetscCall(SNESGetDM(snes, &da));
+  PetscCall(DMGetLocalVector(da, &localX));
+  for (PetscInt i = 0; i < n; i++) {
+    PetscCall(DMGlobalToLocalBegin(da, X[i], INSERT_VALUES, localX));
+    PetscCall(DMGlobalToLocalEnd(da, X[i], INSERT_VALUES, localX));
+    PetscCall(FormFunctionLocal(snes, localX, F[i], ptr));
+  }
+  PetscCall(DMRestoreLocalVector(da, &localX));
+  PetscFunctionReturn(0);
+}
+/* ------------------------------------------------------------------- */
 /*
    FormJacobian - Evaluates Jacobian matrix.
 
@@ -529,6 +565,12 @@ PetscErrorCode FormJacobian(SNES snes, Vec X, Mat J, Mat jac, void *ptr)
       nsize: 4
       args: -fdcoloring -fdcoloring_ds -snes_monitor_short -ksp_gmres_cgs_refinement_type refine_always
 
+   test:
+      suffix: 3_batch
+      nsize: 4
+      args: -fdcoloring -fdcoloring_batch -mat_fd_coloring_bcols 4 -snes_monitor_short -ksp_gmres_cgs_refinement_type refine_always
+      output_file: output/ex14_3.out
+
    test:
       suffix: 4
       nsize: 4
@@ -919,6 +919,11 @@ int main(int argc, char **argv)
      suffix: 5_qn
      args: -da_grid_x 81 -da_grid_y 81 -snes_monitor_short -snes_max_it 50 -par 6.0 -snes_type qn -snes_linesearch_type cp -snes_qn_m 10
 
+   test:
+     suffix: 5_qn_compact
+     output_file: output/ex5_5_qn.out
+     args: -da_grid_x 81 -da_grid_y 81 -snes_monitor_short -snes_max_it 50 -par 6.0 -snes_type qn -snes_linesearch_type cp -snes_qn_m 10 -snes_qn_compact
+
    test:
      suffix: 6
      nsize: 4
@@ -12,6 +12,12 @@ typedef struct {
   MPI_File   mfdes; /* ignored unless using MPI IO */
   MPI_File   mfsub; /* subviewer support */
   MPI_Offset moff;
+  PetscBool  mpiioasync;  /* collective writes return before the data reaches the file */
+  PetscInt   mpiiodepth;  /* maximum number of outstanding asynchronous writes */
+  PetscInt   nreqs;       /* number of outstanding asynchronous writes */
+  MPI_Request *reqs;      /* [mpiiodepth] requests of the outstanding writes */
+  void      **reqbufs;    /* [mpiiodepth] staging buffers of the outstanding writes */
+  PetscInt   aggregators; /* number of processes performing collective IO, passed to MPI as the cb_nodes hint */
 #endif
   char         *filename;            /* file name */
   PetscFileMode filemode;            /* read/write/append mode */
@@ -43,17 +49,63 @@ static PetscErrorCode PetscViewerBinaryClearFunctionList(PetscViewer v)
 #if defined(PETSC_HAVE_MPIIO)
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetUseMPIIO_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetUseMPIIO_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetMPIIOAsync_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetMPIIOAsync_C", NULL));
 #endif
   PetscFunctionReturn(0);
 }
 
 #if defined(PETSC_HAVE_MPIIO)
+  /* The collective version only exists since MPI 3.1; the independent one still lets each process write behind */
+  #if MPI_VERSION > 3 || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+    #define MPIU_File_iwrite_at_all MPI_File_iwrite_at_all
+  #else
+    #define MPIU_File_iwrite_at_all MPI_File_iwrite_at
+  #endif
+
+/* Complete all outstanding asynchronous writes, this must be called before anything that reads the file or changes the file handle */
+static PetscErrorCode PetscViewerBinaryWaitMPIIO(PetscViewer viewer)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
+  PetscMPIInt         nreqs;
+  PetscInt            r;
+
+  PetscFunctionBegin;
+  if (!vbinary->nreqs) PetscFunctionReturn(0);
+  PetscCall(PetscMPIIntCast(vbinary->nreqs, &nreqs));
+  PetscCallMPI(MPI_Waitall(nreqs, vbinary->reqs, MPI_STATUSES_IGNORE));
+  for (r = 0; r < vbinary->nreqs; ++r) PetscCall(PetscFree(vbinary->reqbufs[r]));
+  vbinary->nreqs = 0;
+  PetscFunctionReturn(0);
+}
+
+/* Copy the data to a staging buffer and start writing it, the caller may reuse data as soon as this returns */
+static PetscErrorCode PetscViewerBinaryWriteAllMPIIOAsync(PetscViewer viewer, MPI_Offset off, const void *data, PetscMPIInt cnt, MPI_Datatype mdtype, MPI_Aint dsize)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
+  PetscDataType       pdtype;
+  void               *buf;
+
+  PetscFunctionBegin;
+  if (vbinary->nreqs >= vbinary->mpiiodepth) PetscCall(PetscViewerBinaryWaitMPIIO(viewer));
+  if (!vbinary->reqs) PetscCall(PetscMalloc2(vbinary->mpiiodepth, &vbinary->reqs, vbinary->mpiiodepth, &vbinary->reqbufs));
+  PetscCall(PetscMPIDataTypeToPetscDataType(mdtype, &pdtype));
+  PetscCall(PetscMalloc((size_t)cnt * dsize, &buf));
+  PetscCall(PetscMemcpy(buf, data, (size_t)cnt * dsize));
+  if (!PetscBinaryBigEndian()) PetscCall(PetscByteSwap(buf, pdtype, cnt));
+  PetscCallMPI(MPIU_File_iwrite_at_all(vbinary->mfdes, off, buf, cnt, mdtype, &vbinary->reqs[vbinary->nreqs]));
+  vbinary->reqbufs[vbinary->nreqs++] = buf;
+  PetscCall(PetscInfo(viewer, "Started asynchronous write with %" PetscInt_FMT " writes in flight\n", vbinary->nreqs));
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PetscViewerBinarySyncMPIIO(PetscViewer viewer)
 {
   PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
 
   PetscFunctionBegin;
   if (vbinary->filemode == FILE_MODE_READ) PetscFunctionReturn(0);
+  PetscCall(PetscViewerBinaryWaitMPIIO(viewer));
   if (vbinary->mfsub != MPI_FILE_NULL) PetscCallMPI(MPI_File_sync(vbinary->mfsub));
   if (vbinary->mfdes != MPI_FILE_NULL) {
     PetscCallMPI(MPI_Barrier(PetscObjectComm((PetscObject)viewer)));
@@ -70,6 +122,9 @@ static PetscErrorCode PetscViewerGetSubViewer_Binary(PetscViewer viewer, MPI_Com
 
   PetscFunctionBegin;
   PetscCall(PetscViewerSetUp(viewer));
+#if defined(PETSC_HAVE_MPIIO)
+  PetscCall(PetscViewerBinaryWaitMPIIO(viewer));
+#endif
 
   /* Return subviewer in process zero */
   PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)viewer), &rank));
@@ -108,9 +163,11 @@ static PetscErrorCode PetscViewerGetSubViewer_Binary(PetscViewer viewer, MPI_Com
       PetscCallMPI(MPI_File_open(PETSC_COMM_SELF, vbinary->filename, amode, MPI_INFO_NULL, &vbinary->mfsub));
     }
     /* Subviewer gets the MPI file handle on PETSC_COMM_SELF */
-    obinary->mfdes = vbinary->mfsub;
-    obinary->mfsub = MPI_FILE_NULL;
-    obinary->moff  = vbinary->moff;
+    obinary->mfdes   = vbinary->mfsub;
+    obinary->mfsub   = MPI_FILE_NULL;
+    obinary->moff    = vbinary->moff;
+    obinary->reqs    = NULL;
+    obinary->reqbufs = NULL;
   }
 #endif
 
@@ -136,6 +193,8 @@ static PetscErrorCode PetscViewerRestoreSubViewer_Binary(PetscViewer viewer, MPI
   if (vbinary->usempiio && *outviewer) {
     PetscViewer_Binary *obinary = (PetscViewer_Binary *)(*outviewer)->data;
     PetscCheck(obinary->mfdes == vbinary->mfsub, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Subviewer not obtained from viewer");
+    PetscCall(PetscViewerBinaryWaitMPIIO(*outviewer));
+    PetscCall(PetscFree2(obinary->reqs, obinary->reqbufs));
     if (obinary->mfsub != MPI_FILE_NULL) PetscCallMPI(MPI_File_close(&obinary->mfsub));
     moff = obinary->moff;
   }
@@ -245,6 +304,7 @@ PetscErrorCode PetscViewerBinaryGetMPIIODescriptor(PetscViewer viewer, MPI_File
   PetscValidHeaderSpecificType(viewer, PETSC_VIEWER_CLASSID, 1, PETSCVIEWERBINARY);
   PetscValidPointer(fdes, 2);
   PetscCall(PetscViewerSetUp(viewer));
+  PetscCall(PetscViewerBinaryWaitMPIIO(viewer));
   vbinary = (PetscViewer_Binary *)viewer->data;
   *fdes   = vbinary->mfdes;
   PetscFunctionReturn(0);
@@ -328,6 +388,88 @@ static PetscErrorCode PetscViewerBinaryGetUseMPIIO_Binary(PetscViewer viewer, Pe
 }
 #endif
 
+/*@
+    PetscViewerBinarySetMPIIOAsync - Sets a binary viewer using MPI-IO to return from collective writes, such as `VecView()`,
+        before the data has reached the file
+
+    Logically Collective
+
+    Input Parameters:
++   viewer - the `PetscViewer`; must be a `PETSCVIEWERBINARY`
+-   flg - `PETSC_TRUE` means the writes are asynchronous
+
+    Options Database Keys:
++   -viewer_binary_mpiio_async - Flag for asynchronous writes
+.   -viewer_binary_mpiio_async_depth <n> - Maximum number of outstanding writes, default 2
+-   -viewer_binary_mpiio_aggregators <n> - Number of processes performing the collective writes, passed to MPI-IO as the cb_nodes hint
+
+    Level: advanced
+
+    Notes:
+    The data is copied to a staging buffer and written with nonblocking MPI-IO, so the caller can modify it immediately.
+    Outstanding writes are completed when the depth is exceeded, before any read, and when the file is synchronized or closed.
+
+    This has no effect unless MPI-IO is used, see `PetscViewerBinarySetUseMPIIO()`
+
+.seealso: [](sec_viewers), `PETSCVIEWERBINARY`, `PetscViewerBinaryOpen()`, `PetscViewerBinarySetUseMPIIO()`, `PetscViewerBinaryGetMPIIOAsync()`, `PetscViewerBinaryWriteAll()`
+@*/
+PetscErrorCode PetscViewerBinarySetMPIIOAsync(PetscViewer viewer, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(viewer, flg, 2);
+  PetscTryMethod(viewer, "PetscViewerBinarySetMPIIOAsync_C", (PetscViewer, PetscBool), (viewer, flg));
+  PetscFunctionReturn(0);
+}
+
+#if defined(PETSC_HAVE_MPIIO)
+static PetscErrorCode PetscViewerBinarySetMPIIOAsync_Binary(PetscViewer viewer, PetscBool flg)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
+
+  PetscFunctionBegin;
+  if (!flg) PetscCall(PetscViewerBinaryWaitMPIIO(viewer));
+  vbinary->mpiioasync = flg;
+  PetscFunctionReturn(0);
+}
+#endif
+
+/*@
+    PetscViewerBinaryGetMPIIOAsync - Returns `PETSC_TRUE` if the binary viewer returns from MPI-IO writes before they complete
+
+    Not Collective
+
+    Input Parameter:
+.   viewer - `PetscViewer` context, obtained from `PetscViewerBinaryOpen()`; must be a `PETSCVIEWERBINARY`
+
+    Output Parameter:
+.   flg - `PETSC_TRUE` if the writes are asynchronous
+
+    Level: advanced
+
+.seealso: [](sec_viewers), `PETSCVIEWERBINARY`, `PetscViewerBinaryOpen()`, `PetscViewerBinarySetMPIIOAsync()`, `PetscViewerBinaryGetUseMPIIO()`
+@*/
+PetscErrorCode PetscViewerBinaryGetMPIIOAsync(PetscViewer viewer, PetscBool *flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscValidBoolPointer(flg, 2);
+  *flg = PETSC_FALSE;
+  PetscTryMethod(viewer, "PetscViewerBinaryGetMPIIOAsync_C", (PetscViewer, PetscBool *), (viewer, flg));
+  PetscFunctionReturn(0);
+}
+
+#if defined(PETSC_HAVE_MPIIO)
+static PetscErrorCode PetscViewerBinaryGetMPIIOAsync_Binary(PetscViewer viewer, PetscBool *flg)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
+
+  PetscFunctionBegin;
+  *flg = vbinary->mpiioasync;
+  PetscFunctionReturn(0);
+}
+#endif
+
 /*@
     PetscViewerBinarySetFlowControl - Sets how many messages are allowed to outstanding at the same time during parallel IO reads/writes
 
@@ -742,6 +884,7 @@ static PetscErrorCode PetscViewerFileClose_BinaryMPIIO(PetscViewer v)
   PetscViewer_Binary *vbinary = (PetscViewer_Binary *)v->data;
 
   PetscFunctionBegin;
+  PetscCall(PetscViewerBinaryWaitMPIIO(v));
   if (vbinary->mfdes != MPI_FILE_NULL) PetscCallMPI(MPI_File_close(&vbinary->mfdes));
   if (vbinary->mfsub != MPI_FILE_NULL) PetscCallMPI(MPI_File_close(&vbinary->mfsub));
   vbinary->moff = 0;
@@ -815,6 +958,9 @@ static PetscErrorCode PetscViewerDestroy_Binary(PetscViewer v)
 
   PetscFunctionBegin;
   PetscCall(PetscViewerFileClose_Binary(v));
+#if defined(PETSC_HAVE_MPIIO)
+  PetscCall(PetscFree2(vbinary->reqs, vbinary->reqbufs));
+#endif
   PetscCall(PetscFree(vbinary->filename));
   PetscCall(PetscFree(vbinary));
   PetscCall(PetscViewerBinaryClearFunctionList(v));
@@ -889,6 +1035,7 @@ static PetscErrorCode PetscViewerBinaryWriteReadMPIIO(PetscViewer viewer, void *
   if (write) {
     if (rank == 0) PetscCall(MPIU_File_write_at(mfdes, vbinary->moff, data, cnt, mdtype, &status));
   } else {
+    PetscCall(PetscViewerBinaryWaitMPIIO(viewer));
     if (rank == 0) {
       PetscCall(MPIU_File_read_at(mfdes, vbinary->moff, data, cnt, mdtype, &status));
       if (cnt > 0) PetscCallMPI(MPI_Get_count(&status, mdtype, &cnt));
@@ -1019,10 +1166,14 @@ static PetscErrorCode PetscViewerBinaryWriteReadAll(PetscViewer viewer, PetscBoo
       PetscCallMPI(MPI_Bcast(&total, 1, MPIU_INT, size - 1, comm));
     }
     PetscCall(PetscMPIIntCast(count, &cnt));
-    PetscCall(PetscViewerBinaryGetMPIIODescriptor(viewer, &mfdes));
+    /* Only reads need the outstanding writes to complete, which PetscViewerBinaryGetMPIIODescriptor() does */
+    if (write) mfdes = ((PetscViewer_Binary *)viewer->data)->mfdes;
+    else PetscCall(PetscViewerBinaryGetMPIIODescriptor(viewer, &mfdes));
     PetscCall(PetscViewerBinaryGetMPIIOOffset(viewer, &off));
     off += (MPI_Offset)(start * dsize);
-    if (write) {
+    if (write && ((PetscViewer_Binary *)viewer->data)->mpiioasync) {
+      PetscCall(PetscViewerBinaryWriteAllMPIIOAsync(viewer, off, data, cnt, mdtype, dsize));
+    } else if (write) {
       PetscCall(MPIU_File_write_at_all(mfdes, off, data, cnt, mdtype, MPI_STATUS_IGNORE));
     } else {
       PetscCall(MPIU_File_read_at_all(mfdes, off, data, cnt, mdtype, MPI_STATUS_IGNORE));
@@ -1316,6 +1467,7 @@ static PetscErrorCode PetscViewerFileGetName_Binary(PetscViewer viewer, const ch
 static PetscErrorCode PetscViewerFileSetUp_BinaryMPIIO(PetscViewer viewer)
 {
   PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
+  MPI_Info            info    = MPI_INFO_NULL;
   int                 amode;
 
   PetscFunctionBegin;
@@ -1337,7 +1489,15 @@ static PetscErrorCode PetscViewerFileSetUp_BinaryMPIIO(PetscViewer viewer)
   default:
     SETERRQ(PetscObjectComm((PetscObject)viewer), PETSC_ERR_SUP, "Unsupported file mode %s", PetscFileModes[vbinary->filemode]);
   }
-  PetscCallMPI(MPI_File_open(PetscObjectComm((PetscObject)viewer), vbinary->filename, amode, MPI_INFO_NULL, &vbinary->mfdes));
+  if (vbinary->aggregators > 0) {
+    char cbnodes[32];
+
+    PetscCall(PetscSNPrintf(cbnodes, sizeof(cbnodes), "%" PetscInt_FMT, vbinary->aggregators));
+    PetscCallMPI(MPI_Info_create(&info));
+    PetscCallMPI(MPI_Info_set(info, "cb_nodes", cbnodes));
+  }
+  PetscCallMPI(MPI_File_open(PetscObjectComm((PetscObject)viewer), vbinary->filename, amode, info, &vbinary->mfdes));
+  if (info != MPI_INFO_NULL) PetscCallMPI(MPI_Info_free(&info));
   /*
       The MPI standard does not have MPI_MODE_TRUNCATE. We emulate this behavior by setting the file size to zero.
   */
@@ -1484,6 +1644,19 @@ static PetscErrorCode PetscViewerSetFromOptions_Binary(PetscViewer viewer, Petsc
   PetscCall(PetscOptionsBool("-viewer_binary_skip_header", "Skip writing/reading header information", "PetscViewerBinarySetSkipHeader", binary->skipheader, &binary->skipheader, NULL));
 #if defined(PETSC_HAVE_MPIIO)
   PetscCall(PetscOptionsBool("-viewer_binary_mpiio", "Use MPI-IO functionality to write/read binary file", "PetscViewerBinarySetUseMPIIO", binary->usempiio, &binary->usempiio, NULL));
+  PetscCall(PetscOptionsBool("-viewer_binary_mpiio_async", "Return from MPI-IO collective writes before they complete", "PetscViewerBinarySetMPIIOAsync", binary->mpiioasync, &binary->mpiioasync, NULL));
+  {
+    PetscInt depth = binary->mpiiodepth;
+
+    PetscCall(PetscOptionsBoundedInt("-viewer_binary_mpiio_async_depth", "Maximum number of outstanding asynchronous writes", "PetscViewerBinarySetMPIIOAsync", depth, &depth, NULL, 1));
+    if (depth != binary->mpiiodepth) {
+      /* The requests are sized by the depth, so complete the outstanding writes and reallocate them at the next write */
+      PetscCall(PetscViewerBinaryWaitMPIIO(viewer));
+      PetscCall(PetscFree2(binary->reqs, binary->reqbufs));
+      binary->mpiiodepth = depth;
+    }
+  }
+  PetscCall(PetscOptionsBoundedInt("-viewer_binary_mpiio_aggregators", "Number of processes performing collective MPI-IO (0 lets MPI decide)", "PetscViewerBinarySetUseMPIIO", binary->aggregators, &binary->aggregators, NULL, 0));
 #else
   PetscCall(PetscOptionsBool("-viewer_binary_mpiio", "Use MPI-IO functionality to write/read binary file (NOT AVAILABLE)", "PetscViewerBinarySetUseMPIIO", PETSC_FALSE, NULL, NULL));
 #endif
@@ -1522,9 +1695,12 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
 
   vbinary->fdes = -1;
 #if defined(PETSC_HAVE_MPIIO)
-  vbinary->usempiio = PETSC_FALSE;
-  vbinary->mfdes    = MPI_FILE_NULL;
-  vbinary->mfsub    = MPI_FILE_NULL;
+  vbinary->usempiio    = PETSC_FALSE;
+  vbinary->mfdes       = MPI_FILE_NULL;
+  vbinary->mfsub       = MPI_FILE_NULL;
+  vbinary->mpiioasync  = PETSC_FALSE;
+  vbinary->mpiiodepth  = 2;
+  vbinary->aggregators = 0;
 #endif
   vbinary->filename        = NULL;
   vbinary->filemode        = FILE_MODE_UNDEFINED;
@@ -1554,6 +1730,8 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
 #if defined(PETSC_HAVE_MPIIO)
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetUseMPIIO_C", PetscViewerBinaryGetUseMPIIO_Binary));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetUseMPIIO_C", PetscViewerBinarySetUseMPIIO_Binary));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetMPIIOAsync_C", PetscViewerBinaryGetMPIIOAsync_Binary));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetMPIIOAsync_C", PetscViewerBinarySetMPIIOAsync_Binary));
 #endif
   PetscFunctionReturn(0);
 }
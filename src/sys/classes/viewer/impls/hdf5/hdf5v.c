@@ -78,6 +78,19 @@ static PetscErrorCode PetscViewerSetFromOptions_HDF5(PetscViewer v, PetscOptionI
   flg = PETSC_FALSE;
   PetscCall(PetscOptionsBool("-viewer_hdf5_default_timestepping", "Set default timestepping state", "PetscViewerHDF5SetDefaultTimestepping", flg, &flg, &set));
   if (set) PetscCall(PetscViewerHDF5SetDefaultTimestepping(v, flg));
+  PetscCall(PetscOptionsInt("-viewer_hdf5_chunk_size", "Maximum number of entries in a dataset chunk, or PETSC_DECIDE to align chunks with the parallel layout", "PetscViewerHDF5SetChunkSize", hdf5->chunksize, &hdf5->chunksize, NULL));
+  PetscCall(PetscOptionsRangeInt("-viewer_hdf5_compress", "Deflate compression level of new datasets, 0 for none", "PetscViewerHDF5SetCompression", hdf5->compress, &hdf5->compress, NULL, 0, 9));
+  PetscCall(PetscOptionsBool("-viewer_hdf5_shuffle", "Shuffle bytes before compression", "PetscViewerHDF5SetCompression", hdf5->shuffle, &hdf5->shuffle, NULL));
+  PetscCall(PetscOptionsBoundedInt("-viewer_hdf5_filter", "Identifier of a registered HDF5 filter applied to new datasets, 0 for none", "PetscViewerHDF5SetFilter", hdf5->filter, &hdf5->filter, NULL, 0));
+  {
+    PetscInt params[PETSC_HDF5_MAX_FILTER_PARAMS], n = PETSC_HDF5_MAX_FILTER_PARAMS;
+
+    PetscCall(PetscOptionsIntArray("-viewer_hdf5_filter_params", "Parameters of the HDF5 filter", "PetscViewerHDF5SetFilter", params, &n, &set));
+    if (set) {
+      hdf5->nfilterparams = n;
+      PetscCall(PetscArraycpy(hdf5->filterparams, params, n));
+    }
+  }
   PetscOptionsHeadEnd();
   PetscFunctionReturn(0);
 }
@@ -94,6 +107,10 @@ static PetscErrorCode PetscViewerView_HDF5(PetscViewer v, PetscViewer viewer)
   PetscCall(PetscViewerHDF5GetCollective(v, &flg));
   PetscCall(PetscViewerASCIIPrintf(viewer, "MPI-IO transfer mode: %s\n", flg ? "collective" : "independent"));
   PetscCall(PetscViewerASCIIPrintf(viewer, "Default timestepping: %s\n", PetscBools[hdf5->defTimestepping]));
+  if (hdf5->chunksize == PETSC_DECIDE) PetscCall(PetscViewerASCIIPrintf(viewer, "Dataset chunks aligned with the parallel layout\n"));
+  else if (hdf5->chunksize > 0) PetscCall(PetscViewerASCIIPrintf(viewer, "Maximum dataset chunk size: %" PetscInt_FMT "\n", hdf5->chunksize));
+  if (hdf5->compress) PetscCall(PetscViewerASCIIPrintf(viewer, "Deflate compression level: %" PetscInt_FMT "%s\n", hdf5->compress, hdf5->shuffle ? " with shuffle" : ""));
+  if (hdf5->filter) PetscCall(PetscViewerASCIIPrintf(viewer, "Filter: %" PetscInt_FMT " with %" PetscInt_FMT " parameters\n", hdf5->filter, hdf5->nfilterparams));
   PetscFunctionReturn(0);
 }
 
@@ -392,6 +409,357 @@ PetscErrorCode PetscViewerHDF5GetCollective(PetscViewer viewer, PetscBool *flg)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PetscViewerHDF5SetChunkSize_HDF5(PetscViewer viewer, PetscInt size)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
+
+  PetscFunctionBegin;
+  PetscCheck(size > 0 || size == PETSC_DECIDE || size == PETSC_DEFAULT, PetscObjectComm((PetscObject)viewer), PETSC_ERR_ARG_OUTOFRANGE, "Chunk size %" PetscInt_FMT " must be positive, PETSC_DECIDE, or PETSC_DEFAULT", size);
+  hdf5->chunksize = size;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscViewerHDF5SetChunkSize - Set the chunking policy for datasets created by `VecView()` and `ISView()`
+
+  Logically Collective
+
+  Input Parameters:
++ viewer - the `PetscViewer`; if it is not `PETSCVIEWERHDF5` then this command is ignored
+- size - the maximum number of entries in a chunk, `PETSC_DECIDE` to give each process its own chunk, or `PETSC_DEFAULT` to use a single chunk per time step
+
+  Options Database Key:
+. -viewer_hdf5_chunk_size <size> - sets the chunk size, use decide to align chunks with the parallel layout
+
+  Notes:
+  Chunks are the unit of compression and of parallel filtered writes, so aligning them with the parallel layout lets each process compress its own data.
+  HDF5 chunks all have the same size, so with `PETSC_DECIDE` the chunk is the greatest common divisor of the local sizes, which gives one chunk per
+  process for even layouts. When the local sizes have no large common divisor the chunk is the largest local size, and the data of a process may
+  straddle two chunks; collective filtered writes then exchange the data of the shared chunks between processes, which is correct but slower.
+  Only datasets created after this call are affected.
+
+  Level: advanced
+
+.seealso: [](sec_viewers), `PETSCVIEWERHDF5`, `PetscViewerHDF5GetChunkSize()`, `PetscViewerHDF5SetCompression()`, `PetscViewerHDF5SetFilter()`
+@*/
+PetscErrorCode PetscViewerHDF5SetChunkSize(PetscViewer viewer, PetscInt size)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(viewer, size, 2);
+  PetscTryMethod(viewer, "PetscViewerHDF5SetChunkSize_C", (PetscViewer, PetscInt), (viewer, size));
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscViewerHDF5GetChunkSize - Get the chunking policy for new datasets
+
+  Not Collective
+
+  Input Parameter:
+. viewer - the `PETSCVIEWERHDF5` `PetscViewer`
+
+  Output Parameter:
+. size - the maximum number of entries in a chunk, `PETSC_DECIDE`, or `PETSC_DEFAULT`
+
+  Level: advanced
+
+.seealso: [](sec_viewers), `PETSCVIEWERHDF5`, `PetscViewerHDF5SetChunkSize()`
+@*/
+PetscErrorCode PetscViewerHDF5GetChunkSize(PetscViewer viewer, PetscInt *size)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(viewer, PETSC_VIEWER_CLASSID, 1, PETSCVIEWERHDF5);
+  PetscValidIntPointer(size, 2);
+  *size = hdf5->chunksize;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscViewerHDF5SetCompression_HDF5(PetscViewer viewer, PetscInt level, PetscBool shuffle)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
+
+  PetscFunctionBegin;
+  PetscCheck(level >= 0 && level <= 9, PetscObjectComm((PetscObject)viewer), PETSC_ERR_ARG_OUTOFRANGE, "Deflate level %" PetscInt_FMT " must be in [0, 9]", level);
+  hdf5->compress = level;
+  hdf5->shuffle  = shuffle;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscViewerHDF5SetCompression - Compress datasets created by `VecView()` and `ISView()` with the deflate (gzip) filter
+
+  Logically Collective
+
+  Input Parameters:
++ viewer - the `PetscViewer`; if it is not `PETSCVIEWERHDF5` then this command is ignored
+. level - the deflate level from 1 (fastest) to 9 (smallest), or 0 for no compression
+- shuffle - apply the byte shuffle filter before compressing, which usually helps floating point data
+
+  Options Database Keys:
++ -viewer_hdf5_compress <level> - sets the deflate level
+- -viewer_hdf5_shuffle - turns on the shuffle filter
+
+  Notes:
+  The files remain readable by any HDF5 installation with zlib, which is standard.
+  In parallel, HDF5 1.10.3 or later is required and writes of compressed datasets use the collective transfer mode, independently of `PetscViewerHDF5SetCollective()`.
+
+  Level: advanced
+
+.seealso: [](sec_viewers), `PETSCVIEWERHDF5`, `PetscViewerHDF5GetCompression()`, `PetscViewerHDF5SetChunkSize()`, `PetscViewerHDF5SetFilter()`
+@*/
+PetscErrorCode PetscViewerHDF5SetCompression(PetscViewer viewer, PetscInt level, PetscBool shuffle)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(viewer, level, 2);
+  PetscValidLogicalCollectiveBool(viewer, shuffle, 3);
+  PetscTryMethod(viewer, "PetscViewerHDF5SetCompression_C", (PetscViewer, PetscInt, PetscBool), (viewer, level, shuffle));
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscViewerHDF5GetCompression - Get the deflate compression settings for new datasets
+
+  Not Collective
+
+  Input Parameter:
+. viewer - the `PETSCVIEWERHDF5` `PetscViewer`
+
+  Output Parameters:
++ level - the deflate level, 0 means no compression
+- shuffle - whether the shuffle filter is applied
+
+  Level: advanced
+
+.seealso: [](sec_viewers), `PETSCVIEWERHDF5`, `PetscViewerHDF5SetCompression()`
+@*/
+PetscErrorCode PetscViewerHDF5GetCompression(PetscViewer viewer, PetscInt *level, PetscBool *shuffle)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(viewer, PETSC_VIEWER_CLASSID, 1, PETSCVIEWERHDF5);
+  if (level) *level = hdf5->compress;
+  if (shuffle) *shuffle = hdf5->shuffle;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscViewerHDF5SetFilter_HDF5(PetscViewer viewer, PetscInt filter, PetscInt n, const PetscInt params[])
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
+
+  PetscFunctionBegin;
+  PetscCheck(filter >= 0, PetscObjectComm((PetscObject)viewer), PETSC_ERR_ARG_OUTOFRANGE, "Invalid HDF5 filter identifier %" PetscInt_FMT, filter);
+  PetscCheck(n >= 0 && n <= PETSC_HDF5_MAX_FILTER_PARAMS, PetscObjectComm((PetscObject)viewer), PETSC_ERR_ARG_OUTOFRANGE, "Number of filter parameters %" PetscInt_FMT " must be in [0, %d]", n, PETSC_HDF5_MAX_FILTER_PARAMS);
+  hdf5->filter        = filter;
+  hdf5->nfilterparams = n;
+  PetscCall(PetscArraycpy(hdf5->filterparams, params, n));
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscViewerHDF5SetFilter - Apply a registered HDF5 filter, such as a lossy floating point compressor, to datasets created by `VecView()` and `ISView()`
+
+  Logically Collective
+
+  Input Parameters:
++ viewer - the `PetscViewer`; if it is not `PETSCVIEWERHDF5` then this command is ignored
+. filter - the HDF5 filter identifier, or 0 for none
+. n - the number of filter parameters
+- params - the filter parameters, passed to `H5Pset_filter()` as `cd_values`
+
+  Options Database Keys:
++ -viewer_hdf5_filter <filter> - sets the filter identifier
+- -viewer_hdf5_filter_params <p0,p1,...> - sets the filter parameters
+
+  Notes:
+  The filter must be available to HDF5, either built in or loaded as a plugin through `HDF5_PLUGIN_PATH`, and readers need the same filter.
+  For example, szip is filter 4 with parameters `32,<pixels per block>`.
+  The filter is applied before the shuffle and deflate filters set with `PetscViewerHDF5SetCompression()`.
+
+  Level: advanced
+
+.seealso: [](sec_viewers), `PETSCVIEWERHDF5`, `PetscViewerHDF5GetFilter()`, `PetscViewerHDF5SetCompression()`, `PetscViewerHDF5SetChunkSize()`
+@*/
+PetscErrorCode PetscViewerHDF5SetFilter(PetscViewer viewer, PetscInt filter, PetscInt n, const PetscInt params[])
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(viewer, filter, 2);
+  PetscValidLogicalCollectiveInt(viewer, n, 3);
+  if (n) PetscValidIntPointer(params, 4);
+  PetscTryMethod(viewer, "PetscViewerHDF5SetFilter_C", (PetscViewer, PetscInt, PetscInt, const PetscInt[]), (viewer, filter, n, params));
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscViewerHDF5GetFilter - Get the registered HDF5 filter applied to new datasets
+
+  Not Collective
+
+  Input Parameter:
+. viewer - the `PETSCVIEWERHDF5` `PetscViewer`
+
+  Output Parameters:
++ filter - the HDF5 filter identifier, 0 for none
+. n - the number of filter parameters
+- params - the filter parameters, an array of length at least `n`, pass `NULL` if not needed
+
+  Level: advanced
+
+.seealso: [](sec_viewers), `PETSCVIEWERHDF5`, `PetscViewerHDF5SetFilter()`, `PetscViewerHDF5GetCompression()`
+@*/
+PetscErrorCode PetscViewerHDF5GetFilter(PetscViewer viewer, PetscInt *filter, PetscInt *n, PetscInt params[])
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(viewer, PETSC_VIEWER_CLASSID, 1, PETSCVIEWERHDF5);
+  if (filter) *filter = hdf5->filter;
+  if (n) *n = hdf5->nfilterparams;
+  if (params) PetscCall(PetscArraycpy(params, hdf5->filterparams, hdf5->nfilterparams));
+  PetscFunctionReturn(0);
+}
+
+/* Chunks aligned with the parallel layout are at least this fraction of the largest local part, otherwise they straddle processes */
+#define PETSC_HDF5_MIN_ALIGNED_CHUNK_FRACTION 8
+
+/*
+  PetscViewerHDF5GetRankChunk_Internal - The chunk length along a distributed dimension when the chunk size is `PETSC_DECIDE`
+
+  Input Parameters:
++ n     - the number of processes along the dimension
+. range - the ownership ranges along the dimension, of length n + 1
+- bs    - the block size, which divides all the ranges
+
+  Output Parameter:
+. chunk - the chunk length, in blocks
+
+  Note:
+  The chunk is the greatest common divisor of the local sizes, so that no chunk holds entries of two processes. When
+  that would split the largest local part into more than PETSC_HDF5_MIN_ALIGNED_CHUNK_FRACTION chunks, the chunk is
+  the largest local part instead and the parts of the other processes may straddle two chunks.
+*/
+PetscErrorCode PetscViewerHDF5GetRankChunk_Internal(PetscInt n, const PetscInt range[], PetscInt bs, hsize_t *chunk)
+{
+  PetscInt nmax = 0, g = 0;
+
+  PetscFunctionBegin;
+  for (PetscInt r = 0; r < n; ++r) {
+    PetscInt a = (range[r + 1] - range[r]) / bs, b = g;
+
+    nmax = PetscMax(nmax, a);
+    while (b) {
+      const PetscInt t = a % b;
+
+      a = b;
+      b = t;
+    }
+    g = a;
+  }
+  if (g * PETSC_HDF5_MIN_ALIGNED_CHUNK_FRACTION < nmax) g = nmax;
+  PetscCall(PetscHDF5IntCast(g, chunk));
+  PetscFunctionReturn(0);
+}
+
+/*
+  PetscViewerHDF5CreateDatasetProperties_Internal - Create the dataset creation property list for a new chunked dataset
+
+  Input Parameters:
++ viewer        - the `PETSCVIEWERHDF5` viewer
+. ndims         - the dataset rank
+- rankChunkDims - the chunk aligned with the data of the processes, see `PetscViewerHDF5GetRankChunk_Internal()`, used when the chunk size is `PETSC_DECIDE`
+
+  Input/Output Parameter:
+. chunkDims - the default chunk, on output the chunk used
+
+  Output Parameter:
+. dcpl - the property list, to be closed with H5Pclose()
+*/
+PetscErrorCode PetscViewerHDF5CreateDatasetProperties_Internal(PetscViewer viewer, int ndims, const hsize_t rankChunkDims[], hsize_t chunkDims[], hid_t *dcpl)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
+  int               d;
+
+  PetscFunctionBegin;
+  if (hdf5->chunksize == PETSC_DECIDE) {
+    for (d = 0; d < ndims; ++d) chunkDims[d] = PetscMax(1, rankChunkDims[d]);
+  }
+  if (hdf5->chunksize != PETSC_DEFAULT) {
+    const hsize_t maxsize = hdf5->chunksize > 0 ? (hsize_t)hdf5->chunksize : PETSC_HDF5_MAX_CHUNKSIZE / 64;
+
+    /* Halve the longest side until the chunk fits, an even side stays aligned with the parallel layout */
+    while (PETSC_TRUE) {
+      hsize_t size = 1;
+      int     dmax = 0;
+
+      for (d = 0; d < ndims; ++d) {
+        size *= chunkDims[d];
+        if (chunkDims[d] > chunkDims[dmax]) dmax = d;
+      }
+      if (size <= maxsize || chunkDims[dmax] <= 1) break;
+      chunkDims[dmax] = (chunkDims[dmax] + 1) / 2;
+    }
+  }
+  PetscCallHDF5Return(*dcpl, H5Pcreate, (H5P_DATASET_CREATE));
+  PetscCallHDF5(H5Pset_chunk, (*dcpl, ndims, chunkDims));
+  if (hdf5->filter) {
+    unsigned int cd_values[PETSC_HDF5_MAX_FILTER_PARAMS];
+    htri_t       avail;
+
+    PetscCallHDF5ReturnNoCheck(avail, H5Zfilter_avail, ((H5Z_filter_t)hdf5->filter));
+    PetscCheck(avail > 0, PETSC_COMM_SELF, PETSC_ERR_SUP, "HDF5 filter %" PetscInt_FMT " is not available, check HDF5_PLUGIN_PATH", hdf5->filter);
+    for (d = 0; d < hdf5->nfilterparams; ++d) cd_values[d] = (unsigned int)hdf5->filterparams[d];
+    PetscCallHDF5(H5Pset_filter, (*dcpl, (H5Z_filter_t)hdf5->filter, H5Z_FLAG_MANDATORY, (size_t)hdf5->nfilterparams, cd_values));
+  }
+  if (hdf5->compress && hdf5->shuffle) PetscCallHDF5(H5Pset_shuffle, (*dcpl));
+  if (hdf5->compress) PetscCallHDF5(H5Pset_deflate, (*dcpl, (unsigned int)hdf5->compress));
+  PetscFunctionReturn(0);
+}
+
+/*
+  PetscViewerHDF5CreateTransferProperties_Internal - Create the transfer property list for writing into a dataset
+
+  Input Parameters:
++ viewer - the `PETSCVIEWERHDF5` viewer
+- dset   - the dataset
+
+  Output Parameter:
+. dxpl - a copy of the transfer property list of the viewer, to be closed with H5Pclose()
+
+  Note:
+  Parallel HDF5 can only write filtered datasets collectively, so for those the copy uses collective transfer
+  whatever the mode set with `PetscViewerHDF5SetCollective()`. The mode of the viewer itself is not changed.
+*/
+PetscErrorCode PetscViewerHDF5CreateTransferProperties_Internal(PetscViewer viewer, hid_t dset, hid_t *dxpl)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
+  PetscMPIInt       size;
+
+  PetscFunctionBegin;
+  PetscCallHDF5Return(*dxpl, H5Pcopy, (hdf5->dxpl_id));
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)viewer), &size));
+  if (size > 1) {
+    hid_t dcpl;
+    int   nfilters;
+
+    PetscCallHDF5Return(dcpl, H5Dget_create_plist, (dset));
+    PetscCallHDF5Return(nfilters, H5Pget_nfilters, (dcpl));
+    PetscCallHDF5(H5Pclose, (dcpl));
+    if (nfilters > 0) {
+#if H5_VERSION_GE(1, 10, 3) && defined(H5_HAVE_PARALLEL)
+      PetscCallHDF5(H5Pset_dxpl_mpio, (*dxpl, H5FD_MPIO_COLLECTIVE));
+#else
+      SETERRQ(PetscObjectComm((PetscObject)viewer), PETSC_ERR_SUP, "Writing compressed datasets in parallel requires HDF5 1.10.3 or later");
+#endif
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PetscViewerFileSetName_HDF5(PetscViewer viewer, const char name[])
 {
   PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
@@ -567,6 +935,7 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_HDF5(PetscViewer v)
   hdf5->filename         = NULL;
   hdf5->timestep         = -1;
   hdf5->groups           = NULL;
+  hdf5->chunksize        = PETSC_DEFAULT;
 
   PetscCallHDF5Return(hdf5->dxpl_id, H5Pcreate, (H5P_DATASET_XFER));
 
@@ -578,6 +947,9 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_HDF5(PetscViewer v)
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5SetSPOutput_C", PetscViewerHDF5SetSPOutput_HDF5));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5SetCollective_C", PetscViewerHDF5SetCollective_HDF5));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5GetCollective_C", PetscViewerHDF5GetCollective_HDF5));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5SetChunkSize_C", PetscViewerHDF5SetChunkSize_HDF5));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5SetCompression_C", PetscViewerHDF5SetCompression_HDF5));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5SetFilter_C", PetscViewerHDF5SetFilter_HDF5));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5GetDefaultTimestepping_C", PetscViewerHDF5GetDefaultTimestepping_HDF5));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5SetDefaultTimestepping_C", PetscViewerHDF5SetDefaultTimestepping_HDF5));
   PetscFunctionReturn(0);
@@ -598,7 +970,10 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_HDF5(PetscViewer v)
 
   Options Database Keys:
 +  -viewer_hdf5_base_dimension2 - turns on (true) or off (false) using a dimension of 2 in the HDF5 file even if the bs/dof of the vector is 1
--  -viewer_hdf5_sp_output - forces (if true) the viewer to write data in single precision independent on the precision of PetscReal
+.  -viewer_hdf5_sp_output - forces (if true) the viewer to write data in single precision independent on the precision of PetscReal
+.  -viewer_hdf5_chunk_size <size> - maximum number of entries in a dataset chunk, or decide to align chunks with the parallel layout
+.  -viewer_hdf5_compress <level> - deflate compression level of new datasets
+-  -viewer_hdf5_filter <filter> - registered HDF5 filter applied to new datasets
 
    Level: beginner
 
@@ -616,7 +991,7 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_HDF5(PetscViewer v)
    This PetscViewer should be destroyed with PetscViewerDestroy().
 
 .seealso: [](sec_viewers), `PETSCVIEWERHDF5`, `PetscViewerASCIIOpen()`, `PetscViewerPushFormat()`, `PetscViewerDestroy()`, `PetscViewerHDF5SetBaseDimension2()`,
-          `PetscViewerHDF5SetSPOutput()`, `PetscViewerHDF5GetBaseDimension2()`, `VecView()`, `MatView()`, `VecLoad()`,
+          `PetscViewerHDF5SetSPOutput()`, `PetscViewerHDF5GetBaseDimension2()`, `PetscViewerHDF5SetCompression()`, `VecView()`, `MatView()`, `VecLoad()`,
           `MatLoad()`, `PetscFileMode`, `PetscViewer`, `PetscViewerSetType()`, `PetscViewerFileSetMode()`, `PetscViewerFileSetName()`
 @*/
 PetscErrorCode PetscViewerHDF5Open(MPI_Comm comm, const char name[], PetscFileMode type, PetscViewer *hdf5v)
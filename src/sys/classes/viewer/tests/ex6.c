@@ -204,5 +204,16 @@ int main(int argc, char **args)
        requires: mpiio
        suffix: mpiio
        args: -viewer_binary_mpiio 1
+     test:
+       requires: mpiio
+       suffix: mpiio_async
+       args: -viewer_binary_mpiio 1 -viewer_binary_mpiio_async 1 -viewer_binary_mpiio_async_depth 1 -viewer_binary_mpiio_aggregators 1
+
+   test:
+     requires: mpiio
+     suffix: mpiio_async_depth
+     nsize: 2
+     args: -viewer_binary_mpiio 1 -viewer_binary_mpiio_async 1 -viewer_binary_mpiio_async_depth 2 -info
+     filter: grep "with 2 writes in flight" | sort -u
 
 TEST*/
@@ -0,0 +1,328 @@
+/*
+     Call path profiling of PETSc events, written as folded stacks for flame graphs.
+
+   Each distinct chain of nested events (stage;event;event;...) is a node of a call tree. The event
+   handlers only move a pointer through that tree and count calls; the time is measured for every
+   Nth call of each call path, or taken from a profiling timer signal that charges the node active
+   when it fires. Both keep the cost per event well below that of the default logger.
+*/
+#include <petsclog.h> /*I "petsclog.h" I*/
+#include <petsc/private/logimpl.h>
+#include <petsctime.h>
+#if defined(PETSC_HAVE_SYS_TIME_H) && defined(PETSC_HAVE_STRUCT_SIGACTION)
+  #include <sys/time.h>
+  #include <signal.h>
+  #define PETSC_HAVE_CALLPATH_TIMER
+#endif
+
+#if defined(PETSC_USE_LOG)
+
+  #define PETSC_CALLPATH_BLOCK_SIZE 1024
+  #define PETSC_CALLPATH_MAX_BLOCKS 1024
+  #define PETSC_CALLPATH_MAX_DEPTH  128
+
+typedef struct _n_PetscCallPathNode *PetscCallPathNode;
+struct _n_PetscCallPathNode {
+  PetscLogEvent     event; /* the event, or -(stage+1) for the stage nodes directly below the root */
+  PetscCallPathNode parent, child, sibling;
+  PetscInt64        count;   /* number of calls along this path */
+  PetscInt64        timed;   /* number of those calls that were timed */
+  PetscLogDouble    time;    /* total time of the timed calls */
+  volatile long     samples; /* timer signals received while this path was innermost */
+};
+
+/* The nodes live in blocks that are never moved, so that the signal handler can follow callpathCurrent at any time */
+static PetscCallPathNode                 callpathBlocks[PETSC_CALLPATH_MAX_BLOCKS];
+static PetscInt                          callpathNumNodes = 0;
+static PetscCallPathNode                 callpathRoot     = NULL;
+static PetscInt64                        callpathEvery    = 1;   /* time every Nth call of a path */
+static PetscReal                         callpathInterval = 0.0; /* > 0 for timer signal sampling */
+static PetscInt64                        callpathDropped  = 0;   /* calls charged to their parent because the tree was full */
+
+/* The position in the call tree follows the nesting of events, so each thread keeps its own */
+  #if defined(PETSC_HAVE_THREADSAFETY)
+static PETSC_TLS PetscCallPathNode volatile callpathCurrent = NULL;
+static PETSC_TLS int                        callpathDepth   = 0;
+static PETSC_TLS PetscLogDouble             callpathStart[PETSC_CALLPATH_MAX_DEPTH];
+static PETSC_TLS PetscCallPathNode          callpathStack[PETSC_CALLPATH_MAX_DEPTH];
+  #else
+static PetscCallPathNode volatile callpathCurrent = NULL;
+static int                        callpathDepth   = 0;
+static PetscLogDouble             callpathStart[PETSC_CALLPATH_MAX_DEPTH];
+static PetscCallPathNode          callpathStack[PETSC_CALLPATH_MAX_DEPTH];
+  #endif
+static PetscErrorCode (*callpathPLB)(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject) = NULL;
+static PetscErrorCode (*callpathPLE)(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject) = NULL;
+
+  #if defined(PETSC_HAVE_CALLPATH_TIMER)
+static struct sigaction callpathOldAction;
+
+static void PetscLogCallPathSignalHandler_Private(int sig)
+{
+  PetscCallPathNode node = callpathCurrent;
+
+  (void)sig;
+  if (node) node->samples++;
+}
+  #endif
+
+static PetscErrorCode PetscLogCallPathGetChild_Private(PetscCallPathNode parent, PetscLogEvent event, PetscCallPathNode *child)
+{
+  PetscCallPathNode node;
+
+  PetscFunctionBegin;
+  for (node = parent->child; node; node = node->sibling)
+    if (node->event == event) break;
+  if (!node) {
+    PetscInt b = callpathNumNodes / PETSC_CALLPATH_BLOCK_SIZE;
+
+    if (b >= PETSC_CALLPATH_MAX_BLOCKS) {
+      /* far more call paths than anyone can read, charge new ones to their parent and report how many in the dump */
+      if (!callpathDropped) PetscCall(PetscInfo(NULL, "Call path tree is full, new call paths are charged to their parent\n"));
+      callpathDropped++;
+      *child = parent;
+      PetscFunctionReturn(0);
+    }
+    if (!callpathBlocks[b]) PetscCall(PetscCalloc1(PETSC_CALLPATH_BLOCK_SIZE, &callpathBlocks[b]));
+    node          = &callpathBlocks[b][callpathNumNodes % PETSC_CALLPATH_BLOCK_SIZE];
+    node->event   = event;
+    node->parent  = parent;
+    node->sibling = parent->child;
+    parent->child = node;
+    callpathNumNodes++;
+  }
+  *child = node;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscLogEventBeginCallPath(PetscLogEvent event, int t, PetscObject o1, PetscObject o2, PetscObject o3, PetscObject o4)
+{
+  PetscFunctionBegin;
+  if (callpathPLB) PetscCall((*callpathPLB)(event, t, o1, o2, o3, o4));
+  if (callpathDepth < PETSC_CALLPATH_MAX_DEPTH) {
+    PetscCallPathNode parent = callpathCurrent, node;
+    PetscBool         timed;
+
+    /* the tree is shared by the threads */
+    PetscCall(PetscSpinlockLock(&PetscLogSpinLock));
+    /* outermost events hang below a node for the current stage */
+    if (!callpathDepth) PetscCall(PetscLogCallPathGetChild_Private(callpathRoot, -1 - (petsc_stageLog ? petsc_stageLog->curStage : 0), &parent));
+    PetscCall(PetscLogCallPathGetChild_Private(parent, event, &node));
+    timed = (PetscBool)(callpathInterval <= 0.0 && node->count % callpathEvery == 0);
+    node->count++;
+    PetscCall(PetscSpinlockUnlock(&PetscLogSpinLock));
+    if (timed) PetscTime(&callpathStart[callpathDepth]);
+    else callpathStart[callpathDepth] = -1.0;
+    callpathStack[callpathDepth] = callpathCurrent;
+    callpathCurrent              = node;
+  }
+  callpathDepth++;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscLogEventEndCallPath(PetscLogEvent event, int t, PetscObject o1, PetscObject o2, PetscObject o3, PetscObject o4)
+{
+  PetscFunctionBegin;
+  if (callpathDepth > 0 && --callpathDepth < PETSC_CALLPATH_MAX_DEPTH) {
+    PetscCallPathNode node = callpathCurrent;
+
+    if (callpathStart[callpathDepth] >= 0.0) {
+      PetscLogDouble end;
+
+      PetscTime(&end);
+      PetscCall(PetscSpinlockLock(&PetscLogSpinLock));
+      node->time += end - callpathStart[callpathDepth];
+      node->timed++;
+      PetscCall(PetscSpinlockUnlock(&PetscLogSpinLock));
+    }
+    callpathCurrent = callpathStack[callpathDepth];
+  }
+  if (callpathPLE) PetscCall((*callpathPLE)(event, t, o1, o2, o3, o4));
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogCallPathBegin - Activates call path profiling. The nesting of PETSc events is recorded as a call tree with,
+  for each call path, the number of calls and the inclusive and exclusive time.
+
+  Logically Collective on `PETSC_COMM_WORLD`
+
+  Input Parameters:
++ every    - time only every `every`th call of each call path and extrapolate, or `PETSC_DEFAULT` to time all calls
+- interval - if positive, instead of timing calls sample the innermost call path every `interval` seconds of CPU time
+
+  Options Database Keys:
++ -log_callpath [filename]                   - Activates `PetscLogCallPathBegin()` and writes the call paths in `PetscFinalize()`, default file name is petsc_callpath.folded
+. -log_callpath_sample_every <every>         - time only every Nth call of each call path
+- -log_callpath_sample_interval <interval>   - sample with a profiling timer instead of timing calls
+
+  Level: intermediate
+
+  Notes:
+  With every equal to 1 each call costs two timer calls, less than the default logger used by -log_view which also
+  gathers flops and message counts. For events that are called millions of times a larger every, or a sampling
+  interval, bounds the overhead; the counts of calls remain exact in both cases.
+
+  The timer sampling uses `ITIMER_PROF` and `SIGPROF`, so it cannot be combined with other profilers using that
+  signal. Samples are charged to the innermost event, time outside any event is not sampled.
+
+  Any event logging already active, for example from -log_view, continues to be done.
+
+.seealso: [](ch_profiling), `PetscLogCallPathDump()`, `PetscLogNestedBegin()`, `PetscLogTimelineBegin()`, `PetscLogView()`
+@*/
+PetscErrorCode PetscLogCallPathBegin(PetscInt every, PetscReal interval)
+{
+  PetscFunctionBegin;
+  PetscCheck(!callpathRoot, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Call path logging has already been started");
+  if (every == PETSC_DEFAULT || every == PETSC_DECIDE) every = 1;
+  PetscCheck(every > 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Sampling every %" PetscInt_FMT " calls must be positive", every);
+  if (interval == (PetscReal)PETSC_DEFAULT) interval = 0.0;
+  PetscCall(PetscCalloc1(PETSC_CALLPATH_BLOCK_SIZE, &callpathBlocks[0]));
+  callpathRoot        = &callpathBlocks[0][0];
+  callpathRoot->event = -1;
+  callpathNumNodes    = 1;
+  callpathCurrent     = callpathRoot;
+  callpathDepth       = 0;
+  callpathEvery       = every;
+  callpathInterval    = interval;
+  callpathDropped     = 0;
+  callpathPLB         = PetscLogPLB;
+  callpathPLE         = PetscLogPLE;
+  if (interval > 0.0) {
+  #if defined(PETSC_HAVE_CALLPATH_TIMER)
+    struct sigaction action;
+    struct itimerval timer;
+
+    PetscCall(PetscMemzero(&action, sizeof(action)));
+    action.sa_handler = PetscLogCallPathSignalHandler_Private;
+    action.sa_flags   = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    PetscCheck(!sigaction(SIGPROF, &action, &callpathOldAction), PETSC_COMM_SELF, PETSC_ERR_SYS, "Unable to install the SIGPROF handler");
+    timer.it_interval.tv_sec  = (time_t)interval;
+    timer.it_interval.tv_usec = (suseconds_t)((interval - (PetscReal)timer.it_interval.tv_sec) * 1.e6);
+    if (!timer.it_interval.tv_sec && !timer.it_interval.tv_usec) timer.it_interval.tv_usec = 1;
+    timer.it_value = timer.it_interval;
+    PetscCheck(!setitimer(ITIMER_PROF, &timer, NULL), PETSC_COMM_SELF, PETSC_ERR_SYS, "Unable to start the profiling timer");
+  #else
+    SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "Timer based sampling requires setitimer() and sigaction()");
+  #endif
+  }
+  PetscCall(PetscLogSet(PetscLogEventBeginCallPath, PetscLogEventEndCallPath));
+  PetscFunctionReturn(0);
+}
+
+/* Stop the profiling timer, free the call tree and restore the handlers that were active before */
+PetscErrorCode PetscLogCallPathEnd(void)
+{
+  PetscFunctionBegin;
+  if (!callpathRoot) PetscFunctionReturn(0);
+  #if defined(PETSC_HAVE_CALLPATH_TIMER)
+  if (callpathInterval > 0.0) {
+    struct itimerval timer;
+
+    PetscCall(PetscMemzero(&timer, sizeof(timer)));
+    PetscCheck(!setitimer(ITIMER_PROF, &timer, NULL), PETSC_COMM_SELF, PETSC_ERR_SYS, "Unable to stop the profiling timer");
+    PetscCheck(!sigaction(SIGPROF, &callpathOldAction, NULL), PETSC_COMM_SELF, PETSC_ERR_SYS, "Unable to restore the SIGPROF handler");
+  }
+  #endif
+  if (PetscLogPLB == PetscLogEventBeginCallPath) PetscCall(PetscLogSet(callpathPLB, callpathPLE));
+  callpathCurrent = NULL;
+  callpathRoot    = NULL;
+  for (PetscInt b = 0; b < PETSC_CALLPATH_MAX_BLOCKS && callpathBlocks[b]; b++) PetscCall(PetscFree(callpathBlocks[b]));
+  callpathNumNodes = 0;
+  callpathPLB      = NULL;
+  callpathPLE      = NULL;
+  PetscFunctionReturn(0);
+}
+
+/* Estimated total time of all calls along the path */
+static PetscLogDouble PetscLogCallPathInclusive_Private(PetscCallPathNode node)
+{
+  return node->timed ? node->time * ((PetscLogDouble)node->count / (PetscLogDouble)node->timed) : 0.0;
+}
+
+static PetscErrorCode PetscLogCallPathWrite_Private(FILE *fd, PetscMPIInt rank, PetscEventRegLog eventRegLog, PetscStageLog stageLog, PetscCallPathNode node, char path[], size_t len)
+{
+  const char *name;
+  size_t      plen, nlen;
+
+  PetscFunctionBegin;
+  if (node->event < 0) {
+    int stage = -1 - node->event;
+
+    name = stage < stageLog->numStages ? stageLog->stageInfo[stage].name : "Unknown";
+  } else name = node->event < eventRegLog->numEvents ? eventRegLog->eventInfo[node->event].name : "Unknown";
+  PetscCall(PetscStrlen(path, &plen));
+  PetscCall(PetscStrlen(name, &nlen));
+  if (plen + nlen + 2 < len) {
+    if (plen) PetscCall(PetscStrcat(path, ";"));
+    PetscCall(PetscStrcat(path, name));
+  }
+  if (node->event >= 0) {
+    PetscLogDouble value;
+
+    if (callpathInterval > 0.0) value = (PetscLogDouble)node->samples;
+    else {
+      value = PetscLogCallPathInclusive_Private(node);
+      for (PetscCallPathNode c = node->child; c; c = c->sibling) value -= PetscLogCallPathInclusive_Private(c);
+      /* folded stacks take integral weights, use microseconds */
+      value = PetscMax(value, 0.0) * 1.e6;
+    }
+    if (value >= 0.5) PetscCall(PetscSynchronizedFPrintf(PETSC_COMM_WORLD, fd, "Rank %d;%s %.0f\n", rank, path, value));
+  }
+  for (PetscCallPathNode c = node->child; c; c = c->sibling) PetscCall(PetscLogCallPathWrite_Private(fd, rank, eventRegLog, stageLog, c, path, len));
+  path[plen] = 0;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogCallPathDump - Writes the call paths recorded since `PetscLogCallPathBegin()` on all ranks in the folded stack
+  format used by flame graph tools.
+
+  Collective on `PETSC_COMM_WORLD`
+
+  Input Parameter:
+. filename - the name of the file, or NULL for petsc_callpath.folded
+
+  Options Database Key:
+. -log_callpath [filename] - calls this routine in `PetscFinalize()`
+
+  Level: intermediate
+
+  Notes:
+  Each line is `Rank r;stage;event;...;event weight` where the weight is the exclusive time in microseconds of that
+  call path, or the number of timer samples when sampling with an interval. The file can be given directly to
+  flamegraph.pl or speedscope; remove the leading rank frame, for example with sed, to merge the ranks.
+
+  The inclusive time of a call path is the sum of the weights of the lines that begin with it.
+
+  The call tree holds about a million call paths per rank; calls on call paths beyond that are charged to their parent
+  and a warning gives their number.
+
+.seealso: [](ch_profiling), `PetscLogCallPathBegin()`, `PetscLogView()`, `PetscLogTimelineDump()`
+@*/
+PetscErrorCode PetscLogCallPathDump(const char filename[])
+{
+  FILE            *fd = NULL;
+  PetscMPIInt      rank;
+  PetscStageLog    stageLog;
+  PetscEventRegLog eventRegLog;
+  char             path[4096];
+  PetscInt64       dropped;
+
+  PetscFunctionBegin;
+  PetscCheck(callpathRoot, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Call path logging has not been started, call PetscLogCallPathBegin()");
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCall(PetscLogGetStageLog(&stageLog));
+  PetscCall(PetscStageLogGetEventRegLog(stageLog, &eventRegLog));
+  PetscCall(MPIU_Allreduce(&callpathDropped, &dropped, 1, MPIU_INT64, MPI_SUM, PETSC_COMM_WORLD));
+  if (dropped) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "WARNING: the call path tree was full, %" PetscInt64_FMT " calls on new call paths were charged to their parent call paths in %s\n", dropped, filename ? filename : "petsc_callpath.folded"));
+  PetscCall(PetscFOpen(PETSC_COMM_WORLD, filename ? filename : "petsc_callpath.folded", "w", &fd));
+  path[0] = 0;
+  for (PetscCallPathNode c = callpathRoot->child; c; c = c->sibling) PetscCall(PetscLogCallPathWrite_Private(fd, rank, eventRegLog, stageLog, c, path, sizeof(path)));
+  PetscCall(PetscSynchronizedFlush(PETSC_COMM_WORLD, fd));
+  PetscCall(PetscFClose(PETSC_COMM_WORLD, fd));
+  PetscFunctionReturn(0);
+}
+
+#endif /* PETSC_USE_LOG */
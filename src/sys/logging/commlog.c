@@ -0,0 +1,405 @@
+/*
+     Logging of the rank-to-rank communication matrix and of message size histograms of each stage and event.
+
+   Every logged send adds its size to the (destination rank) entry of the record of the current stage and event and
+   to a histogram of message sizes; reductions have no destination and only go into a second histogram. Nothing is
+   communicated until PetscLogCommDump() is called (normally from PetscFinalize()).
+*/
+#include <petsclog.h> /*I "petsclog.h" I*/
+#include <petsc/private/logimpl.h>
+#include <petsc/private/hashmapi.h>
+#include <petsc/private/hashmapij.h>
+
+#if defined(PETSC_USE_LOG)
+
+PetscBool PetscLogCommOn = PETSC_FALSE;
+
+typedef struct {
+  int             stage;
+  PetscLogEvent   event;
+  PetscLogDouble  hist[2][PETSC_LOG_COMM_BINS]; /* number of point-to-point messages and of reductions of each size */
+  PetscHMapI      destMap;                      /* destination rank in PETSC_COMM_WORLD -> position in dest[] */
+  PetscInt        npairs, maxpairs;
+  PetscMPIInt    *dest;
+  PetscLogDouble *messages, *bytes;
+} PetscLogCommRecord;
+
+static PetscLogCommRecord *commRecords     = NULL;
+static PetscInt            commNumRecords  = 0, commMaxRecords = 0;
+static PetscHMapIJ         commRecordMap   = NULL;               /* (stage, event) -> position in commRecords[] */
+static PetscMPIInt         commRanksKeyval = MPI_KEYVAL_INVALID; /* caches on each communicator the PETSC_COMM_WORLD rank of its ranks */
+
+/* The tables are allocated with malloc() since those on communicators that outlive PetscFinalize() are freed by MPI */
+static PetscMPIInt MPIAPI PetscLogComm_Ranks_Delete_Fn(MPI_Comm comm, PetscMPIInt keyval, void *val, void *extra_state)
+{
+  free(val);
+  return MPI_SUCCESS;
+}
+
+/* The PETSC_COMM_WORLD rank of every rank of comm, computed once per communicator */
+static PetscErrorCode PetscLogCommGetWorldRanks_Private(MPI_Comm comm, const PetscMPIInt **worldranks)
+{
+  PetscMPIInt *ranks, iflg;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_get_attr(comm, commRanksKeyval, &ranks, &iflg));
+  if (!iflg) {
+    MPI_Group    group = MPI_GROUP_NULL, worldgroup;
+    PetscMPIInt  size, inter, *local;
+
+    /* the destination of a send on an intercommunicator is a rank of the remote group */
+    PetscCallMPI(MPI_Comm_test_inter(comm, &inter));
+    if (inter) {
+      PetscCallMPI(MPI_Comm_remote_size(comm, &size));
+      PetscCallMPI(MPI_Comm_remote_group(comm, &group));
+    } else {
+      PetscCallMPI(MPI_Comm_size(comm, &size));
+      PetscCallMPI(MPI_Comm_group(comm, &group));
+    }
+    PetscCallMPI(MPI_Comm_group(PETSC_COMM_WORLD, &worldgroup));
+    ranks = (PetscMPIInt *)malloc((size_t)size * sizeof(PetscMPIInt));
+    PetscCheck(ranks, PETSC_COMM_SELF, PETSC_ERR_MEM, "Unable to allocate the rank table of a communicator");
+    PetscCall(PetscMalloc1(size, &local));
+    for (PetscMPIInt p = 0; p < size; p++) local[p] = p;
+    PetscCallMPI(MPI_Group_translate_ranks(group, size, local, worldgroup, ranks));
+    PetscCall(PetscFree(local));
+    PetscCallMPI(MPI_Group_free(&group));
+    PetscCallMPI(MPI_Group_free(&worldgroup));
+    PetscCallMPI(MPI_Comm_set_attr(comm, commRanksKeyval, ranks));
+  }
+  *worldranks = ranks;
+  PetscFunctionReturn(0);
+}
+
+/* Bin 0 counts empty messages, bin b > 0 the messages of [2^(b-1), 2^b) bytes, the last bin also all larger ones */
+static inline int PetscLogCommBin_Private(PetscLogDouble bytes)
+{
+  int bin = 0;
+
+  for (PetscInt64 n = (PetscInt64)bytes; n > 0 && bin < PETSC_LOG_COMM_BINS - 1; n >>= 1) bin++;
+  return bin;
+}
+
+/* The record of the current stage and event, created on first use */
+static PetscErrorCode PetscLogCommGetRecord_Private(PetscLogCommRecord **record)
+{
+  PetscHashIJKey key;
+  PetscLogEvent  event;
+  int            stage = -1;
+  PetscInt       r;
+
+  PetscFunctionBegin;
+  if (petsc_stageLog) PetscCall(PetscStageLogGetCurrent(petsc_stageLog, &stage));
+  PetscCall(PetscLogGetCurrentEvent_Internal(&event));
+  key.i = stage;
+  key.j = event;
+  PetscCall(PetscHMapIJGet(commRecordMap, key, &r));
+  if (r < 0) {
+    if (commNumRecords == commMaxRecords) {
+      PetscLogCommRecord *tmp;
+
+      commMaxRecords = PetscMax(16, 2 * commMaxRecords);
+      PetscCall(PetscCalloc1(commMaxRecords, &tmp));
+      PetscCall(PetscArraycpy(tmp, commRecords, commNumRecords));
+      PetscCall(PetscFree(commRecords));
+      commRecords = tmp;
+    }
+    r                   = commNumRecords++;
+    commRecords[r].stage = stage;
+    commRecords[r].event = event;
+    PetscCall(PetscHMapICreate(&commRecords[r].destMap));
+    PetscCall(PetscHMapIJSet(commRecordMap, key, r));
+  }
+  *record = &commRecords[r];
+  PetscFunctionReturn(0);
+}
+
+/* Called by the logging MPI_Send() and MPI_Isend() macros and by PetscSF for each message sent */
+PetscErrorCode PetscLogCommSend_Internal(MPI_Comm comm, PetscMPIInt dest, PetscCount count, MPI_Datatype type)
+{
+  PetscLogCommRecord *rec;
+  const PetscMPIInt  *worldranks;
+  PetscMPIInt         typesize;
+  PetscLogDouble      bytes;
+  PetscInt            p;
+
+  PetscFunctionBegin;
+  if (!PetscLogCommOn || dest == MPI_PROC_NULL || type == MPI_DATATYPE_NULL) PetscFunctionReturn(0);
+  PetscCallMPI(MPI_Type_size(type, &typesize));
+  bytes = (PetscLogDouble)count * typesize;
+  PetscCall(PetscSpinlockLock(&PetscLogSpinLock));
+  PetscCall(PetscLogCommGetWorldRanks_Private(comm, &worldranks));
+  PetscCall(PetscLogCommGetRecord_Private(&rec));
+  rec->hist[0][PetscLogCommBin_Private(bytes)] += 1.0;
+  PetscCall(PetscHMapIGet(rec->destMap, worldranks[dest], &p));
+  if (p < 0) {
+    if (rec->npairs == rec->maxpairs) {
+      PetscMPIInt    *d;
+      PetscLogDouble *m, *b;
+
+      rec->maxpairs = PetscMax(8, 2 * rec->maxpairs);
+      PetscCall(PetscMalloc3(rec->maxpairs, &d, rec->maxpairs, &m, rec->maxpairs, &b));
+      PetscCall(PetscArraycpy(d, rec->dest, rec->npairs));
+      PetscCall(PetscArraycpy(m, rec->messages, rec->npairs));
+      PetscCall(PetscArraycpy(b, rec->bytes, rec->npairs));
+      PetscCall(PetscFree3(rec->dest, rec->messages, rec->bytes));
+      rec->dest     = d;
+      rec->messages = m;
+      rec->bytes    = b;
+    }
+    p                = rec->npairs++;
+    rec->dest[p]     = worldranks[dest];
+    rec->messages[p] = 0.0;
+    rec->bytes[p]    = 0.0;
+    PetscCall(PetscHMapISet(rec->destMap, worldranks[dest], p));
+  }
+  rec->messages[p] += 1.0;
+  rec->bytes[p] += bytes;
+  PetscCall(PetscSpinlockUnlock(&PetscLogSpinLock));
+  PetscFunctionReturn(0);
+}
+
+/* Called by the logging MPI_Allreduce(), MPI_Bcast() and MPI_Reduce_scatter_block() macros */
+PetscErrorCode PetscLogCommCollective_Internal(MPI_Comm comm, PetscCount count, MPI_Datatype type)
+{
+  PetscLogCommRecord *rec;
+  PetscMPIInt         typesize, size;
+
+  PetscFunctionBegin;
+  if (!PetscLogCommOn || type == MPI_DATATYPE_NULL) PetscFunctionReturn(0);
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  if (size == 1) PetscFunctionReturn(0);
+  PetscCallMPI(MPI_Type_size(type, &typesize));
+  PetscCall(PetscSpinlockLock(&PetscLogSpinLock));
+  PetscCall(PetscLogCommGetRecord_Private(&rec));
+  rec->hist[1][PetscLogCommBin_Private((PetscLogDouble)count * typesize)] += 1.0;
+  PetscCall(PetscSpinlockUnlock(&PetscLogSpinLock));
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogCommBegin - Turns on the logging of the number and size of the messages sent to each rank, and of histograms
+  of message sizes, for each stage and event. The data is saved with `PetscLogCommDump()`.
+
+  Logically Collective on `PETSC_COMM_WORLD`
+
+  Options Database Key:
+. -log_comm [filename] - turns on the logging and saves it in `PetscFinalize()`
+
+  Level: advanced
+
+  Notes:
+  The messages logged are those sent with `MPI_Send()` and `MPI_Isend()` from PETSc source code, which includes the
+  `MatAssemblyBegin()` stash, and those sent by `PETSCSFBASIC`, which does the communication of `VecScatter` and
+  `PetscSF` by default. Reductions with `MPI_Allreduce()`, `MPI_Bcast()` and `MPI_Reduce_scatter_block()` have no
+  destination, only their sizes are logged in a separate histogram.
+
+  Messages are attributed to the innermost event being logged when they are sent; the default logger is started with
+  `PetscLogDefaultBegin()` if no logging is active, since it keeps track of the current event.
+
+  Each message costs a hash table lookup, this logging is meant for studying the communication pattern of a run, not
+  for timing it.
+
+.seealso: [](ch_profiling), `PetscLogCommDump()`, `PetscLogDefaultBegin()`, `PetscLogView()`, `PetscSFView()`
+@*/
+PetscErrorCode PetscLogCommBegin(void)
+{
+  PetscFunctionBegin;
+  if (PetscLogCommOn) PetscFunctionReturn(0);
+  if (!PetscLogPLB) PetscCall(PetscLogDefaultBegin());
+  PetscCallMPI(MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, PetscLogComm_Ranks_Delete_Fn, &commRanksKeyval, NULL));
+  PetscCall(PetscHMapIJCreate(&commRecordMap));
+  PetscLogCommOn = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* Free the records of the communication logging */
+PetscErrorCode PetscLogCommEnd(void)
+{
+  PetscFunctionBegin;
+  if (!PetscLogCommOn) PetscFunctionReturn(0);
+  for (PetscInt r = 0; r < commNumRecords; r++) {
+    PetscCall(PetscHMapIDestroy(&commRecords[r].destMap));
+    PetscCall(PetscFree3(commRecords[r].dest, commRecords[r].messages, commRecords[r].bytes));
+  }
+  PetscCall(PetscFree(commRecords));
+  commNumRecords = commMaxRecords = 0;
+  PetscCall(PetscHMapIJDestroy(&commRecordMap));
+  PetscCallMPI(MPI_Comm_free_keyval(&commRanksKeyval));
+  PetscLogCommOn = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/* Flattens the records of this rank in the order they are written: the integers and the doubles are kept apart */
+static PetscErrorCode PetscLogCommPack_Private(PetscInt64 counts[2], PetscInt64 **ints, PetscLogDouble **doubles)
+{
+  PetscInt64     *ip;
+  PetscLogDouble *dp;
+
+  PetscFunctionBegin;
+  counts[0] = 1;
+  counts[1] = 0;
+  for (PetscInt r = 0; r < commNumRecords; r++) {
+    counts[0] += 3 + commRecords[r].npairs;
+    counts[1] += 2 * PETSC_LOG_COMM_BINS + 2 * commRecords[r].npairs;
+  }
+  PetscCall(PetscMalloc2(counts[0], ints, counts[1], doubles));
+  ip    = *ints;
+  dp    = *doubles;
+  *ip++ = commNumRecords;
+  for (PetscInt r = 0; r < commNumRecords; r++) {
+    const PetscLogCommRecord *rec = &commRecords[r];
+
+    *ip++ = rec->stage;
+    *ip++ = rec->event;
+    *ip++ = rec->npairs;
+    for (PetscInt p = 0; p < rec->npairs; p++) *ip++ = rec->dest[p];
+    PetscCall(PetscArraycpy(dp, &rec->hist[0][0], 2 * PETSC_LOG_COMM_BINS));
+    dp += 2 * PETSC_LOG_COMM_BINS;
+    PetscCall(PetscArraycpy(dp, rec->messages, rec->npairs));
+    dp += rec->npairs;
+    PetscCall(PetscArraycpy(dp, rec->bytes, rec->npairs));
+    dp += rec->npairs;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscLogCommWriteRank_Private(int fd, const PetscInt64 ints[], const PetscLogDouble doubles[])
+{
+  const PetscInt64     *ip = ints + 1;
+  const PetscLogDouble *dp = doubles;
+
+  PetscFunctionBegin;
+  PetscCall(PetscBinaryWrite(fd, ints, 1, PETSC_INT64));
+  for (PetscInt64 r = 0; r < ints[0]; r++) {
+    PetscInt npairs;
+
+    PetscCall(PetscIntCast(ip[2], &npairs));
+    PetscCall(PetscBinaryWrite(fd, ip, 3, PETSC_INT64));
+    PetscCall(PetscBinaryWrite(fd, dp, 2 * PETSC_LOG_COMM_BINS, PETSC_DOUBLE));
+    PetscCall(PetscBinaryWrite(fd, ip + 3, npairs, PETSC_INT64));
+    PetscCall(PetscBinaryWrite(fd, dp + 2 * PETSC_LOG_COMM_BINS, 2 * npairs, PETSC_DOUBLE));
+    ip += 3 + npairs;
+    dp += 2 * PETSC_LOG_COMM_BINS + 2 * npairs;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscLogCommWriteName_Private(int fd, const char name[])
+{
+  size_t     len;
+  PetscInt64 len64;
+
+  PetscFunctionBegin;
+  PetscCall(PetscStrlen(name, &len));
+  len64 = (PetscInt64)len;
+  PetscCall(PetscBinaryWrite(fd, &len64, 1, PETSC_INT64));
+  PetscCall(PetscBinaryWrite(fd, name, (PetscInt)len, PETSC_CHAR));
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogCommDump - Writes the communication logged since `PetscLogCommBegin()` on all ranks to a single binary file.
+
+  Collective on `PETSC_COMM_WORLD`
+
+  Input Parameter:
+. filename - the name of the file, or NULL for petsc_comm.bin
+
+  Options Database Key:
+. -log_comm [filename] - calls this routine in `PetscFinalize()`
+
+  Level: advanced
+
+  Notes:
+  The file is written with `PetscBinaryWrite()`, thus in big-endian byte order, as
+.vb
+    int64  PETSC_LOG_COMM_FILE_CLASSID, number of ranks, number of histogram bins nb, number of stages
+    for each stage:   int64 length, char name[length]
+    int64  number of events
+    for each event:   int64 length, char name[length]
+    for each rank:
+      int64 number of records
+      for each record:
+        int64  stage, event, number of destination ranks np
+        double histogram of point-to-point messages sent[nb], histogram of reductions[nb]
+        int64  destination rank in PETSC_COMM_WORLD[np]
+        double messages sent to each destination[np], bytes sent to each destination[np]
+.ve
+  Bin 0 of the histograms counts empty messages, bin b > 0 the messages of 2^(b-1) to 2^b - 1 bytes, and the last bin
+  all messages at least that large. An event of -1 stands for messages sent outside of any event.
+
+  Summing the bytes of all records of a rank gives its row of the communication matrix, which is what
+  partitioners and rank reordering tools take as input.
+
+  Rank 0 collects the records from one rank at a time and writes them. Event and stage names are those of rank 0.
+
+.seealso: [](ch_profiling), `PetscLogCommBegin()`, `PetscBinaryRead()`, `PetscLogView()`
+@*/
+PetscErrorCode PetscLogCommDump(const char filename[])
+{
+  MPI_Comm        comm;
+  PetscMPIInt     rank, size, tag;
+  PetscInt64      counts[2];
+  PetscInt64     *ints    = NULL;
+  PetscLogDouble *doubles = NULL;
+
+  PetscFunctionBegin;
+  PetscCheck(PetscLogCommOn, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Communication logging has not been started, call PetscLogCommBegin()");
+  /* the messages sent to collect the records are not part of the run being studied */
+  PetscLogCommOn = PETSC_FALSE;
+  PetscCall(PetscCommDuplicate(PETSC_COMM_WORLD, &comm, &tag));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCall(PetscLogCommPack_Private(counts, &ints, &doubles));
+  if (rank == 0) {
+    PetscStageLog    stageLog;
+    PetscEventRegLog eventRegLog;
+    PetscInt64       header[4];
+    int              fd;
+
+    PetscCall(PetscLogGetStageLog(&stageLog));
+    PetscCall(PetscStageLogGetEventRegLog(stageLog, &eventRegLog));
+    PetscCall(PetscBinaryOpen(filename ? filename : "petsc_comm.bin", FILE_MODE_WRITE, &fd));
+    header[0] = PETSC_LOG_COMM_FILE_CLASSID;
+    header[1] = size;
+    header[2] = PETSC_LOG_COMM_BINS;
+    header[3] = stageLog->numStages;
+    PetscCall(PetscBinaryWrite(fd, header, 4, PETSC_INT64));
+    for (int s = 0; s < stageLog->numStages; s++) PetscCall(PetscLogCommWriteName_Private(fd, stageLog->stageInfo[s].name));
+    header[0] = eventRegLog->numEvents;
+    PetscCall(PetscBinaryWrite(fd, header, 1, PETSC_INT64));
+    for (int e = 0; e < eventRegLog->numEvents; e++) PetscCall(PetscLogCommWriteName_Private(fd, eventRegLog->eventInfo[e].name));
+    PetscCall(PetscLogCommWriteRank_Private(fd, ints, doubles));
+    for (PetscMPIInt r = 1; r < size; r++) {
+      PetscMPIInt nints, ndoubles;
+
+      PetscCall(PetscFree2(ints, doubles));
+      /* let rank r send, so that rank 0 does not have to buffer the records of all ranks at once */
+      PetscCallMPI(MPI_Send(NULL, 0, MPI_INT, r, tag, comm));
+      PetscCallMPI(MPI_Recv(counts, 2, MPIU_INT64, r, tag, comm, MPI_STATUS_IGNORE));
+      PetscCall(PetscMPIIntCast(counts[0], &nints));
+      PetscCall(PetscMPIIntCast(counts[1], &ndoubles));
+      PetscCall(PetscMalloc2(nints, &ints, ndoubles, &doubles));
+      PetscCallMPI(MPI_Recv(ints, nints, MPIU_INT64, r, tag, comm, MPI_STATUS_IGNORE));
+      PetscCallMPI(MPI_Recv(doubles, ndoubles, MPIU_PETSCLOGDOUBLE, r, tag, comm, MPI_STATUS_IGNORE));
+      PetscCall(PetscLogCommWriteRank_Private(fd, ints, doubles));
+    }
+    PetscCall(PetscBinaryClose(fd));
+  } else {
+    PetscMPIInt nints, ndoubles;
+
+    PetscCall(PetscMPIIntCast(counts[0], &nints));
+    PetscCall(PetscMPIIntCast(counts[1], &ndoubles));
+    PetscCallMPI(MPI_Recv(NULL, 0, MPI_INT, 0, tag, comm, MPI_STATUS_IGNORE));
+    PetscCallMPI(MPI_Send(counts, 2, MPIU_INT64, 0, tag, comm));
+    PetscCallMPI(MPI_Send(ints, nints, MPIU_INT64, 0, tag, comm));
+    PetscCallMPI(MPI_Send(doubles, ndoubles, MPIU_PETSCLOGDOUBLE, 0, tag, comm));
+  }
+  PetscCall(PetscFree2(ints, doubles));
+  PetscCall(PetscCommDestroy(&comm));
+  PetscLogCommOn = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+#endif /* PETSC_USE_LOG */
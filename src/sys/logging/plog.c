@@ -215,6 +215,10 @@ PETSC_INTERN PetscErrorCode PetscLogFinalize(void)
   PetscCall(PetscFree(petsc_actions));
   PetscCall(PetscFree(petsc_objects));
   PetscCall(PetscLogNestedEnd());
+  PetscCall(PetscLogCallPathEnd());
+  PetscCall(PetscLogHWCountersEnd());
+  PetscCall(PetscLogCommEnd());
+  PetscCall(PetscLogTimelineEnd());
   PetscCall(PetscLogSet(NULL, NULL));
 
   /* Resetting phase */
@@ -1625,6 +1629,9 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
   PetscLogDouble      fracStageTime, fracStageFlops, fracStageMess, fracStageMessLen, fracStageRed;
   PetscLogDouble      min, max, tot, ratio, avg, x, y;
   PetscLogDouble      minf, maxf, totf, ratf, mint, maxt, tott, ratt, ratC, totm, totml, totr, mal, malmax, emalmax;
+  PetscLogDouble      hw[PETSC_LOG_HW_NUM_COUNTERS], hwBytes, streamBandwidth = 0.0;
+  PetscBool           hwAvailable[PETSC_LOG_HW_NUM_COUNTERS];
+  PetscMPIInt         hwLocal[PETSC_LOG_HW_NUM_COUNTERS], hwAll[PETSC_LOG_HW_NUM_COUNTERS];
   #if defined(PETSC_HAVE_DEVICE)
   PetscLogEvent  KSP_Solve, SNES_Solve, TS_Step, TAO_Solve; /* These need to be fixed to be some events registered with certain objects */
   PetscLogDouble cct, gct, csz, gsz, gmaxt, gflops, gflopr, fracgflops;
@@ -1854,6 +1861,21 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
     PetscCall(PetscFPrintf(comm, fd, "   MMalloc Mbytes: Increase in high water mark of allocated memory (sum over all calls to event). Never negative\n"));
     PetscCall(PetscFPrintf(comm, fd, "   RMI Mbytes: Increase in resident memory (sum over all calls to event)\n"));
   }
+  if (PetscLogHWCounters) {
+    PetscReal bw = 0.0;
+
+    /* the same on all processes, needed to decide on the layout of the table */
+    PetscCall(PetscLogHWCountersGetAvailable_Internal(hwAvailable));
+    for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) hwLocal[i] = hwAvailable[i];
+    PetscCallMPI(MPI_Allreduce(hwLocal, hwAll, PETSC_LOG_HW_NUM_COUNTERS, MPI_INT, MPI_MIN, comm));
+    PetscCall(PetscOptionsGetReal(NULL, NULL, "-log_view_stream_bandwidth", &bw, NULL));
+    streamBandwidth = (PetscLogDouble)bw;
+    PetscCall(PetscFPrintf(comm, fd, "   IPC: instructions per cycle (sum over all processors), - if the counters are not available\n"));
+    PetscCall(PetscFPrintf(comm, fd, "   LLCMiss: last level cache misses (sum over all processors)\n"));
+    PetscCall(PetscFPrintf(comm, fd, "   eGB/s: 10e-9 * (cache misses * %d bytes summed over all processors)/(max time over all processors), estimated cache miss traffic, not DRAM traffic\n", PETSC_LOG_HW_CACHE_LINE));
+    PetscCall(PetscFPrintf(comm, fd, "   eF/B: flop per byte of the estimated cache miss traffic\n"));
+    if (streamBandwidth > 0.0) PetscCall(PetscFPrintf(comm, fd, "   %%S: estimated cache miss traffic in percent of the memory bandwidth %.0f MB/s given with -log_view_stream_bandwidth\n", streamBandwidth));
+  }
   #if defined(PETSC_HAVE_DEVICE)
   PetscCall(PetscFPrintf(comm, fd, "   GPU Mflop/s: 10e-6 * (sum of flop on GPU over all processors)/(max GPU time over all processors)\n"));
   PetscCall(PetscFPrintf(comm, fd, "   CpuToGpu Count: total number of CPU to GPU copies per processor\n"));
@@ -1869,18 +1891,21 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
   /* Report events */
   PetscCall(PetscFPrintf(comm, fd, "Event                Count      Time (sec)     Flop                              --- Global ---  --- Stage ----  Total"));
   if (PetscLogMemory) PetscCall(PetscFPrintf(comm, fd, "  Malloc EMalloc MMalloc RMI"));
+  if (PetscLogHWCounters) PetscCall(PetscFPrintf(comm, fd, "  --- Hardware Counters ---%s", streamBandwidth > 0.0 ? "----" : ""));
   #if defined(PETSC_HAVE_DEVICE)
   PetscCall(PetscFPrintf(comm, fd, "   GPU    - CpuToGpu -   - GpuToCpu - GPU"));
   #endif
   PetscCall(PetscFPrintf(comm, fd, "\n"));
   PetscCall(PetscFPrintf(comm, fd, "                   Max Ratio  Max     Ratio   Max  Ratio  Mess   AvgLen  Reduct  %%T %%F %%M %%L %%R  %%T %%F %%M %%L %%R Mflop/s"));
   if (PetscLogMemory) PetscCall(PetscFPrintf(comm, fd, " Mbytes Mbytes Mbytes Mbytes"));
+  if (PetscLogHWCounters) PetscCall(PetscFPrintf(comm, fd, "  IPC  LLCMiss  eGB/s  eF/B%s", streamBandwidth > 0.0 ? "  %S" : ""));
   #if defined(PETSC_HAVE_DEVICE)
   PetscCall(PetscFPrintf(comm, fd, " Mflop/s Count   Size   Count   Size  %%F"));
   #endif
   PetscCall(PetscFPrintf(comm, fd, "\n"));
   PetscCall(PetscFPrintf(comm, fd, "------------------------------------------------------------------------------------------------------------------------"));
   if (PetscLogMemory) PetscCall(PetscFPrintf(comm, fd, "-----------------------------"));
+  if (PetscLogHWCounters) PetscCall(PetscFPrintf(comm, fd, "--------------------------%s", streamBandwidth > 0.0 ? "----" : ""));
   #if defined(PETSC_HAVE_DEVICE)
   PetscCall(PetscFPrintf(comm, fd, "---------------------------------------"));
   #endif
@@ -1952,6 +1977,7 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
           PetscCallMPI(MPI_Allreduce(&eventInfo[event].mallocIncrease, &malmax, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
           PetscCallMPI(MPI_Allreduce(&eventInfo[event].mallocIncreaseEvent, &emalmax, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
         }
+        if (PetscLogHWCounters) PetscCallMPI(MPI_Allreduce(eventInfo[event].hwCounters, hw, PETSC_LOG_HW_NUM_COUNTERS, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
   #if defined(PETSC_HAVE_DEVICE)
         PetscCallMPI(MPI_Allreduce(&eventInfo[event].CpuToGpuCount, &cct, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
         PetscCallMPI(MPI_Allreduce(&eventInfo[event].GpuToCpuCount, &gct, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
@@ -1980,6 +2006,10 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
           PetscCallMPI(MPI_Allreduce(&zero, &malmax, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
           PetscCallMPI(MPI_Allreduce(&zero, &emalmax, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
         }
+        if (PetscLogHWCounters) {
+          for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) hw[i] = 0.0;
+          PetscCallMPI(MPI_Allreduce(MPI_IN_PLACE, hw, PETSC_LOG_HW_NUM_COUNTERS, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
+        }
   #if defined(PETSC_HAVE_DEVICE)
         PetscCallMPI(MPI_Allreduce(&zero, &cct, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
         PetscCallMPI(MPI_Allreduce(&zero, &gct, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
@@ -2046,6 +2076,18 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
         else
           PetscCall(PetscFPrintf(comm, fd, "%-16s %7d %3.1f %5.4e %3.1f %3.2e %3.1f %2.1e %2.1e %2.1e %2.0f %2.0f %2.0f %2.0f %2.0f %3.0f %2.0f %2.0f %2.0f %2.0f %5.0f", name, maxC, ratC, maxt, ratt, maxf, ratf, totm, totml, totr, 100.0 * fracTime, 100.0 * fracFlops, 100.0 * fracMess, 100.0 * fracMessLen, 100.0 * fracRed, 100.0 * fracStageTime, 100.0 * fracStageFlops, 100.0 * fracStageMess, 100.0 * fracStageMessLen, 100.0 * fracStageRed, PetscAbs(flopr) / 1.0e6));
         if (PetscLogMemory) PetscCall(PetscFPrintf(comm, fd, " %5.0f   %5.0f   %5.0f   %5.0f", mal / 1.0e6, emalmax / 1.0e6, malmax / 1.0e6, mem / 1.0e6));
+        if (PetscLogHWCounters) {
+          if (hwAll[0] && hwAll[1] && hw[0] > 0.0) PetscCall(PetscFPrintf(comm, fd, " %4.2f", hw[1] / hw[0]));
+          else PetscCall(PetscFPrintf(comm, fd, "    -"));
+          if (hwAll[PETSC_LOG_HW_LLC_MISSES]) {
+            hwBytes = hw[PETSC_LOG_HW_LLC_MISSES] * PETSC_LOG_HW_CACHE_LINE;
+            PetscCall(PetscFPrintf(comm, fd, " %8.2e %6.1f %5.2f", hw[PETSC_LOG_HW_LLC_MISSES], maxt > 0.0 ? hwBytes / (1.0e9 * maxt) : 0.0, hwBytes > 0.0 ? totf / hwBytes : 0.0));
+            if (streamBandwidth > 0.0) PetscCall(PetscFPrintf(comm, fd, " %3.0f", maxt > 0.0 ? 100.0 * hwBytes / (1.0e6 * maxt * streamBandwidth) : 0.0));
+          } else {
+            PetscCall(PetscFPrintf(comm, fd, "        -      -     -"));
+            if (streamBandwidth > 0.0) PetscCall(PetscFPrintf(comm, fd, "   -"));
+          }
+        }
   #if defined(PETSC_HAVE_DEVICE)
         if (totf != 0.0) fracgflops = gflops / totf;
         else fracgflops = 0.0;
@@ -2061,6 +2103,7 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
   /* Memory usage and object creation */
   PetscCall(PetscFPrintf(comm, fd, "------------------------------------------------------------------------------------------------------------------------"));
   if (PetscLogMemory) PetscCall(PetscFPrintf(comm, fd, "-----------------------------"));
+  if (PetscLogHWCounters) PetscCall(PetscFPrintf(comm, fd, "--------------------------%s", streamBandwidth > 0.0 ? "----" : ""));
   #if defined(PETSC_HAVE_DEVICE)
   PetscCall(PetscFPrintf(comm, fd, "---------------------------------------"));
   #endif
@@ -2191,6 +2234,8 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
 .  -log_view :filename.txt:ascii_flamegraph - Saves logging information in a format suitable for visualising as a Flame Graph (see below for how to view it)
 .  -log_view_memory - Also display memory usage in each event
 .  -log_view_gpu_time - Also display time in each event for GPU kernels (Note this may slow the computation)
+.  -log_view_hw_counters - Also display hardware counters, memory bandwidth and arithmetic intensity of each event, see `PetscLogHWCountersBegin()`
+.  -log_view_stream_bandwidth <MB/s> - Memory bandwidth of all the processes, for example from make streams, to compare the bandwidth of each event with
 .  -log_all - Saves a file Log.rank for each MPI rank with details of each step of the computation
 -  -log_trace [filename] - Displays a trace of what each process is doing
 
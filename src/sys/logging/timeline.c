@@ -0,0 +1,315 @@
+/*
+     Timeline logging of PETSc events, written in the Chrome trace event format.
+
+   Every PetscLogEventBegin()/PetscLogEventEnd() pair is recorded as one complete event into a
+   fixed size per-rank ring buffer; nothing is communicated until PetscLogTimelineDump() is called
+   (normally from PetscFinalize()), so the cost per event is two timer calls and a few stores.
+*/
+#include <petsclog.h> /*I "petsclog.h" I*/
+#include <petsc/private/logimpl.h>
+#include <petsctime.h>
+
+#if defined(PETSC_USE_LOG)
+
+  #define PETSC_TIMELINE_MAX_DEPTH 64
+
+typedef struct {
+  PetscLogDouble start;      /* time the event began, relative to the timeline base time */
+  PetscLogDouble duration;   /* wall clock time spent in the event */
+  PetscLogDouble flops;      /* flops logged inside the event */
+  PetscLogDouble messages;   /* point-to-point messages sent and received inside the event */
+  PetscLogDouble length;     /* bytes in those messages */
+  PetscLogDouble reductions; /* global reductions inside the event */
+  PetscLogEvent  event;
+  int            stage;
+  int            tid;
+  int            depth; /* nesting level of the event among the events being timed */
+} PetscTimelineRecord;
+
+typedef struct {
+  PetscLogDouble start, flops, messages, length, reductions;
+} PetscTimelineFrame;
+
+static PetscTimelineRecord *timelineRecords  = NULL;
+static PetscInt             timelineSize     = 0; /* capacity of the ring buffer */
+static PetscInt64           timelineCount    = 0; /* number of records ever written, the ring holds the last timelineSize of them */
+static PetscLogDouble       timelineBaseTime = 0.0;
+
+/* The frame stack follows the nesting of events, so each thread keeps its own */
+  #if defined(PETSC_HAVE_THREADSAFETY)
+static PETSC_TLS PetscTimelineFrame timelineFrames[PETSC_TIMELINE_MAX_DEPTH];
+static PETSC_TLS int                timelineDepth = 0;
+  #else
+static PetscTimelineFrame timelineFrames[PETSC_TIMELINE_MAX_DEPTH];
+static int                timelineDepth = 0;
+  #endif
+
+/* The handlers that were active when the timeline was started, so -log_view keeps working */
+static PetscErrorCode (*timelinePLB)(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject) = NULL;
+static PetscErrorCode (*timelinePLE)(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject) = NULL;
+
+static PetscErrorCode PetscLogEventBeginTimeline(PetscLogEvent event, int t, PetscObject o1, PetscObject o2, PetscObject o3, PetscObject o4)
+{
+  PetscFunctionBegin;
+  if (timelinePLB) PetscCall((*timelinePLB)(event, t, o1, o2, o3, o4));
+  if (timelineDepth < PETSC_TIMELINE_MAX_DEPTH) {
+    PetscTimelineFrame *frame = &timelineFrames[timelineDepth];
+
+    frame->flops      = petsc_TotalFlops_th;
+    frame->messages   = petsc_irecv_ct_th + petsc_isend_ct_th + petsc_recv_ct_th + petsc_send_ct_th;
+    frame->length     = petsc_irecv_len_th + petsc_isend_len_th + petsc_recv_len_th + petsc_send_len_th;
+    frame->reductions = petsc_allreduce_ct_th + petsc_gather_ct_th + petsc_scatter_ct_th;
+    PetscTime(&frame->start);
+  }
+  timelineDepth++;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscLogEventEndTimeline(PetscLogEvent event, int t, PetscObject o1, PetscObject o2, PetscObject o3, PetscObject o4)
+{
+  PetscLogDouble end;
+
+  PetscFunctionBegin;
+  PetscTime(&end);
+  if (timelineDepth > 0) timelineDepth--;
+  if (timelineDepth < PETSC_TIMELINE_MAX_DEPTH) {
+    PetscTimelineFrame  *frame = &timelineFrames[timelineDepth];
+    PetscTimelineRecord *rec;
+
+    PetscCall(PetscSpinlockLock(&PetscLogSpinLock));
+    rec = &timelineRecords[timelineCount % timelineSize];
+    timelineCount++;
+    rec->start      = frame->start - timelineBaseTime;
+    rec->duration   = end - frame->start;
+    rec->flops      = petsc_TotalFlops_th - frame->flops;
+    rec->messages   = petsc_irecv_ct_th + petsc_isend_ct_th + petsc_recv_ct_th + petsc_send_ct_th - frame->messages;
+    rec->length     = petsc_irecv_len_th + petsc_isend_len_th + petsc_recv_len_th + petsc_send_len_th - frame->length;
+    rec->reductions = petsc_allreduce_ct_th + petsc_gather_ct_th + petsc_scatter_ct_th - frame->reductions;
+    rec->event      = event;
+    rec->stage      = petsc_stageLog ? petsc_stageLog->curStage : 0;
+  #if defined(PETSC_HAVE_THREADSAFETY)
+    rec->tid = (int)PetscLogGetTid();
+  #else
+    rec->tid = 0;
+  #endif
+    rec->depth = timelineDepth;
+    PetscCall(PetscSpinlockUnlock(&PetscLogSpinLock));
+  }
+  if (timelinePLE) PetscCall((*timelinePLE)(event, t, o1, o2, o3, o4));
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogTimelineBegin - Activates timeline logging. Every PETSc event is recorded, with its start time,
+  duration, stage, thread, flops and message traffic, so that the run can be displayed as a timeline.
+
+  Logically Collective on `PETSC_COMM_WORLD`
+
+  Input Parameter:
+. size - the number of events kept on each rank, or `PETSC_DEFAULT`
+
+  Options Database Keys:
++ -log_timeline [filename] - Activates `PetscLogTimelineBegin()` and writes the timeline in `PetscFinalize()`, default file name is petsc_timeline.json
+- -log_timeline_size <size> - the number of events kept on each rank
+
+  Level: intermediate
+
+  Notes:
+  The records are kept in a ring buffer on each rank, when it is full the oldest events are overwritten. No
+  communication takes place until `PetscLogTimelineDump()` so the overhead per event is small and the logger
+  may be used in production runs.
+
+  Any event logging already active, for example from -log_view, continues to be done, thus `PetscLogTimelineBegin()`
+  should be called after `PetscLogDefaultBegin()` or `PetscLogNestedBegin()`.
+
+  The timeline is written in the Chrome trace event JSON format that can be loaded in
+  https://ui.perfetto.dev or chrome://tracing; each MPI rank is shown as a process.
+
+.seealso: [](ch_profiling), `PetscLogTimelineDump()`, `PetscLogTraceBegin()`, `PetscLogDefaultBegin()`, `PetscLogView()`
+@*/
+PetscErrorCode PetscLogTimelineBegin(PetscInt size)
+{
+  PetscFunctionBegin;
+  PetscCheck(!timelineRecords, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Timeline logging has already been started");
+  if (size == PETSC_DEFAULT || size == PETSC_DECIDE) size = 65536;
+  PetscCheck(size > 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Timeline size %" PetscInt_FMT " must be positive", size);
+  PetscCall(PetscMalloc1(size, &timelineRecords));
+  timelineSize  = size;
+  timelineCount = 0;
+  timelineDepth = 0;
+  timelinePLB   = PetscLogPLB;
+  timelinePLE   = PetscLogPLE;
+  /* leaving the barrier together is the best common origin we have for the clocks of the different ranks */
+  PetscCallMPI(MPI_Barrier(PETSC_COMM_WORLD));
+  PetscTime(&timelineBaseTime);
+  PetscCall(PetscLogSet(PetscLogEventBeginTimeline, PetscLogEventEndTimeline));
+  PetscFunctionReturn(0);
+}
+
+/* Free the timeline records and restore the handlers that were active before the timeline was started */
+PetscErrorCode PetscLogTimelineEnd(void)
+{
+  PetscFunctionBegin;
+  if (!timelineRecords) PetscFunctionReturn(0);
+  if (PetscLogPLB == PetscLogEventBeginTimeline) PetscCall(PetscLogSet(timelinePLB, timelinePLE));
+  PetscCall(PetscFree(timelineRecords));
+  timelineSize  = 0;
+  timelineCount = 0;
+  timelinePLB   = NULL;
+  timelinePLE   = NULL;
+  PetscFunctionReturn(0);
+}
+
+/* Event and stage names are free text, escape the characters that may not appear as such in a JSON string */
+static PetscErrorCode PetscLogTimelineEscape_Private(const char name[], char **escaped)
+{
+  size_t len, n = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscStrlen(name, &len));
+  PetscCall(PetscMalloc1(6 * len + 1, escaped));
+  for (size_t i = 0; i < len; i++) {
+    const unsigned char c = (unsigned char)name[i];
+
+    if (c == '"' || c == '\\') {
+      (*escaped)[n++] = '\\';
+      (*escaped)[n++] = (char)c;
+    } else if (c < 0x20) {
+      PetscCall(PetscSNPrintf(*escaped + n, 7, "\\u%04x", (unsigned int)c));
+      n += 6;
+    } else (*escaped)[n++] = (char)c;
+  }
+  (*escaped)[n] = 0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscLogTimelineWriteRecords_Private(FILE *fd, PetscMPIInt rank, PetscInt n, const PetscTimelineRecord recs[], PetscInt nevents, char *const enames[], PetscInt nstages, char *const snames[], PetscBool *first)
+{
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < n; i++) {
+    const PetscTimelineRecord *rec   = &recs[i];
+    const char                *ename = rec->event >= 0 && rec->event < nevents ? enames[rec->event] : "Unknown";
+    const char                *sname = rec->stage >= 0 && rec->stage < nstages ? snames[rec->stage] : "Unknown";
+
+    PetscCall(PetscFPrintf(PETSC_COMM_SELF, fd, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,", *first ? "" : ",", ename, sname, rank, rec->tid, 1.e6 * rec->start, 1.e6 * rec->duration));
+    PetscCall(PetscFPrintf(PETSC_COMM_SELF, fd, "\"args\":{\"depth\":%d,\"flops\":%.0f,\"messages\":%.0f,\"bytes\":%.0f,\"reductions\":%.0f}}", rec->depth, rec->flops, rec->messages, rec->length, rec->reductions));
+    *first = PETSC_FALSE;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogTimelineDump - Writes the events recorded since `PetscLogTimelineBegin()` on all ranks to a single
+  file in the Chrome trace event JSON format.
+
+  Collective on `PETSC_COMM_WORLD`
+
+  Input Parameter:
+. filename - the name of the file, or NULL for petsc_timeline.json
+
+  Options Database Key:
+. -log_timeline [filename] - calls this routine in `PetscFinalize()`
+
+  Level: intermediate
+
+  Notes:
+  Rank 0 collects the records from one rank at a time and writes them, so only one extra rank buffer is ever
+  needed. Event and stage names are those of rank 0, the events must be registered in the same order on all ranks,
+  as is required for -log_view as well.
+
+  Times are given relative to the call to `PetscLogTimelineBegin()` on each rank.
+
+.seealso: [](ch_profiling), `PetscLogTimelineBegin()`, `PetscLogDump()`, `PetscLogView()`
+@*/
+PetscErrorCode PetscLogTimelineDump(const char filename[])
+{
+  MPI_Comm             comm;
+  MPI_Datatype         rectype;
+  PetscMPIInt          rank, size, tag;
+  PetscInt             n, head;
+  PetscInt64           dropped;
+  PetscTimelineRecord *recs = NULL;
+  FILE                *fd   = NULL;
+  PetscBool            first = PETSC_TRUE;
+  PetscStageLog        stageLog;
+  PetscEventRegLog     eventRegLog;
+  PetscInt             nevents = 0, nstages = 0;
+  char               **enames = NULL, **snames = NULL;
+
+  PetscFunctionBegin;
+  PetscCheck(timelineRecords, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Timeline logging has not been started, call PetscLogTimelineBegin()");
+  PetscCall(PetscCommDuplicate(PETSC_COMM_WORLD, &comm, &tag));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCallMPI(MPI_Type_contiguous((PetscMPIInt)sizeof(PetscTimelineRecord), MPI_BYTE, &rectype));
+  PetscCallMPI(MPI_Type_commit(&rectype));
+
+  /* the ring buffer holds the last n records, the oldest of them at position head */
+  n       = (PetscInt)PetscMin(timelineCount, (PetscInt64)timelineSize);
+  head    = timelineCount > timelineSize ? (PetscInt)(timelineCount % timelineSize) : 0;
+  dropped = timelineCount - n;
+  if (dropped) PetscCall(PetscInfo(NULL, "Timeline ring buffer overflowed, the %" PetscInt64_FMT " oldest events were dropped; increase -log_timeline_size\n", dropped));
+
+  PetscCall(PetscFOpen(comm, filename ? filename : "petsc_timeline.json", "w", &fd));
+  if (rank == 0) {
+    PetscCall(PetscLogGetStageLog(&stageLog));
+    PetscCall(PetscStageLogGetEventRegLog(stageLog, &eventRegLog));
+    nevents = eventRegLog->numEvents;
+    nstages = stageLog->numStages;
+    PetscCall(PetscMalloc2(nevents, &enames, nstages, &snames));
+    for (PetscInt e = 0; e < nevents; e++) PetscCall(PetscLogTimelineEscape_Private(eventRegLog->eventInfo[e].name, &enames[e]));
+    for (PetscInt s = 0; s < nstages; s++) PetscCall(PetscLogTimelineEscape_Private(stageLog->stageInfo[s].name, &snames[s]));
+    PetscCall(PetscFPrintf(PETSC_COMM_SELF, fd, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    for (PetscMPIInt r = 0; r < size; r++) {
+      PetscInt64 counts[2] = {0, 0};
+      PetscInt   m         = 0;
+
+      if (r == 0) {
+        counts[0] = n;
+        counts[1] = dropped;
+      } else {
+        /* let rank r send, so that rank 0 does not have to buffer the records of all ranks at once */
+        PetscCallMPI(MPI_Send(NULL, 0, MPI_INT, r, tag, comm));
+        PetscCallMPI(MPI_Recv(counts, 2, MPIU_INT64, r, tag, comm, MPI_STATUS_IGNORE));
+      }
+      PetscCall(PetscFPrintf(PETSC_COMM_SELF, fd, "%s\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"Rank %d\"}}", first ? "" : ",", r, r));
+      PetscCall(PetscFPrintf(PETSC_COMM_SELF, fd, ",\n{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"sort_index\":%d}}", r, r));
+      if (counts[1]) PetscCall(PetscFPrintf(PETSC_COMM_SELF, fd, ",\n{\"name\":\"process_labels\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"labels\":\"%" PetscInt64_FMT " events dropped\"}}", r, counts[1]));
+      first = PETSC_FALSE;
+      if (r == 0) {
+        PetscCall(PetscLogTimelineWriteRecords_Private(fd, r, timelineSize - head < n ? timelineSize - head : n, timelineRecords + head, nevents, enames, nstages, snames, &first));
+        if (head) PetscCall(PetscLogTimelineWriteRecords_Private(fd, r, head, timelineRecords, nevents, enames, nstages, snames, &first));
+      } else {
+        PetscCall(PetscIntCast(counts[0], &m));
+        PetscCall(PetscFree(recs));
+        PetscCall(PetscMalloc1(m, &recs));
+        PetscCallMPI(MPI_Recv(recs, (PetscMPIInt)m, rectype, r, tag, comm, MPI_STATUS_IGNORE));
+        PetscCall(PetscLogTimelineWriteRecords_Private(fd, r, m, recs, nevents, enames, nstages, snames, &first));
+      }
+    }
+    PetscCall(PetscFPrintf(PETSC_COMM_SELF, fd, "\n]}\n"));
+    PetscCall(PetscFree(recs));
+    for (PetscInt e = 0; e < nevents; e++) PetscCall(PetscFree(enames[e]));
+    for (PetscInt s = 0; s < nstages; s++) PetscCall(PetscFree(snames[s]));
+    PetscCall(PetscFree2(enames, snames));
+  } else {
+    PetscInt64 counts[2];
+
+    counts[0] = n;
+    counts[1] = dropped;
+    /* send the records oldest first */
+    PetscCall(PetscMalloc1(n, &recs));
+    PetscCall(PetscArraycpy(recs, timelineRecords + head, n - head));
+    PetscCall(PetscArraycpy(recs + n - head, timelineRecords, head));
+    PetscCallMPI(MPI_Recv(NULL, 0, MPI_INT, 0, tag, comm, MPI_STATUS_IGNORE));
+    PetscCallMPI(MPI_Send(counts, 2, MPIU_INT64, 0, tag, comm));
+    PetscCallMPI(MPI_Send(recs, (PetscMPIInt)n, rectype, 0, tag, comm));
+    PetscCall(PetscFree(recs));
+  }
+  PetscCall(PetscFClose(comm, fd));
+  PetscCallMPI(MPI_Type_free(&rectype));
+  PetscCall(PetscCommDestroy(&comm));
+  PetscFunctionReturn(0);
+}
+
+#endif /* PETSC_USE_LOG */
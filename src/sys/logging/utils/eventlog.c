@@ -175,6 +175,7 @@ PetscErrorCode PetscEventPerfInfoClear(PetscEventPerfInfo *eventInfo)
   eventInfo->numMessages   = 0.0;
   eventInfo->messageLength = 0.0;
   eventInfo->numReductions = 0.0;
+  for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) eventInfo->hwCounters[i] = 0.0;
 #if defined(PETSC_HAVE_DEVICE)
   eventInfo->CpuToGpuCount = 0.0;
   eventInfo->GpuToCpuCount = 0.0;
@@ -242,6 +243,7 @@ PetscErrorCode PetscEventPerfInfoAdd(PetscEventPerfInfo *eventInfo, PetscEventPe
   outInfo->numMessages += eventInfo->numMessages;
   outInfo->messageLength += eventInfo->messageLength;
   outInfo->numReductions += eventInfo->numReductions;
+  for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) outInfo->hwCounters[i] += eventInfo->hwCounters[i];
 #if defined(PETSC_HAVE_DEVICE)
   outInfo->CpuToGpuCount += eventInfo->CpuToGpuCount;
   outInfo->GpuToCpuCount += eventInfo->GpuToCpuCount;
@@ -865,6 +867,12 @@ PetscErrorCode PetscLogEventBeginDefault(PetscLogEvent event, int t, PetscObject
     eventInfo->mallocIncrease -= usage;
     PetscCall(PetscMallocPushMaximumUsage((int)event));
   }
+  if (PetscLogHWCounters) {
+    PetscLogDouble counters[PETSC_LOG_HW_NUM_COUNTERS];
+
+    PetscCall(PetscLogHWCountersRead_Internal(counters));
+    for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) eventInfo->hwCounters[i] -= counters[i];
+  }
   PetscFunctionReturn(0);
 }
 
@@ -925,6 +933,12 @@ PetscErrorCode PetscLogEventEndDefault(PetscLogEvent event, int t, PetscObject o
     PetscCall(PetscMallocGetMaximumUsage(&usage));
     eventInfo->mallocIncrease += usage; /* MMalloc */
   }
+  if (PetscLogHWCounters) {
+    PetscLogDouble counters[PETSC_LOG_HW_NUM_COUNTERS];
+
+    PetscCall(PetscLogHWCountersRead_Internal(counters));
+    for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) eventInfo->hwCounters[i] += counters[i];
+  }
 #if defined(PETSC_HAVE_THREADSAFETY)
   PetscCall(PetscSpinlockLock(&PetscLogSpinLock));
   PetscCall(PetscEventPerfInfoAdd(eventInfo, eventLog->eventInfo + event));
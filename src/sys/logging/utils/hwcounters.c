@@ -0,0 +1,288 @@
+/*
+     Reading of hardware performance counters for the event logging, through PAPI when PETSc is configured with it and
+   otherwise through the Linux perf_event_open() system call. The counters count only the calling thread in user mode.
+*/
+#include <petsc/private/logimpl.h> /*I    "petscsys.h"   I*/
+#if defined(PETSC_HAVE_PAPI)
+  #include <papi.h>
+#elif defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+PetscBool PetscLogHWCounters = PETSC_FALSE;
+
+static const char *const PetscLogHWCounterNames[PETSC_LOG_HW_NUM_COUNTERS] = {"cycles", "instructions", "last level cache misses"};
+static PetscBool         hwAvailable[PETSC_LOG_HW_NUM_COUNTERS];
+
+#if defined(PETSC_HAVE_PAPI)
+static int hwEventSet = PAPI_NULL;
+static int hwSlot[PETSC_LOG_HW_NUM_COUNTERS]; /* position of each counter in the values returned by PAPI_read() */
+static int hwNumOpen = 0;
+#elif defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+static int hwFd[PETSC_LOG_HW_NUM_COUNTERS];   /* the first open counter leads the group, the others are read with it */
+static int hwSlot[PETSC_LOG_HW_NUM_COUNTERS]; /* position of each counter in the group read */
+static int hwLeader  = -1;
+static int hwNumOpen = 0;
+#endif
+
+#if defined(PETSC_HAVE_PAPI) || defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+/* The counters given with -log_view_hw_counters_events, all of them by default */
+static PetscErrorCode PetscLogHWCountersGetSelected_Private(PetscBool selected[])
+{
+  const char *const keys[PETSC_LOG_HW_NUM_COUNTERS] = {"cycles", "instructions", "llc_misses"};
+  char             *names[PETSC_LOG_HW_NUM_COUNTERS];
+  PetscInt          n = PETSC_LOG_HW_NUM_COUNTERS;
+  PetscBool         set, match;
+
+  PetscFunctionBegin;
+  PetscCall(PetscOptionsGetStringArray(NULL, NULL, "-log_view_hw_counters_events", names, &n, &set));
+  for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) selected[i] = set ? PETSC_FALSE : PETSC_TRUE;
+  for (PetscInt j = 0; j < n && set; j++) {
+    int i;
+
+    for (i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) {
+      PetscCall(PetscStrcasecmp(names[j], keys[i], &match));
+      if (match) break;
+    }
+    PetscCheck(i < PETSC_LOG_HW_NUM_COUNTERS, PETSC_COMM_SELF, PETSC_ERR_ARG_UNKNOWN_TYPE, "Unknown hardware counter %s, use cycles, instructions or llc_misses", names[j]);
+    selected[i] = PETSC_TRUE;
+    PetscCall(PetscFree(names[j]));
+  }
+  PetscFunctionReturn(0);
+}
+#endif
+
+#if defined(PETSC_HAVE_PAPI)
+/* The event counting last level cache misses: the one given with -log_view_hw_counters_llc_event, or the first preset available */
+static PetscErrorCode PetscLogHWCountersAddLLC_Private(PetscBool *added)
+{
+  char      name[PAPI_MAX_STR_LEN];
+  PetscBool set;
+
+  PetscFunctionBegin;
+  *added = PETSC_FALSE;
+  PetscCall(PetscOptionsGetString(NULL, NULL, "-log_view_hw_counters_llc_event", name, sizeof(name), &set));
+  if (set) {
+    int code;
+
+    PetscCheck(PAPI_event_name_to_code(name, &code) == PAPI_OK, PETSC_COMM_SELF, PETSC_ERR_ARG_UNKNOWN_TYPE, "Unknown PAPI event %s", name);
+    *added = PAPI_add_event(hwEventSet, code) == PAPI_OK ? PETSC_TRUE : PETSC_FALSE;
+    if (!*added) PetscCall(PetscInfo(NULL, "PAPI cannot count %s\n", name));
+  } else {
+    const int         presets[] = {PAPI_L3_TCM, PAPI_L2_TCM};
+    const char *const names[]   = {"PAPI_L3_TCM", "PAPI_L2_TCM"};
+
+    /* machines without a third level cache, or virtual machines, may not have PAPI_L3_TCM */
+    for (size_t i = 0; i < PETSC_STATIC_ARRAY_LENGTH(presets) && !*added; i++) {
+      *added = PAPI_add_event(hwEventSet, presets[i]) == PAPI_OK ? PETSC_TRUE : PETSC_FALSE;
+      PetscCall(PetscInfo(NULL, "PAPI %s count %s for the last level cache misses\n", *added ? "will" : "cannot", names[i]));
+    }
+  }
+  PetscFunctionReturn(0);
+}
+#elif defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+/*
+  The event counting last level cache misses: the raw event rNNNN (hexadecimal, as for perf stat) given with
+  -log_view_hw_counters_llc_event, otherwise the generic cache misses event of the kernel and if it is not supported the
+  read misses of the last level cache
+*/
+static PetscErrorCode PetscLogHWCountersOpenLLC_Private(struct perf_event_attr *attr, int *fd)
+{
+  char      name[256];
+  PetscBool set;
+
+  PetscFunctionBegin;
+  PetscCall(PetscOptionsGetString(NULL, NULL, "-log_view_hw_counters_llc_event", name, sizeof(name), &set));
+  if (set) {
+    char *end;
+
+    PetscCheck(name[0] == 'r' && name[1], PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "The event %s for perf_event_open() must be a raw event rNNNN, with NNNN in hexadecimal", name);
+    attr->type   = PERF_TYPE_RAW;
+    attr->config = strtoull(name + 1, &end, 16);
+    PetscCheck(!*end, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "The event %s for perf_event_open() must be a raw event rNNNN, with NNNN in hexadecimal", name);
+    *fd = (int)syscall(SYS_perf_event_open, attr, 0, -1, hwLeader, 0);
+    if (*fd < 0) PetscCall(PetscInfo(NULL, "perf_event_open() cannot count %s\n", name));
+  } else {
+    attr->type   = PERF_TYPE_HARDWARE;
+    attr->config = PERF_COUNT_HW_CACHE_MISSES;
+    *fd          = (int)syscall(SYS_perf_event_open, attr, 0, -1, hwLeader, 0);
+    if (*fd < 0) {
+      attr->type   = PERF_TYPE_HW_CACHE;
+      attr->config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      *fd          = (int)syscall(SYS_perf_event_open, attr, 0, -1, hwLeader, 0);
+      PetscCall(PetscInfo(NULL, "perf_event_open() cannot count the generic cache misses, %s the last level cache read misses\n", *fd < 0 ? "nor" : "using"));
+    }
+  }
+  PetscFunctionReturn(0);
+}
+#endif
+
+/*@C
+  PetscLogHWCountersBegin - Turns on the reading of hardware performance counters at the beginning and end of each event
+  logged with the default logger, their totals are then displayed by `PetscLogView()`
+
+  Not Collective
+
+  Options Database Keys:
++ -log_view_hw_counters - include the hardware counters in the -log_view output
+. -log_view_hw_counters_events <cycles,instructions,llc_misses> - the counters to read, by default all of them
+. -log_view_hw_counters_llc_event <event> - the event counting the last level cache misses, a PAPI event name or a raw perf event rNNNN
+- -log_view_stream_bandwidth <MB/s> - the memory bandwidth of all the processes, for example from make streams, to compare with
+
+  Level: advanced
+
+  Notes:
+  The counters read are cycles, instructions and last level cache misses. They are read through PAPI if PETSc was
+  configured with it, otherwise with the Linux perf_event_open() system call, which requires
+  /proc/sys/kernel/perf_event_paranoid to be at most 2. Counters that are not available on a machine (for example in
+  many virtual machines) or that are not selected with -log_view_hw_counters_events are reported with a - by
+  `PetscLogView()`.
+
+  The last level cache misses are counted with PAPI_L3_TCM, or PAPI_L2_TCM on machines without it, or with the generic
+  cache misses event of perf_event_open(), or its last level cache read misses. The event that counts them best depends on
+  the processor, give it with -log_view_hw_counters_llc_event, for example a native PAPI event or a raw event of the
+  processor manual; -info tells which event is used.
+
+  The misses times the cache line size are reported as an estimate of the last level cache miss traffic, not as the
+  traffic with the memory: hardware prefetches and write backs are not counted, and on some processors the event also
+  counts misses served by another cache. Compare it with the bandwidth given with -log_view_stream_bandwidth as an
+  indication only.
+
+  Each reading of the counters costs a system call; the counting should not be used when studying events that take only
+  a few microseconds.
+
+  Only the thread calling `PetscInitialize()` is counted.
+
+.seealso: [](ch_profiling), `PetscLogView()`, `PetscLogDefaultBegin()`, `PetscLogGpuTime()`
+@*/
+PetscErrorCode PetscLogHWCountersBegin(void)
+{
+  PetscFunctionBegin;
+  if (PetscLogHWCounters) PetscFunctionReturn(0);
+  for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) hwAvailable[i] = PETSC_FALSE;
+#if defined(PETSC_HAVE_PAPI)
+  {
+    const int events[PETSC_LOG_HW_NUM_COUNTERS - 1] = {PAPI_TOT_CYC, PAPI_TOT_INS};
+    PetscBool selected[PETSC_LOG_HW_NUM_COUNTERS];
+
+    PetscCall(PetscLogHWCountersGetSelected_Private(selected));
+    PetscCheck(PAPI_library_init(PAPI_VER_CURRENT) == PAPI_VER_CURRENT, PETSC_COMM_SELF, PETSC_ERR_LIB, "Unable to initialize PAPI");
+    PetscCheck(PAPI_create_eventset(&hwEventSet) == PAPI_OK, PETSC_COMM_SELF, PETSC_ERR_LIB, "Unable to create a PAPI event set");
+    hwNumOpen = 0;
+    for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) {
+      PetscBool added;
+
+      if (!selected[i]) continue;
+      if (i == PETSC_LOG_HW_LLC_MISSES) PetscCall(PetscLogHWCountersAddLLC_Private(&added));
+      else added = PAPI_add_event(hwEventSet, events[i]) == PAPI_OK ? PETSC_TRUE : PETSC_FALSE;
+      if (added) {
+        hwAvailable[i] = PETSC_TRUE;
+        hwSlot[i]      = hwNumOpen++;
+      } else PetscCall(PetscInfo(NULL, "PAPI cannot count %s\n", PetscLogHWCounterNames[i]));
+    }
+    if (hwNumOpen) PetscCheck(PAPI_start(hwEventSet) == PAPI_OK, PETSC_COMM_SELF, PETSC_ERR_LIB, "Unable to start the PAPI counters");
+  }
+#elif defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  {
+    const unsigned long long configs[PETSC_LOG_HW_NUM_COUNTERS - 1] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS};
+    PetscBool                selected[PETSC_LOG_HW_NUM_COUNTERS];
+
+    PetscCall(PetscLogHWCountersGetSelected_Private(selected));
+    hwLeader  = -1;
+    hwNumOpen = 0;
+    for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) {
+      struct perf_event_attr attr;
+
+      if (!selected[i]) continue;
+      PetscCall(PetscMemzero(&attr, sizeof(attr)));
+      attr.size           = sizeof(attr);
+      attr.disabled       = hwLeader < 0 ? 1 : 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      attr.read_format    = PERF_FORMAT_GROUP;
+      if (i == PETSC_LOG_HW_LLC_MISSES) PetscCall(PetscLogHWCountersOpenLLC_Private(&attr, &hwFd[i]));
+      else {
+        attr.type   = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        hwFd[i]     = (int)syscall(SYS_perf_event_open, &attr, 0, -1, hwLeader, 0);
+      }
+      if (hwFd[i] < 0) {
+        PetscCall(PetscInfo(NULL, "perf_event_open() cannot count %s\n", PetscLogHWCounterNames[i]));
+        continue;
+      }
+      if (hwLeader < 0) hwLeader = hwFd[i];
+      hwAvailable[i] = PETSC_TRUE;
+      hwSlot[i]      = hwNumOpen++;
+    }
+    if (hwLeader >= 0) PetscCheck(!ioctl(hwLeader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP), PETSC_COMM_SELF, PETSC_ERR_SYS, "Unable to start the hardware counters");
+  }
+#else
+  PetscCall(PetscInfo(NULL, "Hardware counters need PAPI or Linux perf_event_open(), none is available\n"));
+#endif
+  PetscLogHWCounters = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* Stop the counters and release them */
+PetscErrorCode PetscLogHWCountersEnd(void)
+{
+  PetscFunctionBegin;
+  if (!PetscLogHWCounters) PetscFunctionReturn(0);
+#if defined(PETSC_HAVE_PAPI)
+  if (hwNumOpen) {
+    long long values[PETSC_LOG_HW_NUM_COUNTERS];
+
+    PetscCheck(PAPI_stop(hwEventSet, values) == PAPI_OK, PETSC_COMM_SELF, PETSC_ERR_LIB, "Unable to stop the PAPI counters");
+  }
+  PetscCheck(PAPI_cleanup_eventset(hwEventSet) == PAPI_OK, PETSC_COMM_SELF, PETSC_ERR_LIB, "Unable to clean up the PAPI event set");
+  PetscCheck(PAPI_destroy_eventset(&hwEventSet) == PAPI_OK, PETSC_COMM_SELF, PETSC_ERR_LIB, "Unable to destroy the PAPI event set");
+  PAPI_shutdown();
+  hwNumOpen = 0;
+#elif defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  /* close the group leader last */
+  for (int i = PETSC_LOG_HW_NUM_COUNTERS - 1; i >= 0; i--)
+    if (hwAvailable[i]) PetscCheck(!close(hwFd[i]), PETSC_COMM_SELF, PETSC_ERR_SYS, "Unable to close hardware counter");
+  hwLeader  = -1;
+  hwNumOpen = 0;
+#endif
+  for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) hwAvailable[i] = PETSC_FALSE;
+  PetscLogHWCounters = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/* The current values of the counters, zero for those that are not available */
+PetscErrorCode PetscLogHWCountersRead_Internal(PetscLogDouble counters[])
+{
+  PetscFunctionBegin;
+  for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) counters[i] = 0.0;
+#if defined(PETSC_HAVE_PAPI)
+  if (hwNumOpen) {
+    long long values[PETSC_LOG_HW_NUM_COUNTERS];
+
+    PetscCheck(PAPI_read(hwEventSet, values) == PAPI_OK, PETSC_COMM_SELF, PETSC_ERR_LIB, "Unable to read the PAPI counters");
+    for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++)
+      if (hwAvailable[i]) counters[i] = (PetscLogDouble)values[hwSlot[i]];
+  }
+#elif defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  if (hwNumOpen) {
+    unsigned long long values[1 + PETSC_LOG_HW_NUM_COUNTERS]; /* the number of counters followed by their values */
+    const size_t       size = (size_t)(1 + hwNumOpen) * sizeof(unsigned long long);
+
+    PetscCheck(read(hwLeader, values, size) == (ssize_t)size, PETSC_COMM_SELF, PETSC_ERR_SYS, "Unable to read the hardware counters");
+    for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++)
+      if (hwAvailable[i]) counters[i] = (PetscLogDouble)values[1 + hwSlot[i]];
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+/* Which counters can be read on this process */
+PetscErrorCode PetscLogHWCountersGetAvailable_Internal(PetscBool available[])
+{
+  PetscFunctionBegin;
+  for (int i = 0; i < PETSC_LOG_HW_NUM_COUNTERS; i++) available[i] = hwAvailable[i];
+  PetscFunctionReturn(0);
+}
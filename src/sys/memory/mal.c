@@ -27,6 +27,10 @@ PetscMemkindType previousmktype = PETSC_MK_HBW_PREFERRED;
 */
 #define SHIFT_CLASSID 456123
 
+/* defined in mnuma.c, blocks of at least PetscMallocLargeThreshold bytes follow PetscMallocSetLargePolicy() */
+PETSC_INTERN size_t         PetscMallocLargeThreshold;
+PETSC_INTERN PetscErrorCode PetscMallocLarge_Private(size_t, PetscBool, int, const char[], const char[], void **);
+
 PETSC_EXTERN PetscErrorCode PetscMallocAlign(size_t mem, PetscBool clear, int line, const char func[], const char file[], void **result)
 {
   if (!mem) {
@@ -51,6 +55,7 @@ PETSC_EXTERN PetscErrorCode PetscMallocAlign(size_t mem, PetscBool clear, int li
   PetscCheck(*result, PETSC_COMM_SELF, line, func, file, PETSC_ERR_MEM, PETSC_ERROR_INITIAL, "Memory requested %.0f", (PetscLogDouble)mem);
   if (PetscLogMemory) PetscCall(PetscMemzero(*result, mem));
   #elif PetscDefined(HAVE_POSIX_MEMALIGN)
+  if (PetscMallocLargeThreshold && mem >= PetscMallocLargeThreshold) return PetscMallocLarge_Private(mem, clear, line, func, file, result);
   int ret = posix_memalign(result, PETSC_MEMALIGN, mem);
   PetscCheck(ret == 0, PETSC_COMM_SELF, line, func, file, PETSC_ERR_MEM, PETSC_ERROR_INITIAL, "Memory requested %.0f", (PetscLogDouble)mem);
   if (clear || PetscLogMemory) PetscCall(PetscMemzero(*result, mem));
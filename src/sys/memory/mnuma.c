@@ -0,0 +1,132 @@
+/*
+     Placement of the pages of large allocations, such as the arrays of Vec and Mat, on NUMA nodes and in huge pages.
+*/
+#define PETSC_DESIRE_FEATURE_TEST_MACROS /* for posix_memalign() and madvise() */
+#include <petscsys.h>                    /*I   "petscsys.h"   I*/
+#if defined(PETSC_HAVE_UNISTD_H)
+  #include <unistd.h>
+#endif
+#if defined(PETSC_HAVE_MMAP)
+  #include <sys/mman.h>
+#endif
+#if defined(PETSC_HAVE_LINUX_MEMPOLICY_H)
+  #include <linux/mempolicy.h>
+  #include <sys/syscall.h>
+#endif
+
+const char *const PetscMallocNUMAPolicies[] = {"DEFAULT", "INTERLEAVE", "FIRST_TOUCH", "PetscMallocNUMAPolicy", "PETSC_MALLOC_NUMA_", NULL};
+
+#define PETSC_HUGE_PAGE_SIZE 2097152
+
+/* checked by PetscMallocAlign(), zero when no policy is set */
+PETSC_INTERN size_t PetscMallocLargeThreshold;
+size_t              PetscMallocLargeThreshold = 0;
+
+static PetscMallocNUMAPolicy largePolicy    = PETSC_MALLOC_NUMA_DEFAULT;
+static PetscBool             largeHugePages = PETSC_FALSE;
+static size_t                largePageSize  = 4096;
+#if defined(PETSC_HAVE_LINUX_MEMPOLICY_H) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+  #define PETSC_LARGE_MAX_NODES 1024
+static unsigned long largeNodeMask[PETSC_LARGE_MAX_NODES / (8 * sizeof(unsigned long))]; /* the nodes the process may allocate on */
+#endif
+
+/*@C
+   PetscMallocSetLargePolicy - Sets how the pages of large allocations, such as the arrays of `Vec` and `Mat`, are placed
+   on the NUMA nodes and whether they use huge pages
+
+   Not Collective
+
+   Input Parameters:
++  threshold - allocations of at least this many bytes follow the policy, `PETSC_DEFAULT` for 2 megabytes
+.  policy - the NUMA placement, see `PetscMallocNUMAPolicy`
+-  hugepages - ask for transparent 2 megabyte huge pages
+
+   Options Database Keys:
++  -malloc_numa_policy <default,interleave,first_touch> - the NUMA placement
+.  -malloc_hugepages - use transparent huge pages
+-  -malloc_large_threshold <bytes> - the size from which the policy is used
+
+   Level: advanced
+
+   Notes:
+   This is applied by `PetscMallocAlign()`, thus it also works with -malloc_debug and -malloc_pool, but not with
+   memkind (-malloc_hbw), and not to memory obtained with `PetscRealloc()`.
+
+   With huge pages the allocations are aligned to 2 megabytes and advised with madvise(MADV_HUGEPAGE); whether the
+   kernel then uses huge pages depends on /sys/kernel/mm/transparent_hugepage/enabled. This reduces the TLB misses of
+   the sweeps through large arrays. Explicit (hugetlbfs) pages are not used since they could not be returned with free().
+
+   `PETSC_MALLOC_NUMA_INTERLEAVE` uses the Linux mbind() system call; it is best when the threads access the arrays
+   with no particular affinity. `PETSC_MALLOC_NUMA_FIRST_TOUCH` is best for MPI+OpenMP runs where each thread works on
+   the same part of a vector in every operation; the memory is then zeroed at allocation even by `PetscMalloc()`.
+   Without OpenMP it has no effect.
+
+.seealso: `PetscMallocNUMAPolicy`, `PetscMallocSetDRAM()`, `PetscMallocSet()`, `PetscMallocAlign()`
+@*/
+PetscErrorCode PetscMallocSetLargePolicy(size_t threshold, PetscMallocNUMAPolicy policy, PetscBool hugepages)
+{
+  PetscFunctionBegin;
+  if (threshold == (size_t)PETSC_DEFAULT) threshold = PETSC_HUGE_PAGE_SIZE;
+  largePolicy    = policy;
+  largeHugePages = hugepages;
+#if defined(PETSC_HAVE_GETPAGESIZE)
+  largePageSize = (size_t)getpagesize();
+#endif
+#if !defined(PETSC_HAVE_MMAP) || !defined(MADV_HUGEPAGE)
+  if (hugepages) PetscCall(PetscInfo(NULL, "Transparent huge pages are not available, ignoring them\n"));
+  largeHugePages = PETSC_FALSE;
+#endif
+  if (policy == PETSC_MALLOC_NUMA_INTERLEAVE) {
+#if defined(PETSC_LARGE_MAX_NODES)
+    if (syscall(SYS_get_mempolicy, NULL, largeNodeMask, (unsigned long)PETSC_LARGE_MAX_NODES, NULL, (unsigned long)MPOL_F_MEMS_ALLOWED)) {
+      PetscCall(PetscInfo(NULL, "Unable to get the NUMA nodes of the process, not interleaving\n"));
+      largePolicy = PETSC_MALLOC_NUMA_DEFAULT;
+    }
+#else
+    PetscCall(PetscInfo(NULL, "NUMA interleaving needs the Linux mbind() system call, not interleaving\n"));
+    largePolicy = PETSC_MALLOC_NUMA_DEFAULT;
+#endif
+  }
+#if !defined(PETSC_HAVE_OPENMP)
+  if (policy == PETSC_MALLOC_NUMA_FIRST_TOUCH) PetscCall(PetscInfo(NULL, "First touch placement has no effect without OpenMP\n"));
+#endif
+  PetscMallocLargeThreshold = (largePolicy != PETSC_MALLOC_NUMA_DEFAULT || largeHugePages) ? threshold : 0;
+  PetscFunctionReturn(0);
+}
+
+/* Called by PetscMallocAlign() for blocks of at least PetscMallocLargeThreshold bytes; the memory can be freed with free() */
+PETSC_INTERN PetscErrorCode PetscMallocLarge_Private(size_t mem, PetscBool clear, int line, const char func[], const char file[], void **result)
+{
+  size_t align = PETSC_MEMALIGN, len;
+
+  /* mbind() and madvise() work on whole pages */
+  if (largePolicy == PETSC_MALLOC_NUMA_INTERLEAVE) align = PetscMax(align, largePageSize);
+  if (largeHugePages) align = PetscMax(align, (size_t)PETSC_HUGE_PAGE_SIZE);
+  len = ((mem + largePageSize - 1) / largePageSize) * largePageSize;
+#if defined(PETSC_HAVE_POSIX_MEMALIGN)
+  PetscCheck(posix_memalign(result, align, mem) == 0, PETSC_COMM_SELF, line, func, file, PETSC_ERR_MEM, PETSC_ERROR_INITIAL, "Memory requested %.0f", (PetscLogDouble)mem);
+#else
+  SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "Large allocation policies need posix_memalign(), requested in %s() at %s:%d", func, file, line);
+#endif
+#if defined(PETSC_HAVE_MMAP) && defined(MADV_HUGEPAGE)
+  /* only advice, the allocation is fine without it */
+  if (largeHugePages) (void)madvise(*result, len, MADV_HUGEPAGE);
+#endif
+#if defined(PETSC_LARGE_MAX_NODES)
+  /* MPOL_MF_MOVE also moves the pages the allocator may have touched already, when it reuses freed memory */
+  if (largePolicy == PETSC_MALLOC_NUMA_INTERLEAVE) (void)syscall(SYS_mbind, *result, len, (unsigned long)MPOL_INTERLEAVE, largeNodeMask, (unsigned long)PETSC_LARGE_MAX_NODES, (unsigned long)MPOL_MF_MOVE);
+#endif
+  if (largePolicy == PETSC_MALLOC_NUMA_FIRST_TOUCH) {
+#if defined(PETSC_HAVE_OPENMP)
+    const PetscInt64 npages = (PetscInt64)(len / largePageSize);
+    char            *base   = (char *)*result;
+
+    /* the same static partition as the loops of PETSc over the entries of the array */
+    #pragma omp parallel for schedule(static)
+    for (PetscInt64 p = 0; p < npages; p++) memset(base + p * largePageSize, 0, PetscMin(largePageSize, mem - (size_t)p * largePageSize));
+#else
+    if (clear || PetscLogMemory) PetscCall(PetscMemzero(*result, mem));
+#endif
+  } else if (clear || PetscLogMemory) PetscCall(PetscMemzero(*result, mem));
+  return 0;
+}
@@ -0,0 +1,275 @@
+/*
+     A pool allocator for PetscMalloc(): blocks of up to 64 kilobytes are rounded up to a power of two and freed blocks
+   are kept on a free list of their size class, so that the many short-lived work arrays allocated in hot loops do not
+   go back to the system allocator each time.
+*/
+#include <petscsys.h> /*I   "petscsys.h"   I*/
+
+/*
+   These are defined in mal.c and ensure that malloced space is PetscScalar aligned
+*/
+PETSC_EXTERN PetscErrorCode PetscMallocAlign(size_t, PetscBool, int, const char[], const char[], void **);
+PETSC_EXTERN PetscErrorCode PetscFreeAlign(void *, int, const char[], const char[]);
+PETSC_EXTERN PetscErrorCode PetscReallocAlign(size_t, int, const char[], const char[], void **);
+
+/* defined in mtr.c, lets the tracing of -malloc_debug and -malloc_view take its memory from the pool */
+PETSC_INTERN PetscErrorCode PetscMallocTraceSetBase_Private(PetscErrorCode (*)(size_t, PetscBool, int, const char[], const char[], void **), PetscErrorCode (*)(void *, int, const char[], const char[]), PetscErrorCode (*)(size_t, int, const char[], const char[], void **));
+PETSC_INTERN PetscBool      petscsetmallocvisited;
+
+#define POOL_MIN_SHIFT   5  /* the smallest size class holds 32 bytes */
+#define POOL_NUM_CLASSES 12 /* the largest 64 kilobytes */
+#define POOL_CLASS_SIZE(c) ((size_t)1 << ((c) + POOL_MIN_SHIFT))
+#define POOL_MAGIC       0x5eedb10c
+
+/* put before each block, -1 as size class marks the blocks too large for the pool */
+typedef struct {
+  int sizeclass;
+  int magic;
+} PoolHeader;
+
+#define POOL_HEADER_BYTES ((sizeof(PoolHeader) + (PETSC_MEMALIGN - 1)) & ~(PETSC_MEMALIGN - 1))
+
+/* The free blocks of each size class, linked through their first bytes; each thread has its own lists */
+typedef struct {
+  void  *head[POOL_NUM_CLASSES];
+  size_t count[POOL_NUM_CLASSES];
+} PoolCache;
+
+#if defined(PETSC_HAVE_THREADSAFETY)
+static PETSC_TLS PoolCache poolCache;
+#else
+static PoolCache poolCache;
+#endif
+
+/* Statistics for -malloc_view, not exact when several threads allocate */
+static PetscLogDouble poolAllocs[POOL_NUM_CLASSES], poolReused[POOL_NUM_CLASSES], poolLarge = 0;
+static size_t         poolHighWater[POOL_NUM_CLASSES];
+static size_t         poolMaxCached = 1048576; /* bytes kept in the free list of each size class */
+
+static inline int PoolSizeClass(size_t mem)
+{
+  int c = 0;
+
+  while (c < POOL_NUM_CLASSES && POOL_CLASS_SIZE(c) < mem) c++;
+  return c < POOL_NUM_CLASSES ? c : -1;
+}
+
+static inline PetscErrorCode PoolGetHeader(void *ptr, int line, const char func[], const char file[], PoolHeader **head)
+{
+  *head = (PoolHeader *)((char *)ptr - POOL_HEADER_BYTES);
+  PetscCheck((*head)->magic == POOL_MAGIC, PETSC_COMM_SELF, PETSC_ERR_MEMC, "Block at address %p freed in %s() at %s:%d was not allocated by PetscMallocPool() or is corrupted", ptr, func, file, line);
+  return 0;
+}
+
+/*@C
+   PetscMallocPool - Allocates memory from the pool of freed blocks of the same size class when possible.
+
+   Not Collective
+
+   Input Parameters:
++  mem - number of bytes to allocate
+.  clear - zero the memory
+.  line - line number where used
+.  func - function calling routine
+-  file - file name where used
+
+   Output Parameter:
+.  result - the `PETSC_MEMALIGN` aligned memory
+
+   Options Database Keys:
++  -malloc_pool - use the pool for all `PetscMalloc()` calls
+-  -malloc_pool_cache <bytes> - the most memory kept for reuse in each size class, default 1 megabyte
+
+   Level: developer
+
+   Notes:
+   Requests of up to 64 kilobytes are rounded up to the next power of two, at least 32 bytes, and served from the
+   blocks of that size freed earlier by the same thread; larger requests go to `PetscMallocAlign()`. This saves the
+   cost of the system allocator, and the fragmentation it may cause, for the short-lived work arrays allocated over and
+   over by `MatSetValues()`, `MatGetRow()`, `DMGetWorkArray()` or `PetscSF`, at the price of up to twice the memory for
+   those small blocks.
+
+   The pool is used by passing `PetscMallocPool()`, `PetscFreePool()` and `PetscReallocPool()` to `PetscMallocSet()`
+   before `PetscInitialize()`, or with -malloc_pool; then -malloc_debug and -malloc_view keep working on top of the
+   pool and `PetscMallocView()` shows how many allocations it served.
+
+.seealso: `PetscFreePool()`, `PetscReallocPool()`, `PetscMallocPoolTrim()`, `PetscMallocSet()`, `PetscMallocView()`
+@*/
+PetscErrorCode PetscMallocPool(size_t mem, PetscBool clear, int line, const char func[], const char file[], void **result)
+{
+  PoolHeader *head;
+  char       *raw;
+  int         c;
+
+  if (!mem) {
+    *result = NULL;
+    return 0;
+  }
+  c = PoolSizeClass(mem);
+  if (c >= 0) {
+    poolAllocs[c]++;
+    if (poolCache.head[c]) {
+      *result           = poolCache.head[c];
+      poolCache.head[c] = *(void **)*result;
+      poolCache.count[c]--;
+      poolReused[c]++;
+      if (clear) PetscCall(PetscMemzero(*result, mem));
+      return 0;
+    }
+  } else poolLarge++;
+  PetscCall(PetscMallocAlign(POOL_HEADER_BYTES + (c >= 0 ? POOL_CLASS_SIZE(c) : mem), clear, line, func, file, (void **)&raw));
+  head            = (PoolHeader *)raw;
+  head->sizeclass = c;
+  head->magic     = POOL_MAGIC;
+  *result         = raw + POOL_HEADER_BYTES;
+  return 0;
+}
+
+/*@C
+   PetscFreePool - Returns memory obtained with `PetscMallocPool()` to the pool, or to the system if the pool of its size
+   class is full.
+
+   Not Collective
+
+   Input Parameters:
++  ptr - the memory
+.  line - line number where used
+.  func - function calling routine
+-  file - file name where used
+
+   Level: developer
+
+.seealso: `PetscMallocPool()`, `PetscMallocPoolTrim()`
+@*/
+PetscErrorCode PetscFreePool(void *ptr, int line, const char func[], const char file[])
+{
+  PoolHeader *head;
+  int         c;
+
+  if (!ptr) return 0;
+  PetscCall(PoolGetHeader(ptr, line, func, file, &head));
+  c = head->sizeclass;
+  if (c >= 0 && (poolCache.count[c] + 1) * POOL_CLASS_SIZE(c) <= poolMaxCached) {
+    *(void **)ptr     = poolCache.head[c];
+    poolCache.head[c] = ptr;
+    if (++poolCache.count[c] > poolHighWater[c]) poolHighWater[c] = poolCache.count[c];
+    return 0;
+  }
+  head->magic = 0;
+  return PetscFreeAlign(head, line, func, file);
+}
+
+/*@C
+   PetscReallocPool - Changes the size of memory obtained with `PetscMallocPool()`
+
+   Not Collective
+
+   Input Parameters:
++  mem - the new number of bytes
+.  line - line number where used
+.  func - function calling routine
+.  file - file name where used
+-  result - the memory
+
+   Output Parameter:
+.  result - the memory, moved if it no longer fits in its size class
+
+   Level: developer
+
+.seealso: `PetscMallocPool()`, `PetscFreePool()`
+@*/
+PetscErrorCode PetscReallocPool(size_t mem, int line, const char func[], const char file[], void **result)
+{
+  PoolHeader *head;
+  void       *raw;
+
+  if (!*result) return PetscMallocPool(mem, PETSC_FALSE, line, func, file, result);
+  if (!mem) {
+    PetscCall(PetscFreePool(*result, line, func, file));
+    *result = NULL;
+    return 0;
+  }
+  PetscCall(PoolGetHeader(*result, line, func, file, &head));
+  if (head->sizeclass >= 0) {
+    const size_t size = POOL_CLASS_SIZE(head->sizeclass);
+    void        *newresult;
+
+    if (mem <= size) return 0;
+    PetscCall(PetscMallocPool(mem, PETSC_FALSE, line, func, file, &newresult));
+    PetscCall(PetscMemcpy(newresult, *result, size));
+    PetscCall(PetscFreePool(*result, line, func, file));
+    *result = newresult;
+  } else {
+    /* stays a large block even if it shrinks, the header is moved along with the data */
+    raw = head;
+    PetscCall(PetscReallocAlign(POOL_HEADER_BYTES + mem, line, func, file, &raw));
+    *result = (char *)raw + POOL_HEADER_BYTES;
+  }
+  return 0;
+}
+
+/*@C
+   PetscMallocPoolTrim - Returns all the blocks kept for reuse by the calling thread to the system
+
+   Not Collective
+
+   Level: developer
+
+   Note:
+   Called in `PetscFinalize()`, and may be called after a phase of a computation that allocated many small blocks that
+   will not be needed again.
+
+.seealso: `PetscMallocPool()`, `PetscFreePool()`
+@*/
+PetscErrorCode PetscMallocPoolTrim(void)
+{
+  PetscFunctionBegin;
+  for (int c = 0; c < POOL_NUM_CLASSES; c++) {
+    while (poolCache.head[c]) {
+      void       *ptr  = poolCache.head[c];
+      PoolHeader *head = (PoolHeader *)((char *)ptr - POOL_HEADER_BYTES);
+
+      poolCache.head[c] = *(void **)ptr;
+      head->magic       = 0;
+      PetscCall(PetscFreeAlign(head, __LINE__, PETSC_FUNCTION_NAME, __FILE__));
+    }
+    poolCache.count[c] = 0;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Called by PetscMallocView() */
+PETSC_INTERN PetscErrorCode PetscMallocPoolView_Private(FILE *fp, PetscMPIInt rank)
+{
+  PetscLogDouble allocs = 0, reused = 0;
+
+  PetscFunctionBegin;
+  for (int c = 0; c < POOL_NUM_CLASSES; c++) {
+    allocs += poolAllocs[c];
+    reused += poolReused[c];
+  }
+  if (!allocs && !poolLarge) PetscFunctionReturn(0);
+  (void)fprintf(fp, "[%d] PetscMallocPool() served %.0f of %.0f allocations from freed blocks, %.0f allocations were too large for the pool\n", rank, reused, allocs, poolLarge);
+  (void)fprintf(fp, "[%d] Pool size class (bytes), allocations, served from freed blocks, most blocks kept for reuse\n", rank);
+  for (int c = 0; c < POOL_NUM_CLASSES; c++) {
+    if (poolAllocs[c]) (void)fprintf(fp, "[%d] %8.0f %12.0f %12.0f %8.0f\n", rank, (PetscLogDouble)POOL_CLASS_SIZE(c), poolAllocs[c], poolReused[c], (PetscLogDouble)poolHighWater[c]);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* -malloc_pool: under the tracing if -malloc_debug or -malloc_view are on, so those keep working */
+PETSC_INTERN PetscErrorCode PetscSetUseMallocPool_Private(PetscInt cache)
+{
+  PetscBool tracing;
+
+  PetscFunctionBegin;
+  if (cache != PETSC_DEFAULT) {
+    PetscCheck(cache >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Pool cache size %" PetscInt_FMT " cannot be negative", cache);
+    poolMaxCached = (size_t)cache;
+  }
+  PetscCall(PetscMallocGetDebug(&tracing, NULL, NULL));
+  if (tracing) PetscCall(PetscMallocTraceSetBase_Private(PetscMallocPool, PetscFreePool, PetscReallocPool));
+  else if (!petscsetmallocvisited) PetscCall(PetscMallocSet(PetscMallocPool, PetscFreePool, PetscReallocPool));
+  else PetscCall(PetscInfo(NULL, "Ignoring -malloc_pool since PetscMallocSet() has already been called\n"));
+  PetscFunctionReturn(0);
+}
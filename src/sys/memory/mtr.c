@@ -15,6 +15,13 @@ PETSC_EXTERN PetscErrorCode PetscMallocAlign(size_t, PetscBool, int, const char[
 PETSC_EXTERN PetscErrorCode PetscFreeAlign(void *, int, const char[], const char[]);
 PETSC_EXTERN PetscErrorCode PetscReallocAlign(size_t, int, const char[], const char[], void **);
 
+/* The routines the tracing gets its memory from, those of the pool with -malloc_pool */
+static PetscErrorCode (*TRMallocBase)(size_t, PetscBool, int, const char[], const char[], void **) = PetscMallocAlign;
+static PetscErrorCode (*TRFreeBase)(void *, int, const char[], const char[])                       = PetscFreeAlign;
+static PetscErrorCode (*TRReallocBase)(size_t, int, const char[], const char[], void **)           = PetscReallocAlign;
+
+PETSC_INTERN PetscErrorCode PetscMallocPoolView_Private(FILE *, PetscMPIInt);
+
 #define CLASSID_VALUE ((PetscClassId)0xf0e0d0c9)
 #define ALREADY_FREED ((PetscClassId)0x0f0e0d9c)
 
@@ -183,7 +190,7 @@ PetscErrorCode PetscTrMallocDefault(size_t a, PetscBool clear, int lineno, const
   PetscCall(PetscMallocValidate(lineno, function, filename));
 
   nsize = (a + (PETSC_MEMALIGN - 1)) & ~(PETSC_MEMALIGN - 1);
-  PetscCall(PetscMallocAlign(nsize + sizeof(TrSPACE) + sizeof(PetscClassId), clear, lineno, function, filename, (void **)&inew));
+  PetscCall((*TRMallocBase)(nsize + sizeof(TrSPACE) + sizeof(PetscClassId), clear, lineno, function, filename, (void **)&inew));
 
   head = (TRSPACE *)inew;
   inew += sizeof(TrSPACE);
@@ -326,7 +333,7 @@ PetscErrorCode PetscTrFreeDefault(void *aa, int lineno, const char function[], c
   else TRhead = head->next;
 
   if (head->next) head->next->prev = head->prev;
-  PetscCall(PetscFreeAlign(a, lineno, function, filename));
+  PetscCall((*TRFreeBase)(a, lineno, function, filename));
   PetscFunctionReturn(0);
 }
 
@@ -407,7 +414,7 @@ PetscErrorCode PetscTrReallocDefault(size_t len, int lineno, const char function
   if (head->next) head->next->prev = head->prev;
 
   nsize = (len + (PETSC_MEMALIGN - 1)) & ~(PETSC_MEMALIGN - 1);
-  PetscCall(PetscReallocAlign(nsize + sizeof(TrSPACE) + sizeof(PetscClassId), lineno, function, filename, (void **)&inew));
+  PetscCall((*TRReallocBase)(nsize + sizeof(TrSPACE) + sizeof(PetscClassId), lineno, function, filename, (void **)&inew));
 
   head = (TRSPACE *)inew;
   inew += sizeof(TrSPACE);
@@ -858,6 +865,8 @@ PetscErrorCode PetscMallocTraceGet(PetscBool *logging)
 
      `PetscMemoryView()` gives a brief summary of current memory usage
 
+     With -malloc_pool it also shows how many allocations of each size class `PetscMallocPool()` served from freed blocks
+
 .seealso: `PetscMallocGetCurrentUsage()`, `PetscMallocDump()`, `PetscMallocViewSet()`, `PetscMemoryView()`
 @*/
 PetscErrorCode PetscMallocView(FILE *fp)
@@ -917,6 +926,7 @@ PetscErrorCode PetscMallocView(FILE *fp)
   free(shortlength);
   free(shortcount);
   free((char **)shortfunction);
+  PetscCall(PetscMallocPoolView_Private(fp, rank));
   err = fflush(fp);
   PetscCheck(!err, PETSC_COMM_SELF, PETSC_ERR_SYS, "fflush() failed on file");
   PetscFunctionReturn(0);
@@ -963,6 +973,20 @@ PetscErrorCode PetscMallocSetDebug(PetscBool eachcall, PetscBool initializenan)
   PetscLogMallocMax     = 10000;
   PetscLogMalloc        = -1;
   TRdebugIinitializenan = initializenan;
+  TRMallocBase          = PetscMallocAlign;
+  TRFreeBase            = PetscFreeAlign;
+  TRReallocBase         = PetscReallocAlign;
+  PetscFunctionReturn(0);
+}
+
+/* Called by -malloc_pool, before anything is allocated with the tracing */
+PETSC_INTERN PetscErrorCode PetscMallocTraceSetBase_Private(PetscErrorCode (*imalloc)(size_t, PetscBool, int, const char[], const char[], void **), PetscErrorCode (*ifree)(void *, int, const char[], const char[]), PetscErrorCode (*irealloc)(size_t, int, const char[], const char[], void **))
+{
+  PetscFunctionBegin;
+  PetscCheck(!TRfrags, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Cannot change the memory used by the tracing once it has allocated memory");
+  TRMallocBase  = imalloc;
+  TRFreeBase    = ifree;
+  TRReallocBase = irealloc;
   PetscFunctionReturn(0);
 }
 
@@ -1,8 +1,10 @@
-#include <petsc/private/deviceimpl.h>
+#include "hoststream.hpp"
 
 #include <petsc/private/cpp/macros.hpp>
 #include <petsc/private/cpp/utility.hpp>
 
+#include <cstring> // std::memcpy, std::memset
+
 namespace Petsc
 {
 
@@ -16,25 +18,157 @@ namespace impl
 {
 
 class DeviceContext {
+  // the point of a stream an event was recorded at
+  struct Event {
+    std::shared_ptr<Stream> stream{};
+    std::uint64_t           target = 0;
+  };
+
+  PETSC_CXX_COMPAT_DECL(std::shared_ptr<Stream> &stream_(PetscDeviceContext dctx)) { return *static_cast<std::shared_ptr<Stream> *>(dctx->data); }
+  PETSC_CXX_COMPAT_DECL(Event *event_cast_(PetscEvent event)) { return static_cast<Event *>(event->data); }
+  PETSC_CXX_COMPAT_DECL(std::shared_ptr<Graph> &graph_cast_(PetscDeviceGraph graph)) { return *static_cast<std::shared_ptr<Graph> *>(graph->data); }
+
 public:
-  PETSC_CXX_COMPAT_DECL(PetscErrorCode destroy(PetscDeviceContext)) { return 0; }
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode destroy(PetscDeviceContext dctx))
+  {
+    PetscFunctionBegin;
+    if (dctx->data) {
+      auto &stream = stream_(dctx);
+
+      // a capture that was not ended is dropped
+      if (stream->capturing()) {
+        std::shared_ptr<Graph> graph;
+
+        (void)stream->end_capture(graph);
+      }
+      // the work may still use the memory of the context's objects
+      PetscCall(stream->synchronize());
+      delete static_cast<std::shared_ptr<Stream> *>(dctx->data);
+      dctx->data = nullptr;
+    }
+    PetscFunctionReturn(0);
+  }
   PETSC_CXX_COMPAT_DECL(PetscErrorCode changeStreamType(PetscDeviceContext, PetscStreamType)) { return 0; }
   PETSC_CXX_COMPAT_DECL(PetscErrorCode setUp(PetscDeviceContext)) { return 0; }
-  PETSC_CXX_COMPAT_DECL(PetscErrorCode query(PetscDeviceContext, PetscBool *idle))
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode query(PetscDeviceContext dctx, PetscBool *idle))
+  {
+    PetscFunctionBegin;
+    *idle = stream_(dctx)->idle() ? PETSC_TRUE : PETSC_FALSE;
+    PetscFunctionReturn(0);
+  }
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode waitForContext(PetscDeviceContext dctxa, PetscDeviceContext dctxb))
   {
+    const auto &streamb = stream_(dctxb);
+
     PetscFunctionBegin;
-    *idle = PETSC_TRUE; // the host is always idle
+    PetscCall(stream_(dctxa)->wait_for(streamb, streamb->record()));
+    PetscFunctionReturn(0);
+  }
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode synchronize(PetscDeviceContext dctx))
+  {
+    PetscFunctionBegin;
+    PetscCall(stream_(dctx)->synchronize());
     PetscFunctionReturn(0);
   }
-  PETSC_CXX_COMPAT_DECL(PetscErrorCode waitForContext(PetscDeviceContext, PetscDeviceContext)) { return 0; }
-  PETSC_CXX_COMPAT_DECL(PetscErrorCode synchronize(PetscDeviceContext)) { return 0; }
   PETSC_CXX_COMPAT_DECL(PetscErrorCode getBlasHandle(PetscDeviceContext, void *)) { SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "Not implemented"); }
   PETSC_CXX_COMPAT_DECL(PetscErrorCode getSolverHandle(PetscDeviceContext, void *)) { SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "Not implemented"); }
   PETSC_CXX_COMPAT_DECL(PetscErrorCode getStreamHandle(PetscDeviceContext, void *)) { SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "Not implemented"); }
   PETSC_CXX_COMPAT_DECL(PetscErrorCode beginTimer(PetscDeviceContext)) { SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "Not implemented"); }
   PETSC_CXX_COMPAT_DECL(PetscErrorCode endTimer(PetscDeviceContext, PetscLogDouble *)) { SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "Not implemented"); }
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode memFree(PetscDeviceContext dctx, PetscMemType, void **))
+  {
+    PetscFunctionBegin;
+    // the memory is freed by the caller once the work queued before is done
+    PetscCall(stream_(dctx)->synchronize());
+    PetscFunctionReturn(0);
+  }
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode memCopy(PetscDeviceContext dctx, void *PETSC_RESTRICT dest, const void *PETSC_RESTRICT src, std::size_t n, PetscDeviceCopyMode mode))
+  {
+    PetscFunctionBegin;
+    PetscCheck(mode == PETSC_DEVICE_COPY_HTOH, PETSC_COMM_SELF, PETSC_ERR_SUP, "Device context (id: %" PetscInt64_FMT ", name: %s, type: host) can only handle copying host memory", PetscObjectCast(dctx)->id, PetscObjectCast(dctx)->name);
+    PetscCall(stream_(dctx)->enqueue([=] {
+      std::memcpy(dest, src, n);
+      return PetscErrorCode(0);
+    }));
+    PetscFunctionReturn(0);
+  }
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode memSet(PetscDeviceContext dctx, PetscMemType mtype, void *ptr, PetscInt v, std::size_t n))
+  {
+    PetscFunctionBegin;
+    PetscCheck(PetscMemTypeHost(mtype), PETSC_COMM_SELF, PETSC_ERR_SUP, "Device context (id: %" PetscInt64_FMT ", name: %s, type: host) can only handle memsetting host memory", PetscObjectCast(dctx)->id, PetscObjectCast(dctx)->name);
+    PetscCall(stream_(dctx)->enqueue([=] {
+      std::memset(ptr, static_cast<int>(v), n);
+      return PetscErrorCode(0);
+    }));
+    PetscFunctionReturn(0);
+  }
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode createEvent(PetscDeviceContext, PetscEvent event))
+  {
+    PetscFunctionBegin;
+    PetscCallCXX(event->data = new Event{});
+    event->destroy = [](PetscEvent event) {
+      PetscFunctionBegin;
+      delete event_cast_(event);
+      event->data = nullptr;
+      PetscFunctionReturn(0);
+    };
+    PetscFunctionReturn(0);
+  }
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode recordEvent(PetscDeviceContext dctx, PetscEvent event))
+  {
+    const auto ev = event_cast_(event);
+
+    PetscFunctionBegin;
+    ev->stream = stream_(dctx);
+    ev->target = ev->stream->record();
+    PetscFunctionReturn(0);
+  }
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode waitForEvent(PetscDeviceContext dctx, PetscEvent event))
+  {
+    const auto ev = event_cast_(event);
+
+    PetscFunctionBegin;
+    if (ev->stream) PetscCall(stream_(dctx)->wait_for(ev->stream, ev->target));
+    PetscFunctionReturn(0);
+  }
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode launchHost(PetscDeviceContext dctx, PetscErrorCode (*kernel)(void *), void *ctx))
+  {
+    PetscFunctionBegin;
+    PetscCall(stream_(dctx)->enqueue([=] { return kernel(ctx); }));
+    PetscFunctionReturn(0);
+  }
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode beginCapture(PetscDeviceContext dctx))
+  {
+    PetscFunctionBegin;
+    PetscCall(stream_(dctx)->begin_capture());
+    PetscFunctionReturn(0);
+  }
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode endCapture(PetscDeviceContext dctx, PetscDeviceGraph graph))
+  {
+    std::shared_ptr<Graph> g;
+
+    PetscFunctionBegin;
+    PetscCall(stream_(dctx)->end_capture(g));
+    graph->nops   = static_cast<PetscInt>(g->num_functions());
+    graph->ntasks = static_cast<PetscInt>(g->num_tasks());
+    PetscCallCXX(graph->data = new std::shared_ptr<Graph>(std::move(g)));
+    graph->destroy = [](PetscDeviceGraph graph) {
+      PetscFunctionBegin;
+      // the launches still queued hold their own references to the functions
+      delete &graph_cast_(graph);
+      graph->data = nullptr;
+      PetscFunctionReturn(0);
+    };
+    PetscFunctionReturn(0);
+  }
+  PETSC_CXX_COMPAT_DECL(PetscErrorCode launchGraph(PetscDeviceContext dctx, PetscDeviceGraph graph))
+  {
+    PetscFunctionBegin;
+    PetscCall(graph_cast_(graph)->launch(stream_(dctx)));
+    PetscFunctionReturn(0);
+  }
 
-  const _DeviceContextOps ops = {destroy, changeStreamType, setUp, query, waitForContext, synchronize, getBlasHandle, getSolverHandle, getStreamHandle, beginTimer, endTimer, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+  const _DeviceContextOps ops = {destroy, changeStreamType, setUp, query, waitForContext, synchronize, getBlasHandle, getSolverHandle, getStreamHandle, beginTimer, endTimer, nullptr, memFree, memCopy, memSet, createEvent, recordEvent, waitForEvent, launchHost, beginCapture, endCapture, launchGraph};
 };
 
 } // namespace impl
@@ -52,5 +186,6 @@ PetscErrorCode PetscDeviceContextCreate_HOST(PetscDeviceContext dctx)
   PetscFunctionBegin;
   PetscAssert(!dctx->data, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "PetscDeviceContext %" PetscInt64_FMT " is of type host, but still has data member %p", PetscObjectCast(dctx)->id, dctx->data);
   PetscCall(PetscArraycpy(dctx->ops, &hostctx.ops, 1));
+  PetscCallCXX(dctx->data = new std::shared_ptr<::Petsc::device::host::impl::Stream>(std::make_shared<::Petsc::device::host::impl::Stream>()));
   PetscFunctionReturn(0);
 }
@@ -1,4 +1,5 @@
 #include "hostdevice.hpp"
+#include "hoststream.hpp"
 
 namespace Petsc
 {
@@ -11,6 +12,8 @@ namespace host
 
 PetscErrorCode Device::initialize(MPI_Comm comm, PetscInt *defaultDeviceId, PetscBool *defaultView, PetscDeviceInitType *defaultInitType) noexcept
 {
+  PetscInt nthreads = impl::ThreadPool::get().size();
+
   PetscFunctionBegin;
   // the host is always id 0
   *defaultDeviceId = 0;
@@ -19,7 +22,14 @@ PetscErrorCode Device::initialize(MPI_Comm comm, PetscInt *defaultDeviceId, Pets
 
   PetscOptionsBegin(comm, nullptr, "PetscDevice host Options", "Sys");
   PetscCall(base_type::PetscOptionDeviceView(PetscOptionsObject, defaultView, nullptr));
+  PetscCall(PetscOptionsBoundedInt("-device_threads_host", "Number of threads running the work queued on host PetscDeviceContexts, 0 to run it immediately", "PetscDeviceContextLaunchHost()", nthreads, &nthreads, nullptr, 0));
   PetscOptionsEnd();
+  if (nthreads && !impl::ThreadPool::get().running()) {
+    PetscCall(impl::ThreadPool::get().start(nthreads));
+    PetscCall(PetscInfo(nullptr, "Running the work of host PetscDeviceContexts on %" PetscInt_FMT " threads\n", nthreads));
+    // all queued work completes before PetscFinalize() returns
+    PetscCall(PetscRegisterFinalize([] { return impl::ThreadPool::get().stop(); }));
+  }
   PetscFunctionReturn(0);
 }
 
@@ -0,0 +1,414 @@
+#include "hoststream.hpp"
+
+namespace Petsc
+{
+
+namespace device
+{
+
+namespace host
+{
+
+namespace impl
+{
+
+// the index of the pool thread running the caller, -1 for the other threads
+static thread_local std::ptrdiff_t worker_id = -1;
+
+// ==========================================================================================
+// Stream
+// ==========================================================================================
+
+PetscErrorCode Stream::enqueue(std::function<PetscErrorCode()> work) noexcept
+{
+  auto &pool     = ThreadPool::get();
+  bool  activate = false;
+
+  PetscFunctionBegin;
+  if (capture_) {
+    auto      &graph = *capture_;
+    const auto id    = capture_id_;
+
+    // consecutive functions of the stream go in the same item, unless the stream was recorded in between
+    if (graph.cut_[id] || graph.items_.empty() || graph.items_.back().stream != id || !graph.items_.back().work) {
+      PetscCallCXX(graph.items_.emplace_back());
+      graph.items_.back().stream = id;
+      PetscCallCXX(graph.items_.back().work = std::make_shared<Graph::function_list>());
+      ++graph.counts_[id];
+      graph.cut_[id] = false;
+    }
+    PetscCallCXX(graph.items_.back().work->push_back(std::move(work)));
+    PetscFunctionReturn(0);
+  }
+  if (!pool.running()) {
+    PetscCall(work());
+    PetscFunctionReturn(0);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    PetscCallCXX(tasks_.emplace_back());
+    tasks_.back().work = std::move(work);
+    ++submitted_;
+    activate   = !scheduled_;
+    scheduled_ = true;
+  }
+  if (activate) pool.activate(shared_from_this());
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode Stream::wait_for(const std::shared_ptr<Stream> &stream, std::uint64_t target) noexcept
+{
+  auto &pool     = ThreadPool::get();
+  bool  activate = false;
+
+  PetscFunctionBegin;
+  if (stream.get() == this) PetscFunctionReturn(0);
+  if (capture_ || stream->capture_) {
+    PetscCheck(stream->capture_, PETSC_COMM_SELF, PETSC_ERR_SUP, "A host PetscDeviceContext being captured cannot wait for one that is not");
+    // a stream forked from a capturing one takes part in the capture
+    if (!capture_) PetscCall(stream->capture_->add_stream(shared_from_this()));
+    PetscCheck(capture_ == stream->capture_, PETSC_COMM_SELF, PETSC_ERR_SUP, "A host PetscDeviceContext cannot wait for one captured in another graph");
+    {
+      auto &graph = *capture_;
+
+      PetscCallCXX(graph.items_.emplace_back());
+      graph.items_.back().stream      = capture_id_;
+      graph.items_.back().wait_stream = stream->capture_id_;
+      graph.items_.back().wait_target = target;
+      ++graph.counts_[capture_id_];
+    }
+    PetscFunctionReturn(0);
+  }
+  if (!pool.running()) PetscFunctionReturn(0);
+  {
+    std::lock_guard<std::mutex> lock(stream->mutex_);
+
+    if (stream->completed_ >= target) PetscFunctionReturn(0);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    PetscCallCXX(tasks_.emplace_back());
+    tasks_.back().wait_stream = stream;
+    tasks_.back().wait_target = target;
+    ++submitted_;
+    activate   = !scheduled_;
+    scheduled_ = true;
+  }
+  if (activate) pool.activate(shared_from_this());
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode Stream::synchronize() noexcept
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    PetscCallCXX(done_.wait(lock, [this] { return completed_ == submitted_; }));
+    ierr   = error_;
+    error_ = 0;
+  }
+  PetscCheck(!ierr, PETSC_COMM_SELF, ierr, "A function queued on a host PetscDeviceContext returned error code %d", (int)ierr);
+  PetscFunctionReturn(0);
+}
+
+std::uint64_t Stream::record() noexcept
+{
+  if (capture_) {
+    // the items queued so far, which the functions queued next must not be fused with
+    capture_->cut_[capture_id_] = true;
+    return capture_->counts_[capture_id_];
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    return submitted_;
+  }
+}
+
+bool Stream::idle() noexcept
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return completed_ == submitted_;
+}
+
+PetscErrorCode Stream::begin_capture() noexcept
+{
+  PetscFunctionBegin;
+  PetscCheck(!capture_, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Host PetscDeviceContext is already being captured");
+  PetscCallCXX(capture_ = std::make_shared<Graph>());
+  PetscCall(capture_->add_stream(shared_from_this()));
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode Stream::end_capture(std::shared_ptr<Graph> &graph) noexcept
+{
+  PetscFunctionBegin;
+  PetscCheck(capture_ && !capture_id_, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Host PetscDeviceContext did not begin a capture");
+  graph = std::move(capture_);
+  // the streams that took part are released, the forked work is replayed on streams of the graph
+  for (std::size_t i = 0; i < graph->streams_.size(); ++i) {
+    auto &stream = graph->streams_[i];
+
+    stream->capture_.reset();
+    if (i) PetscCallCXX(stream = std::make_shared<Stream>());
+    else stream.reset();
+  }
+  PetscFunctionReturn(0);
+}
+
+// ==========================================================================================
+// Graph
+// ==========================================================================================
+
+PetscErrorCode Graph::add_stream(const std::shared_ptr<Stream> &stream) noexcept
+{
+  PetscFunctionBegin;
+  PetscCallCXX(streams_.push_back(stream));
+  PetscCallCXX(counts_.push_back(0));
+  PetscCallCXX(cut_.push_back(false));
+  // the stream that began the capture already holds the graph
+  stream->capture_    = streams_.front()->capture_;
+  stream->capture_id_ = streams_.size() - 1;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode Graph::launch(const std::shared_ptr<Stream> &stream) noexcept
+{
+  // the number of tasks queued on each stream before the launch and after each of its items
+  std::vector<std::vector<std::uint64_t>> done;
+  const auto                              get = [&](std::size_t i) -> const std::shared_ptr<Stream> & { return i ? streams_[i] : stream; };
+
+  PetscFunctionBegin;
+  PetscCheck(!stream->capturing(), PETSC_COMM_SELF, PETSC_ERR_SUP, "Cannot launch a graph on a host PetscDeviceContext being captured");
+  PetscCallCXX(done.resize(streams_.size()));
+  for (std::size_t i = 0; i < streams_.size(); ++i) {
+    PetscCallCXX(done[i].reserve(counts_[i] + 1));
+    done[i].push_back(get(i)->record());
+  }
+  for (auto &&item : items_) {
+    const auto &s = get(item.stream);
+
+    if (const auto &work = item.work) {
+      if (work->size() == 1) {
+        PetscCall(s->enqueue(work->front()));
+      } else {
+        PetscCall(s->enqueue([work] {
+          for (auto &&f : *work) {
+            const auto ierr = f();
+
+            if (ierr) return ierr;
+          }
+          return PetscErrorCode(0);
+        }));
+      }
+    } else {
+      PetscCall(s->wait_for(get(item.wait_stream), done[item.wait_stream][item.wait_target]));
+    }
+    done[item.stream].push_back(s->record());
+  }
+  // the stream of the launch waits for the forked work, whether or not it was joined in the capture
+  for (std::size_t i = 1; i < streams_.size(); ++i) PetscCall(stream->wait_for(streams_[i], streams_[i]->record()));
+  PetscFunctionReturn(0);
+}
+
+std::size_t Graph::num_functions() const noexcept
+{
+  std::size_t n = 0;
+
+  for (auto &&item : items_) n += item.work ? item.work->size() : 0;
+  return n;
+}
+
+std::size_t Graph::num_tasks() const noexcept
+{
+  std::size_t n = 0;
+
+  for (auto &&item : items_) n += item.work ? 1 : 0;
+  return n;
+}
+
+// ==========================================================================================
+// ThreadPool
+// ==========================================================================================
+
+ThreadPool &ThreadPool::get() noexcept
+{
+  static ThreadPool pool;
+
+  return pool;
+}
+
+PetscErrorCode ThreadPool::start(PetscInt nthreads) noexcept
+{
+  PetscFunctionBegin;
+  if (running() || nthreads <= 0) PetscFunctionReturn(0);
+  stop_ = false;
+  PetscCallCXX(queues_.reset(new Queue[nthreads]));
+  PetscCallCXX(threads_.reserve(nthreads));
+  for (PetscInt i = 0; i < nthreads; ++i) PetscCallCXX(threads_.emplace_back([this, i] { work(static_cast<std::size_t>(i)); }));
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode ThreadPool::stop() noexcept
+{
+  PetscFunctionBegin;
+  if (!running()) PetscFunctionReturn(0);
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    PetscCallCXX(idle_.wait(lock, [this] { return active_ == 0; }));
+    stop_ = true;
+  }
+  wakeup_.notify_all();
+  for (auto &&thread : threads_) PetscCallCXX(thread.join());
+  threads_.clear();
+  queues_.reset();
+  PetscFunctionReturn(0);
+}
+
+// a stream that had no queued work now has some
+void ThreadPool::activate(std::shared_ptr<Stream> stream) noexcept
+{
+  ++active_;
+  schedule(std::move(stream));
+}
+
+// queue the stream, on the queue of the calling thread if it belongs to the pool
+void ThreadPool::schedule(std::shared_ptr<Stream> stream) noexcept
+{
+  const auto n  = threads_.size();
+  const auto id = worker_id >= 0 ? static_cast<std::size_t>(worker_id) : next_++ % n;
+
+  {
+    std::lock_guard<std::mutex> lock(queues_[id].mutex);
+
+    queues_[id].streams.push_back(std::move(stream));
+  }
+  ++ready_;
+  // taking the lock ensures a thread deciding to sleep has either seen ready_ or is waiting
+  { std::lock_guard<std::mutex> lock(mutex_); }
+  wakeup_.notify_one();
+}
+
+// the most recently queued stream of our own queue, which is likely in cache, or else the oldest one of another queue
+bool ThreadPool::pop(std::size_t id, std::shared_ptr<Stream> &stream) noexcept
+{
+  const auto n = threads_.size();
+
+  for (std::size_t k = 0; k < n; ++k) {
+    auto                       &queue = queues_[(id + k) % n];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.streams.empty()) continue;
+    if (k) {
+      stream = std::move(queue.streams.front());
+      queue.streams.pop_front();
+    } else {
+      stream = std::move(queue.streams.back());
+      queue.streams.pop_back();
+    }
+    --ready_;
+    return true;
+  }
+  return false;
+}
+
+// a task of the stream completed, resume the streams waiting for it
+void ThreadPool::complete(Stream &stream, std::unique_lock<std::mutex> &lock) noexcept
+{
+  std::vector<std::shared_ptr<Stream>> resumed;
+
+  ++stream.completed_;
+  for (auto it = stream.waiters_.begin(); it != stream.waiters_.end();) {
+    if (it->first <= stream.completed_) {
+      resumed.push_back(std::move(it->second));
+      it = stream.waiters_.erase(it);
+    } else ++it;
+  }
+  stream.done_.notify_all();
+  lock.unlock();
+  for (auto &&waiter : resumed) schedule(std::move(waiter));
+  lock.lock();
+}
+
+// run the tasks of the stream until it has none left or must wait for another stream
+void ThreadPool::run(const std::shared_ptr<Stream> &stream) noexcept
+{
+  std::unique_lock<std::mutex> lock(stream->mutex_);
+
+  if (stream->parked_) {
+    // the wait it was parked on is met
+    stream->parked_ = false;
+    complete(*stream, lock);
+  }
+  while (!stream->tasks_.empty()) {
+    auto task = std::move(stream->tasks_.front());
+
+    stream->tasks_.pop_front();
+    if (const auto &other = task.wait_stream) {
+      stream->parked_ = true;
+      lock.unlock();
+      {
+        std::lock_guard<std::mutex> olock(other->mutex_);
+
+        if (other->completed_ < task.wait_target) {
+          // another thread runs the stream again once the wait is met, do not touch it anymore
+          other->waiters_.emplace_back(task.wait_target, stream);
+          return;
+        }
+      }
+      lock.lock();
+      stream->parked_ = false;
+    } else {
+      PetscErrorCode ierr;
+
+      lock.unlock();
+      try {
+        ierr = task.work();
+      } catch (...) {
+        ierr = PETSC_ERR_LIB;
+      }
+      lock.lock();
+      if (ierr && !stream->error_) stream->error_ = ierr;
+    }
+    complete(*stream, lock);
+  }
+  stream->scheduled_ = false;
+  lock.unlock();
+  if (--active_ == 0) {
+    std::lock_guard<std::mutex> plock(mutex_);
+
+    idle_.notify_all();
+  }
+}
+
+void ThreadPool::work(std::size_t id) noexcept
+{
+  worker_id = static_cast<std::ptrdiff_t>(id);
+  while (true) {
+    std::shared_ptr<Stream> stream;
+
+    if (pop(id, stream)) {
+      run(stream);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    wakeup_.wait(lock, [this] { return stop_ || ready_ > 0; });
+    if (stop_ && !ready_) return;
+  }
+}
+
+} // namespace impl
+
+} // namespace host
+
+} // namespace device
+
+} // namespace Petsc
@@ -0,0 +1,153 @@
+#ifndef HOSTSTREAM_HPP
+#define HOSTSTREAM_HPP
+
+#if defined(__cplusplus)
+  #include <petsc/private/deviceimpl.h>
+
+  #include <atomic>
+  #include <condition_variable>
+  #include <cstdint>
+  #include <deque>
+  #include <functional>
+  #include <memory>
+  #include <mutex>
+  #include <thread>
+  #include <utility>
+  #include <vector>
+
+namespace Petsc
+{
+
+namespace device
+{
+
+namespace host
+{
+
+namespace impl
+{
+
+class Stream;
+class Graph;
+
+// An entry of a stream, either work or a wait for the first target tasks of another stream to complete
+struct Task {
+  std::function<PetscErrorCode()> work{};
+  std::shared_ptr<Stream>         wait_stream{};
+  std::uint64_t                   wait_target = 0;
+};
+
+// The work queued on a host PetscDeviceContext. The tasks of a stream run one after the other, in the order they were
+// queued, but the tasks of different streams run concurrently on the threads of the ThreadPool. Without threads each
+// task runs as soon as it is queued.
+class Stream : public std::enable_shared_from_this<Stream> {
+public:
+  PETSC_NODISCARD PetscErrorCode enqueue(std::function<PetscErrorCode()>) noexcept;
+  PETSC_NODISCARD PetscErrorCode wait_for(const std::shared_ptr<Stream> &, std::uint64_t) noexcept;
+  PETSC_NODISCARD PetscErrorCode synchronize() noexcept;
+  // the number of tasks queued so far, what waiting for this stream at this point means
+  PETSC_NODISCARD std::uint64_t record() noexcept;
+  PETSC_NODISCARD bool          idle() noexcept;
+  // while capturing the work is recorded in a Graph instead of being run; the streams that wait for a capturing stream
+  // take part in the capture until it ends
+  PETSC_NODISCARD PetscErrorCode begin_capture() noexcept;
+  PETSC_NODISCARD PetscErrorCode end_capture(std::shared_ptr<Graph> &) noexcept;
+  PETSC_NODISCARD bool           capturing() const noexcept { return static_cast<bool>(capture_); }
+
+private:
+  friend class ThreadPool;
+  friend class Graph;
+
+  std::mutex                                                     mutex_{};
+  std::condition_variable                                        done_{};
+  std::deque<Task>                                               tasks_{};
+  std::uint64_t                                                  submitted_ = 0, completed_ = 0;
+  bool                                                           scheduled_ = false; // queued in or run by the pool
+  bool                                                           parked_    = false; // the first task is a wait not yet met
+  std::vector<std::pair<std::uint64_t, std::shared_ptr<Stream>>> waiters_{};         // the streams parked on this one
+  PetscErrorCode                                                 error_ = 0;         // the first error of its tasks
+  std::shared_ptr<Graph>                                         capture_{};         // the graph being captured
+  std::size_t                                                    capture_id_ = 0;    // the index of the stream in it
+};
+
+// The work captured from one stream and the streams it forked, replayed on a stream by launch(). Consecutive functions
+// of a stream are fused into a single task, so that a replay pays for one dispatch and one synchronization per
+// sequence instead of one per function, and none of the arguments are validated again.
+class Graph {
+public:
+  PETSC_NODISCARD PetscErrorCode launch(const std::shared_ptr<Stream> &) noexcept;
+  // the number of functions and of tasks of a replay
+  PETSC_NODISCARD std::size_t    num_functions() const noexcept;
+  PETSC_NODISCARD std::size_t    num_tasks() const noexcept;
+
+private:
+  friend class Stream;
+
+  using function_list = std::vector<std::function<PetscErrorCode()>>;
+
+  // either functions run in order or a wait for the first wait_target items of another stream
+  struct Item {
+    std::size_t                    stream = 0;
+    std::shared_ptr<function_list> work{};
+    std::size_t                    wait_stream = 0;
+    std::uint64_t                  wait_target = 0;
+  };
+
+  // while capturing the streams taking part, the first one began the capture; afterwards the streams the forked work
+  // is replayed on, the first one is the stream passed to launch()
+  std::vector<std::shared_ptr<Stream>> streams_{};
+  std::vector<std::uint64_t>           counts_{}; // the number of items of each stream
+  std::vector<bool>                    cut_{};    // whether the next function of the stream starts a new item
+  std::vector<Item>                    items_{};  // in the order they were queued
+
+  PETSC_NODISCARD PetscErrorCode add_stream(const std::shared_ptr<Stream> &) noexcept;
+};
+
+// A pool of threads that run the streams with queued work; each thread has its own queue of streams and steals from the
+// queues of the other threads when it runs out of work
+class ThreadPool {
+public:
+  PETSC_NODISCARD static ThreadPool &get() noexcept;
+
+  PETSC_NODISCARD PetscErrorCode start(PetscInt) noexcept;
+  // waits for all queued work to complete before stopping the threads
+  PETSC_NODISCARD PetscErrorCode stop() noexcept;
+  PETSC_NODISCARD bool           running() const noexcept { return !threads_.empty(); }
+  PETSC_NODISCARD PetscInt       size() const noexcept { return static_cast<PetscInt>(threads_.size()); }
+
+private:
+  friend class Stream;
+
+  struct Queue {
+    std::mutex                          mutex{};
+    std::deque<std::shared_ptr<Stream>> streams{};
+  };
+
+  std::vector<std::thread> threads_{};
+  std::unique_ptr<Queue[]> queues_{};
+  std::mutex               mutex_{};
+  std::condition_variable  wakeup_{}, idle_{};
+  std::atomic<int>         ready_{0};  // streams in the queues
+  std::atomic<int>         active_{0}; // streams with queued work, including those parked
+  std::atomic<std::size_t> next_{0};
+  bool                     stop_ = false;
+
+  void activate(std::shared_ptr<Stream>) noexcept;
+  void schedule(std::shared_ptr<Stream>) noexcept;
+  bool pop(std::size_t, std::shared_ptr<Stream> &) noexcept;
+  void run(const std::shared_ptr<Stream> &) noexcept;
+  void complete(Stream &, std::unique_lock<std::mutex> &) noexcept;
+  void work(std::size_t) noexcept;
+};
+
+} // namespace impl
+
+} // namespace host
+
+} // namespace device
+
+} // namespace Petsc
+
+#endif // __cplusplus
+
+#endif // HOSTSTREAM_HPP
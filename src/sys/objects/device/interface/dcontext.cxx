@@ -840,6 +840,205 @@ PetscErrorCode PetscDeviceContextSynchronize(PetscDeviceContext dctx)
   PetscFunctionReturn(0);
 }
 
+/*@C
+  PetscDeviceContextLaunchHost - Queue a function to run on the host, in order with the other work
+  queued on a `PetscDeviceContext`
+
+  Not Collective
+
+  Input Parameters:
++ dctx   - The `PetscDeviceContext`
+. kernel - The function, called as `kernel(ctx)`
+- ctx    - The context of `kernel` (may be `NULL`)
+
+  Notes:
+  With a host `PetscDeviceContext` the function runs on one of the -device_threads_host threads
+  once the work queued on `dctx` before it has completed, while the caller goes on. The functions
+  launched on different contexts run concurrently, unless the contexts wait for one another with
+  `PetscDeviceContextWaitForContext()` (or `PetscDeviceContextFork()` and
+  `PetscDeviceContextJoin()`). Thus, for example, independent vector updates computed by plain loops
+  over the arrays of several `Vec` can overlap on many-core processors. Without threads, the
+  default, the function runs immediately.
+
+  With other device types the host waits for `dctx` and then calls the function.
+
+  An error returned by the function is returned by the next `PetscDeviceContextSynchronize()` of
+  `dctx`. Since the function runs on another thread it must be thread safe, and, unless PETSc was
+  configured with --with-threadsafety, it must not call PETSc routines (including `PetscLogFlops()`).
+  The memory it uses must stay valid until it has run.
+
+  DAG representation:
+.vb
+  time ->
+
+  -> dctx - |= CALL =| - dctx ->
+.ve
+
+  Level: intermediate
+
+.N ASYNC_API
+
+.seealso: `PetscDeviceContextSynchronize()`, `PetscDeviceContextWaitForContext()`,
+`PetscDeviceContextFork()`, `PetscDeviceContextJoin()`
+@*/
+PetscErrorCode PetscDeviceContextLaunchHost(PetscDeviceContext dctx, PetscErrorCode (*kernel)(void *), void *ctx)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscDeviceContextGetOptionalNullContext_Internal(&dctx));
+  PetscValidFunction(kernel, 2);
+  if (dctx->ops->launchhost) {
+    PetscUseTypeMethod(dctx, launchhost, kernel, ctx);
+  } else {
+    PetscCall(PetscDeviceContextSynchronize(dctx));
+    PetscCall((*kernel)(ctx));
+  }
+  PetscCall(PetscObjectStateIncrease(PetscObjectCast(dctx)));
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscDeviceContextBeginCapture - Begin recording the work queued on a `PetscDeviceContext` into
+  a `PetscDeviceGraph`
+
+  Not Collective
+
+  Input Parameter:
+. dctx - The `PetscDeviceContext`
+
+  Notes:
+  Until `PetscDeviceContextEndCapture()` the work queued on `dctx` (with
+  `PetscDeviceContextLaunchHost()`, `PetscDeviceMemcpy()`, `PetscDeviceMemset()`, ...) is recorded
+  instead of being run. The contexts that wait for `dctx`, in particular those created by
+  `PetscDeviceContextFork()`, take part in the capture, so that the graph holds the whole DAG of the
+  work, including its parallelism. A captured context may only wait for contexts taking part in the
+  same capture.
+
+  This is meant for the sequence of operations repeated by every iteration of a solver, for
+  example the kernels of a Krylov cycle or of a stage of an explicit Runge-Kutta method on small
+  local problems, where the cost of queuing each operation is not negligible. The arguments of the
+  operations are recorded, so each launch of the graph works on the same memory.
+
+  Only host contexts support capturing.
+
+  Level: advanced
+
+.seealso: `PetscDeviceContextEndCapture()`, `PetscDeviceGraphLaunch()`, `PetscDeviceGraphDestroy()`,
+`PetscDeviceContextLaunchHost()`
+@*/
+PetscErrorCode PetscDeviceContextBeginCapture(PetscDeviceContext dctx)
+{
+  PetscDeviceType dtype;
+
+  PetscFunctionBegin;
+  PetscCall(PetscDeviceContextGetOptionalNullContext_Internal(&dctx));
+  PetscCall(PetscDeviceContextGetDeviceType(dctx, &dtype));
+  PetscCheck(dctx->ops->begincapture, PETSC_COMM_SELF, PETSC_ERR_SUP, "PetscDeviceContext of type %s does not support capturing", PetscDeviceTypes[dtype]);
+  PetscUseTypeMethod(dctx, begincapture);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscDeviceContextEndCapture - End the recording started by `PetscDeviceContextBeginCapture()`
+
+  Not Collective
+
+  Input Parameter:
+. dctx - The `PetscDeviceContext` the capture began on
+
+  Output Parameter:
+. graph - The recorded work
+
+  Notes:
+  Consecutive operations queued on the same context are fused, such that launching the graph queues
+  one task for each of them, and the operations are not validated again.
+
+  Level: advanced
+
+.seealso: `PetscDeviceContextBeginCapture()`, `PetscDeviceGraphLaunch()`, `PetscDeviceGraphDestroy()`
+@*/
+PetscErrorCode PetscDeviceContextEndCapture(PetscDeviceContext dctx, PetscDeviceGraph *graph)
+{
+  PetscDeviceType dtype;
+
+  PetscFunctionBegin;
+  PetscCall(PetscDeviceContextGetOptionalNullContext_Internal(&dctx));
+  PetscValidPointer(graph, 2);
+  PetscCall(PetscDeviceContextGetDeviceType(dctx, &dtype));
+  PetscCheck(dctx->ops->endcapture, PETSC_COMM_SELF, PETSC_ERR_SUP, "PetscDeviceContext of type %s does not support capturing", PetscDeviceTypes[dtype]);
+  PetscCall(PetscNew(graph));
+  (*graph)->dtype = dtype;
+  PetscUseTypeMethod(dctx, endcapture, *graph);
+  PetscCall(PetscInfo(dctx, "Captured %" PetscInt_FMT " operations of dctx %" PetscInt64_FMT " into %" PetscInt_FMT " tasks\n", (*graph)->nops, PetscObjectCast(dctx)->id, (*graph)->ntasks));
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscDeviceGraphLaunch - Queue the work recorded in a `PetscDeviceGraph` on a `PetscDeviceContext`
+
+  Not Collective, Asynchronous
+
+  Input Parameters:
++ graph - The `PetscDeviceGraph`
+- dctx  - The `PetscDeviceContext`
+
+  Notes:
+  The work runs after the work already queued on `dctx`, and the work queued on `dctx` afterwards
+  runs after all of the work of the graph, including that of the contexts forked in the capture.
+  `dctx` need not be the context the graph was captured from, but it must have the same device type.
+
+  DAG representation:
+.vb
+  time ->
+
+  -> dctx - |= CALL =| - dctx ->
+.ve
+
+  Level: advanced
+
+.N ASYNC_API
+
+.seealso: `PetscDeviceContextBeginCapture()`, `PetscDeviceContextEndCapture()`, `PetscDeviceGraphDestroy()`
+@*/
+PetscErrorCode PetscDeviceGraphLaunch(PetscDeviceGraph graph, PetscDeviceContext dctx)
+{
+  PetscDeviceType dtype;
+
+  PetscFunctionBegin;
+  PetscValidPointer(graph, 1);
+  PetscCall(PetscDeviceContextGetOptionalNullContext_Internal(&dctx));
+  PetscCall(PetscDeviceContextGetDeviceType(dctx, &dtype));
+  PetscCheck(graph->dtype == dtype, PETSC_COMM_SELF, PETSC_ERR_ARG_NOTSAMETYPE, "PetscDeviceGraph was captured from a PetscDeviceContext of type %s, cannot launch it on one of type %s", PetscDeviceTypes[graph->dtype], PetscDeviceTypes[dtype]);
+  PetscUseTypeMethod(dctx, launchgraph, graph);
+  PetscCall(PetscObjectStateIncrease(PetscObjectCast(dctx)));
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscDeviceGraphDestroy - Destroy a `PetscDeviceGraph`
+
+  Not Collective
+
+  Input Parameter:
+. graph - The `PetscDeviceGraph`
+
+  Notes:
+  The launches of the graph still queued are not affected.
+
+  Level: advanced
+
+.seealso: `PetscDeviceContextEndCapture()`, `PetscDeviceGraphLaunch()`
+@*/
+PetscErrorCode PetscDeviceGraphDestroy(PetscDeviceGraph *graph)
+{
+  PetscFunctionBegin;
+  PetscValidPointer(graph, 1);
+  if (!*graph) PetscFunctionReturn(0);
+  if ((*graph)->destroy) PetscCall((*(*graph)->destroy)(*graph));
+  PetscAssert(!(*graph)->data, PETSC_COMM_SELF, PETSC_ERR_PLIB, "PetscDeviceGraph failed to destroy its data member: %p", (*graph)->data);
+  PetscCall(PetscFree(*graph));
+  PetscFunctionReturn(0);
+}
+
 /* every device type has a vector of null PetscDeviceContexts -- one for each device */
 static auto nullContexts          = std::array<std::vector<PetscDeviceContext>, PETSC_DEVICE_MAX>{};
 static auto nullContextsFinalizer = false;
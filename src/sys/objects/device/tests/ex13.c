@@ -0,0 +1,139 @@
+static const char help[] = "Tests PetscDeviceContextLaunchHost() on host device contexts.\n\n";
+
+#include "petscdevicetestcommon.h"
+#include <petscvec.h>
+
+typedef struct {
+  PetscScalar *x;
+  PetscInt     start, end;
+  PetscScalar  alpha;
+} ScaleCtx;
+
+typedef struct {
+  volatile PetscInt *flag;
+  PetscInt           value, *seen;
+} FlagCtx;
+
+/* x[i] = alpha * (x[i] + i) over one part of the array, runs on a pool thread so it only uses plain loops */
+static PetscErrorCode ScaleKernel(void *ctx)
+{
+  ScaleCtx *s = (ScaleCtx *)ctx;
+
+  for (PetscInt i = s->start; i < s->end; ++i) s->x[i] = s->alpha * (s->x[i] + (PetscScalar)i);
+  return 0;
+}
+
+/* spins for a while before setting the flag, so that a context not waiting for it would see the old value */
+static PetscErrorCode SetFlagKernel(void *ctx)
+{
+  FlagCtx          *f = (FlagCtx *)ctx;
+  volatile PetscInt sum = 0;
+
+  for (PetscInt i = 0; i < 10000000; ++i) sum += i % 3;
+  *f->flag = f->value;
+  return sum < 0;
+}
+
+static PetscErrorCode ReadFlagKernel(void *ctx)
+{
+  FlagCtx *f = (FlagCtx *)ctx;
+
+  *f->seen = *f->flag;
+  return 0;
+}
+
+static PetscErrorCode FailKernel(void *ctx)
+{
+  return PETSC_ERR_USER;
+}
+
+int main(int argc, char *argv[])
+{
+  const PetscInt      nsub = 4, n = 1000;
+  PetscDevice         device;
+  PetscDeviceContext  dctx, *dsub;
+  Vec                 x;
+  PetscScalar        *xa;
+  ScaleCtx            parts[4];
+  volatile PetscInt   flag = 0;
+  PetscInt            seen = -1;
+  FlagCtx             set, read;
+  PetscBool           idle;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+
+  PetscCall(PetscDeviceCreate(PETSC_DEVICE_HOST, PETSC_DECIDE, &device));
+  PetscCall(PetscDeviceConfigure(device));
+  PetscCall(PetscDeviceContextCreate(&dctx));
+  PetscCall(PetscDeviceContextSetDevice(dctx, device));
+  PetscCall(PetscDeviceContextSetUp(dctx));
+
+  /* independent updates of the parts of a vector on forked contexts, then a second pass on the joined parent */
+  PetscCall(VecCreateSeq(PETSC_COMM_SELF, n, &x));
+  PetscCall(VecSet(x, 1.0));
+  PetscCall(VecGetArray(x, &xa));
+  PetscCall(PetscDeviceContextFork(dctx, nsub, &dsub));
+  for (PetscInt k = 0; k < nsub; ++k) {
+    parts[k].x     = xa;
+    parts[k].start = (k * n) / nsub;
+    parts[k].end   = ((k + 1) * n) / nsub;
+    parts[k].alpha = 2.0;
+    PetscCall(PetscDeviceContextLaunchHost(dsub[k], ScaleKernel, &parts[k]));
+  }
+  PetscCall(PetscDeviceContextJoin(dctx, nsub, PETSC_DEVICE_CONTEXT_JOIN_DESTROY, &dsub));
+  {
+    ScaleCtx all = {xa, 0, n, 1.0};
+
+    PetscCall(PetscDeviceContextLaunchHost(dctx, ScaleKernel, &all));
+    PetscCall(PetscDeviceContextSynchronize(dctx));
+  }
+  PetscCall(PetscDeviceContextQueryIdle(dctx, &idle));
+  PetscCheck(idle, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Device context not idle after synchronization");
+  for (PetscInt i = 0; i < n; ++i) PetscCheck(xa[i] == (PetscScalar)(2 + 3 * i), PETSC_COMM_SELF, PETSC_ERR_PLIB, "Entry %" PetscInt_FMT " is %g instead of %g", i, (double)PetscRealPart(xa[i]), (double)(2 + 3 * i));
+  PetscCall(VecRestoreArray(x, &xa));
+  PetscCall(VecDestroy(&x));
+
+  /* a context waiting for another one sees the results of its work */
+  {
+    PetscDeviceContext dctxa, dctxb;
+
+    set.flag   = &flag;
+    set.value  = 42;
+    read.flag  = &flag;
+    read.seen  = &seen;
+    read.value = 0;
+    PetscCall(PetscDeviceContextDuplicate(dctx, &dctxa));
+    PetscCall(PetscDeviceContextDuplicate(dctx, &dctxb));
+    PetscCall(PetscDeviceContextLaunchHost(dctxa, SetFlagKernel, &set));
+    PetscCall(PetscDeviceContextWaitForContext(dctxb, dctxa));
+    PetscCall(PetscDeviceContextLaunchHost(dctxb, ReadFlagKernel, &read));
+    PetscCall(PetscDeviceContextSynchronize(dctxb));
+    PetscCheck(seen == 42, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Waiting context saw %" PetscInt_FMT " instead of 42", seen);
+    PetscCall(PetscDeviceContextDestroy(&dctxb));
+    PetscCall(PetscDeviceContextDestroy(&dctxa));
+  }
+
+  /* the error of a function is returned by the synchronization */
+  PetscCall(PetscPushErrorHandler(PetscReturnErrorHandler, NULL));
+  ierr = PetscDeviceContextLaunchHost(dctx, FailKernel, NULL);
+  if (!ierr) ierr = PetscDeviceContextSynchronize(dctx);
+  PetscCall(PetscPopErrorHandler());
+  PetscCheck(ierr == PETSC_ERR_USER, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error of the function not returned, got %d", (int)ierr);
+
+  PetscCall(PetscDeviceContextDestroy(&dctx));
+  PetscCall(PetscDeviceDestroy(&device));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "EXIT_SUCCESS\n"));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    requires: cxx
+    output_file: ./output/ExitSuccess.out
+    args: -device_threads_host {{0 1 4}}
+
+TEST*/
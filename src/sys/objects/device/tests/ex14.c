@@ -0,0 +1,125 @@
+static const char help[] = "Tests capturing and launching PetscDeviceGraph on host device contexts.\n\n";
+
+#include "petscdevicetestcommon.h"
+
+typedef struct {
+  PetscScalar *y;
+  PetscScalar *x;
+  PetscInt     start, end;
+  PetscScalar  alpha;
+} AXPYCtx;
+
+typedef struct {
+  PetscScalar *x;
+  PetscInt     n;
+  PetscScalar *sum;
+  PetscInt    *count;
+} SumCtx;
+
+/* y[i] += alpha * x[i] over one part of the arrays */
+static PetscErrorCode AXPYKernel(void *ctx)
+{
+  AXPYCtx *a = (AXPYCtx *)ctx;
+
+  for (PetscInt i = a->start; i < a->end; ++i) a->y[i] += a->alpha * a->x[i];
+  return 0;
+}
+
+/* the sum of the entries of x, and the number of times it was computed */
+static PetscErrorCode SumKernel(void *ctx)
+{
+  SumCtx *s = (SumCtx *)ctx;
+
+  *s->sum = 0.0;
+  for (PetscInt i = 0; i < s->n; ++i) *s->sum += s->x[i];
+  ++(*s->count);
+  return 0;
+}
+
+static PetscErrorCode CountKernel(void *ctx)
+{
+  ++(*(PetscInt *)ctx);
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  const PetscInt     nsub = 3, n = 300, nlaunch = 5;
+  PetscDevice        device;
+  PetscDeviceContext dctx, dctx2, *dsub;
+  PetscDeviceGraph   graph;
+  PetscScalar        x[300], y[300], sum = 0.0;
+  AXPYCtx            parts[3];
+  SumCtx             sctx;
+  PetscInt           count = 0, nsum = 0;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+
+  PetscCall(PetscDeviceCreate(PETSC_DEVICE_HOST, PETSC_DECIDE, &device));
+  PetscCall(PetscDeviceConfigure(device));
+  PetscCall(PetscDeviceContextCreate(&dctx));
+  PetscCall(PetscDeviceContextSetDevice(dctx, device));
+  PetscCall(PetscDeviceContextSetUp(dctx));
+  PetscCall(PetscDeviceContextDuplicate(dctx, &dctx2));
+
+  for (PetscInt i = 0; i < n; ++i) {
+    x[i] = 1.0;
+    y[i] = (PetscScalar)i;
+  }
+  sctx.x     = y;
+  sctx.n     = n;
+  sctx.sum   = &sum;
+  sctx.count = &nsum;
+
+  /* one iteration: forked updates of the parts of y, the sum of y after the join, and two consecutive functions that are fused */
+  PetscCall(PetscDeviceContextBeginCapture(dctx));
+  PetscCall(PetscDeviceContextFork(dctx, nsub, &dsub));
+  for (PetscInt k = 0; k < nsub; ++k) {
+    parts[k].y     = y;
+    parts[k].x     = x;
+    parts[k].start = (k * n) / nsub;
+    parts[k].end   = ((k + 1) * n) / nsub;
+    parts[k].alpha = 2.0;
+    PetscCall(PetscDeviceContextLaunchHost(dsub[k], AXPYKernel, &parts[k]));
+  }
+  PetscCall(PetscDeviceContextJoin(dctx, nsub, PETSC_DEVICE_CONTEXT_JOIN_DESTROY, &dsub));
+  PetscCall(PetscDeviceContextLaunchHost(dctx, SumKernel, &sctx));
+  PetscCall(PetscDeviceContextLaunchHost(dctx, CountKernel, &count));
+  PetscCall(PetscDeviceContextEndCapture(dctx, &graph));
+  PetscCall(PetscDeviceContextSynchronize(dctx));
+  PetscCheck(!count && !nsum && y[1] == 1.0, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Captured work ran during the capture");
+
+  /* the launches run in order, on the context the graph was captured from or another one */
+  for (PetscInt l = 0; l < nlaunch; ++l) {
+    PetscCall(PetscDeviceGraphLaunch(graph, (l % 2) ? dctx2 : dctx));
+    PetscCall(PetscDeviceContextWaitForContext((l % 2) ? dctx : dctx2, (l % 2) ? dctx2 : dctx));
+  }
+  PetscCall(PetscDeviceContextSynchronize(dctx));
+  PetscCall(PetscDeviceContextSynchronize(dctx2));
+  PetscCheck(count == nlaunch && nsum == nlaunch, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Graph ran %" PetscInt_FMT " times instead of %" PetscInt_FMT, count, nlaunch);
+  for (PetscInt i = 0; i < n; ++i) PetscCheck(y[i] == (PetscScalar)(i + 2 * nlaunch), PETSC_COMM_SELF, PETSC_ERR_PLIB, "Entry %" PetscInt_FMT " is %g instead of %g", i, (double)PetscRealPart(y[i]), (double)(i + 2 * nlaunch));
+  PetscCheck(sum == (PetscScalar)(n * (n - 1) / 2 + 2 * nlaunch * n), PETSC_COMM_SELF, PETSC_ERR_PLIB, "Sum is %g instead of %g", (double)PetscRealPart(sum), (double)(n * (n - 1) / 2 + 2 * nlaunch * n));
+
+  /* the graph may be destroyed while a launch is still queued */
+  PetscCall(PetscDeviceGraphLaunch(graph, dctx));
+  PetscCall(PetscDeviceGraphDestroy(&graph));
+  PetscCall(PetscDeviceContextSynchronize(dctx));
+  PetscCheck(count == nlaunch + 1, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Graph ran %" PetscInt_FMT " times instead of %" PetscInt_FMT, count, nlaunch + 1);
+
+  PetscCall(PetscDeviceContextDestroy(&dctx2));
+  PetscCall(PetscDeviceContextDestroy(&dctx));
+  PetscCall(PetscDeviceDestroy(&device));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "EXIT_SUCCESS\n"));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    requires: cxx
+    output_file: ./output/ExitSuccess.out
+    args: -device_threads_host {{0 1 4}}
+
+TEST*/
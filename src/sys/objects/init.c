@@ -206,6 +206,7 @@ PetscErrorCode PetscEnd(void)
 
 PetscBool                   PetscOptionsPublish = PETSC_FALSE;
 PETSC_INTERN PetscErrorCode PetscSetUseHBWMalloc_Private(void);
+PETSC_INTERN PetscErrorCode PetscSetUseMallocPool_Private(PetscInt);
 PETSC_INTERN PetscBool      petscsetmallocvisited;
 static char                 emacsmachinename[256];
 
@@ -319,6 +320,13 @@ PETSC_INTERN PetscErrorCode PetscOptionsCheckInitial_Private(const char help[])
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-malloc_hbw", &flg1, NULL));
   /* ignore this option if malloc is already set */
   if (flg1 && !petscsetmallocvisited) PetscCall(PetscSetUseHBWMalloc_Private());
+  flg1 = PETSC_FALSE;
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-malloc_pool", &flg1, NULL));
+  if (flg1) {
+    PetscInt cache = PETSC_DEFAULT;
+    PetscCall(PetscOptionsGetInt(NULL, NULL, "-malloc_pool_cache", &cache, NULL));
+    PetscCall(PetscSetUseMallocPool_Private(cache));
+  }
 
   flg1 = PETSC_FALSE;
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-malloc_info", &flg1, NULL));
@@ -329,6 +337,17 @@ PETSC_INTERN PetscErrorCode PetscOptionsCheckInitial_Private(const char help[])
   if (flg1) PetscCall(PetscMemorySetGetMaximumUsage());
 #endif
 
+  {
+    PetscMallocNUMAPolicy policy    = PETSC_MALLOC_NUMA_DEFAULT;
+    PetscBool             hugepages = PETSC_FALSE;
+    PetscInt              threshold = PETSC_DEFAULT;
+
+    PetscCall(PetscOptionsGetEnum(NULL, NULL, "-malloc_numa_policy", PetscMallocNUMAPolicies, (PetscEnum *)&policy, &flg1));
+    PetscCall(PetscOptionsGetBool(NULL, NULL, "-malloc_hugepages", &hugepages, &flg2));
+    PetscCall(PetscOptionsGetInt(NULL, NULL, "-malloc_large_threshold", &threshold, NULL));
+    if (flg1 || flg2) PetscCall(PetscMallocSetLargePolicy(threshold == PETSC_DEFAULT ? (size_t)PETSC_DEFAULT : (size_t)threshold, policy, hugepages));
+  }
+
 #if defined(PETSC_USE_LOG)
   PetscCall(PetscOptionsHasName(NULL, NULL, "-objects_dump", &PetscObjectsLog));
 #endif
@@ -561,6 +580,28 @@ PETSC_INTERN PetscErrorCode PetscOptionsCheckInitial_Private(const char help[])
     PetscCall(PetscOptionsGetReal(NULL, NULL, "-log_threshold", &threshold, &flg1));
     if (flg1) PetscCall(PetscLogSetThreshold((PetscLogDouble)threshold, NULL));
   }
+
+  flg1 = PETSC_FALSE;
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-log_view_hw_counters", &flg1, NULL));
+  if (flg1) PetscCall(PetscLogHWCountersBegin());
+  PetscCall(PetscOptionsHasName(NULL, NULL, "-log_comm", &flg1));
+  if (flg1) PetscCall(PetscLogCommBegin());
+
+  /* after -log_view so that the timeline logger also feeds the handlers started above */
+  PetscCall(PetscOptionsHasName(NULL, NULL, "-log_timeline", &flg1));
+  if (flg1) {
+    PetscInt size = PETSC_DEFAULT;
+    PetscCall(PetscOptionsGetInt(NULL, NULL, "-log_timeline_size", &size, NULL));
+    PetscCall(PetscLogTimelineBegin(size));
+  }
+  PetscCall(PetscOptionsHasName(NULL, NULL, "-log_callpath", &flg1));
+  if (flg1) {
+    PetscInt  every    = PETSC_DEFAULT;
+    PetscReal interval = 0.0;
+    PetscCall(PetscOptionsGetInt(NULL, NULL, "-log_callpath_sample_every", &every, NULL));
+    PetscCall(PetscOptionsGetReal(NULL, NULL, "-log_callpath_sample_interval", &interval, NULL));
+    PetscCall(PetscLogCallPathBegin(every, interval));
+  }
 #endif
 
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-saws_options", &PetscOptionsPublish, NULL));
@@ -598,6 +639,11 @@ PETSC_INTERN PetscErrorCode PetscOptionsCheckInitial_Private(const char help[])
     PetscCall((*PetscHelpPrintf)(comm, " -malloc_info: prints total memory usage\n"));
     PetscCall((*PetscHelpPrintf)(comm, " -malloc_view <optional filename>: keeps log of all memory allocations, displays in PetscFinalize()\n"));
     PetscCall((*PetscHelpPrintf)(comm, " -malloc_debug <true or false>: enables or disables extended checking for memory corruption\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -malloc_pool: reuses freed blocks of up to 64 kilobytes instead of returning them to the system\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -malloc_pool_cache <bytes>: most memory kept for reuse in each size class of -malloc_pool\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -malloc_numa_policy <default,interleave,first_touch>: NUMA placement of the pages of large allocations\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -malloc_hugepages: uses transparent huge pages for large allocations\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -malloc_large_threshold <bytes>: size from which -malloc_numa_policy and -malloc_hugepages apply\n"));
     PetscCall((*PetscHelpPrintf)(comm, " -options_view: dump list of options inputted\n"));
     PetscCall((*PetscHelpPrintf)(comm, " -options_left: dump list of unused options\n"));
     PetscCall((*PetscHelpPrintf)(comm, " -options_left no: don't dump list of unused options\n"));
@@ -609,6 +655,15 @@ PETSC_INTERN PetscErrorCode PetscOptionsCheckInitial_Private(const char help[])
     PetscCall((*PetscHelpPrintf)(comm, " -get_total_flops: total flops over all processors\n"));
     PetscCall((*PetscHelpPrintf)(comm, " -log_view [:filename:[format]]: logging objects and events\n"));
     PetscCall((*PetscHelpPrintf)(comm, " -log_trace [filename]: prints trace of all PETSc calls\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -log_view_hw_counters: include hardware counters of each event in -log_view\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -log_view_hw_counters_events <cycles,instructions,llc_misses>: the hardware counters to read\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -log_view_hw_counters_llc_event <event>: the PAPI event or raw perf event rNNNN counting the last level cache misses\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -log_comm [filename]: saves the bytes sent to each rank and message size histograms of each event\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -log_timeline [filename]: saves a timeline of all PETSc events in Chrome trace format\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -log_timeline_size <size>: number of events kept per process for -log_timeline\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -log_callpath [filename]: saves the time of each nesting of PETSc events as folded stacks for flame graphs\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -log_callpath_sample_every <n>: time only every nth call of each call path\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -log_callpath_sample_interval <seconds>: sample call paths with a profiling timer instead\n"));
     PetscCall((*PetscHelpPrintf)(comm, " -log_exclude <list,of,classnames>: exclude given classes from logging\n"));
   #if defined(PETSC_HAVE_DEVICE)
     PetscCall((*PetscHelpPrintf)(comm, " -log_view_gpu_time: log the GPU time for each and event\n"));
@@ -58,6 +58,14 @@ static inline int PetscOptEqual(const char a[], const char b[])
 
 KHASH_INIT(HO, kh_cstr_t, int, 1, PetscOptHash, PetscOptEqual)
 
+/* Case-insensitive check that name begins with prefix */
+static inline PetscBool PetscOptHasPrefix(const char name[], const char prefix[])
+{
+  while (*prefix)
+    if (PetscToLower(*name++) != PetscToLower(*prefix++)) return PETSC_FALSE;
+  return PETSC_TRUE;
+}
+
 #define MAXPREFIXES        25
 #define MAXOPTIONSMONITORS 5
 
@@ -75,7 +83,7 @@ struct _n_PetscOptions {
   PetscOptionSource *source; /* source for option value */
   PetscBool          precedentProcessed;
 
-  /* Hash table */
+  /* Hash table from the names to their position in the arrays above, built at the first lookup and then kept in step */
   khash_t(HO) *ht;
 
   /* Prefixes */
@@ -1249,6 +1257,56 @@ PetscErrorCode PetscOptionsSetAlias(PetscOptions options, const char newname[],
   PetscFunctionReturn(0);
 }
 
+/*
+   The position of name in the options, which are sorted with PetscOptNameCmp(), or where it would be inserted
+*/
+static inline int PetscOptionsSearch_Private(PetscOptions options, const char name[], PetscBool *found)
+{
+  int lo = 0, hi = options->N;
+
+  *found = PETSC_FALSE;
+  while (lo < hi) {
+    const int mid = lo + (hi - lo) / 2, result = PetscOptNameCmp(options->names[mid], name);
+
+    if (!result) {
+      *found = PETSC_TRUE;
+      return mid;
+    }
+    if (result < 0) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+/*
+   Updates the hash table, if it has been built, after the option at position n has been inserted and the options after
+   it moved up, or before it is removed and the options after it moved down; cheaper than rebuilding the table at the
+   next lookup
+*/
+static PetscErrorCode PetscOptionsHashUpdate_Private(PetscOptions options, int n, PetscBool insert)
+{
+  khash_t(HO) *ht = options->ht;
+  khiter_t     it;
+  int          ret;
+
+  PetscFunctionBegin;
+  if (!ht) PetscFunctionReturn(0);
+  if (insert) {
+    it = kh_put(HO, ht, options->names[n], &ret);
+    PetscCheck(ret > 0, PETSC_COMM_SELF, PETSC_ERR_MEM, "Hash table allocation failed"); /* 2 when the bucket held a deleted option */
+    kh_val(ht, it) = n;
+  } else {
+    it = kh_get(HO, ht, options->names[n]);
+    if (it != kh_end(ht)) kh_del(HO, ht, it);
+  }
+  for (int i = n + 1; i < options->N; i++) {
+    it = kh_get(HO, ht, options->names[i]);
+    PetscCheck(it != kh_end(ht), PETSC_COMM_SELF, PETSC_ERR_PLIB, "Option %s missing from the hash table", options->names[i]);
+    kh_val(ht, it) = insert ? i : i - 1;
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@C
    PetscOptionsSetValue - Sets an option name-value pair in the options
    database, overriding whatever is already present.
@@ -1285,7 +1343,6 @@ PetscErrorCode PetscOptionsSetValue_Private(PetscOptions options, const char nam
 {
   size_t    len;
   int       n, i;
-  char    **names;
   char      fullname[PETSC_MAX_OPTION_NAME] = "";
   PetscBool flg;
 
@@ -1318,19 +1375,8 @@ PetscErrorCode PetscOptionsSetValue_Private(PetscOptions options, const char nam
     }
   }
 
-  /* slow search */
-  n     = options->N;
-  names = options->names;
-  for (i = 0; i < options->N; i++) {
-    int result = PetscOptNameCmp(names[i], name);
-    if (!result) {
-      n = i;
-      goto setvalue;
-    } else if (result > 0) {
-      n = i;
-      break;
-    }
-  }
+  n = PetscOptionsSearch_Private(options, name, &flg);
+  if (flg) goto setvalue;
   if (options->N == options->Nalloc) {
     char             **names, **values;
     PetscBool         *used;
@@ -1370,15 +1416,12 @@ PetscErrorCode PetscOptionsSetValue_Private(PetscOptions options, const char nam
   options->source[n] = PETSC_OPT_CODE;
   options->N++;
 
-  /* destroy hash table */
-  kh_destroy(HO, options->ht);
-  options->ht = NULL;
-
   /* set new name */
   len               = strlen(name);
   options->names[n] = (char *)malloc((len + 1) * sizeof(char));
   PetscCheck(options->names[n], PETSC_COMM_SELF, PETSC_ERR_MEM, "Failed to allocate option name");
   strcpy(options->names[n], name);
+  PetscCall(PetscOptionsHashUpdate_Private(options, n, PETSC_TRUE));
 
 setvalue:
   /* set new value */
@@ -1427,8 +1470,8 @@ setvalue:
 @*/
 PetscErrorCode PetscOptionsClearValue(PetscOptions options, const char name[])
 {
-  int    N, n, i;
-  char **names;
+  int       N, n, i;
+  PetscBool found;
 
   PetscFunctionBegin;
   options = options ? options : defaultoptions;
@@ -1437,21 +1480,11 @@ PetscErrorCode PetscOptionsClearValue(PetscOptions options, const char name[])
 
   name++; /* skip starting dash */
 
-  /* slow search */
-  N = n = options->N;
-  names = options->names;
-  for (i = 0; i < N; i++) {
-    int result = PetscOptNameCmp(names[i], name);
-    if (!result) {
-      n = i;
-      break;
-    } else if (result > 0) {
-      n = N;
-      break;
-    }
-  }
-  if (n == N) PetscFunctionReturn(0); /* it was not present */
+  N = options->N;
+  n = PetscOptionsSearch_Private(options, name, &found);
+  if (!found) PetscFunctionReturn(0); /* it was not present */
 
+  PetscCall(PetscOptionsHashUpdate_Private(options, n, PETSC_FALSE));
   /* remove name and value */
   if (options->names[n]) free(options->names[n]);
   if (options->values[n]) free(options->values[n]);
@@ -1464,10 +1497,6 @@ PetscErrorCode PetscOptionsClearValue(PetscOptions options, const char name[])
   }
   options->N--;
 
-  /* destroy hash table */
-  kh_destroy(HO, options->ht);
-  options->ht = NULL;
-
   PetscCall(PetscOptionsMonitor(options, name, NULL, PETSC_OPT_CODE));
   PetscFunctionReturn(0);
 }
@@ -1552,18 +1581,14 @@ PetscErrorCode PetscOptionsFindPair(PetscOptions options, const char pre[], cons
       if (set) *set = PETSC_TRUE;
       PetscFunctionReturn(0);
     }
-  } else { /* slow search */
-    int i, N = options->N;
-    for (i = 0; i < N; i++) {
-      int result = PetscOptNameCmp(options->names[i], name);
-      if (!result) {
-        options->used[i] = PETSC_TRUE;
-        if (value) *value = options->values[i];
-        if (set) *set = PETSC_TRUE;
-        PetscFunctionReturn(0);
-      } else if (result > 0) {
-        break;
-      }
+  } else { /* binary search */
+    PetscBool found;
+    int       i = PetscOptionsSearch_Private(options, name, &found);
+    if (found) {
+      options->used[i] = PETSC_TRUE;
+      if (value) *value = options->values[i];
+      if (set) *set = PETSC_TRUE;
+      PetscFunctionReturn(0);
     }
   }
 
@@ -1657,9 +1682,8 @@ PETSC_EXTERN PetscErrorCode PetscOptionsFindPairPrefix_Private(PetscOptions opti
     }
   }
 
-  { /* slow search */
+  { /* binary search */
     int       c, i;
-    size_t    len;
     PetscBool match;
 
     for (c = -1; c < numCnt; ++c) {
@@ -1672,15 +1696,13 @@ PETSC_EXTERN PetscErrorCode PetscOptionsFindPairPrefix_Private(PetscOptions opti
         PetscCall(PetscStrlcat(opt, tmp, sizeof(opt)));
         PetscCall(PetscStrlcat(opt, name + loce[c], sizeof(opt)));
       }
-      PetscCall(PetscStrlen(opt, &len));
-      for (i = 0; i < options->N; i++) {
-        PetscCall(PetscStrncmp(options->names[i], opt, len, &match));
-        if (match) {
-          options->used[i] = PETSC_TRUE;
-          if (value) *value = options->values[i];
-          if (set) *set = PETSC_TRUE;
-          PetscFunctionReturn(0);
-        }
+      /* the options beginning with opt follow each other in the sorted options, starting where opt would be inserted */
+      i = PetscOptionsSearch_Private(options, opt, &match);
+      if (i < options->N && PetscOptHasPrefix(options->names[i], opt)) {
+        options->used[i] = PETSC_TRUE;
+        if (value) *value = options->values[i];
+        if (set) *set = PETSC_TRUE;
+        PetscFunctionReturn(0);
       }
     }
   }
@@ -1867,20 +1889,15 @@ PetscErrorCode PetscOptionsGetAll(PetscOptions options, char *copts[])
 @*/
 PetscErrorCode PetscOptionsUsed(PetscOptions options, const char *name, PetscBool *used)
 {
-  PetscInt i;
+  int       i;
+  PetscBool found;
 
   PetscFunctionBegin;
   PetscValidCharPointer(name, 2);
   PetscValidBoolPointer(used, 3);
   options = options ? options : defaultoptions;
-  *used   = PETSC_FALSE;
-  for (i = 0; i < options->N; i++) {
-    PetscCall(PetscStrcasecmp(options->names[i], name, used));
-    if (*used) {
-      *used = options->used[i];
-      break;
-    }
-  }
+  i       = PetscOptionsSearch_Private(options, name, &found);
+  *used   = found ? options->used[i] : PETSC_FALSE;
   PetscFunctionReturn(0);
 }
 
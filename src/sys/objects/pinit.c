@@ -1151,6 +1151,10 @@ PETSC_INTERN PetscErrorCode PetscInitialize_Common(const char *prog, const char
 .  -malloc_view - show a list of all allocated memory during `PetscFinalize()`
 .  -malloc_view_threshold <t> - only list memory allocations of size greater than t with -malloc_view
 .  -malloc_requested_size - malloc logging will record the requested size rather than size after alignment
+.  -malloc_pool - reuse freed blocks of up to 64 kilobytes instead of returning them to the system, see `PetscMallocPool()`
+.  -malloc_numa_policy <default,interleave,first_touch> - NUMA placement of the pages of large allocations, see `PetscMallocSetLargePolicy()`
+.  -malloc_hugepages - use transparent huge pages for large allocations, see `PetscMallocSetLargePolicy()`
+.  -malloc_large_threshold <bytes> - size from which -malloc_numa_policy and -malloc_hugepages apply, 2 megabytes by default, see `PetscMallocSetLargePolicy()`
 .  -fp_trap - Stops on floating point exceptions
 .  -no_signal_handler - Indicates not to trap error signals
 .  -shared_tmp - indicates /tmp directory is shared by all processors
@@ -1180,6 +1184,8 @@ PETSC_INTERN PetscErrorCode PetscInitialize_Common(const char *prog, const char
 .  -log_view [:filename:format] - Prints summary of flop and timing information to screen or file, see `PetscLogView()`.
 .  -log_view_memory - Includes in the summary from -log_view the memory used in each event, see `PetscLogView()`.
 .  -log_view_gpu_time - Includes in the summary from -log_view the time used in each GPU kernel, see `PetscLogView().
+.  -log_view_hw_counters - Includes in the summary from -log_view hardware counters of each event, see `PetscLogHWCountersBegin()`
+.  -log_comm [filename] - Saves the bytes sent to each rank and histograms of message sizes of each event, see `PetscLogCommBegin()`
 .  -log_summary [filename] - (Deprecated, use -log_view) Prints summary of flop and timing information to screen. If the filename is specified the
         summary is written to the file.  See PetscLogView().
 .  -log_exclude: <vec,mat,pc,ksp,snes> - excludes subset of object classes from logging
@@ -1521,6 +1527,18 @@ PetscErrorCode PetscFinalize(void)
   PetscCall(PetscOptionsGetString(NULL, NULL, "-log_all", mname, sizeof(mname), &flg1));
   PetscCall(PetscOptionsGetString(NULL, NULL, "-log", mname, sizeof(mname), &flg2));
   if (flg1 || flg2) PetscCall(PetscLogDump(mname));
+
+  mname[0] = 0;
+  PetscCall(PetscOptionsGetString(NULL, NULL, "-log_timeline", mname, sizeof(mname), &flg1));
+  if (flg1) PetscCall(PetscLogTimelineDump(mname[0] ? mname : NULL));
+
+  mname[0] = 0;
+  PetscCall(PetscOptionsGetString(NULL, NULL, "-log_callpath", mname, sizeof(mname), &flg1));
+  if (flg1) PetscCall(PetscLogCallPathDump(mname[0] ? mname : NULL));
+
+  mname[0] = 0;
+  PetscCall(PetscOptionsGetString(NULL, NULL, "-log_comm", mname, sizeof(mname), &flg1));
+  if (flg1) PetscCall(PetscLogCommDump(mname[0] ? mname : NULL));
 #endif
 
   flg1 = PETSC_FALSE;
@@ -1776,6 +1794,7 @@ PetscErrorCode PetscFinalize(void)
    memory was not freed.
 
 */
+  PetscCall(PetscMallocPoolTrim());
   PetscCall(PetscMallocClear());
   PetscCall(PetscStackReset());
 
@@ -142,6 +142,38 @@ int main(int argc, char **argv)
   PetscTestCheck(has == PETSC_FALSE);
   PetscCall(PetscOptionsClearValue(NULL, "-abc_xyz"));
 
+  /* many options inserted and cleared out of order between lookups, the hash table must stay in step with them */
+  {
+    const int n = 500;
+    char      name[64], value[64];
+
+    for (int i = 0; i < n; i++) {
+      const int k = (37 * i) % n;
+
+      PetscCall(PetscSNPrintf(name, sizeof(name), "-opt%dx", k));
+      PetscCall(PetscSNPrintf(value, sizeof(value), "%d", k));
+      PetscCall(PetscOptionsSetValue(NULL, name, value));
+      PetscCall(PetscOptionsFindPair(NULL, NULL, name, &val, &has));
+      PetscTestCheck(has == PETSC_TRUE && !strcmp(val, value));
+    }
+    for (int k = 0; k < n; k += 2) {
+      PetscCall(PetscSNPrintf(name, sizeof(name), "-OPT%dX", k));
+      PetscCall(PetscOptionsClearValue(NULL, name));
+    }
+    for (int k = 0; k < n; k++) {
+      PetscCall(PetscSNPrintf(name, sizeof(name), "-opt%dx", k));
+      PetscCall(PetscSNPrintf(value, sizeof(value), "%d", k));
+      PetscCall(PetscOptionsFindPair(NULL, NULL, name, &val, &has));
+      PetscTestCheck(k % 2 ? (has == PETSC_TRUE && !strcmp(val, value)) : has == PETSC_FALSE);
+    }
+    for (int k = 1; k < n; k += 2) {
+      PetscCall(PetscSNPrintf(name, sizeof(name), "-opt%dx", k));
+      PetscCall(PetscOptionsClearValue(NULL, name));
+      PetscCall(PetscOptionsHasName(NULL, NULL, name, &has));
+      PetscTestCheck(has == PETSC_FALSE);
+    }
+  }
+
   PetscCall(PetscFinalize());
   return 0;
 }
@@ -0,0 +1,65 @@
+static char help[] = "Tests PetscMalloc(), PetscRealloc() and PetscFree() with many blocks of different sizes, as done with -malloc_pool.\n\n";
+
+#include <petscsys.h>
+
+int main(int argc, char **argv)
+{
+  PetscInt  *a[64], n[64], i, j, k;
+  PetscReal *big;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  /* allocate and free blocks of many sizes several times so that freed blocks get reused */
+  for (k = 0; k < 4; k++) {
+    for (i = 0; i < 64; i++) {
+      n[i] = 1 + (i * 37 + k * 11) % 300;
+      PetscCall(PetscMalloc1(n[i], &a[i]));
+      for (j = 0; j < n[i]; j++) a[i][j] = i + j;
+    }
+    /* grow half of the blocks, which moves those that no longer fit in their size class */
+    for (i = 0; i < 64; i += 2) {
+      PetscCall(PetscRealloc((3 * n[i] + 5) * sizeof(PetscInt), &a[i]));
+      for (j = n[i]; j < 3 * n[i] + 5; j++) a[i][j] = i + j;
+      n[i] = 3 * n[i] + 5;
+    }
+    for (i = 0; i < 64; i++) {
+      for (j = 0; j < n[i]; j++) PetscCheck(a[i][j] == i + j, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Block %" PetscInt_FMT " entry %" PetscInt_FMT " is wrong", i, j);
+    }
+    for (i = 63; i >= 0; i -= 3) PetscCall(PetscFree(a[i]));
+    for (i = 0; i < 64; i++) PetscCall(PetscFree(a[i]));
+  }
+  /* cleared memory must be zero even when reused */
+  for (k = 0; k < 2; k++) {
+    PetscCall(PetscCalloc1(100, &a[0]));
+    for (j = 0; j < 100; j++) PetscCheck(a[0][j] == 0, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Cleared entry %" PetscInt_FMT " is not zero", j);
+    for (j = 0; j < 100; j++) a[0][j] = j + 1;
+    PetscCall(PetscFree(a[0]));
+  }
+  /* a block too large for the size classes */
+  PetscCall(PetscMalloc1(100000, &big));
+  for (j = 0; j < 100000; j++) big[j] = (PetscReal)j;
+  PetscCall(PetscRealloc(200000 * sizeof(PetscReal), &big));
+  for (j = 0; j < 100000; j++) PetscCheck(big[j] == (PetscReal)j, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Large block entry %" PetscInt_FMT " is wrong", j);
+  PetscCall(PetscFree(big));
+  PetscCall(PetscMallocPoolTrim());
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "All blocks correct\n"));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      args: -malloc_pool
+
+   test:
+      suffix: cache
+      args: -malloc_pool -malloc_pool_cache 4096 -malloc_debug
+      output_file: output/ex65_1.out
+
+   test:
+      suffix: nodebug
+      args: -malloc_pool -malloc_debug 0
+      output_file: output/ex65_1.out
+
+TEST*/
@@ -0,0 +1,116 @@
+static char help[] = "Tests PetscLogCommBegin() by reading back the file written by PetscLogCommDump().\n\n";
+
+#include <petscsys.h>
+#include <petscviewer.h>
+
+/* Reads a name written by PetscLogCommDump() and returns whether it equals name */
+static PetscErrorCode ReadName(int fd, const char name[], PetscBool *match)
+{
+  PetscInt64 len;
+  char       buf[PETSC_MAX_PATH_LEN];
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscBinaryRead(fd, &len, 1, NULL, PETSC_INT64));
+  PetscCheck(len < PETSC_MAX_PATH_LEN, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Name of length %" PetscInt64_FMT " is too long", len);
+  PetscCall(PetscBinaryRead(fd, buf, (PetscInt)len, NULL, PETSC_CHAR));
+  buf[len] = 0;
+  PetscCall(PetscStrcmp(buf, name, match));
+  PetscFunctionReturn(0);
+}
+
+/* Prints the records of the event named ename, those of other events depend on what PETSc does behind the scenes */
+static PetscErrorCode ReadCommFile(const char filename[], const char ename[])
+{
+  PetscInt64 header[4], nevents, event = -1;
+  int        fd;
+  PetscBool  match;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscBinaryOpen(filename, FILE_MODE_READ, &fd));
+  PetscCall(PetscBinaryRead(fd, header, 4, NULL, PETSC_INT64));
+  PetscCheck(header[0] == PETSC_LOG_COMM_FILE_CLASSID, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Not a communication log file");
+  PetscCheck(header[2] == PETSC_LOG_COMM_BINS, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Unexpected number of histogram bins %" PetscInt64_FMT, header[2]);
+  PetscCall(PetscPrintf(PETSC_COMM_SELF, "Ranks %" PetscInt64_FMT "\n", header[1]));
+  for (PetscInt64 s = 0; s < header[3]; s++) PetscCall(ReadName(fd, "", &match));
+  PetscCall(PetscBinaryRead(fd, &nevents, 1, NULL, PETSC_INT64));
+  for (PetscInt64 e = 0; e < nevents; e++) {
+    PetscCall(ReadName(fd, ename, &match));
+    if (match) event = e;
+  }
+  PetscCheck(event >= 0, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Event %s not found", ename);
+  for (PetscInt64 r = 0; r < header[1]; r++) {
+    PetscInt64 nrecords;
+
+    PetscCall(PetscBinaryRead(fd, &nrecords, 1, NULL, PETSC_INT64));
+    for (PetscInt64 k = 0; k < nrecords; k++) {
+      PetscInt64     info[3], *dest;
+      PetscLogDouble hist[2 * PETSC_LOG_COMM_BINS], *counts;
+      PetscInt       np;
+
+      PetscCall(PetscBinaryRead(fd, info, 3, NULL, PETSC_INT64));
+      PetscCall(PetscBinaryRead(fd, hist, 2 * PETSC_LOG_COMM_BINS, NULL, PETSC_DOUBLE));
+      PetscCall(PetscIntCast(info[2], &np));
+      PetscCall(PetscMalloc2(np, &dest, 2 * np, &counts));
+      PetscCall(PetscBinaryRead(fd, dest, np, NULL, PETSC_INT64));
+      PetscCall(PetscBinaryRead(fd, counts, 2 * np, NULL, PETSC_DOUBLE));
+      if (info[1] == event) {
+        PetscCall(PetscPrintf(PETSC_COMM_SELF, "Rank %" PetscInt64_FMT " %s\n", r, ename));
+        for (PetscInt p = 0; p < np; p++) PetscCall(PetscPrintf(PETSC_COMM_SELF, "  to rank %" PetscInt64_FMT ": %g messages %g bytes\n", dest[p], counts[p], counts[np + p]));
+        for (PetscInt b = 0; b < PETSC_LOG_COMM_BINS; b++) {
+          if (hist[b] > 0.0) PetscCall(PetscPrintf(PETSC_COMM_SELF, "  messages in bin %" PetscInt_FMT ": %g\n", b, hist[b]));
+        }
+        for (PetscInt b = 0; b < PETSC_LOG_COMM_BINS; b++) {
+          if (hist[PETSC_LOG_COMM_BINS + b] > 0.0) PetscCall(PetscPrintf(PETSC_COMM_SELF, "  reductions in bin %" PetscInt_FMT ": %g\n", b, hist[PETSC_LOG_COMM_BINS + b]));
+        }
+      }
+      PetscCall(PetscFree2(dest, counts));
+    }
+  }
+  PetscCall(PetscBinaryClose(fd));
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  PetscLogEvent event;
+  PetscMPIInt   rank, size, left, right;
+  int           sbuf[4] = {0, 1, 2, 3}, rbuf[4], sum, one = 1;
+  MPI_Request   reqs[2];
+  char          filename[PETSC_MAX_PATH_LEN] = "ex66_comm.bin";
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetString(NULL, NULL, "-filename", filename, sizeof(filename), NULL));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  right = (rank + 1) % size;
+  left  = (rank + size - 1) % size;
+
+  PetscCall(PetscLogEventRegister("Ring exchange", PETSC_VIEWER_CLASSID, &event));
+  PetscCall(PetscLogCommBegin());
+  /* each rank sends 16 bytes to the right, an empty message to the left and does one reduction of 4 bytes */
+  PetscCall(PetscLogEventBegin(event, 0, 0, 0, 0));
+  PetscCallMPI(MPI_Isend(sbuf, 4, MPI_INT, right, 0, PETSC_COMM_WORLD, &reqs[0]));
+  PetscCallMPI(MPI_Isend(NULL, 0, MPI_INT, left, 1, PETSC_COMM_WORLD, &reqs[1]));
+  PetscCallMPI(MPI_Recv(rbuf, 4, MPI_INT, left, 0, PETSC_COMM_WORLD, MPI_STATUS_IGNORE));
+  PetscCallMPI(MPI_Recv(NULL, 0, MPI_INT, right, 1, PETSC_COMM_WORLD, MPI_STATUS_IGNORE));
+  PetscCallMPI(MPI_Waitall(2, reqs, MPI_STATUSES_IGNORE));
+  PetscCallMPI(MPI_Allreduce(&one, &sum, 1, MPI_INT, MPI_SUM, PETSC_COMM_WORLD));
+  PetscCall(PetscLogEventEnd(event, 0, 0, 0, 0));
+  PetscCheck(sum == size, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Wrong reduction");
+
+  PetscCall(PetscLogCommDump(filename));
+  if (rank == 0) PetscCall(ReadCommFile(filename, "Ring exchange"));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   build:
+     requires: defined(PETSC_USE_LOG)
+
+   test:
+     nsize: 3
+
+TEST*/
@@ -16,7 +16,7 @@ int main(int argc, char **argv)
 {
   PetscMPIInt   rank;
   int           i, imax = 10000, icount;
-  PetscLogEvent USER_EVENT, check_USER_EVENT;
+  PetscLogEvent USER_EVENT, check_USER_EVENT, QUOTED_EVENT;
 
   PetscFunctionBeginUser;
   PetscCall(PetscInitialize(&argc, &argv, NULL, help));
@@ -68,6 +68,14 @@ int main(int argc, char **argv)
   PetscCall(PetscSleep(0.5));
   PetscCall(PetscLogEventEnd(USER_EVENT, 0, 0, 0, 0));
 
+  /*
+     Event names may contain characters that must be escaped in the -log_timeline output
+  */
+  PetscCall(PetscLogEventRegister("User \"quoted\" \\ event", PETSC_VIEWER_CLASSID, &QUOTED_EVENT));
+  PetscCall(PetscLogEventBegin(QUOTED_EVENT, 0, 0, 0, 0));
+  PetscCall(PetscSleep(0.1));
+  PetscCall(PetscLogEventEnd(QUOTED_EVENT, 0, 0, 0, 0));
+
   PetscCall(PetscFinalize());
   return 0;
 }
@@ -79,4 +87,27 @@ int main(int argc, char **argv)
 
    test:
 
+   test:
+     suffix: timeline
+     nsize: 2
+     args: -log_timeline ex3_timeline.json -log_timeline_size 16
+     filter: grep -o "name.:.User[^,]*" ex3_timeline.json | sort | uniq -c
+
+   test:
+     suffix: callpath
+     nsize: 2
+     args: -log_callpath ex3_callpath.folded -log_callpath_sample_every 2
+     filter: sed -e "s/ [0-9]*$//" ex3_callpath.folded | sort
+
+   test:
+     suffix: comm
+     nsize: 2
+     args: -log_comm ex3_comm.bin
+     filter: od -A n -t x1 -N 16 ex3_comm.bin
+
+   test:
+     suffix: hw_counters
+     args: -log_view -log_view_hw_counters -log_view_hw_counters_events cycles
+     filter: grep -e "^User event" -e "IPC  LLCMiss" | grep -o -e "^User event *[0-9]*" -e "IPC  LLCMiss.*" -e "    -        -      -     -"
+
 TEST*/
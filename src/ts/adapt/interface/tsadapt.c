@@ -989,6 +989,20 @@ PetscErrorCode TSAdaptCheckStage(TSAdapt adapt, TS ts, PetscReal t, Vec Y, Petsc
   PetscValidBoolPointer(accept, 5);
 
   if (ts->snes) PetscCall(SNESGetConvergedReason(ts->snes, &snesreason));
+  if (snesreason < 0 && ts->lagjacobian.used) {
+    /* retry the step with a new Jacobian before counting a failure and reducing it */
+    *accept               = PETSC_FALSE;
+    ts->lagjacobian.valid = PETSC_FALSE;
+    ts->lagjacobian.used  = PETSC_FALSE;
+    ts->lagjacobian.nretry++;
+    PetscCall(PetscInfo(ts, "Step=%" PetscInt_FMT ", nonlinear solve failed with a reused Jacobian, retrying with a new one\n", ts->steps));
+    if (adapt->monitor) {
+      PetscCall(PetscViewerASCIIAddTab(adapt->monitor, ((PetscObject)adapt)->tablevel));
+      PetscCall(PetscViewerASCIIPrintf(adapt->monitor, "    TSAdapt %s step %3" PetscInt_FMT " stage rejected (%s) t=%-11g+%10.3e retrying with a new Jacobian\n", ((PetscObject)adapt)->type_name, ts->steps, SNESConvergedReasons[snesreason], (double)ts->ptime, (double)ts->time_step));
+      PetscCall(PetscViewerASCIISubtractTab(adapt->monitor, ((PetscObject)adapt)->tablevel));
+    }
+    PetscFunctionReturn(0);
+  }
   if (snesreason < 0) {
     *accept = PETSC_FALSE;
     if (++ts->num_snes_failures >= ts->max_snes_failures && ts->max_snes_failures > 0) {
@@ -37,6 +37,7 @@ PetscErrorCode TSEventDestroy(TSEvent *event)
   PetscCall(PetscFree((*event)->terminate));
   PetscCall(PetscFree((*event)->events_zero));
   PetscCall(PetscFree((*event)->vtol));
+  PetscCall(VecDestroy(&(*event)->work));
 
   for (i = 0; i < (*event)->recsize; i++) PetscCall(PetscFree((*event)->recorder.eventidx[i]));
   PetscCall(PetscFree((*event)->recorder.eventidx));
@@ -124,6 +125,46 @@ PetscErrorCode TSSetEventTolerances(TS ts, PetscReal tol, PetscReal vtol[])
   PetscFunctionReturn(0);
 }
 
+/*@
+   TSSetEventInterpolation - Locate the events on the interpolant of the time step
+
+   Logically Collective
+
+   Input Parameters:
++  ts - time integration context
+-  flg - `PETSC_TRUE` to locate the events on the interpolant, `PETSC_FALSE` to locate them by rolling back and repeating the time step
+
+   Options Database Key:
+.  -ts_event_interpolate <bool> - locate the events on the interpolant of the time step
+
+   Level: intermediate
+
+   Notes:
+   Must call `TSSetEventHandler()` before setting the interpolation.
+
+   When an event function changes sign within an accepted step, the event is located by the Illinois variant of regula falsi
+   on the continuous extension of the step computed by `TSInterpolate()`, instead of repeating the step with smaller and smaller
+   time steps. Each iteration evaluates all the event functions with a single call of the event handler at the interpolated
+   solution, and no right-hand side is evaluated, so this is much cheaper with many events or an expensive right-hand side.
+   The solution is then set to the interpolated solution at the earliest event, and the integration restarts from there.
+
+   The accuracy of the event times is that of the interpolant, which may be of lower order than the integrator. The `TSType`
+   (and its tableau, for `TSRK` and `TSARKIMEX`) must provide an interpolation formula. The events are located by rolling back the
+   step as usual when the `TSType` has no `TSInterpolate()`, when the trajectory is saved and when forward sensitivities or
+   integrals are computed, since these need the time steps to end at the events.
+
+.seealso: [](chapter_ts), `TS`, `TSEvent`, `TSSetEventHandler()`, `TSInterpolate()`, `TSSetEventTolerances()`
+@*/
+PetscErrorCode TSSetEventInterpolation(TS ts, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(ts, flg, 2);
+  PetscCheck(ts->event, PetscObjectComm((PetscObject)ts), PETSC_ERR_USER, "Must set the events first by calling TSSetEventHandler()");
+  ts->event->interpolate = flg;
+  PetscFunctionReturn(0);
+}
+
 /*@C
    TSSetEventHandler - Sets a function used for detecting events
 
@@ -224,6 +265,7 @@ PetscErrorCode TSSetEventHandler(TS ts, PetscInt nevents, PetscInt direction[],
     PetscCall(PetscOptionsReal("-ts_event_post_eventinterval_step", "Time step after event interval", "", event->timestep_posteventinterval, &event->timestep_posteventinterval, NULL));
     PetscCall(PetscOptionsReal("-ts_event_post_event_step", "Time step after event", "", event->timestep_postevent, &event->timestep_postevent, NULL));
     PetscCall(PetscOptionsReal("-ts_event_dt_min", "Minimum time step considered for TSEvent", "", event->timestep_min, &event->timestep_min, NULL));
+    PetscCall(PetscOptionsBool("-ts_event_interpolate", "Locate the events on the interpolant of the time step", "TSSetEventInterpolation", event->interpolate, &event->interpolate, NULL));
   }
   PetscOptionsEnd();
 
@@ -470,6 +512,128 @@ static PetscErrorCode TSEventLocation(TS ts, PetscReal *dt)
   PetscFunctionReturn(0);
 }
 
+/* whether event i crosses zero from fa to fb in its direction, a zero at the left end is an event already handled */
+static inline PetscBool TSEventCrossing_Private(TSEvent event, PetscInt i, PetscScalar fa, PetscScalar fb)
+{
+  PetscInt sa, sb;
+
+  if (PetscAbsScalar(fa) < event->vtol[i]) return PETSC_FALSE;
+  sa = PetscSign(PetscRealPart(fa));
+  sb = PetscAbsScalar(fb) < event->vtol[i] ? -sa : PetscSign(PetscRealPart(fb));
+  if (sa == sb) return PETSC_FALSE;
+  return (PetscBool)(!event->direction[i] || sb == event->direction[i]);
+}
+
+static PetscBool TSEventCanInterpolate_Private(TS ts)
+{
+  TSEvent event = ts->event;
+
+  return (PetscBool)(event->interpolate && ts->ops->interpolate && !ts->trajectory && !ts->forward_solve && !(ts->quadraturets && ts->costintegralfwd) && event->ptime_prev == ts->ptime_prev);
+}
+
+/*
+  TSEventLocationInterpolate - Locates the earliest event in the accepted step by the Illinois variant of regula falsi on the
+  interpolant of the step, and sets the solution to the interpolated solution there. All the event functions are evaluated
+  together at each iterate, no right-hand side is evaluated.
+*/
+static PetscErrorCode TSEventLocationInterpolate(TS ts, PetscReal *t)
+{
+  TSEvent      event = ts->event;
+  PetscReal    tl = event->ptime_prev, tr = ts->ptime, tc, *gl, *gr;
+  PetscScalar *fl, *fr, *fc;
+  PetscInt     i, its, nevals = 0, in[2], out[2];
+  PetscBool    crossing, zero;
+
+  PetscFunctionBegin;
+  if (!event->work) PetscCall(VecDuplicate(ts->vec_sol, &event->work));
+  PetscCall(PetscMalloc5(event->nevents, &fl, event->nevents, &fr, event->nevents, &fc, event->nevents, &gl, event->nevents, &gr));
+  for (i = 0; i < event->nevents; i++) {
+    fl[i] = event->fvalue_prev[i];
+    fr[i] = event->fvalue[i];
+    gl[i] = PetscRealPart(fl[i]);
+    gr[i] = PetscRealPart(fr[i]);
+    event->side[i]         = 0;
+    event->zerocrossing[i] = PETSC_FALSE;
+  }
+  for (its = 0;; its++) {
+    /* converged when an event crossing in [tl,tr] is zero at tr, or when the interval is too short */
+    in[0] = 0;
+    in[1] = 0;
+    for (i = 0; i < event->nevents; i++) {
+      if (!TSEventCrossing_Private(event, i, fl[i], fr[i])) continue;
+      in[1] = 1;
+      if (PetscAbsScalar(fr[i]) < event->vtol[i]) in[0] = 1;
+    }
+    PetscCall(MPIU_Allreduce(in, out, 2, MPIU_INT, MPI_MAX, PetscObjectComm((PetscObject)ts)));
+    if (!out[1]) break; /* none of the sign changes is in the direction of its event */
+    if (out[0] || tr - tl <= PetscMax(event->timestep_min, 4 * PETSC_MACHINE_EPSILON * PetscAbsReal(tr)) || its == 100) break;
+
+    /* the earliest of the regula falsi iterates of the events crossing zero in [tl,tr] */
+    tc = tr;
+    for (i = 0; i < event->nevents; i++) {
+      if (TSEventCrossing_Private(event, i, fl[i], fr[i])) tc = PetscMin(tc, tl + (tr - tl) * gl[i] / (gl[i] - gr[i]));
+    }
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &tc, 1, MPIU_REAL, MPIU_MIN, PetscObjectComm((PetscObject)ts)));
+    if (!(tc > tl && tc < tr)) tc = (tl + tr) / 2;
+    PetscCall(TSInterpolate(ts, tc, event->work));
+    PetscCall(VecLockReadPush(event->work));
+    PetscCall((*event->eventhandler)(ts, tc, event->work, fc, event->ctx));
+    PetscCall(VecLockReadPop(event->work));
+    nevals++;
+
+    crossing = PETSC_FALSE;
+    for (i = 0; i < event->nevents; i++) {
+      if (TSEventCrossing_Private(event, i, fl[i], fc[i])) crossing = PETSC_TRUE;
+    }
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &crossing, 1, MPIU_BOOL, MPI_LOR, PetscObjectComm((PetscObject)ts)));
+    /* the Illinois modification halves the weight of an end point retained twice in a row */
+    if (crossing) {
+      tr = tc;
+      for (i = 0; i < event->nevents; i++) {
+        fr[i] = fc[i];
+        gr[i] = PetscRealPart(fc[i]);
+        if (event->side[i] == 1) gl[i] /= 2;
+        event->side[i] = 1;
+      }
+    } else {
+      tl = tc;
+      for (i = 0; i < event->nevents; i++) {
+        fl[i] = fc[i];
+        gl[i] = PetscRealPart(fc[i]);
+        if (event->side[i] == -1) gr[i] /= 2;
+        event->side[i] = -1;
+      }
+    }
+  }
+
+  /* as when rolling back, an event function zero at the end of the interval is an event even without a sign change */
+  event->nevents_zero = 0;
+  for (i = 0; i < event->nevents; i++) {
+    if (TSEventCrossing_Private(event, i, fl[i], fr[i]) || PetscAbsScalar(fr[i]) < event->vtol[i]) event->events_zero[event->nevents_zero++] = i;
+    event->side[i] = 0;
+  }
+  zero = (PetscBool)(event->nevents_zero > 0);
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &zero, 1, MPIU_BOOL, MPI_LOR, PetscObjectComm((PetscObject)ts)));
+  if (zero) {
+    for (i = 0; i < event->nevents_zero; i++) {
+      if (event->monitor) PetscCall(PetscViewerASCIIPrintf(event->monitor, "TSEvent: Event %" PetscInt_FMT " zero crossing located at time %g on the interpolant with %" PetscInt_FMT " evaluations\n", event->events_zero[i], (double)tr, nevals));
+    }
+    for (i = 0; i < event->nevents; i++) event->fvalue[i] = fr[i];
+    /* restart from the interpolated solution at the event */
+    if (tr < ts->ptime) {
+      PetscCall(TSInterpolate(ts, tr, event->work));
+      PetscCall(VecCopy(event->work, ts->vec_sol));
+      ts->ptime = tr;
+      if (ts->reason == TS_CONVERGED_TIME) PetscCall(TSSetConvergedReason(ts, TS_CONVERGED_ITERATING));
+      PetscCall(TSRestartStep(ts));
+    }
+    event->status = TSEVENT_ZERO;
+    *t            = tr;
+  } else event->status = TSEVENT_NONE;
+  PetscCall(PetscFree5(fl, fr, fc, gl, gr));
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode TSEventHandler(TS ts)
 {
   TSEvent   event;
@@ -510,7 +674,10 @@ PetscErrorCode TSEventHandler(TS ts)
   PetscCall(TSEventDetection(ts));
 
   /* Locate the events */
-  if (event->status == TSEVENT_LOCATED_INTERVAL || event->status == TSEVENT_PROCESSING) {
+  if (event->status == TSEVENT_LOCATED_INTERVAL && TSEventCanInterpolate_Private(ts)) {
+    /* Locate the zero crossing within the step, the step is kept */
+    PetscCall(TSEventLocationInterpolate(ts, &t));
+  } else if (event->status == TSEVENT_LOCATED_INTERVAL || event->status == TSEVENT_PROCESSING) {
     /* Approach the zero crosing by setting a new step size */
     PetscCall(TSEventLocation(ts, &dt));
     /* Roll back when new events are detected */
@@ -522,30 +689,30 @@ PetscErrorCode TSEventHandler(TS ts)
     PetscCall(MPIU_Allreduce(&dt, &dt_min, 1, MPIU_REAL, MPIU_MIN, PetscObjectComm((PetscObject)ts)));
     if (dt_reset > 0.0 && dt_reset < dt_min) dt_min = dt_reset;
     PetscCall(TSSetTimeStep(ts, dt_min));
-    /* Found the zero crossing */
-    if (event->status == TSEVENT_ZERO) {
-      PetscCall(TSPostEvent(ts, t, U));
-
-      dt = event->ptime_end - t;
-      if (PetscAbsReal(dt) < PETSC_SMALL) { /* we hit the event, continue with the candidate time step */
-        dt            = event->timestep_prev;
-        event->status = TSEVENT_NONE;
-      }
-      if (event->timestep_postevent) { /* user has specified a PostEvent dt*/
-        dt = event->timestep_postevent;
-      }
-      if (ts->exact_final_time == TS_EXACTFINALTIME_MATCHSTEP) {
-        PetscReal maxdt = ts->max_time - t;
-        dt              = dt > maxdt ? maxdt : (PetscIsCloseAtTol(dt, maxdt, 10 * PETSC_MACHINE_EPSILON, 0) ? maxdt : dt);
-      }
-      PetscCall(TSSetTimeStep(ts, dt));
-      event->iterctr = 0;
+  }
+  /* Found the zero crossing */
+  if (event->status == TSEVENT_ZERO) {
+    PetscCall(TSPostEvent(ts, t, U));
+
+    dt = event->ptime_end - t;
+    if (PetscAbsReal(dt) < PETSC_SMALL) { /* we hit the event, continue with the candidate time step */
+      dt            = event->timestep_prev;
+      event->status = TSEVENT_NONE;
     }
-    /* Have not found the zero crosing yet */
-    if (event->status == TSEVENT_PROCESSING) {
-      if (event->monitor) PetscCall(PetscViewerASCIIPrintf(event->monitor, "TSEvent: iter %" PetscInt_FMT " - Stepping forward as no event detected in interval [%g - %g]\n", event->iterctr, (double)event->ptime_prev, (double)t));
-      event->iterctr++;
+    if (event->timestep_postevent) { /* user has specified a PostEvent dt*/
+      dt = event->timestep_postevent;
     }
+    if (ts->exact_final_time == TS_EXACTFINALTIME_MATCHSTEP) {
+      PetscReal maxdt = ts->max_time - t;
+      dt              = dt > maxdt ? maxdt : (PetscIsCloseAtTol(dt, maxdt, 10 * PETSC_MACHINE_EPSILON, 0) ? maxdt : dt);
+    }
+    PetscCall(TSSetTimeStep(ts, dt));
+    event->iterctr = 0;
+  }
+  /* Have not found the zero crosing yet */
+  if (event->status == TSEVENT_PROCESSING) {
+    if (event->monitor) PetscCall(PetscViewerASCIIPrintf(event->monitor, "TSEvent: iter %" PetscInt_FMT " - Stepping forward as no event detected in interval [%g - %g]\n", event->iterctr, (double)event->ptime_prev, (double)t));
+    event->iterctr++;
   }
   if (event->status == TSEVENT_LOCATED_INTERVAL) { /* The step has been rolled back */
     event->status      = TSEVENT_PROCESSING;
@@ -1286,6 +1286,30 @@ static PetscErrorCode TSARKIMEXGetType_ARKIMEX(TS ts, TSARKIMEXType *arktype)
   *arktype = ark->tableau->name;
   PetscFunctionReturn(0);
 }
+/*
+   The stiff part of the registered tableau with the given name, for the methods built on the ARKIMEX tableaus
+*/
+PetscErrorCode TSARKIMEXGetTableauByName_Internal(TSARKIMEXType arktype, PetscInt *s, const PetscReal **At, const PetscReal **bt, const PetscReal **ct, const PetscReal **bembedt, PetscInt *order)
+{
+  PetscBool match;
+
+  PetscFunctionBegin;
+  PetscCall(TSARKIMEXInitializePackage());
+  for (ARKTableauLink link = ARKTableauList; link; link = link->next) {
+    PetscCall(PetscStrcmp(link->tab.name, arktype, &match));
+    if (match) {
+      if (s) *s = link->tab.s;
+      if (At) *At = link->tab.At;
+      if (bt) *bt = link->tab.bt;
+      if (ct) *ct = link->tab.ct;
+      if (bembedt) *bembedt = link->tab.bembedt;
+      if (order) *order = link->tab.order;
+      PetscFunctionReturn(0);
+    }
+  }
+  SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_UNKNOWN_TYPE, "Could not find ARKIMEX tableau '%s'", arktype);
+}
+
 static PetscErrorCode TSARKIMEXSetType_ARKIMEX(TS ts, TSARKIMEXType arktype)
 {
   TS_ARKIMEX    *ark = (TS_ARKIMEX *)ts->data;
@@ -0,0 +1,704 @@
+/*
+       Code for the time integration of ensembles of small independent ODE systems, with the members interleaved
+*/
+#include <petsc/private/tsimpl.h> /*I   "petscts.h"   I*/
+
+static const char *citation = "@book{HairerWanner1996,\n"
+                              "  author    = {E. Hairer and G. Wanner},\n"
+                              "  title     = {Solving Ordinary Differential Equations II: Stiff and Differential-Algebraic Problems},\n"
+                              "  publisher = {Springer},\n"
+                              "  year      = {1996}\n}\n";
+static PetscBool  cited    = PETSC_FALSE;
+
+typedef struct {
+  PetscInt           m;  /* size of a member */
+  PetscInt           nb; /* number of members on this process */
+  TSBatchRHSFunction rhsfunction;
+  void              *funP;
+  TSBatchRHSJacobian rhsjacobian;
+  void              *jacP;
+  PetscBool          implicit;
+  char              *rktype, *arkimextype;
+
+  /* the tableau in use */
+  PetscInt         s, order;
+  const PetscReal *A, *b, *c, *bembed;
+
+  /* per member */
+  PetscReal *h;      /* the step size the controller chose last */
+  PetscReal *tm;     /* the time of the member within the macro step */
+  PetscInt  *nrej;   /* consecutive rejections */
+  PetscInt  *active; /* the members still stepping, compacted into the work arrays */
+
+  /* work arrays over the active members, entry j of member k at j*n+k */
+  PetscReal   *t, *hk, *err;
+  PetscScalar *U0, *U, *Y, *Z, *F, *K, *J, *LU;
+  PetscInt    *piv;
+  PetscBool   *fail;
+
+  /* statistics */
+  PetscInt nsteps, nrejects, nfevals, njevals, nfactors;
+} TS_Batch;
+
+/* the right-hand side of the n active members, compacted */
+static PetscErrorCode TSBatchEvaluate(TS ts, PetscInt n, const PetscReal t[], const PetscScalar u[], PetscScalar f[])
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCallBack("TSBatch callback function", (*batch->rhsfunction)(ts, n, batch->m, batch->active, t, u, f, batch->funP));
+  batch->nfevals++;
+  PetscFunctionReturn(0);
+}
+
+/* J = df/du of the n active members at u, from the user or by one-sided differences */
+static PetscErrorCode TSBatchEvaluateJacobian(TS ts, PetscInt n, const PetscReal t[], const PetscScalar u[], const PetscScalar f[], PetscScalar J[])
+{
+  TS_Batch        *batch = (TS_Batch *)ts->data;
+  const PetscInt   m     = batch->m;
+  const PetscReal  sqeps = PetscSqrtReal(PETSC_MACHINE_EPSILON);
+  PetscScalar     *up = batch->Y, *fp = batch->F;
+
+  PetscFunctionBegin;
+  batch->njevals++;
+  if (batch->rhsjacobian) {
+    PetscCallBack("TSBatch callback Jacobian", (*batch->rhsjacobian)(ts, n, m, batch->active, t, u, J, batch->jacP));
+    PetscFunctionReturn(0);
+  }
+  PetscCall(PetscArraycpy(up, u, m * n));
+  for (PetscInt c = 0; c < m; c++) {
+    for (PetscInt k = 0; k < n; k++) up[c * n + k] += sqeps * PetscMax(PetscAbsScalar(u[c * n + k]), 1.0);
+    PetscCall(TSBatchEvaluate(ts, n, t, up, fp));
+    for (PetscInt k = 0; k < n; k++) {
+      const PetscReal delta = sqeps * PetscMax(PetscAbsScalar(u[c * n + k]), 1.0);
+
+      for (PetscInt r = 0; r < m; r++) J[(r * m + c) * n + k] = (fp[r * n + k] - f[r * n + k]) / delta;
+      up[c * n + k] = u[c * n + k];
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   LU factorization with partial pivoting of the n matrices M = I - hgamma*J, the loop over the members innermost.
+   A member with a singular matrix is marked as failed.
+*/
+static PetscErrorCode TSBatchFactor(PetscInt n, PetscInt m, const PetscReal hgamma[], const PetscScalar J[], PetscScalar M[], PetscInt piv[], PetscBool fail[])
+{
+  PetscFunctionBegin;
+  for (PetscInt r = 0; r < m; r++) {
+    for (PetscInt c = 0; c < m; c++) {
+      for (PetscInt k = 0; k < n; k++) M[(r * m + c) * n + k] = (r == c ? 1.0 : 0.0) - hgamma[k] * J[(r * m + c) * n + k];
+    }
+  }
+  for (PetscInt col = 0; col < m; col++) {
+    for (PetscInt k = 0; k < n; k++) {
+      PetscInt  p   = col;
+      PetscReal max = PetscAbsScalar(M[(col * m + col) * n + k]);
+
+      for (PetscInt r = col + 1; r < m; r++) {
+        if (PetscAbsScalar(M[(r * m + col) * n + k]) > max) {
+          max = PetscAbsScalar(M[(r * m + col) * n + k]);
+          p   = r;
+        }
+      }
+      piv[col * n + k] = p;
+      if (max == 0.0) {
+        fail[k]                  = PETSC_TRUE;
+        M[(col * m + col) * n + k] = 1.0;
+      }
+    }
+    for (PetscInt c = 0; c < m; c++) {
+      for (PetscInt k = 0; k < n; k++) {
+        const PetscInt p = piv[col * n + k];
+
+        if (p != col) {
+          const PetscScalar tmp = M[(col * m + c) * n + k];
+
+          M[(col * m + c) * n + k] = M[(p * m + c) * n + k];
+          M[(p * m + c) * n + k]   = tmp;
+        }
+      }
+    }
+    for (PetscInt r = col + 1; r < m; r++) {
+      for (PetscInt k = 0; k < n; k++) M[(r * m + col) * n + k] /= M[(col * m + col) * n + k];
+      for (PetscInt c = col + 1; c < m; c++) {
+        for (PetscInt k = 0; k < n; k++) M[(r * m + c) * n + k] -= M[(r * m + col) * n + k] * M[(col * m + c) * n + k];
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* solves with the factors of TSBatchFactor() in place */
+static PetscErrorCode TSBatchSolve(PetscInt n, PetscInt m, const PetscScalar M[], const PetscInt piv[], PetscScalar x[])
+{
+  PetscFunctionBegin;
+  for (PetscInt col = 0; col < m; col++) {
+    for (PetscInt k = 0; k < n; k++) {
+      const PetscInt p = piv[col * n + k];
+
+      if (p != col) {
+        const PetscScalar tmp = x[col * n + k];
+
+        x[col * n + k] = x[p * n + k];
+        x[p * n + k]   = tmp;
+      }
+    }
+  }
+  for (PetscInt r = 1; r < m; r++) {
+    for (PetscInt c = 0; c < r; c++) {
+      for (PetscInt k = 0; k < n; k++) x[r * n + k] -= M[(r * m + c) * n + k] * x[c * n + k];
+    }
+  }
+  for (PetscInt r = m - 1; r >= 0; r--) {
+    for (PetscInt c = r + 1; c < m; c++) {
+      for (PetscInt k = 0; k < n; k++) x[r * n + k] -= M[(r * m + c) * n + k] * x[c * n + k];
+    }
+    for (PetscInt k = 0; k < n; k++) x[r * n + k] /= M[(r * m + r) * n + k];
+  }
+  PetscFunctionReturn(0);
+}
+
+/* the weighted RMS norm of the n members of x with the tolerances of the TS, scaled by the members u and v */
+static PetscErrorCode TSBatchNormWRMS(TS ts, PetscInt n, const PetscScalar x[], const PetscScalar u[], const PetscScalar v[], const PetscScalar *atol, const PetscScalar *rtol, PetscReal norm[])
+{
+  TS_Batch      *batch = (TS_Batch *)ts->data;
+  const PetscInt m     = batch->m, nb = batch->nb;
+
+  PetscFunctionBegin;
+  for (PetscInt k = 0; k < n; k++) norm[k] = 0.0;
+  for (PetscInt j = 0; j < m; j++) {
+    for (PetscInt k = 0; k < n; k++) {
+      const PetscInt  i  = batch->active[k];
+      const PetscReal a  = atol ? PetscRealPart(atol[j * nb + i]) : ts->atol;
+      const PetscReal r  = rtol ? PetscRealPart(rtol[j * nb + i]) : ts->rtol;
+      const PetscReal sc = a + r * PetscMax(PetscAbsScalar(u[j * n + k]), PetscAbsScalar(v[j * n + k]));
+      const PetscReal e  = PetscAbsScalar(x[j * n + k]) / sc;
+
+      norm[k] += e * e;
+    }
+  }
+  for (PetscInt k = 0; k < n; k++) norm[k] = PetscSqrtReal(norm[k] / m);
+  PetscFunctionReturn(0);
+}
+
+/* the stages of the explicit method for the n active members, K[s] = f(t + c h, U0 + h sum_j A[s,j] K[j]) */
+static PetscErrorCode TSBatchStagesExplicit(TS ts, PetscInt n)
+{
+  TS_Batch       *batch = (TS_Batch *)ts->data;
+  const PetscInt  m = batch->m, s = batch->s, mn = m * n;
+  const PetscReal *A = batch->A, *c = batch->c;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < s; i++) {
+    PetscScalar *Ki = batch->K + i * mn;
+
+    for (PetscInt k = 0; k < n; k++) batch->t[k] = batch->tm[batch->active[k]] + c[i] * batch->hk[k];
+    PetscCall(PetscArraycpy(batch->Y, batch->U0, mn));
+    for (PetscInt j = 0; j < i; j++) {
+      const PetscScalar *Kj = batch->K + j * mn;
+
+      if (A[i * s + j] == 0.0) continue;
+      for (PetscInt l = 0; l < m; l++) {
+        for (PetscInt k = 0; k < n; k++) batch->Y[l * n + k] += batch->hk[k] * A[i * s + j] * Kj[l * n + k];
+      }
+    }
+    PetscCall(TSBatchEvaluate(ts, n, batch->t, batch->Y, Ki));
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   The stages of the diagonally implicit method for the n active members, each solved by a simplified Newton iteration
+   with the Jacobian at the start of the step. Members whose iteration does not converge are marked as failed.
+*/
+static PetscErrorCode TSBatchStagesImplicit(TS ts, PetscInt n, const PetscScalar *atol, const PetscScalar *rtol)
+{
+  TS_Batch        *batch = (TS_Batch *)ts->data;
+  const PetscInt   m = batch->m, s = batch->s, mn = m * n, maxit = 10;
+  const PetscReal *A = batch->A, *c = batch->c;
+  const PetscReal  ntol       = 0.03; /* of the weighted norm of the Newton update */
+  PetscScalar     *dY         = batch->U;
+  PetscBool        jevaluated = PETSC_FALSE;
+  PetscReal        gamma      = 0.0;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < s; i++) {
+    PetscScalar    *Ki = batch->K + i * mn;
+    const PetscReal aii = A[i * s + i];
+
+    for (PetscInt k = 0; k < n; k++) batch->t[k] = batch->tm[batch->active[k]] + c[i] * batch->hk[k];
+    /* Z = U0 + h sum_{j<i} A[i,j] K[j] */
+    PetscCall(PetscArraycpy(batch->Z, batch->U0, mn));
+    for (PetscInt j = 0; j < i; j++) {
+      const PetscScalar *Kj = batch->K + j * mn;
+
+      if (A[i * s + j] == 0.0) continue;
+      for (PetscInt l = 0; l < m; l++) {
+        for (PetscInt k = 0; k < n; k++) batch->Z[l * n + k] += batch->hk[k] * A[i * s + j] * Kj[l * n + k];
+      }
+    }
+    if (aii == 0.0) {
+      PetscCall(TSBatchEvaluate(ts, n, batch->t, batch->Z, Ki));
+      continue;
+    }
+    if (!jevaluated) {
+      PetscReal   *t0 = batch->err;
+      PetscScalar *f0 = Ki;
+
+      for (PetscInt k = 0; k < n; k++) t0[k] = batch->tm[batch->active[k]];
+      /* the explicit first stage of the method is f at the start of the step */
+      if (i > 0 && A[0] == 0.0 && c[0] == 0.0) f0 = batch->K;
+      else PetscCall(TSBatchEvaluate(ts, n, t0, batch->U0, f0));
+      PetscCall(TSBatchEvaluateJacobian(ts, n, t0, batch->U0, f0, batch->J));
+      jevaluated = PETSC_TRUE;
+    }
+    if (aii != gamma) {
+      for (PetscInt k = 0; k < n; k++) batch->err[k] = batch->hk[k] * aii;
+      PetscCall(TSBatchFactor(n, m, batch->err, batch->J, batch->LU, batch->piv, batch->fail));
+      batch->nfactors++;
+      gamma = aii;
+    }
+    /* Y - h aii f(t, Y) = Z, starting from Y = Z */
+    PetscCall(PetscArraycpy(batch->Y, batch->Z, mn));
+    for (PetscInt it = 0; it < maxit; it++) {
+      PetscBool converged = PETSC_TRUE;
+
+      PetscCall(TSBatchEvaluate(ts, n, batch->t, batch->Y, batch->F));
+      for (PetscInt l = 0; l < m; l++) {
+        for (PetscInt k = 0; k < n; k++) dY[l * n + k] = batch->Z[l * n + k] + batch->hk[k] * aii * batch->F[l * n + k] - batch->Y[l * n + k];
+      }
+      PetscCall(TSBatchSolve(n, m, batch->LU, batch->piv, dY));
+      for (PetscInt l = 0; l < m; l++) {
+        for (PetscInt k = 0; k < n; k++) batch->Y[l * n + k] += dY[l * n + k];
+      }
+      PetscCall(TSBatchNormWRMS(ts, n, dY, batch->Y, batch->U0, atol, rtol, batch->err));
+      for (PetscInt k = 0; k < n; k++) {
+        if (!(batch->err[k] <= ntol)) converged = PETSC_FALSE;
+      }
+      if (converged) break;
+      if (it == maxit - 1) {
+        for (PetscInt k = 0; k < n; k++) {
+          if (!(batch->err[k] <= ntol)) batch->fail[k] = PETSC_TRUE;
+        }
+      }
+    }
+    for (PetscInt l = 0; l < m; l++) {
+      for (PetscInt k = 0; k < n; k++) Ki[l * n + k] = (batch->Y[l * n + k] - batch->Z[l * n + k]) / (batch->hk[k] * aii);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSStep_Batch(TS ts)
+{
+  TS_Batch          *batch = (TS_Batch *)ts->data;
+  const PetscInt     m = batch->m, nb = batch->nb, s = batch->s;
+  const PetscReal    t0 = ts->ptime, tf = ts->ptime + ts->time_step, exponent = 1.0 / PetscMax(batch->order, 1);
+  const PetscReal    tiny = 100 * PETSC_MACHINE_EPSILON * PetscMax(PetscAbsReal(tf), 1.0);
+  const PetscScalar *atol = NULL, *rtol = NULL;
+  PetscScalar       *u;
+  PetscReal          safety, reject_safety, clipmin, clipmax;
+  PetscInt           diverged = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscCitationsRegister(citation, &cited));
+  PetscCall(TSAdaptGetSafety(ts->adapt, &safety, &reject_safety));
+  PetscCall(TSAdaptGetClip(ts->adapt, &clipmin, &clipmax));
+  PetscCall(VecGetArray(ts->vec_sol, &u));
+  if (ts->vatol) PetscCall(VecGetArrayRead(ts->vatol, &atol));
+  if (ts->vrtol) PetscCall(VecGetArrayRead(ts->vrtol, &rtol));
+  for (PetscInt i = 0; i < nb; i++) {
+    batch->tm[i]   = t0;
+    batch->nrej[i] = 0;
+    if (!(batch->h[i] > 0.0) || !batch->bembed) batch->h[i] = ts->time_step;
+  }
+  while (!diverged) {
+    PetscInt n = 0, mn;
+
+    for (PetscInt i = 0; i < nb; i++) {
+      if (tf - batch->tm[i] > tiny) batch->active[n++] = i;
+    }
+    if (!n) break;
+    mn = m * n;
+    for (PetscInt k = 0; k < n; k++) {
+      const PetscInt i = batch->active[k];
+
+      batch->hk[k]   = PetscMin(batch->h[i], tf - batch->tm[i]);
+      batch->fail[k] = PETSC_FALSE;
+    }
+    for (PetscInt j = 0; j < m; j++) {
+      for (PetscInt k = 0; k < n; k++) batch->U0[j * n + k] = u[j * nb + batch->active[k]];
+    }
+
+    if (batch->implicit) PetscCall(TSBatchStagesImplicit(ts, n, atol, rtol));
+    else PetscCall(TSBatchStagesExplicit(ts, n));
+
+    /* the solution, and the difference to the embedded one in Z */
+    PetscCall(PetscArraycpy(batch->U, batch->U0, mn));
+    PetscCall(PetscArrayzero(batch->Z, mn));
+    for (PetscInt i = 0; i < s; i++) {
+      const PetscScalar *Ki = batch->K + i * mn;
+
+      for (PetscInt j = 0; j < m; j++) {
+        for (PetscInt k = 0; k < n; k++) batch->U[j * n + k] += batch->hk[k] * batch->b[i] * Ki[j * n + k];
+      }
+      if (!batch->bembed) continue;
+      for (PetscInt j = 0; j < m; j++) {
+        for (PetscInt k = 0; k < n; k++) batch->Z[j * n + k] += batch->hk[k] * (batch->b[i] - batch->bembed[i]) * Ki[j * n + k];
+      }
+    }
+    /* the error of the stiff components is filtered by the factors of the stages, as the estimate of the embedded method overestimates it */
+    if (batch->bembed && batch->implicit) PetscCall(TSBatchSolve(n, m, batch->LU, batch->piv, batch->Z));
+    if (batch->bembed) PetscCall(TSBatchNormWRMS(ts, n, batch->Z, batch->U0, batch->U, atol, rtol, batch->err));
+    else PetscCall(PetscArrayzero(batch->err, n));
+
+    for (PetscInt k = 0; k < n; k++) {
+      const PetscInt  i   = batch->active[k];
+      const PetscReal err = batch->err[k];
+      PetscBool       accept;
+      PetscReal       factor;
+
+      accept = (!batch->fail[k] && !PetscIsInfOrNanReal(err) && err <= 1.0) ? PETSC_TRUE : PETSC_FALSE;
+      if (batch->fail[k] || PetscIsInfOrNanReal(err)) factor = 0.25;
+      else if (err == 0.0) factor = clipmax;
+      else factor = PetscClipInterval((accept ? safety : reject_safety) * PetscPowReal(err, -exponent), clipmin, clipmax);
+      if (accept) {
+        for (PetscInt j = 0; j < m; j++) u[j * nb + i] = batch->U[j * n + k];
+        batch->tm[i] = (tf - (batch->tm[i] + batch->hk[k]) > tiny) ? batch->tm[i] + batch->hk[k] : tf;
+        batch->nrej[i] = 0;
+        batch->nsteps++;
+        /* a step shortened to reach the end of the macro step does not limit the next one */
+        if (batch->bembed) batch->h[i] = (batch->hk[k] < batch->h[i]) ? PetscMax(batch->h[i], batch->hk[k] * factor) : batch->hk[k] * factor;
+      } else {
+        batch->h[i] = batch->hk[k] * PetscMin(factor, 1.0);
+        batch->nrejects++;
+        if (++batch->nrej[i] > ts->max_reject || !batch->bembed) diverged = 1;
+      }
+    }
+  }
+  if (ts->vrtol) PetscCall(VecRestoreArrayRead(ts->vrtol, &rtol));
+  if (ts->vatol) PetscCall(VecRestoreArrayRead(ts->vatol, &atol));
+  PetscCall(VecRestoreArray(ts->vec_sol, &u));
+
+  /* a member of any process that fails stops all of them */
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &diverged, 1, MPIU_INT, MPI_MAX, PetscObjectComm((PetscObject)ts)));
+  if (diverged) {
+    ts->reason = TS_DIVERGED_STEP_REJECTED;
+    PetscFunctionReturn(0);
+  }
+  ts->ptime += ts->time_step;
+  PetscFunctionReturn(0);
+}
+/*------------------------------------------------------------*/
+
+static PetscErrorCode TSBatchLoadTableau(TS ts)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  if (batch->implicit) {
+    PetscCall(TSARKIMEXGetTableauByName_Internal(batch->arkimextype, &batch->s, &batch->A, &batch->b, &batch->c, &batch->bembed, &batch->order));
+    for (PetscInt i = 0; i < batch->s; i++) {
+      for (PetscInt j = i + 1; j < batch->s; j++) PetscCheck(batch->A[i * batch->s + j] == 0.0, PetscObjectComm((PetscObject)ts), PETSC_ERR_SUP, "ARKIMEX method %s is not diagonally implicit", batch->arkimextype);
+    }
+  } else {
+    PetscCall(TSRKGetTableauByName_Internal(batch->rktype, &batch->s, &batch->A, &batch->b, &batch->c, &batch->bembed, &batch->order));
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSReset_Batch(TS ts)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree4(batch->h, batch->tm, batch->nrej, batch->active));
+  PetscCall(PetscFree4(batch->t, batch->hk, batch->err, batch->fail));
+  PetscCall(PetscFree6(batch->U0, batch->U, batch->Y, batch->Z, batch->F, batch->K));
+  PetscCall(PetscFree3(batch->J, batch->LU, batch->piv));
+  batch->nb = 0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSSetUp_Batch(TS ts)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+  PetscInt  n, m = batch->m, nb, s;
+
+  PetscFunctionBegin;
+  PetscCheck(batch->rhsfunction, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_WRONGSTATE, "Must call TSBatchSetRHSFunction() first");
+  PetscCall(TSBatchLoadTableau(ts));
+  PetscCall(VecGetLocalSize(ts->vec_sol, &n));
+  PetscCheck(n % m == 0, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Local size of the solution %" PetscInt_FMT " is not a multiple of the size of a member %" PetscInt_FMT, n, m);
+  nb = n / m;
+  s  = batch->s;
+  PetscCall(TSReset_Batch(ts));
+  batch->nb = nb;
+  PetscCall(PetscCalloc4(nb, &batch->h, nb, &batch->tm, nb, &batch->nrej, nb, &batch->active));
+  PetscCall(PetscMalloc4(nb, &batch->t, nb, &batch->hk, nb, &batch->err, nb, &batch->fail));
+  PetscCall(PetscMalloc6(n, &batch->U0, n, &batch->U, n, &batch->Y, n, &batch->Z, n, &batch->F, s * n, &batch->K));
+  if (batch->implicit) PetscCall(PetscMalloc3(m * n, &batch->J, m * n, &batch->LU, n, &batch->piv));
+  if (ts->exact_final_time == TS_EXACTFINALTIME_UNSPECIFIED) ts->exact_final_time = TS_EXACTFINALTIME_MATCHSTEP;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSDestroy_Batch(TS ts)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCall(TSReset_Batch(ts));
+  PetscCall(PetscFree(batch->rktype));
+  PetscCall(PetscFree(batch->arkimextype));
+  PetscCall(PetscFree(ts->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRHSFunction_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRHSJacobian_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetImplicit_C", NULL));
+  PetscFunctionReturn(0);
+}
+/*------------------------------------------------------------*/
+
+static PetscErrorCode TSSetFromOptions_Batch(TS ts, PetscOptionItems *PetscOptionsObject)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+  char      rktype[256], arkimextype[256];
+  PetscBool flg;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "Batch ODE solver options");
+  PetscCall(PetscStrncpy(rktype, batch->rktype, sizeof(rktype)));
+  PetscCall(PetscOptionsString("-ts_batch_rk_type", "Explicit Runge-Kutta method of the members", "TSBatchSetImplicit", rktype, rktype, sizeof(rktype), &flg));
+  if (flg) {
+    PetscCall(PetscFree(batch->rktype));
+    PetscCall(PetscStrallocpy(rktype, &batch->rktype));
+  }
+  PetscCall(PetscStrncpy(arkimextype, batch->arkimextype, sizeof(arkimextype)));
+  PetscCall(PetscOptionsString("-ts_batch_arkimex_type", "ARKIMEX method whose diagonally implicit part is used for stiff members", "TSBatchSetImplicit", arkimextype, arkimextype, sizeof(arkimextype), &flg));
+  if (flg) {
+    PetscCall(PetscFree(batch->arkimextype));
+    PetscCall(PetscStrallocpy(arkimextype, &batch->arkimextype));
+  }
+  PetscCall(PetscOptionsBool("-ts_batch_implicit", "Use the diagonally implicit method", "TSBatchSetImplicit", batch->implicit, &batch->implicit, NULL));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSView_Batch(TS ts, PetscViewer viewer)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+  PetscBool iascii;
+  PetscInt  stats[5], nb;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (!iascii) PetscFunctionReturn(0);
+  stats[0] = batch->nsteps;
+  stats[1] = batch->nrejects;
+  stats[2] = batch->nfevals;
+  stats[3] = batch->njevals;
+  stats[4] = batch->nfactors;
+  nb       = batch->nb;
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, stats, 5, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject)ts)));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &nb, 1, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject)ts)));
+  PetscCall(PetscViewerASCIIPrintf(viewer, "  %" PetscInt_FMT " members of size %" PetscInt_FMT "\n", nb, batch->m));
+  if (batch->implicit) PetscCall(PetscViewerASCIIPrintf(viewer, "  Diagonally implicit method of ARKIMEX type %s\n", batch->arkimextype));
+  else PetscCall(PetscViewerASCIIPrintf(viewer, "  Explicit method of RK type %s\n", batch->rktype));
+  PetscCall(PetscViewerASCIIPrintf(viewer, "  Member steps %" PetscInt_FMT ", rejected %" PetscInt_FMT ", batched function evaluations %" PetscInt_FMT "\n", stats[0], stats[1], stats[2]));
+  if (batch->implicit) PetscCall(PetscViewerASCIIPrintf(viewer, "  Batched Jacobian evaluations %" PetscInt_FMT ", factorizations %" PetscInt_FMT "%s\n", stats[3], stats[4], batch->rhsjacobian ? "" : " (Jacobian by finite differences)"));
+  PetscFunctionReturn(0);
+}
+/* ------------------------------------------------------------ */
+
+static PetscErrorCode TSBatchSetRHSFunction_Batch(TS ts, PetscInt m, TSBatchRHSFunction f, void *ctx)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCheck(m > 0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Size of a member %" PetscInt_FMT " must be positive", m);
+  if (m != batch->m) ts->setupcalled = PETSC_FALSE;
+  batch->m           = m;
+  batch->rhsfunction = f;
+  batch->funP        = ctx;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSBatchSetRHSJacobian_Batch(TS ts, TSBatchRHSJacobian J, void *ctx)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  batch->rhsjacobian = J;
+  batch->jacP        = ctx;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSBatchSetImplicit_Batch(TS ts, PetscBool implicit)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  if (implicit != batch->implicit) ts->setupcalled = PETSC_FALSE;
+  batch->implicit = implicit;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  TSBatchSetRHSFunction - Sets the right-hand side function of the members of a `TSBATCH` ensemble
+
+  Logically collective
+
+  Input Parameters:
++  ts - timestepping context
+.  m - the size of each member
+.  f - the batched right-hand side function
+-  ctx - [optional] user-defined context for the function (may be `NULL`)
+
+  Calling sequence of f:
+$   PetscErrorCode f(TS ts, PetscInt n, PetscInt m, const PetscInt idx[], const PetscReal t[], const PetscScalar u[], PetscScalar F[], void *ctx);
+
++  ts - the `TS` context
+.  n - the number of members in the batch
+.  m - the size of each member
+.  idx - the local index of each member in the solution vector
+.  t - the time of each member
+.  u - the states, component j of member k is u[j*n+k]
+.  F - the right-hand sides, stored like u
+-  ctx - [optional] user-defined context
+
+  Level: beginner
+
+  Note:
+  The local part of the solution vector holds nb members, with component j of member i at the entry j*nb+i. The function
+  is called with the members still stepping compacted into arrays of the same layout, so n may be smaller than nb.
+
+.seealso: [](chapter_ts), `TSBATCH`, `TSBatchSetRHSJacobian()`, `TSBatchSetImplicit()`
+@*/
+PetscErrorCode TSBatchSetRHSFunction(TS ts, PetscInt m, TSBatchRHSFunction f, void *ctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ts, m, 2);
+  PetscTryMethod(ts, "TSBatchSetRHSFunction_C", (TS, PetscInt, TSBatchRHSFunction, void *), (ts, m, f, ctx));
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  TSBatchSetRHSJacobian - Sets the Jacobian of the right-hand side function of the members of a `TSBATCH` ensemble
+
+  Logically collective
+
+  Input Parameters:
++  ts - timestepping context
+.  J - the batched Jacobian function
+-  ctx - [optional] user-defined context for the function (may be `NULL`)
+
+  Calling sequence of J:
+$   PetscErrorCode J(TS ts, PetscInt n, PetscInt m, const PetscInt idx[], const PetscReal t[], const PetscScalar u[], PetscScalar Jac[], void *ctx);
+
++  ts - the `TS` context
+.  n - the number of members in the batch
+.  m - the size of each member
+.  idx - the local index of each member in the solution vector
+.  t - the time of each member
+.  u - the states, component j of member k is u[j*n+k]
+.  Jac - the Jacobians, the derivative of component r with respect to component c of member k is Jac[(r*m+c)*n+k]
+-  ctx - [optional] user-defined context
+
+  Level: intermediate
+
+  Note:
+  Only the implicit method uses the Jacobian. Without it, the Jacobian is computed by finite differences with m extra
+  evaluations of the right-hand side function.
+
+.seealso: [](chapter_ts), `TSBATCH`, `TSBatchSetRHSFunction()`, `TSBatchSetImplicit()`
+@*/
+PetscErrorCode TSBatchSetRHSJacobian(TS ts, TSBatchRHSJacobian J, void *ctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscTryMethod(ts, "TSBatchSetRHSJacobian_C", (TS, TSBatchRHSJacobian, void *), (ts, J, ctx));
+  PetscFunctionReturn(0);
+}
+
+/*@
+  TSBatchSetImplicit - Sets whether the members of a `TSBATCH` ensemble are integrated with a diagonally implicit method
+
+  Logically collective
+
+  Input Parameters:
++  ts - timestepping context
+-  implicit - `PETSC_TRUE` to use the diagonally implicit part of a `TSARKIMEX` method, `PETSC_FALSE` for an explicit `TSRK` method
+
+  Options Database Keys:
++  -ts_batch_implicit <bool> - use the implicit method
+.  -ts_batch_rk_type <type> - the `TSRKType` of the explicit method, `TSRK5DP` by default
+-  -ts_batch_arkimex_type <type> - the `TSARKIMEXType` of the implicit method, `TSARKIMEX3` by default
+
+  Level: beginner
+
+.seealso: [](chapter_ts), `TSBATCH`, `TSBatchSetRHSFunction()`, `TSBatchSetRHSJacobian()`
+@*/
+PetscErrorCode TSBatchSetImplicit(TS ts, PetscBool implicit)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(ts, implicit, 2);
+  PetscTryMethod(ts, "TSBatchSetImplicit_C", (TS, PetscBool), (ts, implicit));
+  PetscFunctionReturn(0);
+}
+
+/*MC
+      TSBATCH - ODE solver for ensembles of many small independent systems, such as parameter sweeps or the chemistry of the cells of a mesh
+
+  The local part of the solution holds the members interleaved, component j of member i at the entry j*nb+i of the nb
+  members of the process, so that the loops over the members are innermost and vectorize. Each member takes its own
+  adaptive steps with the tableau of a `TSRK` method, or of the diagonally implicit part of a `TSARKIMEX` method for stiff
+  members, within the steps of the `TS`. The error of a member is the weighted RMS norm of the difference to the
+  embedded method with the tolerances of `TSSetTolerances()`, and the safety factor and clipping of the `TSAdapt` control
+  its step size. The members still stepping are compacted before each step, so the batch shrinks as they finish.
+
+  The implicit stages are solved by a simplified Newton iteration with the Jacobian at the start of the step, factored
+  for all members at once with partial pivoting.
+
+  Options Database Keys:
++  -ts_batch_implicit <bool> - use the implicit method
+.  -ts_batch_rk_type <type> - the `TSRKType` of the explicit method, `TSRK5DP` by default
+-  -ts_batch_arkimex_type <type> - the `TSARKIMEXType` of the implicit method, `TSARKIMEX3` by default
+
+  Level: intermediate
+
+  Notes:
+  The right-hand side is given with `TSBatchSetRHSFunction()`, not `TSSetRHSFunction()`.
+
+  The steps of the `TS`, at which monitors see the solution, have the fixed size of `TSSetTimeStep()`, only the steps of
+  the members within them are adaptive. The `TSAdaptType` is not used, only the safety factor and clipping of the
+  `TSAdapt`. The `TS` is not stepped past the final time unless `TSSetExactFinalTime()` asks for it.
+
+.seealso: [](chapter_ts), `TSCreate()`, `TS`, `TSSetType()`, `TSBatchSetRHSFunction()`, `TSBatchSetRHSJacobian()`, `TSBatchSetImplicit()`, `TSRK`, `TSARKIMEX`
+M*/
+PETSC_EXTERN PetscErrorCode TSCreate_Batch(TS ts)
+{
+  TS_Batch *batch;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&batch));
+  ts->data = (void *)batch;
+  PetscCall(PetscStrallocpy(TSRK5DP, &batch->rktype));
+  PetscCall(PetscStrallocpy(TSARKIMEX3, &batch->arkimextype));
+
+  ts->ops->setup          = TSSetUp_Batch;
+  ts->ops->step           = TSStep_Batch;
+  ts->ops->reset          = TSReset_Batch;
+  ts->ops->destroy        = TSDestroy_Batch;
+  ts->ops->setfromoptions = TSSetFromOptions_Batch;
+  ts->ops->view           = TSView_Batch;
+  ts->default_adapt_type  = TSADAPTNONE;
+  ts->usessnes            = PETSC_FALSE;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRHSFunction_C", TSBatchSetRHSFunction_Batch));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRHSJacobian_C", TSBatchSetRHSJacobian_Batch));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetImplicit_C", TSBatchSetImplicit_Batch));
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,456 @@
+/*
+       Code for local time stepping of explicit finite volume discretizations on DMPlex.
+*/
+#include <petsc/private/tsimpl.h> /*I   "petscts.h"   I*/
+#include <petsc/private/dmpleximpl.h>
+#include <petscds.h>
+#include <petscfv.h>
+
+static PetscBool  cited      = PETSC_FALSE;
+static const char citation[] = "@article{OsherSanders1983,\n"
+                               "  title   = {Numerical approximations to nonlinear conservation laws with locally varying time and space grids},\n"
+                               "  author  = {Stanley Osher and Richard Sanders},\n"
+                               "  journal = {Mathematics of Computation},\n"
+                               "  volume  = {41},\n"
+                               "  number  = {164},\n"
+                               "  pages   = {321--336},\n"
+                               "  year    = {1983}\n}\n";
+
+typedef struct {
+  PetscInt   maxclasses; /* largest number of classes */
+  PetscInt   nclasses;   /* class k steps with the step size of the TS divided by 2^k */
+  PetscInt  *nfaces;     /* faces of each class, the class of a face is the finer of the classes of its two cells */
+  PetscInt **faces;
+  PetscInt  *ncells; /* local cells of each class */
+  PetscInt **cells;
+  PetscInt  *gncells; /* global number of cells of each class */
+  PetscReal  work;    /* face flux evaluations relative to stepping every cell with the smallest step */
+  Vec        locX;    /* state seen by the face fluxes */
+  Vec        locF;    /* fluxes accumulated over the step of each cell */
+  Vec        X0;      /* solution at the beginning of the step */
+} TS_LTS;
+
+static PetscErrorCode TSStep_LTS(TS ts)
+{
+  TS_LTS        *lts  = (TS_LTS *)ts->data;
+  const PetscInt nsub = 1 << (lts->nclasses - 1);
+  const PetscReal h   = ts->time_step / nsub;
+  PetscReal      next_time_step = ts->time_step;
+  PetscBool      stageok, accept = PETSC_TRUE;
+  DM             dm;
+  PetscDS        ds;
+  Vec            faceGeometry, cellGeometry;
+  PetscInt       dof;
+
+  PetscFunctionBegin;
+  PetscCall(TSGetDM(ts, &dm));
+  PetscCall(DMPlexGetGeometryFVM(dm, &faceGeometry, &cellGeometry, NULL));
+  PetscCall(DMGetDS(dm, &ds));
+  PetscCall(PetscDSGetTotalDimension(ds, &dof));
+  PetscCall(VecCopy(ts->vec_sol, lts->X0));
+  PetscCall(VecZeroEntries(lts->locF));
+  PetscCall(TSPreStage(ts, ts->ptime));
+  /*
+     Class k is active at the substeps s which are multiples of nsub/2^k: its faces add their fluxes times its step size to the
+     cells on both sides, and its cells are updated with the fluxes accumulated over their step at the end of it. Coarser cells
+     keep their value while the finer cells next to them substep, so that the fluxes through the faces between classes are
+     added to both sides with the same step size, and the method is conservative.
+  */
+  for (PetscInt s = 0; s < nsub; s++) {
+    const PetscReal t = ts->ptime + s * h;
+    PetscScalar    *u, *fa;
+
+    PetscCall(DMGlobalToLocalBegin(dm, ts->vec_sol, INSERT_VALUES, lts->locX));
+    PetscCall(DMGlobalToLocalEnd(dm, ts->vec_sol, INSERT_VALUES, lts->locX));
+    PetscCall(DMPlexInsertBoundaryValues(dm, PETSC_TRUE, lts->locX, t, faceGeometry, cellGeometry, NULL));
+    PetscCall(DMPlexInsertBoundaryValues(dm, PETSC_FALSE, lts->locX, t, faceGeometry, cellGeometry, NULL));
+    for (PetscInt k = 0; k < lts->nclasses; k++) {
+      if (s % (nsub >> k)) continue;
+      PetscCall(DMPlexAccumulateFluxesFVM_Internal(dm, lts->nfaces[k], lts->faces[k], faceGeometry, cellGeometry, lts->locX, ts->time_step / (1 << k), lts->locF));
+    }
+    PetscCall(VecGetArray(ts->vec_sol, &u));
+    PetscCall(VecGetArray(lts->locF, &fa));
+    for (PetscInt k = 0; k < lts->nclasses; k++) {
+      if ((s + 1) % (nsub >> k)) continue;
+      for (PetscInt i = 0; i < lts->ncells[k]; i++) {
+        PetscScalar *uc, *fc;
+
+        PetscCall(DMPlexPointGlobalRef(dm, lts->cells[k][i], u, &uc));
+        PetscCall(DMPlexPointLocalRef(dm, lts->cells[k][i], fa, &fc));
+        for (PetscInt d = 0; d < dof; d++) {
+          uc[d] += fc[d];
+          fc[d] = 0.0;
+        }
+      }
+    }
+    PetscCall(VecRestoreArray(lts->locF, &fa));
+    PetscCall(VecRestoreArray(ts->vec_sol, &u));
+  }
+  PetscCall(TSPostStage(ts, ts->ptime, 0, &ts->vec_sol));
+  PetscCall(TSAdaptCheckStage(ts->adapt, ts, ts->ptime, ts->vec_sol, &stageok));
+  if (stageok) PetscCall(TSFunctionDomainError(ts, ts->ptime + ts->time_step, ts->vec_sol, &stageok));
+  if (stageok) PetscCall(TSAdaptChoose(ts->adapt, ts, ts->time_step, NULL, &next_time_step, &accept));
+  if (!stageok || !accept) {
+    PetscCall(VecCopy(lts->X0, ts->vec_sol));
+    ts->reason = TS_DIVERGED_STEP_REJECTED;
+    PetscFunctionReturn(0);
+  }
+  ts->ptime += ts->time_step;
+  ts->time_step = next_time_step;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSInterpolate_LTS(TS ts, PetscReal t, Vec X)
+{
+  TS_LTS   *lts   = (TS_LTS *)ts->data;
+  PetscReal theta = ts->ptime > ts->ptime_prev ? (t - ts->ptime_prev) / (ts->ptime - ts->ptime_prev) : 1.0;
+
+  PetscFunctionBegin;
+  PetscCall(VecAXPBYPCZ(X, 1.0 - theta, theta, 0.0, lts->X0, ts->vec_sol));
+  PetscFunctionReturn(0);
+}
+
+/*------------------------------------------------------------*/
+
+static PetscErrorCode TSReset_LTS(TS ts)
+{
+  TS_LTS *lts = (TS_LTS *)ts->data;
+
+  PetscFunctionBegin;
+  for (PetscInt k = 0; k < lts->nclasses; k++) PetscCall(PetscFree2(lts->faces[k], lts->cells[k]));
+  PetscCall(PetscFree5(lts->nfaces, lts->faces, lts->ncells, lts->cells, lts->gncells));
+  lts->nclasses = 0;
+  PetscCall(VecDestroy(&lts->locX));
+  PetscCall(VecDestroy(&lts->locF));
+  PetscCall(VecDestroy(&lts->X0));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSDestroy_LTS(TS ts)
+{
+  PetscFunctionBegin;
+  PetscCall(TSReset_LTS(ts));
+  PetscCall(PetscFree(ts->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSLTSSetMaxClasses_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSLTSGetNumClasses_C", NULL));
+  PetscFunctionReturn(0);
+}
+
+/*
+  The radius of a cell is its smallest distance to the centroids of its faces, as for DMPlexGetMinRadius(). A cell whose
+  radius is at least 2^j times the smallest radius goes in class nclasses-1-j, so that the step size of its class is at most
+  2^j times the step size of the finest class.
+*/
+static PetscErrorCode TSSetUp_LTS(TS ts)
+{
+  TS_LTS            *lts = (TS_LTS *)ts->data;
+  PetscErrorCode   (*rhs)(DM, PetscReal, Vec, Vec, void *);
+  MPI_Comm           comm;
+  DM                 dm, dmFace, dmCell;
+  DMLabel            ghostLabel;
+  PetscDS            ds;
+  PetscSF            sf;
+  PetscBool          isplex;
+  Vec                faceGeometry, cellGeometry;
+  const PetscScalar *facegeom, *cellgeom;
+  PetscReal         *radius, rmin = PETSC_MAX_REAL, rmax = 0.0, nflux[2] = {0.0, 0.0};
+  PetscInt           dim, Nf, pStart, pEnd, cStart, cEnd, cEndInterior, fStart, fEnd, *cclass, nclasses = 1, nroots;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)ts, &comm));
+  PetscCall(TSCheckImplicitTerm(ts));
+  PetscCall(TSGetDM(ts, &dm));
+  PetscCall(PetscObjectTypeCompare((PetscObject)dm, DMPLEX, &isplex));
+  PetscCheck(isplex, comm, PETSC_ERR_SUP, "TSLTS needs a DMPLEX");
+  PetscCall(DMTSGetRHSFunctionLocal(dm, &rhs, NULL));
+  PetscCheck(rhs == DMPlexTSComputeRHSFunctionFVM, comm, PETSC_ERR_SUP, "TSLTS needs the finite volume right hand side DMPlexTSComputeRHSFunctionFVM() set with DMTSSetRHSFunctionLocal()");
+  PetscCall(DMGetDS(dm, &ds));
+  PetscCall(PetscDSGetNumFields(ds, &Nf));
+  for (PetscInt f = 0; f < Nf; f++) {
+    PetscObject  obj;
+    PetscClassId id;
+    DM           dmGrad;
+
+    PetscCall(PetscDSGetDiscretization(ds, f, &obj));
+    PetscCall(PetscObjectGetClassId(obj, &id));
+    PetscCheck(id == PETSCFV_CLASSID, comm, PETSC_ERR_SUP, "TSLTS needs finite volume fields only, field %" PetscInt_FMT " is not", f);
+    PetscCall(DMPlexGetGradientDM(dm, (PetscFV)obj, &dmGrad));
+    PetscCheck(!dmGrad, comm, PETSC_ERR_SUP, "TSLTS supports first order finite volumes only, without gradient reconstruction");
+  }
+  PetscCall(TSGetAdapt(ts, &ts->adapt));
+  PetscCall(TSAdaptCandidatesClear(ts->adapt));
+
+  PetscCall(DMGetDimension(dm, &dim));
+  PetscCall(DMGetLabel(dm, "ghost", &ghostLabel));
+  PetscCall(DMGetPointSF(dm, &sf));
+  PetscCall(DMPlexGetChart(dm, &pStart, &pEnd));
+  PetscCall(DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd));
+  PetscCall(DMPlexGetGhostCellStratum(dm, &cEndInterior, NULL));
+  if (cEndInterior < 0) cEndInterior = cEnd;
+  PetscCall(DMPlexGetHeightStratum(dm, 1, &fStart, &fEnd));
+  PetscCall(DMPlexGetGeometryFVM(dm, &faceGeometry, &cellGeometry, NULL));
+  PetscCall(VecGetDM(faceGeometry, &dmFace));
+  PetscCall(VecGetDM(cellGeometry, &dmCell));
+  PetscCall(VecGetArrayRead(faceGeometry, &facegeom));
+  PetscCall(VecGetArrayRead(cellGeometry, &cellgeom));
+
+  /* Radius of the local cells */
+  PetscCall(PetscMalloc2(cEnd - cStart, &radius, pEnd - pStart, &cclass));
+  for (PetscInt p = pStart; p < pEnd; p++) cclass[p - pStart] = -1;
+  for (PetscInt c = cStart; c < cEndInterior; c++) {
+    const PetscInt  *cone;
+    PetscFVCellGeom *cg;
+    PetscInt         coneSize, ghost = -1;
+
+    radius[c - cStart] = -1.0;
+    if (ghostLabel) PetscCall(DMLabelGetValue(ghostLabel, c, &ghost));
+    if (ghost > 0) continue;
+    PetscCall(DMPlexPointLocalRead(dmCell, c, cellgeom, &cg));
+    PetscCall(DMPlexGetConeSize(dm, c, &coneSize));
+    PetscCall(DMPlexGetCone(dm, c, &cone));
+    radius[c - cStart] = PETSC_MAX_REAL;
+    for (PetscInt i = 0; i < coneSize; i++) {
+      PetscFVFaceGeom *fg;
+      PetscReal        v[3];
+
+      PetscCall(DMPlexPointLocalRead(dmFace, cone[i], facegeom, &fg));
+      DMPlex_WaxpyD_Internal(dim, -1, fg->centroid, cg->centroid, v);
+      radius[c - cStart] = PetscMin(radius[c - cStart], DMPlex_NormD_Internal(dim, v));
+    }
+    rmin = PetscMin(rmin, radius[c - cStart]);
+    rmax = PetscMax(rmax, radius[c - cStart]);
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &rmin, 1, MPIU_REAL, MPIU_MIN, comm));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &rmax, 1, MPIU_REAL, MPIU_MAX, comm));
+  while (nclasses < lts->maxclasses && rmax >= rmin * (1 << nclasses)) nclasses++;
+
+  /* Classes of the cells, sent to the ghosts of the other processes so that the faces between processes get the same class on both sides */
+  for (PetscInt c = cStart; c < cEndInterior; c++) {
+    PetscInt j = 0;
+
+    if (radius[c - cStart] < 0) continue;
+    while (j < nclasses - 1 && radius[c - cStart] >= rmin * (2 << j)) j++;
+    cclass[c - pStart] = nclasses - 1 - j;
+  }
+  PetscCall(PetscSFGetGraph(sf, &nroots, NULL, NULL, NULL));
+  if (nroots >= 0) {
+    PetscCall(PetscSFBcastBegin(sf, MPIU_INT, cclass, cclass, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf, MPIU_INT, cclass, cclass, MPI_REPLACE));
+  }
+  for (PetscInt c = cEndInterior; c < cEnd; c++) {
+    const PetscInt *cone, *support;
+
+    PetscCall(DMPlexGetCone(dm, c, &cone));
+    PetscCall(DMPlexGetSupport(dm, cone[0], &support));
+    cclass[c - pStart] = cclass[(support[0] == c ? support[1] : support[0]) - pStart];
+  }
+
+  /* Faces and local cells of each class */
+  lts->nclasses = nclasses;
+  PetscCall(PetscCalloc5(nclasses, &lts->nfaces, nclasses, &lts->faces, nclasses, &lts->ncells, nclasses, &lts->cells, nclasses, &lts->gncells));
+  for (PetscInt pass = 0; pass < 2; pass++) {
+    if (pass) {
+      for (PetscInt k = 0; k < nclasses; k++) {
+        PetscCall(PetscMalloc2(lts->nfaces[k], &lts->faces[k], lts->ncells[k], &lts->cells[k]));
+        lts->nfaces[k] = lts->ncells[k] = 0;
+      }
+    }
+    for (PetscInt f = fStart; f < fEnd; f++) {
+      const PetscInt *support;
+      PetscInt        ghost = -1, nsupp, nchild, k;
+
+      if (ghostLabel) PetscCall(DMLabelGetValue(ghostLabel, f, &ghost));
+      PetscCall(DMPlexGetSupportSize(dm, f, &nsupp));
+      PetscCall(DMPlexGetTreeChildren(dm, f, &nchild, NULL));
+      if (ghost >= 0 || nsupp != 2 || nchild > 0) continue;
+      PetscCall(DMPlexGetSupport(dm, f, &support));
+      k = PetscMax(cclass[support[0] - pStart], cclass[support[1] - pStart]);
+      PetscCheck(k >= 0, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Face %" PetscInt_FMT " has no class", f);
+      if (pass) lts->faces[k][lts->nfaces[k]] = f;
+      lts->nfaces[k]++;
+    }
+    for (PetscInt c = cStart; c < cEndInterior; c++) {
+      const PetscInt k = cclass[c - pStart];
+
+      if (radius[c - cStart] < 0) continue;
+      if (pass) lts->cells[k][lts->ncells[k]] = c;
+      lts->ncells[k]++;
+    }
+  }
+  for (PetscInt k = 0; k < nclasses; k++) {
+    nflux[0] += (PetscReal)lts->nfaces[k] * (1 << k);
+    nflux[1] += (PetscReal)lts->nfaces[k] * (1 << (nclasses - 1));
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, nflux, 2, MPIU_REAL, MPIU_SUM, comm));
+  lts->work = nflux[1] > 0 ? nflux[0] / nflux[1] : 1.0;
+  PetscCall(MPIU_Allreduce(lts->ncells, lts->gncells, nclasses, MPIU_INT, MPI_SUM, comm));
+  PetscCall(PetscFree2(radius, cclass));
+  PetscCall(VecRestoreArrayRead(faceGeometry, &facegeom));
+  PetscCall(VecRestoreArrayRead(cellGeometry, &cellgeom));
+
+  PetscCall(DMCreateLocalVector(dm, &lts->locX));
+  PetscCall(VecDuplicate(lts->locX, &lts->locF));
+  PetscCall(VecDuplicate(ts->vec_sol, &lts->X0));
+  PetscFunctionReturn(0);
+}
+/*------------------------------------------------------------*/
+
+static PetscErrorCode TSSetFromOptions_LTS(TS ts, PetscOptionItems *PetscOptionsObject)
+{
+  TS_LTS  *lts = (TS_LTS *)ts->data;
+  PetscInt maxclasses = lts->maxclasses;
+  PetscBool flg;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "Local time stepping options");
+  PetscCall(PetscOptionsInt("-ts_lts_max_classes", "Largest number of classes of cells with step sizes in ratio 2", "TSLTSSetMaxClasses", maxclasses, &maxclasses, &flg));
+  if (flg) PetscCall(TSLTSSetMaxClasses(ts, maxclasses));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSView_LTS(TS ts, PetscViewer viewer)
+{
+  TS_LTS   *lts = (TS_LTS *)ts->data;
+  PetscBool iascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  Largest number of classes %" PetscInt_FMT "\n", lts->maxclasses));
+    if (lts->nclasses) {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "  Classes of cells: %" PetscInt_FMT "\n", lts->nclasses));
+      for (PetscInt k = 0; k < lts->nclasses; k++) PetscCall(PetscViewerASCIIPrintf(viewer, "    step size 1/%d: %" PetscInt_FMT " cells\n", 1 << k, lts->gncells[k]));
+      PetscCall(PetscViewerASCIIPrintf(viewer, "  Substeps per step: %d, each one updates the ghost and boundary values of all the cells\n", 1 << (lts->nclasses - 1)));
+      PetscCall(PetscViewerASCIIPrintf(viewer, "  Face fluxes relative to stepping all the cells with the smallest step size: %.3g, the ghost and boundary updates are not reduced\n", (double)lts->work));
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSLTSSetMaxClasses_LTS(TS ts, PetscInt maxclasses)
+{
+  TS_LTS *lts = (TS_LTS *)ts->data;
+
+  PetscFunctionBegin;
+  if (maxclasses == PETSC_DEFAULT) maxclasses = 16;
+  PetscCheck(maxclasses > 0 && maxclasses <= 30, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Number of classes %" PetscInt_FMT " must be in [1, 30]", maxclasses);
+  PetscCheck(!ts->setupcalled || maxclasses == lts->maxclasses, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_WRONGSTATE, "Cannot change the number of classes after TSSetUp()");
+  lts->maxclasses = maxclasses;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSLTSGetNumClasses_LTS(TS ts, PetscInt *nclasses)
+{
+  TS_LTS *lts = (TS_LTS *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCheck(ts->setupcalled, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_WRONGSTATE, "Must call TSSetUp() first");
+  *nclasses = lts->nclasses;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  TSLTSSetMaxClasses - Sets the largest number of classes of cells of `TSLTS`
+
+  Logically collective
+
+  Input Parameters:
++ ts - the `TS` context
+- maxclasses - the largest number of classes, or `PETSC_DEFAULT` (16)
+
+  Options Database Key:
+. -ts_lts_max_classes <maxclasses> - the largest number of classes
+
+  Level: intermediate
+
+  Note:
+  The cells whose radius is 2^j times the smallest radius, or more, step with 2^j times the step size of the smallest cells,
+  for j less than maxclasses. Limiting the number of classes limits the number of substeps of a step of the `TS`.
+
+.seealso: [](chapter_ts), `TS`, `TSLTS`, `TSLTSGetNumClasses()`
+@*/
+PetscErrorCode TSLTSSetMaxClasses(TS ts, PetscInt maxclasses)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ts, maxclasses, 2);
+  PetscTryMethod(ts, "TSLTSSetMaxClasses_C", (TS, PetscInt), (ts, maxclasses));
+  PetscFunctionReturn(0);
+}
+
+/*@
+  TSLTSGetNumClasses - Gets the number of classes of cells of `TSLTS`, the step size of the `TS` being 2^(nclasses-1) times the step size of the smallest cells
+
+  Not collective
+
+  Input Parameter:
+. ts - the `TS` context, after `TSSetUp()`
+
+  Output Parameter:
+. nclasses - the number of classes
+
+  Level: intermediate
+
+.seealso: [](chapter_ts), `TS`, `TSLTS`, `TSLTSSetMaxClasses()`
+@*/
+PetscErrorCode TSLTSGetNumClasses(TS ts, PetscInt *nclasses)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidIntPointer(nclasses, 2);
+  PetscUseMethod(ts, "TSLTSGetNumClasses_C", (TS, PetscInt *), (ts, nclasses));
+  PetscFunctionReturn(0);
+}
+
+/* ------------------------------------------------------------ */
+
+/*MC
+      TSLTS - Local time stepping with the explicit forward Euler method for finite volume discretizations on `DMPLEX`
+
+  The cells are sorted by size into classes whose step sizes are in ratio 2: class k steps with the step size of the `TS`
+  divided by 2^k, and one step of the `TS` substeps 2^(nclasses-1) times. The finest class holds the cells whose radius is
+  less than twice the smallest radius, so the step size stable for the smallest cells, times 2^(nclasses-1) (see
+  `TSLTSGetNumClasses()`), is the step size of the `TS`.
+
+  The flux through a face is computed with the step size of the finer of the classes of its two cells, and added to both of
+  them; the coarser cells are updated with the fluxes accumulated over their step, so that the method is conservative
+  [Osher and Sanders 1983]. The number of face fluxes per step is that of stepping all the cells with their own step size,
+  which is shown by `TSView()` relative to stepping all the cells with the smallest step size. Only the face fluxes are
+  saved: every substep still updates the ghost values and the boundary values of the whole local mesh, so the gain is
+  large when the Riemann solver dominates the cost and small for cheap fluxes.
+
+  Level: intermediate
+
+  Notes:
+  The right hand side must be the finite volume residual `DMPlexTSComputeRHSFunctionFVM()`, set with `DMTSSetRHSFunctionLocal()`,
+  whose Riemann solvers and boundary conditions `TSLTS` uses. All the fields must be `PetscFV`, without gradient reconstruction.
+
+  The method is first order in time, and the step size of the `TS` is fixed.
+
+.seealso: [](chapter_ts), `TSCreate()`, `TS`, `TSSetType()`, `TSEULER`, `TSLTSSetMaxClasses()`, `TSLTSGetNumClasses()`, `DMPlexTSComputeRHSFunctionFVM()`
+M*/
+PETSC_EXTERN PetscErrorCode TSCreate_LTS(TS ts)
+{
+  TS_LTS *lts;
+
+  PetscFunctionBegin;
+  PetscCall(PetscCitationsRegister(citation, &cited));
+  PetscCall(PetscNew(&lts));
+  lts->maxclasses = 16;
+  ts->data        = (void *)lts;
+
+  ts->ops->setup          = TSSetUp_LTS;
+  ts->ops->step           = TSStep_LTS;
+  ts->ops->reset          = TSReset_LTS;
+  ts->ops->destroy        = TSDestroy_LTS;
+  ts->ops->setfromoptions = TSSetFromOptions_LTS;
+  ts->ops->view           = TSView_LTS;
+  ts->ops->interpolate    = TSInterpolate_LTS;
+  ts->default_adapt_type  = TSADAPTNONE;
+  ts->usessnes            = PETSC_FALSE;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSLTSSetMaxClasses_C", TSLTSSetMaxClasses_LTS));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSLTSGetNumClasses_C", TSLTSGetNumClasses_LTS));
+  PetscFunctionReturn(0);
+}
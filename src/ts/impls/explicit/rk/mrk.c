@@ -23,167 +23,224 @@ static PetscErrorCode TSReset_RK_MultirateNonsplit(TS ts)
 
   PetscFunctionBegin;
   PetscCall(VecDestroy(&rk->X0));
-  PetscCall(VecDestroyVecs(tab->s, &rk->YdotRHS_slow));
+  PetscCall(VecDestroy(&rk->vec_dtmax));
+  for (PetscInt l = 0; l < rk->nlevels; l++) PetscCall(ISDestroy(&rk->is_level[l]));
+  for (PetscInt l = 0; l < rk->nlevels_alloc; l++) {
+    PetscCall(VecDestroy(&rk->X0_level[l]));
+    if (rk->YdotRHS_level[l]) PetscCall(VecDestroyVecs(tab->s, &rk->YdotRHS_level[l]));
+  }
+  PetscCall(PetscFree5(rk->is_level, rk->X0_level, rk->YdotRHS_level, rk->t_level, rk->h_level));
+  rk->nlevels       = 0;
+  rk->nlevels_alloc = 0;
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode TSInterpolate_RK_MultirateNonsplit(TS ts, PetscReal itime, Vec X)
+/* X = the dense output at time itime of the current step of a level */
+static PetscErrorCode TSRKMultirateInterpolateLevel(TS ts, PetscInt l, PetscReal itime, Vec X)
 {
   TS_RK           *rk = (TS_RK *)ts->data;
   PetscInt         s = rk->tableau->s, p = rk->tableau->p, i, j;
-  PetscReal        h = ts->time_step;
+  PetscReal        h = rk->h_level[l];
   PetscReal        tt, t;
   PetscScalar     *b;
   const PetscReal *B = rk->tableau->binterp;
 
   PetscFunctionBegin;
   PetscCheck(B, PetscObjectComm((PetscObject)ts), PETSC_ERR_SUP, "TSRK %s does not have an interpolation formula", rk->tableau->name);
-  t = (itime - rk->ptime) / h;
+  t = (itime - rk->t_level[l]) / h;
   PetscCall(PetscMalloc1(s, &b));
   for (i = 0; i < s; i++) b[i] = 0;
   for (j = 0, tt = t; j < p; j++, tt *= t) {
     for (i = 0; i < s; i++) b[i] += h * B[i * p + j] * tt;
   }
-  PetscCall(VecCopy(rk->X0, X));
-  PetscCall(VecMAXPY(X, s, b, rk->YdotRHS_slow));
+  PetscCall(VecCopy(rk->X0_level[l], X));
+  PetscCall(VecMAXPY(X, s, b, rk->YdotRHS_level[l]));
   PetscCall(PetscFree(b));
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode TSStepRefine_RK_MultirateNonsplit(TS ts)
+static PetscErrorCode TSInterpolate_RK_MultirateNonsplit(TS ts, PetscReal itime, Vec X)
+{
+  PetscFunctionBegin;
+  PetscCall(TSRKMultirateInterpolateLevel(ts, 0, itime, X));
+  PetscFunctionReturn(0);
+}
+
+/* copies the components of a level from X to Y */
+static PetscErrorCode TSRKMultirateCopyLevel(TS ts, PetscInt l, Vec X, Vec Y)
+{
+  TS_RK *rk = (TS_RK *)ts->data;
+  Vec    subvec;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetSubVector(X, rk->is_level[l], &subvec));
+  PetscCall(VecISCopy(Y, rk->is_level[l], SCATTER_FORWARD, subvec));
+  PetscCall(VecRestoreSubVector(X, rk->is_level[l], &subvec));
+  PetscFunctionReturn(0);
+}
+
+/*
+  One step of size h of level l. All the components take part in the stages, the ones of the slower levels with the
+  dense output of their own steps. The step only advances the components of level l, the faster levels then take
+  dtratio steps each within it.
+*/
+static PetscErrorCode TSRKMultirateStepLevel(TS ts, PetscInt l, PetscReal t, PetscReal h)
 {
-  TS               previousts, subts;
   TS_RK           *rk  = (TS_RK *)ts->data;
   RKTableau        tab = rk->tableau;
-  Vec             *Y = rk->Y, *YdotRHS = rk->YdotRHS;
-  Vec              vec_fast, subvec_fast;
+  Vec             *Y = rk->Y, *YdotRHS, X0, W = rk->X0;
   const PetscInt   s = tab->s;
-  const PetscReal *A = tab->A, *c = tab->c;
+  const PetscReal *A = tab->A, *b = tab->b, *c = tab->c;
   PetscScalar     *w = rk->work;
-  PetscInt         i, j, k;
-  PetscReal        t = ts->ptime, h = ts->time_step;
+  PetscInt         i, j;
 
   PetscFunctionBegin;
-  PetscCall(VecDuplicate(ts->vec_sol, &vec_fast));
-  previousts = rk->subts_current;
-  PetscCall(TSRHSSplitGetSubTS(rk->subts_current, "fast", &subts));
-  PetscCall(TSRHSSplitGetSubTS(subts, "fast", &subts));
-  for (k = 0; k < rk->dtratio; k++) {
-    for (i = 0; i < s; i++) {
-      PetscCall(TSInterpolate_RK_MultirateNonsplit(ts, t + k * h / rk->dtratio + h / rk->dtratio * c[i], Y[i]));
-      for (j = 0; j < i; j++) w[j] = h / rk->dtratio * A[i * s + j];
-      /* update the fast components in the stage value, the slow components will be ignored, so we do not care the slow part in vec_fast */
-      PetscCall(VecCopy(ts->vec_sol, vec_fast));
-      PetscCall(VecMAXPY(vec_fast, i, w, YdotRHS));
-      /* update the fast components in the stage value */
-      PetscCall(VecGetSubVector(vec_fast, rk->is_fast, &subvec_fast));
-      PetscCall(VecISCopy(Y[i], rk->is_fast, SCATTER_FORWARD, subvec_fast));
-      PetscCall(VecRestoreSubVector(vec_fast, rk->is_fast, &subvec_fast));
-      /* compute the stage RHS */
-      PetscCall(TSComputeRHSFunction(ts, t + k * h / rk->dtratio + h / rk->dtratio * c[i], Y[i], YdotRHS[i]));
+  if (!rk->X0_level[l]) {
+    PetscCall(VecDuplicate(ts->vec_sol, &rk->X0_level[l]));
+    PetscCall(VecDuplicateVecs(ts->vec_sol, s, &rk->YdotRHS_level[l]));
+  }
+  X0      = rk->X0_level[l];
+  YdotRHS = rk->YdotRHS_level[l];
+  rk->t_level[l] = t;
+  rk->h_level[l] = h;
+  PetscCall(VecCopy(ts->vec_sol, X0));
+  for (i = 0; i < s; i++) {
+    rk->stage_time = t + h * c[i];
+    if (!l) PetscCall(TSPreStage(ts, rk->stage_time));
+    PetscCall(VecCopy(X0, Y[i]));
+    for (j = 0; j < i; j++) w[j] = h * A[i * s + j];
+    PetscCall(VecMAXPY(Y[i], i, w, YdotRHS));
+    for (j = 0; j < l; j++) {
+      PetscCall(TSRKMultirateInterpolateLevel(ts, j, rk->stage_time, W));
+      PetscCall(TSRKMultirateCopyLevel(ts, j, W, Y[i]));
     }
-    PetscCall(VecCopy(ts->vec_sol, vec_fast));
-    PetscCall(TSEvaluateStep(ts, tab->order, vec_fast, NULL));
-    /* update the fast components in the solution */
-    PetscCall(VecGetSubVector(vec_fast, rk->is_fast, &subvec_fast));
-    PetscCall(VecISCopy(ts->vec_sol, rk->is_fast, SCATTER_FORWARD, subvec_fast));
-    PetscCall(VecRestoreSubVector(vec_fast, rk->is_fast, &subvec_fast));
-
-    if (subts) {
-      Vec *YdotRHS_copy;
-      PetscCall(VecDuplicateVecs(ts->vec_sol, s, &YdotRHS_copy));
-      rk->subts_current = rk->subts_fast;
-      ts->ptime         = t + k * h / rk->dtratio;
-      ts->time_step     = h / rk->dtratio;
-      PetscCall(TSRHSSplitGetIS(rk->subts_current, "fast", &rk->is_fast));
-      for (i = 0; i < s; i++) {
-        PetscCall(VecCopy(rk->YdotRHS_slow[i], YdotRHS_copy[i]));
-        PetscCall(VecCopy(YdotRHS[i], rk->YdotRHS_slow[i]));
-      }
+    if (!l) PetscCall(TSPostStage(ts, rk->stage_time, i, Y));
+    PetscCall(TSComputeRHSFunction(ts, rk->stage_time, Y[i], YdotRHS[i]));
+  }
+  PetscCall(VecCopy(X0, W));
+  for (j = 0; j < s; j++) w[j] = h * b[j];
+  PetscCall(VecMAXPY(W, s, w, YdotRHS));
+  PetscCall(TSRKMultirateCopyLevel(ts, l, W, ts->vec_sol));
 
-      PetscCall(TSStepRefine_RK_MultirateNonsplit(ts));
+  if (l + 1 < rk->nlevels) {
+    for (PetscInt k = 0; k < rk->dtratio; k++) PetscCall(TSRKMultirateStepLevel(ts, l + 1, t + k * h / rk->dtratio, h / rk->dtratio));
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+  The level of each component is the number of times the step must be divided by dtratio to be below the stable step
+  size of the component, at most maxlevels-1
+*/
+static PetscErrorCode TSRKMultiratePartition(TS ts)
+{
+  TS_RK             *rk = (TS_RK *)ts->data;
+  MPI_Comm           comm;
+  const PetscScalar *dtmax;
+  PetscInt           n, rstart, nover = 0, *level, *count, **idx, nlevels = 1;
 
-      rk->subts_current = previousts;
-      ts->ptime         = t;
-      ts->time_step     = h;
-      PetscCall(TSRHSSplitGetIS(previousts, "fast", &rk->is_fast));
-      for (i = 0; i < s; i++) PetscCall(VecCopy(YdotRHS_copy[i], rk->YdotRHS_slow[i]));
-      PetscCall(VecDestroyVecs(s, &YdotRHS_copy));
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)ts, &comm));
+  PetscCallBack("TSRK callback stability", (*rk->stability)(ts, ts->ptime, ts->vec_sol, rk->vec_dtmax, rk->stabilityctx));
+  PetscCall(VecGetLocalSize(rk->vec_dtmax, &n));
+  PetscCall(VecGetOwnershipRange(rk->vec_dtmax, &rstart, NULL));
+  PetscCall(PetscMalloc1(n, &level));
+  PetscCall(PetscCalloc2(rk->maxlevels, &count, rk->maxlevels, &idx));
+  PetscCall(VecGetArrayRead(rk->vec_dtmax, &dtmax));
+  for (PetscInt i = 0; i < n; i++) {
+    PetscReal h = ts->time_step;
+    PetscInt  l = 0;
+
+    while (h > PetscRealPart(dtmax[i]) && l < rk->maxlevels - 1) {
+      h /= rk->dtratio;
+      l++;
     }
+    if (h > PetscRealPart(dtmax[i])) nover++;
+    level[i] = l;
+    count[l]++;
+    nlevels = PetscMax(nlevels, l + 1);
   }
-  PetscCall(VecDestroy(&vec_fast));
+  PetscCall(VecRestoreArrayRead(rk->vec_dtmax, &dtmax));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &nlevels, 1, MPIU_INT, MPI_MAX, comm));
+  for (PetscInt l = 0; l < nlevels; l++) PetscCall(PetscMalloc1(count[l], &idx[l]));
+  PetscCall(PetscArrayzero(count, rk->maxlevels));
+  for (PetscInt i = 0; i < n; i++) idx[level[i]][count[level[i]]++] = rstart + i;
+  for (PetscInt l = 0; l < rk->nlevels; l++) PetscCall(ISDestroy(&rk->is_level[l]));
+  for (PetscInt l = 0; l < nlevels; l++) PetscCall(ISCreateGeneral(comm, count[l], idx[l], PETSC_OWN_POINTER, &rk->is_level[l]));
+  rk->nlevels = nlevels;
+  if (PetscDefined(USE_INFO)) {
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, count, nlevels, MPIU_INT, MPI_SUM, comm));
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &nover, 1, MPIU_INT, MPI_SUM, comm));
+    for (PetscInt l = 0; l < nlevels; l++) PetscCall(PetscInfo(ts, "Level %" PetscInt_FMT " with step size %g: %" PetscInt_FMT " components\n", l, (double)(ts->time_step / PetscPowRealInt(rk->dtratio, l)), count[l]));
+    if (nover) PetscCall(PetscInfo(ts, "%" PetscInt_FMT " components would need more than %" PetscInt_FMT " levels\n", nover, rk->maxlevels));
+  }
+  PetscCall(PetscFree(level));
+  PetscCall(PetscFree2(count, idx));
   PetscFunctionReturn(0);
 }
 
 static PetscErrorCode TSStep_RK_MultirateNonsplit(TS ts)
 {
-  TS_RK           *rk  = (TS_RK *)ts->data;
-  RKTableau        tab = rk->tableau;
-  Vec             *Y = rk->Y, *YdotRHS = rk->YdotRHS, *YdotRHS_slow = rk->YdotRHS_slow;
-  Vec              stage_slow, sol_slow; /* vectors store the slow components */
-  Vec              subvec_slow;          /* sub vector to store the slow components */
-  IS               is_slow = rk->is_slow;
-  const PetscInt   s       = tab->s;
-  const PetscReal *A = tab->A, *c = tab->c;
-  PetscScalar     *w = rk->work;
-  PetscInt         i, j, dtratio = rk->dtratio;
-  PetscReal        next_time_step = ts->time_step, t = ts->ptime, h = ts->time_step;
+  TS_RK    *rk             = (TS_RK *)ts->data;
+  PetscReal next_time_step = ts->time_step, t = ts->ptime, h = ts->time_step;
 
   PetscFunctionBegin;
+  if (rk->stability && (!rk->nlevels || (rk->repartition > 0 && ts->steps % rk->repartition == 0))) PetscCall(TSRKMultiratePartition(ts));
   rk->status = TS_STEP_INCOMPLETE;
-  PetscCall(VecDuplicate(ts->vec_sol, &stage_slow));
-  PetscCall(VecDuplicate(ts->vec_sol, &sol_slow));
-  PetscCall(VecCopy(ts->vec_sol, rk->X0));
-  for (i = 0; i < s; i++) {
-    rk->stage_time = t + h * c[i];
-    PetscCall(TSPreStage(ts, rk->stage_time));
-    PetscCall(VecCopy(ts->vec_sol, Y[i]));
-    for (j = 0; j < i; j++) w[j] = h * A[i * s + j];
-    PetscCall(VecMAXPY(Y[i], i, w, YdotRHS_slow));
-    PetscCall(TSPostStage(ts, rk->stage_time, i, Y));
-    /* compute the stage RHS */
-    PetscCall(TSComputeRHSFunction(ts, t + h * c[i], Y[i], YdotRHS_slow[i]));
-  }
-  /* update the slow components in the solution */
-  rk->YdotRHS = YdotRHS_slow;
-  rk->dtratio = 1;
-  PetscCall(TSEvaluateStep(ts, tab->order, sol_slow, NULL));
-  rk->dtratio = dtratio;
-  rk->YdotRHS = YdotRHS;
-  /* update the slow components in the solution */
-  PetscCall(VecGetSubVector(sol_slow, is_slow, &subvec_slow));
-  PetscCall(VecISCopy(ts->vec_sol, is_slow, SCATTER_FORWARD, subvec_slow));
-  PetscCall(VecRestoreSubVector(sol_slow, is_slow, &subvec_slow));
-
-  rk->subts_current = ts;
-  rk->ptime         = t;
-  rk->time_step     = h;
-  PetscCall(TSStepRefine_RK_MultirateNonsplit(ts));
+  PetscCall(TSRKMultirateStepLevel(ts, 0, t, h));
+  rk->ptime     = t;
+  rk->time_step = h;
 
   ts->ptime     = t + ts->time_step;
   ts->time_step = next_time_step;
   rk->status    = TS_STEP_COMPLETE;
-
-  /* free memory of work vectors */
-  PetscCall(VecDestroy(&stage_slow));
-  PetscCall(VecDestroy(&sol_slow));
   PetscFunctionReturn(0);
 }
 
 static PetscErrorCode TSSetUp_RK_MultirateNonsplit(TS ts)
 {
-  TS_RK    *rk  = (TS_RK *)ts->data;
-  RKTableau tab = rk->tableau;
+  TS_RK *rk = (TS_RK *)ts->data;
 
   PetscFunctionBegin;
-  PetscCall(TSRHSSplitGetIS(ts, "slow", &rk->is_slow));
-  PetscCall(TSRHSSplitGetIS(ts, "fast", &rk->is_fast));
-  PetscCheck(rk->is_slow && rk->is_fast, PetscObjectComm((PetscObject)ts), PETSC_ERR_USER, "Must set up RHSSplits with TSRHSSplitSetIS() using split names 'slow' and 'fast' respectively in order to use multirate RK");
-  PetscCall(TSRHSSplitGetSubTS(ts, "slow", &rk->subts_slow));
-  PetscCall(TSRHSSplitGetSubTS(ts, "fast", &rk->subts_fast));
-  PetscCheck(rk->subts_slow && rk->subts_fast, PetscObjectComm((PetscObject)ts), PETSC_ERR_USER, "Must set up the RHSFunctions for 'slow' and 'fast' components using TSRHSSplitSetRHSFunction() or calling TSSetRHSFunction() for each sub-TS");
+  rk->nlevels_alloc = rk->maxlevels;
+  if (!rk->stability) {
+    TS current;
+
+    PetscCall(TSRHSSplitGetIS(ts, "slow", &rk->is_slow));
+    PetscCall(TSRHSSplitGetIS(ts, "fast", &rk->is_fast));
+    PetscCheck(rk->is_slow && rk->is_fast, PetscObjectComm((PetscObject)ts), PETSC_ERR_USER, "Must set up RHSSplits with TSRHSSplitSetIS() using split names 'slow' and 'fast' respectively in order to use multirate RK, or give the stable step sizes with TSRKSetMultirateStability()");
+    PetscCall(TSRHSSplitGetSubTS(ts, "slow", &rk->subts_slow));
+    PetscCall(TSRHSSplitGetSubTS(ts, "fast", &rk->subts_fast));
+    PetscCheck(rk->subts_slow && rk->subts_fast, PetscObjectComm((PetscObject)ts), PETSC_ERR_USER, "Must set up the RHSFunctions for 'slow' and 'fast' components using TSRHSSplitSetRHSFunction() or calling TSSetRHSFunction() for each sub-TS");
+    /* the 'fast' sub-TS of a level may split its components again into 'slow' and 'fast' ones */
+    rk->nlevels_alloc = 2;
+    for (current = rk->subts_fast; current; rk->nlevels_alloc++) {
+      IS is_slow, is_fast;
+
+      PetscCall(TSRHSSplitGetIS(current, "slow", &is_slow));
+      PetscCall(TSRHSSplitGetIS(current, "fast", &is_fast));
+      if (!is_slow || !is_fast) break;
+      PetscCall(TSRHSSplitGetSubTS(current, "fast", &current));
+    }
+  }
+  PetscCall(PetscCalloc5(rk->nlevels_alloc, &rk->is_level, rk->nlevels_alloc, &rk->X0_level, rk->nlevels_alloc, &rk->YdotRHS_level, rk->nlevels_alloc, &rk->t_level, rk->nlevels_alloc, &rk->h_level));
+  if (!rk->stability) {
+    TS current = ts;
+
+    rk->nlevels = rk->nlevels_alloc;
+    for (PetscInt l = 0; l < rk->nlevels - 1; l++) {
+      PetscCall(TSRHSSplitGetIS(current, "slow", &rk->is_level[l]));
+      PetscCall(PetscObjectReference((PetscObject)rk->is_level[l]));
+      if (l == rk->nlevels - 2) {
+        PetscCall(TSRHSSplitGetIS(current, "fast", &rk->is_level[l + 1]));
+        PetscCall(PetscObjectReference((PetscObject)rk->is_level[l + 1]));
+      } else PetscCall(TSRHSSplitGetSubTS(current, "fast", &current));
+    }
+  } else {
+    PetscCheck(rk->dtratio > 1, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "The ratio of the step sizes of the levels %" PetscInt_FMT " must be larger than 1", rk->dtratio);
+    PetscCall(VecDuplicate(ts->vec_sol, &rk->vec_dtmax));
+  }
   PetscCall(VecDuplicate(ts->vec_sol, &rk->X0));
-  PetscCall(VecDuplicateVecs(ts->vec_sol, tab->s, &rk->YdotRHS_slow));
   rk->subts_current = rk->subts_fast;
 
   ts->ops->step        = TSStep_RK_MultirateNonsplit;
@@ -507,3 +564,27 @@ PetscErrorCode TSRKGetMultirate_RK(TS ts, PetscBool *use_multirate)
   *use_multirate = rk->use_multirate;
   PetscFunctionReturn(0);
 }
+
+PetscErrorCode TSRKSetMultirateStability_RK(TS ts, PetscErrorCode (*stability)(TS, PetscReal, Vec, Vec, void *), void *ctx)
+{
+  TS_RK *rk = (TS_RK *)ts->data;
+
+  PetscFunctionBegin;
+  rk->stability    = stability;
+  rk->stabilityctx = ctx;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode TSRKSetMultirateLevels_RK(TS ts, PetscInt maxlevels, PetscInt repartition)
+{
+  TS_RK *rk = (TS_RK *)ts->data;
+
+  PetscFunctionBegin;
+  if (maxlevels != PETSC_DEFAULT) {
+    PetscCheck(maxlevels > 0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Number of levels %" PetscInt_FMT " must be positive", maxlevels);
+    PetscCheck(!ts->setupcalled || maxlevels == rk->maxlevels, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_WRONGSTATE, "Cannot change the number of levels after TSSetUp()");
+    rk->maxlevels = maxlevels;
+  }
+  if (repartition != PETSC_DEFAULT) rk->repartition = repartition;
+  PetscFunctionReturn(0);
+}
@@ -1,2 +1,4 @@
 PETSC_INTERN PetscErrorCode TSRKSetMultirate_RK(TS, PetscBool);
 PETSC_INTERN PetscErrorCode TSRKGetMultirate_RK(TS, PetscBool *);
+PETSC_INTERN PetscErrorCode TSRKSetMultirateStability_RK(TS, PetscErrorCode (*)(TS, PetscReal, Vec, Vec, void *), void *);
+PETSC_INTERN PetscErrorCode TSRKSetMultirateLevels_RK(TS, PetscInt, PetscInt);
@@ -540,6 +540,30 @@ PetscErrorCode TSRKGetTableau(TS ts, PetscInt *s, const PetscReal **A, const Pet
   PetscFunctionReturn(0);
 }
 
+/*
+   The registered tableau with the given name, for the methods built on the RK tableaus
+*/
+PetscErrorCode TSRKGetTableauByName_Internal(TSRKType rktype, PetscInt *s, const PetscReal **A, const PetscReal **b, const PetscReal **c, const PetscReal **bembed, PetscInt *order)
+{
+  PetscBool match;
+
+  PetscFunctionBegin;
+  PetscCall(TSRKInitializePackage());
+  for (RKTableauLink link = RKTableauList; link; link = link->next) {
+    PetscCall(PetscStrcmp(link->tab.name, rktype, &match));
+    if (match) {
+      if (s) *s = link->tab.s;
+      if (A) *A = link->tab.A;
+      if (b) *b = link->tab.b;
+      if (c) *c = link->tab.c;
+      if (bembed) *bembed = link->tab.bembed;
+      if (order) *order = link->tab.order;
+      PetscFunctionReturn(0);
+    }
+  }
+  SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_UNKNOWN_TYPE, "Could not find RK tableau '%s'", rktype);
+}
+
 /*
  This is for single-step RK method
  The step completion formula is
@@ -1199,6 +1223,14 @@ static PetscErrorCode TSSetFromOptions_RK(TS ts, PetscOptionItems *PetscOptionsO
   PetscOptionsHeadEnd();
   PetscOptionsBegin(PetscObjectComm((PetscObject)ts), NULL, "Multirate methods options", "");
   PetscCall(PetscOptionsInt("-ts_rk_dtratio", "time step ratio between slow and fast", "", rk->dtratio, &rk->dtratio, NULL));
+  {
+    PetscInt  maxlevels = rk->maxlevels, repartition = rk->repartition;
+    PetscBool flg1, flg2;
+
+    PetscCall(PetscOptionsInt("-ts_rk_multirate_max_levels", "Largest number of rate levels computed from the stable step sizes", "TSRKSetMultirateLevels", maxlevels, &maxlevels, &flg1));
+    PetscCall(PetscOptionsInt("-ts_rk_multirate_repartition", "Steps between updates of the rate levels, 0 to keep the first ones", "TSRKSetMultirateLevels", repartition, &repartition, &flg2));
+    if (flg1 || flg2) PetscCall(TSRKSetMultirateLevels(ts, maxlevels, repartition));
+  }
   PetscOptionsEnd();
   PetscFunctionReturn(0);
 }
@@ -1225,6 +1257,15 @@ static PetscErrorCode TSView_RK(TS ts, PetscViewer viewer)
     PetscCall(PetscViewerASCIIPrintf(viewer, "  FSAL property: %s\n", FSAL ? "yes" : "no"));
     PetscCall(PetscFormatRealArray(buf, sizeof(buf), "% 8.6f", s, c));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  Abscissa c = %s\n", buf));
+    if (rk->use_multirate && !ts->use_splitrhsfunction && rk->nlevels) {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "  Multirate levels: %" PetscInt_FMT ", step size ratio %" PetscInt_FMT "%s\n", rk->nlevels, rk->dtratio, rk->stability ? " (from the stable step sizes)" : ""));
+      for (PetscInt l = 0; l < rk->nlevels; l++) {
+        PetscInt n;
+
+        PetscCall(ISGetSize(rk->is_level[l], &n));
+        PetscCall(PetscViewerASCIIPrintf(viewer, "    level %" PetscInt_FMT ": %" PetscInt_FMT " components\n", l, n));
+      }
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -1378,6 +1419,8 @@ static PetscErrorCode TSDestroy_RK(TS ts)
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKGetTableau_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKSetMultirate_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKGetMultirate_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKSetMultirateStability_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKSetMultirateLevels_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSSetUp_RK_MultirateSplit_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSReset_RK_MultirateSplit_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSSetUp_RK_MultirateNonsplit_C", NULL));
@@ -1466,6 +1509,78 @@ PetscErrorCode TSRKGetMultirate(TS ts, PetscBool *use_multirate)
   PetscFunctionReturn(0);
 }
 
+/*@C
+  TSRKSetMultirateStability - Sets the function giving the stable step size of each component, from which the multirate `TSRK` method computes the rate levels of the components
+
+  Logically collective
+
+  Input Parameters:
++  ts - timestepping context
+.  stability - the function
+-  ctx - [optional] user-defined context for the function (may be `NULL`)
+
+  Calling sequence of stability:
+$   PetscErrorCode stability(TS ts, PetscReal t, Vec U, Vec Dt, void *ctx);
+
++  ts - the `TS` context
+.  t - the current time
+.  U - the current solution
+.  Dt - the largest stable step size of each component, for example the CFL number times the size of its cell divided by the local wave speed
+-  ctx - [optional] user-defined context
+
+  Level: intermediate
+
+  Notes:
+  Without the 'slow' and 'fast' splits of `TSRHSSplitSetIS()`, the multirate method (with `-ts_use_splitrhsfunction 0`) puts
+  each component in the slowest level whose step size is below its stable step size. The step size of level l is the
+  step size of the `TS` divided by dtratio^l, see `-ts_rk_dtratio`. The levels are recomputed as the solution evolves, see
+  `TSRKSetMultirateLevels()`.
+
+  Components whose stable step size is below the step size of the finest level are put in the finest level.
+
+  The stages of a level use the components of the faster levels advanced with its own step size, and the method is not
+  conservative at the interfaces of the levels. For a finite volume discretization the stable step size of a cell should
+  therefore be the smallest of the cells in its stencil, so that the faster levels include a buffer of slower cells and
+  the slower levels never depend on stages that are unstable; use `TSMPRK` when exact conservation is needed.
+
+.seealso: [](chapter_ts), `TSRK`, `TSRKSetMultirate()`, `TSRKSetMultirateLevels()`, `TSMPRK`, `TSRHSSplitSetIS()`
+@*/
+PetscErrorCode TSRKSetMultirateStability(TS ts, PetscErrorCode (*stability)(TS, PetscReal, Vec, Vec, void *), void *ctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscTryMethod(ts, "TSRKSetMultirateStability_C", (TS, PetscErrorCode(*)(TS, PetscReal, Vec, Vec, void *), void *), (ts, stability, ctx));
+  PetscFunctionReturn(0);
+}
+
+/*@
+  TSRKSetMultirateLevels - Sets the largest number of rate levels of the multirate `TSRK` method computed from the stable step sizes, and how often they are recomputed
+
+  Logically collective
+
+  Input Parameters:
++  ts - timestepping context
+.  maxlevels - the largest number of levels, or `PETSC_DEFAULT` to keep it (3 initially)
+-  repartition - the number of steps between updates of the levels, 0 to keep the first ones, or `PETSC_DEFAULT` to keep it (1 initially)
+
+  Options Database Keys:
++  -ts_rk_multirate_max_levels <maxlevels> - the largest number of levels
+-  -ts_rk_multirate_repartition <steps> - the steps between updates of the levels
+
+  Level: intermediate
+
+.seealso: [](chapter_ts), `TSRK`, `TSRKSetMultirate()`, `TSRKSetMultirateStability()`
+@*/
+PetscErrorCode TSRKSetMultirateLevels(TS ts, PetscInt maxlevels, PetscInt repartition)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ts, maxlevels, 2);
+  PetscValidLogicalCollectiveInt(ts, repartition, 3);
+  PetscTryMethod(ts, "TSRKSetMultirateLevels_C", (TS, PetscInt, PetscInt), (ts, maxlevels, repartition));
+  PetscFunctionReturn(0);
+}
+
 /*MC
       TSRK - ODE and DAE solver using Runge-Kutta schemes
 
@@ -1521,8 +1636,12 @@ PETSC_EXTERN PetscErrorCode TSCreate_RK(TS ts)
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKGetTableau_C", TSRKGetTableau_RK));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKSetMultirate_C", TSRKSetMultirate_RK));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKGetMultirate_C", TSRKGetMultirate_RK));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKSetMultirateStability_C", TSRKSetMultirateStability_RK));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKSetMultirateLevels_C", TSRKSetMultirateLevels_RK));
 
   PetscCall(TSRKSetType(ts, TSRKDefault));
-  rk->dtratio = 1;
+  rk->dtratio     = 1;
+  rk->maxlevels   = 3;
+  rk->repartition = 1;
   PetscFunctionReturn(0);
 }
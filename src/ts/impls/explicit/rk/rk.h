@@ -39,6 +39,16 @@ typedef struct {
   IS           is_fast, is_slow;
   TS           subts_fast, subts_slow, subts_current, ts_root;
   PetscBool    use_multirate;
+  /* rate levels of the multirate method without RHS splits, from the nested splits or from the stable step sizes */
+  PetscInt    nlevels, nlevels_alloc, maxlevels;
+  PetscInt    repartition;    /* steps between updates of the levels from the stable step sizes, 0 to keep the first */
+  IS         *is_level;       /* the components advanced at each level                                            */
+  Vec        *X0_level;       /* the start of the current step of each level                                      */
+  Vec       **YdotRHS_level;  /* the stages of the current step of each level                                     */
+  PetscReal  *t_level, *h_level;
+  Vec         vec_dtmax;
+  void       *stabilityctx;
+  PetscErrorCode (*stability)(TS, PetscReal, Vec, Vec, void *);
   Mat          MatFwdSensip0;
   Mat         *MatsFwdStageSensip;
   Mat         *MatsFwdSensipTemp;
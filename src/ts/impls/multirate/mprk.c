@@ -31,6 +31,7 @@ struct _MPRKTableau {
   PetscInt   sbase;           /* Number of stages in the base method*/
   PetscInt   s;               /* Number of stages */
   PetscInt   np;              /* Number of partitions */
+  PetscInt   ratio1, ratio2;  /* Step size ratios slow/medium and medium/fast, the fast step is the slow one divided by both */
   PetscReal *Af, *bf, *cf;    /* Tableau for fast components */
   PetscReal *Amb, *bmb, *cmb; /* Tableau for medium components */
   PetscInt  *rmb;             /* Array of flags for repeated stages in medium method */
@@ -64,6 +65,11 @@ typedef struct {
   PetscReal    time_step;
   IS           is_slow, is_slowbuffer, is_medium, is_mediumbuffer, is_fast;
   TS           subts_slow, subts_slowbuffer, subts_medium, subts_mediumbuffer, subts_fast;
+  /* partitions computed from the stable step sizes of the components, slowest first */
+  IS        is_level[3];
+  Vec       vec_dtmax;
+  void     *stabilityctx;
+  PetscErrorCode (*stability)(TS, PetscReal, Vec, Vec, void *);
 } TS_MPRK;
 
 static PetscErrorCode TSMPRKGenerateTableau2(PetscInt ratio, PetscInt s, const PetscReal Abase[], const PetscReal bbase[], PetscReal A1[], PetscReal b1[], PetscReal A2[], PetscReal b2[])
@@ -484,7 +490,9 @@ PetscErrorCode TSMPRKRegister(TSMPRKType name, PetscInt order, PetscInt sbase, P
   t->order = order;
   t->sbase = sbase;
   t->s     = s;
-  t->np    = 2;
+  t->np     = 2;
+  t->ratio1 = ratio1;
+  t->ratio2 = ratio2;
 
   PetscCall(PetscMalloc3(s * s, &t->Af, s, &t->bf, s, &t->cf));
   PetscCall(PetscArraycpy(t->Af, Af, s * s));
@@ -611,6 +619,57 @@ static PetscErrorCode TSMPRKSetSplits(TS ts)
   PetscFunctionReturn(0);
 }
 
+/*
+  Each component goes to the slowest partition whose step size is below its stable step size, the fast one if there is
+  none. The slow partition steps with the step size of the TS, the medium one with it divided by ratio1 and the fast
+  one with it divided by ratio1*ratio2.
+*/
+static PetscErrorCode TSMPRKPartition(TS ts)
+{
+  TS_MPRK           *mprk = (TS_MPRK *)ts->data;
+  MPRKTableau        tab  = mprk->tableau;
+  MPI_Comm           comm;
+  const PetscScalar *dtmax;
+  PetscReal          h[3];
+  PetscInt           n, rstart, count[3] = {0, 0, 0}, *idx[3];
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)ts, &comm));
+  h[0] = ts->time_step;
+  h[1] = h[0] / tab->ratio1;
+  h[2] = h[1] / tab->ratio2;
+  if (tab->np == 2) h[1] = h[2];
+  PetscCallBack("TSMPRK callback stability", (*mprk->stability)(ts, ts->ptime, ts->vec_sol, mprk->vec_dtmax, mprk->stabilityctx));
+  PetscCall(VecGetLocalSize(mprk->vec_dtmax, &n));
+  PetscCall(VecGetOwnershipRange(mprk->vec_dtmax, &rstart, NULL));
+  for (PetscInt l = 0; l < tab->np; l++) PetscCall(PetscMalloc1(n, &idx[l]));
+  PetscCall(VecGetArrayRead(mprk->vec_dtmax, &dtmax));
+  for (PetscInt i = 0; i < n; i++) {
+    PetscInt l = 0;
+
+    while (h[l] > PetscRealPart(dtmax[i]) && l < tab->np - 1) l++;
+    idx[l][count[l]++] = rstart + i;
+  }
+  PetscCall(VecRestoreArrayRead(mprk->vec_dtmax, &dtmax));
+  for (PetscInt l = 0; l < tab->np; l++) {
+    PetscCall(ISDestroy(&mprk->is_level[l]));
+    PetscCall(ISCreateGeneral(comm, count[l], idx[l], PETSC_OWN_POINTER, &mprk->is_level[l]));
+  }
+  /* without buffers, the slow method is applied to the whole slow partition */
+  mprk->is_slow       = NULL;
+  mprk->is_slowbuffer = mprk->is_level[0];
+  if (tab->np == 3) {
+    mprk->is_medium       = NULL;
+    mprk->is_mediumbuffer = mprk->is_level[1];
+  }
+  mprk->is_fast = mprk->is_level[tab->np - 1];
+  if (PetscDefined(USE_INFO)) {
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, count, tab->np, MPIU_INT, MPI_SUM, comm));
+    for (PetscInt l = 0; l < tab->np; l++) PetscCall(PetscInfo(ts, "Partition %" PetscInt_FMT " with step size %g: %" PetscInt_FMT " components\n", l, (double)h[l], count[l]));
+  }
+  PetscFunctionReturn(0);
+}
+
 /*
  This if for nonsplit RHS MPRK
  The step completion formula is
@@ -646,6 +705,7 @@ static PetscErrorCode TSStep_MPRK(TS ts)
   PetscReal        next_time_step = ts->time_step, t = ts->ptime, h = ts->time_step;
 
   PetscFunctionBegin;
+  if (mprk->stability) PetscCall(TSMPRKPartition(ts));
   for (i = 0; i < s; i++) {
     mprk->stage_time = t + h * cf[i];
     PetscCall(TSPreStage(ts, mprk->stage_time));
@@ -926,8 +986,12 @@ static PetscErrorCode TSMPRKTableauReset(TS ts)
 
 static PetscErrorCode TSReset_MPRK(TS ts)
 {
+  TS_MPRK *mprk = (TS_MPRK *)ts->data;
+
   PetscFunctionBegin;
   PetscCall(TSMPRKTableauReset(ts));
+  for (PetscInt l = 0; l < 3; l++) PetscCall(ISDestroy(&mprk->is_level[l]));
+  PetscCall(VecDestroy(&mprk->vec_dtmax));
   PetscFunctionReturn(0);
 }
 
@@ -1013,25 +1077,31 @@ static PetscErrorCode TSSetUp_MPRK(TS ts)
   DM          dm;
 
   PetscFunctionBegin;
-  PetscCall(TSRHSSplitGetIS(ts, "slow", &mprk->is_slow));
-  PetscCall(TSRHSSplitGetIS(ts, "fast", &mprk->is_fast));
-  PetscCheck(mprk->is_slow && mprk->is_fast, PetscObjectComm((PetscObject)ts), PETSC_ERR_USER, "Must set up RHSSplits with TSRHSSplitSetIS() using split names 'slow' and 'fast' respectively in order to use the method '%s'", tab->name);
+  if (mprk->stability) {
+    PetscCheck(!ts->use_splitrhsfunction, PetscObjectComm((PetscObject)ts), PETSC_ERR_SUP, "The partitions can only be computed from the stable step sizes without split RHS functions, use -ts_use_splitrhsfunction 0");
+    PetscCall(VecDuplicate(ts->vec_sol, &mprk->vec_dtmax));
+    PetscCall(TSMPRKPartition(ts));
+  } else {
+    PetscCall(TSRHSSplitGetIS(ts, "slow", &mprk->is_slow));
+    PetscCall(TSRHSSplitGetIS(ts, "fast", &mprk->is_fast));
+    PetscCheck(mprk->is_slow && mprk->is_fast, PetscObjectComm((PetscObject)ts), PETSC_ERR_USER, "Must set up RHSSplits with TSRHSSplitSetIS() using split names 'slow' and 'fast' respectively in order to use the method '%s', or give the stable step sizes with TSMPRKSetMultirateStability()", tab->name);
 
-  if (tab->np == 3) {
-    PetscCall(TSRHSSplitGetIS(ts, "medium", &mprk->is_medium));
-    PetscCheck(mprk->is_medium, PetscObjectComm((PetscObject)ts), PETSC_ERR_USER, "Must set up RHSSplits with TSRHSSplitSetIS() using split names 'slow' and 'medium' and 'fast' respectively in order to use the method '%s'", tab->name);
-    PetscCall(TSRHSSplitGetIS(ts, "mediumbuffer", &mprk->is_mediumbuffer));
-    if (!mprk->is_mediumbuffer) { /* let medium buffer cover whole medium region */
-      mprk->is_mediumbuffer = mprk->is_medium;
-      mprk->is_medium       = NULL;
+    if (tab->np == 3) {
+      PetscCall(TSRHSSplitGetIS(ts, "medium", &mprk->is_medium));
+      PetscCheck(mprk->is_medium, PetscObjectComm((PetscObject)ts), PETSC_ERR_USER, "Must set up RHSSplits with TSRHSSplitSetIS() using split names 'slow' and 'medium' and 'fast' respectively in order to use the method '%s'", tab->name);
+      PetscCall(TSRHSSplitGetIS(ts, "mediumbuffer", &mprk->is_mediumbuffer));
+      if (!mprk->is_mediumbuffer) { /* let medium buffer cover whole medium region */
+        mprk->is_mediumbuffer = mprk->is_medium;
+        mprk->is_medium       = NULL;
+      }
     }
-  }
 
-  /* If users do not provide buffer region settings, the solver will do them automatically, but with a performance penalty */
-  PetscCall(TSRHSSplitGetIS(ts, "slowbuffer", &mprk->is_slowbuffer));
-  if (!mprk->is_slowbuffer) { /* let slow buffer cover whole slow region */
-    mprk->is_slowbuffer = mprk->is_slow;
-    mprk->is_slow       = NULL;
+    /* If users do not provide buffer region settings, the solver will do them automatically, but with a performance penalty */
+    PetscCall(TSRHSSplitGetIS(ts, "slowbuffer", &mprk->is_slowbuffer));
+    if (!mprk->is_slowbuffer) { /* let slow buffer cover whole slow region */
+      mprk->is_slowbuffer = mprk->is_slow;
+      mprk->is_slow       = NULL;
+    }
   }
   PetscCall(TSCheckImplicitTerm(ts));
   PetscCall(TSMPRKTableauSetUp(ts));
@@ -1088,6 +1158,17 @@ static PetscErrorCode TSView_MPRK(TS ts, PetscViewer viewer)
     PetscCall(TSMPRKGetType(ts, &mprktype));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  MPRK type %s\n", mprktype));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  Order: %" PetscInt_FMT "\n", tab->order));
+    if (mprk->stability && mprk->is_level[0]) {
+      const char *const names[3] = {"slow", tab->np == 3 ? "medium" : "fast", "fast"};
+
+      PetscCall(PetscViewerASCIIPrintf(viewer, "  Partitions from the stable step sizes:\n"));
+      for (i = 0; i < tab->np; i++) {
+        PetscInt n;
+
+        PetscCall(ISGetSize(mprk->is_level[i], &n));
+        PetscCall(PetscViewerASCIIPrintf(viewer, "    %s: %" PetscInt_FMT " components\n", names[i], n));
+      }
+    }
 
     PetscCall(PetscFormatRealArray(fbuf, sizeof(fbuf), "% 8.6f", tab->s, tab->cf));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  Abscissa cf = %s\n", fbuf));
@@ -1215,6 +1296,59 @@ static PetscErrorCode TSMPRKSetType_MPRK(TS ts, TSMPRKType mprktype)
   SETERRQ(PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_UNKNOWN_TYPE, "Could not find '%s'", mprktype);
 }
 
+/*@C
+  TSMPRKSetMultirateStability - Sets the function giving the stable step size of each component, from which `TSMPRK` computes its slow, medium and fast partitions
+
+  Logically collective
+
+  Input Parameters:
++  ts - timestepping context
+.  stability - the function
+-  ctx - [optional] user-defined context for the function (may be `NULL`)
+
+  Calling sequence of stability:
+$   PetscErrorCode stability(TS ts, PetscReal t, Vec U, Vec Dt, void *ctx);
+
++  ts - the `TS` context
+.  t - the current time
+.  U - the current solution
+.  Dt - the largest stable step size of each component, for example the CFL number times the size of its cell divided by the local wave speed
+-  ctx - [optional] user-defined context
+
+  Level: intermediate
+
+  Notes:
+  The partitions then replace the splits given with `TSRHSSplitSetIS()` and are recomputed at every step. Each component
+  is put in the slowest partition whose step size is below its stable step size: the slow partition steps with the step
+  size of the `TS`, the medium one with it divided by the first step size ratio of the method and the fast one with it
+  divided by both ratios, see `TSMPRKRegister()`. Components that are not stable with the fast step size are put in the
+  fast partition.
+
+  The slow and medium methods are applied to their whole partitions, there are no buffer regions. The stable step sizes
+  should therefore be the smallest ones of the components the stencil of each component reaches.
+
+  Only the method without split RHS functions (`-ts_use_splitrhsfunction 0`) is supported.
+
+.seealso: [](chapter_ts), `TSMPRK`, `TSRKSetMultirateStability()`, `TSRHSSplitSetIS()`
+@*/
+PetscErrorCode TSMPRKSetMultirateStability(TS ts, PetscErrorCode (*stability)(TS, PetscReal, Vec, Vec, void *), void *ctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscTryMethod(ts, "TSMPRKSetMultirateStability_C", (TS, PetscErrorCode(*)(TS, PetscReal, Vec, Vec, void *), void *), (ts, stability, ctx));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSMPRKSetMultirateStability_MPRK(TS ts, PetscErrorCode (*stability)(TS, PetscReal, Vec, Vec, void *), void *ctx)
+{
+  TS_MPRK *mprk = (TS_MPRK *)ts->data;
+
+  PetscFunctionBegin;
+  mprk->stability    = stability;
+  mprk->stabilityctx = ctx;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode TSGetStages_MPRK(TS ts, PetscInt *ns, Vec **Y)
 {
   TS_MPRK *mprk = (TS_MPRK *)ts->data;
@@ -1236,6 +1370,7 @@ static PetscErrorCode TSDestroy_MPRK(TS ts)
   PetscCall(PetscFree(ts->data));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSMPRKGetType_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSMPRKSetType_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSMPRKSetMultirateStability_C", NULL));
   PetscFunctionReturn(0);
 }
 
@@ -1249,7 +1384,7 @@ static PetscErrorCode TSDestroy_MPRK(TS ts)
   Note:
   The default is `TSMPRKPM2`, it can be changed with `TSMPRKSetType()` or -ts_mprk_type
 
-.seealso: [](chapter_ts), `TSCreate()`, `TS`, `TSSetType()`, `TSMPRKSetType()`, `TSMPRKGetType()`, `TSMPRKType`, `TSMPRKRegister()`, `TSMPRKSetMultirateType()`
+.seealso: [](chapter_ts), `TSCreate()`, `TS`, `TSSetType()`, `TSMPRKSetType()`, `TSMPRKGetType()`, `TSMPRKType`, `TSMPRKRegister()`, `TSMPRKSetMultirateType()`, `TSMPRKSetMultirateStability()`
           `TSMPRKM2`, `TSMPRKM3`, `TSMPRKRFSMR3`, `TSMPRKRFSMR2`, `TSType`
 M*/
 PETSC_EXTERN PetscErrorCode TSCreate_MPRK(TS ts)
@@ -1274,6 +1409,7 @@ PETSC_EXTERN PetscErrorCode TSCreate_MPRK(TS ts)
 
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSMPRKGetType_C", TSMPRKGetType_MPRK));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSMPRKSetType_C", TSMPRKSetType_MPRK));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSMPRKSetMultirateStability_C", TSMPRKSetMultirateStability_MPRK));
 
   PetscCall(TSMPRKSetType(ts, TSMPRKDefault));
   PetscFunctionReturn(0);
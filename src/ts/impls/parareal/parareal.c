@@ -0,0 +1,616 @@
+/*
+       Code for the parallel-in-time integration of the Parareal method, with fine and coarse TS propagating the time slices
+*/
+#include <petsc/private/tsimpl.h> /*I   "petscts.h"   I*/
+#include <petscdmshell.h>
+
+static const char *citation = "@article{LionsMadayTurinici2001,\n"
+                              "  author  = {J.-L. Lions and Y. Maday and G. Turinici},\n"
+                              "  title   = {A ``parareal'' in time discretization of {PDE}'s},\n"
+                              "  journal = {Comptes Rendus de l'Acad\\'emie des Sciences, S\\'erie I, Math\\'ematique},\n"
+                              "  volume  = {332},\n"
+                              "  number  = {7},\n"
+                              "  pages   = {661--668},\n"
+                              "  year    = {2001}\n}\n";
+static PetscBool  cited    = PETSC_FALSE;
+
+typedef struct {
+  TS          fine, coarse;
+  MPI_Comm    tcomm; /* the processes of the other time slices with the same rank in space */
+  PetscMPIInt tag, nslices, slice;
+  PetscInt    ncoarse; /* coarse steps per slice */
+  PetscReal   rtol;
+  PetscInt    maxits; /* PETSC_DEFAULT for the number of slices, after which the method is exact */
+  PetscBool   monitor;
+
+  Vec U;     /* the start of the slice */
+  Vec F, G;  /* the fine and coarse propagations of the start */
+  Vec Uend;  /* the end of the slice */
+  Vec W, dU; /* work */
+
+  PetscInt its, finesteps, coarsesteps; /* of the last solve on this slice */
+} TS_Parareal;
+
+static PetscErrorCode TSPararealSend_Private(TS ts, Vec U, PetscMPIInt dest)
+{
+  TS_Parareal       *pr = (TS_Parareal *)ts->data;
+  const PetscScalar *u;
+  PetscInt           n;
+  PetscMPIInt        nn;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(U, &n));
+  PetscCall(PetscMPIIntCast(n, &nn));
+  PetscCall(VecGetArrayRead(U, &u));
+  PetscCallMPI(MPI_Send(u, nn, MPIU_SCALAR, dest, pr->tag, pr->tcomm));
+  PetscCall(VecRestoreArrayRead(U, &u));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSPararealRecv_Private(TS ts, Vec U, PetscMPIInt source)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  PetscScalar *u;
+  PetscInt     n;
+  PetscMPIInt  nn;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(U, &n));
+  PetscCall(PetscMPIIntCast(n, &nn));
+  PetscCall(VecGetArrayWrite(U, &u));
+  PetscCallMPI(MPI_Recv(u, nn, MPIU_SCALAR, source, pr->tag, pr->tcomm, MPI_STATUS_IGNORE));
+  PetscCall(VecRestoreArrayWrite(U, &u));
+  PetscFunctionReturn(0);
+}
+
+/* integrates U in place from t0 to t1 with the steps dt of the propagator */
+static PetscErrorCode TSPararealPropagate_Private(TS sub, PetscReal t0, PetscReal t1, PetscReal dt, Vec U, PetscInt *nsteps)
+{
+  PetscInt steps;
+
+  PetscFunctionBegin;
+  PetscCall(TSSetTime(sub, t0));
+  PetscCall(TSSetStepNumber(sub, 0));
+  PetscCall(TSSetMaxTime(sub, t1));
+  PetscCall(TSSetTimeStep(sub, dt));
+  PetscCall(TSSolve(sub, U));
+  PetscCheck(sub->reason >= 0, PetscObjectComm((PetscObject)sub), PETSC_ERR_NOT_CONVERGED, "Propagation of a time slice failed due to %s", TSConvergedReasons[sub->reason]);
+  PetscCall(TSGetStepNumber(sub, &steps));
+  *nsteps += steps;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSStep_Parareal(TS ts)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  PetscMPIInt  p = pr->slice, P = pr->nslices;
+  PetscReal    H, t0, t1;
+  PetscInt     maxits, k;
+  PetscScalar *u;
+  PetscInt     n;
+  PetscMPIInt  nn;
+
+  PetscFunctionBegin;
+  PetscCall(PetscCitationsRegister(citation, &cited));
+  H               = (ts->max_time - ts->ptime) / P;
+  t0              = ts->ptime + p * H;
+  t1              = p == P - 1 ? ts->max_time : t0 + H;
+  maxits          = pr->maxits == PETSC_DEFAULT ? P : pr->maxits;
+  pr->its         = 0;
+  pr->finesteps   = 0;
+  pr->coarsesteps = 0;
+
+  /* the coarse propagation through the slices in turn */
+  if (p) PetscCall(TSPararealRecv_Private(ts, pr->U, p - 1));
+  else PetscCall(VecCopy(ts->vec_sol, pr->U));
+  PetscCall(VecCopy(pr->U, pr->G));
+  PetscCall(TSPararealPropagate_Private(pr->coarse, t0, t1, H / pr->ncoarse, pr->G, &pr->coarsesteps));
+  PetscCall(VecCopy(pr->G, pr->Uend));
+  if (p < P - 1) PetscCall(TSPararealSend_Private(ts, pr->Uend, p + 1));
+
+  /* after k iterations the first k slices are exact, their start no longer changes */
+  for (k = 1; k <= maxits; k++) {
+    PetscReal change, norm;
+
+    /* the fine propagations of the slices are concurrent, of the starts that changed in the previous iteration */
+    if (p >= k - 1) {
+      PetscCall(VecCopy(pr->U, pr->F));
+      PetscCall(TSPararealPropagate_Private(pr->fine, t0, t1, ts->time_step, pr->F, &pr->finesteps));
+    }
+    PetscCall(VecCopy(pr->Uend, pr->dU));
+    if (p >= k) { /* the coarse correction U_{p+1} = G(U_p) + F(U_p^old) - G(U_p^old) through the slices in turn */
+      PetscCall(TSPararealRecv_Private(ts, pr->U, p - 1));
+      PetscCall(VecCopy(pr->U, pr->W));
+      PetscCall(TSPararealPropagate_Private(pr->coarse, t0, t1, H / pr->ncoarse, pr->W, &pr->coarsesteps));
+      PetscCall(VecWAXPY(pr->Uend, -1.0, pr->G, pr->W));
+      PetscCall(VecAXPY(pr->Uend, 1.0, pr->F));
+      PetscCall(VecCopy(pr->W, pr->G));
+    } else PetscCall(VecCopy(pr->F, pr->Uend));
+    if (p < P - 1 && p + 1 >= k) PetscCall(TSPararealSend_Private(ts, pr->Uend, p + 1));
+
+    /* the largest relative change of the ends of the slices */
+    PetscCall(VecAXPY(pr->dU, -1.0, pr->Uend));
+    PetscCall(VecNorm(pr->dU, NORM_2, &change));
+    PetscCall(VecNorm(pr->Uend, NORM_2, &norm));
+    if (norm > 0) change /= norm;
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &change, 1, MPIU_REAL, MPIU_MAX, pr->tcomm));
+    pr->its = k;
+    if (pr->monitor && !p) PetscCall(PetscPrintf(PetscObjectComm((PetscObject)ts), "  Parareal iteration %" PetscInt_FMT ", largest relative change of the ends of the time slices %g\n", k, (double)change));
+    if (change <= pr->rtol) break;
+  }
+
+  /* the solution is the end of the last slice */
+  if (p == P - 1) PetscCall(VecCopy(pr->Uend, ts->vec_sol));
+  PetscCall(VecGetLocalSize(ts->vec_sol, &n));
+  PetscCall(PetscMPIIntCast(n, &nn));
+  PetscCall(VecGetArray(ts->vec_sol, &u));
+  PetscCallMPI(MPI_Bcast(u, nn, MPIU_SCALAR, P - 1, pr->tcomm));
+  PetscCall(VecRestoreArray(ts->vec_sol, &u));
+  ts->ptime = ts->max_time;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSPararealGetSubTS_Private(TS ts, PetscBool fine, TS *sub)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  TS          *s  = fine ? &pr->fine : &pr->coarse;
+
+  PetscFunctionBegin;
+  if (!*s) {
+    PetscCall(TSCreate(PetscObjectComm((PetscObject)ts), s));
+    PetscCall(PetscObjectIncrementTabLevel((PetscObject)*s, (PetscObject)ts, 1));
+    PetscCall(TSSetOptionsPrefix(*s, ((PetscObject)ts)->prefix));
+    PetscCall(TSAppendOptionsPrefix(*s, fine ? "parareal_fine_" : "parareal_coarse_"));
+    PetscCall(TSSetType(*s, TSBEULER));
+    PetscCall(TSSetExactFinalTime(*s, TS_EXACTFINALTIME_MATCHSTEP));
+  }
+  *sub = *s;
+  PetscFunctionReturn(0);
+}
+
+/* the propagators solve the problem of the TS, with the callbacks of its DMTS on a DM of their own for their own DMSNES */
+static PetscErrorCode TSPararealSetUpSubTS_Private(TS ts, TS sub)
+{
+  DM        dm, subdm;
+  SNES      snes;
+  Mat       A, B;
+  PetscBool isshell;
+
+  PetscFunctionBegin;
+  PetscCall(TSGetDM(ts, &dm));
+  PetscCall(PetscObjectTypeCompare((PetscObject)dm, DMSHELL, &isshell));
+  if (isshell) {
+    PetscCall(DMShellCreate(PetscObjectComm((PetscObject)dm), &subdm));
+    PetscCall(DMShellSetGlobalVector(subdm, ts->vec_sol));
+  } else {
+    PetscCall(DMClone(dm, &subdm));
+    PetscCall(DMCopyDisc(dm, subdm));
+  }
+  PetscCall(DMCopyDMTS(dm, subdm));
+  PetscCall(TSSetDM(sub, subdm));
+  PetscCall(DMDestroy(&subdm));
+  PetscCall(TSSetProblemType(sub, ts->problem_type));
+  PetscCall(TSSetEquationType(sub, ts->equation_type));
+  if (ts->snes) {
+    PetscCall(SNESGetJacobian(ts->snes, &A, &B, NULL, NULL));
+    if (A) {
+      PetscCall(TSGetSNES(sub, &snes));
+      PetscCall(SNESSetJacobian(snes, A, B, NULL, NULL));
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSSetUp_Parareal(TS ts)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  TS           fine, coarse;
+  PetscInt     n[2];
+
+  PetscFunctionBegin;
+  PetscCheck(ts->max_time < PETSC_MAX_REAL, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_WRONGSTATE, "The time slices of TSPARAREAL need the final time, call TSSetMaxTime()");
+  PetscCallMPI(MPI_Comm_size(pr->tcomm, &pr->nslices));
+  PetscCallMPI(MPI_Comm_rank(pr->tcomm, &pr->slice));
+  PetscCall(VecGetLocalSize(ts->vec_sol, &n[0]));
+  n[1] = -n[0];
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, n, 2, MPIU_INT, MPI_MAX, pr->tcomm));
+  PetscCheck(n[0] == -n[1], PETSC_COMM_SELF, PETSC_ERR_ARG_INCOMP, "The solutions of the time slices must have the same local size, not %" PetscInt_FMT " and %" PetscInt_FMT, -n[1], n[0]);
+
+  PetscCall(TSPararealGetSubTS_Private(ts, PETSC_TRUE, &fine));
+  PetscCall(TSPararealGetSubTS_Private(ts, PETSC_FALSE, &coarse));
+  PetscCall(TSPararealSetUpSubTS_Private(ts, fine));
+  PetscCall(TSPararealSetUpSubTS_Private(ts, coarse));
+  PetscCall(VecDuplicate(ts->vec_sol, &pr->U));
+  PetscCall(VecDuplicate(ts->vec_sol, &pr->F));
+  PetscCall(VecDuplicate(ts->vec_sol, &pr->G));
+  PetscCall(VecDuplicate(ts->vec_sol, &pr->Uend));
+  PetscCall(VecDuplicate(ts->vec_sol, &pr->W));
+  PetscCall(VecDuplicate(ts->vec_sol, &pr->dU));
+  if (ts->exact_final_time == TS_EXACTFINALTIME_UNSPECIFIED) ts->exact_final_time = TS_EXACTFINALTIME_MATCHSTEP;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSReset_Parareal(TS ts)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCall(VecDestroy(&pr->U));
+  PetscCall(VecDestroy(&pr->F));
+  PetscCall(VecDestroy(&pr->G));
+  PetscCall(VecDestroy(&pr->Uend));
+  PetscCall(VecDestroy(&pr->W));
+  PetscCall(VecDestroy(&pr->dU));
+  if (pr->fine) PetscCall(TSReset(pr->fine));
+  if (pr->coarse) PetscCall(TSReset(pr->coarse));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSDestroy_Parareal(TS ts)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCall(TSReset_Parareal(ts));
+  PetscCall(TSDestroy(&pr->fine));
+  PetscCall(TSDestroy(&pr->coarse));
+  PetscCall(PetscCommDestroy(&pr->tcomm));
+  PetscCall(PetscFree(ts->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetTimeCommunicator_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetFineTS_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetCoarseTS_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetTolerances_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetCoarseSteps_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetIterationNumber_C", NULL));
+  PetscFunctionReturn(0);
+}
+/*------------------------------------------------------------*/
+
+static PetscErrorCode TSSetFromOptions_Parareal(TS ts, PetscOptionItems *PetscOptionsObject)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  TS           sub;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "Parareal options");
+  PetscCall(PetscOptionsReal("-ts_parareal_rtol", "Relative change of the ends of the time slices at which the iterations stop", "TSPararealSetTolerances", pr->rtol, &pr->rtol, NULL));
+  PetscCall(PetscOptionsInt("-ts_parareal_max_it", "Maximum number of iterations, the number of time slices by default", "TSPararealSetTolerances", pr->maxits, &pr->maxits, NULL));
+  PetscCall(PetscOptionsInt("-ts_parareal_coarse_steps", "Number of steps of the coarse propagator on a time slice", "TSPararealSetCoarseSteps", pr->ncoarse, &pr->ncoarse, NULL));
+  PetscCall(PetscOptionsBool("-ts_parareal_monitor", "Monitor the change of the ends of the time slices", "TSSetFromOptions", pr->monitor, &pr->monitor, NULL));
+  PetscOptionsHeadEnd();
+  PetscCheck(pr->ncoarse > 0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Number of coarse steps %" PetscInt_FMT " must be positive", pr->ncoarse);
+  PetscCall(TSPararealGetSubTS_Private(ts, PETSC_TRUE, &sub));
+  PetscCall(TSSetFromOptions(sub));
+  PetscCall(TSPararealGetSubTS_Private(ts, PETSC_FALSE, &sub));
+  PetscCall(TSSetFromOptions(sub));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSView_Parareal(TS ts, PetscViewer viewer)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  PetscBool    iascii;
+  PetscMPIInt  nslices;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (!iascii) PetscFunctionReturn(0);
+  PetscCallMPI(MPI_Comm_size(pr->tcomm, &nslices));
+  PetscCall(PetscViewerASCIIPrintf(viewer, "  %d time slices, at most %" PetscInt_FMT " iterations, relative tolerance %g\n", nslices, pr->maxits == PETSC_DEFAULT ? (PetscInt)nslices : pr->maxits, (double)pr->rtol));
+  if (ts->setupcalled) PetscCall(PetscViewerASCIIPrintf(viewer, "  Iterations %" PetscInt_FMT ", fine steps %" PetscInt_FMT " and coarse steps %" PetscInt_FMT " on time slice %d\n", pr->its, pr->finesteps, pr->coarsesteps, pr->slice));
+  PetscCall(PetscViewerASCIIPrintf(viewer, "  Coarse steps per time slice %" PetscInt_FMT "\n", pr->ncoarse));
+  if (pr->fine) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  Fine propagator:\n"));
+    PetscCall(PetscViewerASCIIPushTab(viewer));
+    PetscCall(TSView(pr->fine, viewer));
+    PetscCall(PetscViewerASCIIPopTab(viewer));
+  }
+  if (pr->coarse) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  Coarse propagator:\n"));
+    PetscCall(PetscViewerASCIIPushTab(viewer));
+    PetscCall(TSView(pr->coarse, viewer));
+    PetscCall(PetscViewerASCIIPopTab(viewer));
+  }
+  PetscFunctionReturn(0);
+}
+/* ------------------------------------------------------------ */
+
+static PetscErrorCode TSPararealSetTimeCommunicator_Parareal(TS ts, MPI_Comm tcomm)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscCommDestroy(&pr->tcomm));
+  PetscCall(PetscCommDuplicate(tcomm, &pr->tcomm, &pr->tag));
+  ts->setupcalled = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSPararealGetFineTS_Parareal(TS ts, TS *fine)
+{
+  PetscFunctionBegin;
+  PetscCall(TSPararealGetSubTS_Private(ts, PETSC_TRUE, fine));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSPararealGetCoarseTS_Parareal(TS ts, TS *coarse)
+{
+  PetscFunctionBegin;
+  PetscCall(TSPararealGetSubTS_Private(ts, PETSC_FALSE, coarse));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSPararealSetTolerances_Parareal(TS ts, PetscReal rtol, PetscInt maxits)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  if (rtol == (PetscReal)PETSC_DEFAULT) pr->rtol = 1.e-8;
+  else if (rtol != (PetscReal)PETSC_DECIDE) {
+    PetscCheck(rtol >= 0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Relative tolerance %g must be nonnegative", (double)rtol);
+    pr->rtol = rtol;
+  }
+  if (maxits == PETSC_DEFAULT) pr->maxits = PETSC_DEFAULT;
+  else if (maxits != PETSC_DECIDE) {
+    PetscCheck(maxits >= 0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Maximum number of iterations %" PetscInt_FMT " must be nonnegative", maxits);
+    pr->maxits = maxits;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSPararealSetCoarseSteps_Parareal(TS ts, PetscInt ncoarse)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCheck(ncoarse > 0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Number of coarse steps %" PetscInt_FMT " must be positive", ncoarse);
+  pr->ncoarse = ncoarse;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSPararealGetIterationNumber_Parareal(TS ts, PetscInt *its)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  *its = pr->its;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  TSPararealSetTimeCommunicator - Sets the communicator of the time slices of a `TSPARAREAL` integrator
+
+  Logically collective
+
+  Input Parameters:
++  ts - timestepping context, on the communicator of the processes sharing a time slice
+-  tcomm - the communicator of the processes with the same rank in the other time slices, one process per time slice
+
+  Level: beginner
+
+  Notes:
+  The time slices are numbered by the rank in tcomm. `MPI_Comm_split()` of `PETSC_COMM_WORLD` with the time slice as color gives the
+  communicator of the `TS`, and with its rank in it as color gives tcomm.
+
+  The default `PETSC_COMM_SELF` makes a single time slice, which is integrated by the fine propagator.
+
+.seealso: [](chapter_ts), `TSPARAREAL`, `TSPararealGetFineTS()`, `TSPararealGetCoarseTS()`
+@*/
+PetscErrorCode TSPararealSetTimeCommunicator(TS ts, MPI_Comm tcomm)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscTryMethod(ts, "TSPararealSetTimeCommunicator_C", (TS, MPI_Comm), (ts, tcomm));
+  PetscFunctionReturn(0);
+}
+
+/*@
+  TSPararealGetFineTS - Gets the fine propagator of a `TSPARAREAL` integrator
+
+  Not collective
+
+  Input Parameter:
+.  ts - timestepping context
+
+  Output Parameter:
+.  fine - the `TS` integrating the time slices accurately
+
+  Level: intermediate
+
+  Notes:
+  Its options have the prefix -parareal_fine_ after the one of ts, and it is a `TSBEULER` by default. It takes the steps of the
+  size of those of ts.
+
+  It solves the problem of ts, its functions need not be set.
+
+.seealso: [](chapter_ts), `TSPARAREAL`, `TSPararealGetCoarseTS()`
+@*/
+PetscErrorCode TSPararealGetFineTS(TS ts, TS *fine)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidPointer(fine, 2);
+  PetscUseMethod(ts, "TSPararealGetFineTS_C", (TS, TS *), (ts, fine));
+  PetscFunctionReturn(0);
+}
+
+/*@
+  TSPararealGetCoarseTS - Gets the coarse propagator of a `TSPARAREAL` integrator
+
+  Not collective
+
+  Input Parameter:
+.  ts - timestepping context
+
+  Output Parameter:
+.  coarse - the `TS` integrating the time slices cheaply
+
+  Level: intermediate
+
+  Notes:
+  Its options have the prefix -parareal_coarse_ after the one of ts, and it is a `TSBEULER` by default. It takes the number of
+  steps on a time slice given by `TSPararealSetCoarseSteps()`.
+
+  It solves the problem of ts, its functions need not be set.
+
+.seealso: [](chapter_ts), `TSPARAREAL`, `TSPararealGetFineTS()`, `TSPararealSetCoarseSteps()`
+@*/
+PetscErrorCode TSPararealGetCoarseTS(TS ts, TS *coarse)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidPointer(coarse, 2);
+  PetscUseMethod(ts, "TSPararealGetCoarseTS_C", (TS, TS *), (ts, coarse));
+  PetscFunctionReturn(0);
+}
+
+/*@
+  TSPararealSetTolerances - Sets when the iterations of a `TSPARAREAL` integrator stop
+
+  Logically collective
+
+  Input Parameters:
++  ts - timestepping context
+.  rtol - the largest relative change of the ends of the time slices in an iteration at which they stop, or `PETSC_DEFAULT` (1e-8)
+-  maxits - the maximum number of iterations, or `PETSC_DEFAULT` for the number of time slices
+
+  Options Database Keys:
++  -ts_parareal_rtol <rtol> - the relative tolerance
+-  -ts_parareal_max_it <maxits> - the maximum number of iterations
+
+  Level: intermediate
+
+  Note:
+  After as many iterations as time slices the solution is the one of the fine propagator, the iterations can only be useful
+  if they stop well before.
+
+.seealso: [](chapter_ts), `TSPARAREAL`, `TSPararealGetIterationNumber()`
+@*/
+PetscErrorCode TSPararealSetTolerances(TS ts, PetscReal rtol, PetscInt maxits)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveReal(ts, rtol, 2);
+  PetscValidLogicalCollectiveInt(ts, maxits, 3);
+  PetscTryMethod(ts, "TSPararealSetTolerances_C", (TS, PetscReal, PetscInt), (ts, rtol, maxits));
+  PetscFunctionReturn(0);
+}
+
+/*@
+  TSPararealSetCoarseSteps - Sets the number of steps of the coarse propagator of a `TSPARAREAL` integrator on a time slice
+
+  Logically collective
+
+  Input Parameters:
++  ts - timestepping context
+-  ncoarse - the number of steps, 1 by default
+
+  Options Database Key:
+.  -ts_parareal_coarse_steps <ncoarse> - the number of steps
+
+  Level: intermediate
+
+.seealso: [](chapter_ts), `TSPARAREAL`, `TSPararealGetCoarseTS()`
+@*/
+PetscErrorCode TSPararealSetCoarseSteps(TS ts, PetscInt ncoarse)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ts, ncoarse, 2);
+  PetscTryMethod(ts, "TSPararealSetCoarseSteps_C", (TS, PetscInt), (ts, ncoarse));
+  PetscFunctionReturn(0);
+}
+
+/*@
+  TSPararealGetIterationNumber - Gets the number of iterations of the last solve of a `TSPARAREAL` integrator
+
+  Not collective
+
+  Input Parameter:
+.  ts - timestepping context
+
+  Output Parameter:
+.  its - the number of iterations
+
+  Level: intermediate
+
+.seealso: [](chapter_ts), `TSPARAREAL`, `TSPararealSetTolerances()`
+@*/
+PetscErrorCode TSPararealGetIterationNumber(TS ts, PetscInt *its)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidIntPointer(its, 2);
+  PetscUseMethod(ts, "TSPararealGetIterationNumber_C", (TS, PetscInt *), (ts, its));
+  PetscFunctionReturn(0);
+}
+
+/*MC
+      TSPARAREAL - Parallel-in-time integration with the Parareal method
+
+  The interval from the current time to the final time is split into as many time slices as processes in the communicator
+  given with `TSPararealSetTimeCommunicator()`, each integrated by the processes of the communicator of the `TS`. A coarse
+  propagator gives the start of every slice in turn; then in each iteration the fine propagator integrates all the slices
+  concurrently from their starts, and the coarse propagator corrects the starts in turn with the differences between the two
+  propagators,
+
+$  U_{p+1}^{k+1} = G(U_p^{k+1}) + F(U_p^k) - G(U_p^k),
+
+  until the ends of the slices change by less than the tolerance of `TSPararealSetTolerances()`. The solution is then the end
+  of the last slice, on all the slices.
+
+  After k iterations the first k slices are exact, they do no more work. The speedup over the fine propagator alone is
+  bounded by the number of slices over the number of iterations, so that the coarse propagator must be both cheap and
+  accurate enough for few iterations, as for diffusive problems.
+
+  The fine and coarse propagators are `TS` of their own, obtained with `TSPararealGetFineTS()` and `TSPararealGetCoarseTS()`,
+  solving the problem of the `TS` on a copy of its `DM`.
+
+  Options Database Keys:
++  -ts_parareal_rtol <rtol> - the relative tolerance on the change of the ends of the time slices
+.  -ts_parareal_max_it <maxits> - the maximum number of iterations
+.  -ts_parareal_coarse_steps <ncoarse> - the number of coarse steps on a time slice
+.  -ts_parareal_monitor - show the change of the ends of the time slices in each iteration
+.  -parareal_fine_ts_type <type> - the type of the fine propagator
+-  -parareal_coarse_ts_type <type> - the type of the coarse propagator
+
+  Level: advanced
+
+  Notes:
+  The whole interval up to the final time of `TSSetMaxTime()` is one step of the `TS`. The step size of the `TS` is the one of
+  the fine propagator.
+
+  Parareal is the two level multigrid reduction in time with F-relaxation.
+
+.seealso: [](chapter_ts), `TSCreate()`, `TS`, `TSSetType()`, `TSPararealSetTimeCommunicator()`, `TSPararealGetFineTS()`, `TSPararealGetCoarseTS()`,
+          `TSPararealSetTolerances()`, `TSPararealSetCoarseSteps()`, `TSPararealGetIterationNumber()`
+M*/
+PETSC_EXTERN PetscErrorCode TSCreate_Parareal(TS ts)
+{
+  TS_Parareal *pr;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&pr));
+  ts->data    = (void *)pr;
+  pr->ncoarse = 1;
+  pr->rtol    = 1.e-8;
+  pr->maxits  = PETSC_DEFAULT;
+  PetscCall(PetscCommDuplicate(PETSC_COMM_SELF, &pr->tcomm, &pr->tag));
+
+  ts->ops->setup          = TSSetUp_Parareal;
+  ts->ops->step           = TSStep_Parareal;
+  ts->ops->reset          = TSReset_Parareal;
+  ts->ops->destroy        = TSDestroy_Parareal;
+  ts->ops->setfromoptions = TSSetFromOptions_Parareal;
+  ts->ops->view           = TSView_Parareal;
+  ts->default_adapt_type  = TSADAPTNONE;
+  ts->usessnes            = PETSC_FALSE;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetTimeCommunicator_C", TSPararealSetTimeCommunicator_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetFineTS_C", TSPararealGetFineTS_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetCoarseTS_C", TSPararealGetCoarseTS_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetTolerances_C", TSPararealSetTolerances_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetCoarseSteps_C", TSPararealSetCoarseSteps_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetIterationNumber_C", TSPararealGetIterationNumber_Parareal));
+  PetscFunctionReturn(0);
+}
@@ -127,6 +127,9 @@ PetscErrorCode TSSetFromOptions(TS ts)
   PetscCall(PetscOptionsBool("-ts_rhs_jacobian_test_mult", "Test the RHS Jacobian for consistency with RHS at each solve ", "None", ts->testjacobian, &ts->testjacobian, NULL));
   PetscCall(PetscOptionsBool("-ts_rhs_jacobian_test_mult_transpose", "Test the RHS Jacobian transpose for consistency with RHS at each solve ", "None", ts->testjacobiantranspose, &ts->testjacobiantranspose, NULL));
   PetscCall(PetscOptionsBool("-ts_use_splitrhsfunction", "Use the split RHS function for multirate solvers ", "TSSetUseSplitRHSFunction", ts->use_splitrhsfunction, &ts->use_splitrhsfunction, NULL));
+  PetscCall(PetscOptionsBool("-ts_jacobian_lag", "Reuse the Jacobian of the nonlinear solves while Newton's method converges fast", "TSSetJacobianLag", ts->lagjacobian.on, &ts->lagjacobian.on, NULL));
+  PetscCall(PetscOptionsReal("-ts_jacobian_lag_rate", "Rebuild the Jacobian when Newton's method contracts the residual by less than this", "TSSetJacobianLagTolerances", ts->lagjacobian.rate, &ts->lagjacobian.rate, NULL));
+  PetscCall(PetscOptionsInt("-ts_jacobian_lag_max_steps", "Rebuild the Jacobian after this many steps, -1 for never", "TSSetJacobianLagTolerances", ts->lagjacobian.maxsteps, &ts->lagjacobian.maxsteps, NULL));
 #if defined(PETSC_HAVE_SAWS)
   {
     PetscBool set;
@@ -836,6 +839,59 @@ static PetscErrorCode TSRecoverRHSJacobian(TS ts, Mat A, Mat B)
   PetscFunctionReturn(0);
 }
 
+/*
+  Reuses the Jacobian held by A and B for the nonlinear solver, see TSSetJacobianLag(). When only the shift has changed and the
+  mass matrix is the identity, A and a separate B are updated with MatShift().
+*/
+static PetscErrorCode TSLagJacobianReuse_Private(TS ts, PetscBool ijacobian, PetscReal shift, Mat A, Mat B, PetscBool *reuse)
+{
+  PetscObjectId    Aid;
+  PetscObjectState Astate;
+  PetscBool        mf;
+
+  PetscFunctionBegin;
+  *reuse = PETSC_FALSE;
+  PetscCall(PetscObjectGetId((PetscObject)A, &Aid));
+  PetscCall(PetscObjectStateGet((PetscObject)A, &Astate));
+  if (!ts->lagjacobian.valid || Aid != ts->lagjacobian.Aid || Astate != ts->lagjacobian.Astate) PetscFunctionReturn(0);
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, MATMFFD, &mf));
+  if (shift != ts->lagjacobian.shift) {
+    /* only the IJacobian knows how the implicit function depends on Udot */
+    if (ijacobian && ts->equation_type != TS_EQ_ODE_EXPLICIT) PetscFunctionReturn(0);
+    if (!mf) PetscCall(MatShift(A, shift - ts->lagjacobian.shift));
+    if (A != B) PetscCall(MatShift(B, shift - ts->lagjacobian.shift));
+    if (!ijacobian) {
+      Mat Arhs = NULL;
+
+      /* keep the shift of the RHS Jacobian consistent, it may be undone later */
+      PetscCall(TSGetRHSMats_Private(ts, &Arhs, NULL));
+      if (Arhs == A) ts->rhsjacobian.shift = shift;
+    }
+    ts->lagjacobian.shift = shift;
+    ts->lagjacobian.nshift++;
+  } else ts->lagjacobian.nreuse++;
+  if (mf) { /* the matrix-free Jacobian is linearized at the current state */
+    PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  }
+  PetscCall(PetscObjectStateGet((PetscObject)A, &ts->lagjacobian.Astate));
+  ts->lagjacobian.used = PETSC_TRUE;
+  *reuse               = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSLagJacobianBuilt_Private(TS ts, PetscReal shift, Mat A)
+{
+  PetscFunctionBegin;
+  ts->lagjacobian.valid = PETSC_TRUE;
+  ts->lagjacobian.shift = shift;
+  ts->lagjacobian.step  = ts->steps;
+  PetscCall(PetscObjectGetId((PetscObject)A, &ts->lagjacobian.Aid));
+  PetscCall(PetscObjectStateGet((PetscObject)A, &ts->lagjacobian.Astate));
+  ts->lagjacobian.nbuild++;
+  PetscFunctionReturn(0);
+}
+
 /*@
    TSComputeIJacobian - Evaluates the Jacobian of the DAE
 
@@ -872,6 +928,7 @@ PetscErrorCode TSComputeIJacobian(TS ts, PetscReal t, Vec U, Vec Udot, PetscReal
   TSRHSJacobian rhsjacobian;
   DM            dm;
   void         *ctx;
+  PetscBool     lag;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
@@ -888,6 +945,14 @@ PetscErrorCode TSComputeIJacobian(TS ts, PetscReal t, Vec U, Vec Udot, PetscReal
 
   PetscCheck(rhsjacobian || ijacobian, PetscObjectComm((PetscObject)ts), PETSC_ERR_USER, "Must call TSSetRHSJacobian() and / or TSSetIJacobian()");
 
+  lag = (PetscBool)(ts->lagjacobian.insnes && (ijacobian || !imex));
+  if (lag) {
+    PetscBool reuse;
+
+    PetscCall(TSLagJacobianReuse_Private(ts, ijacobian ? PETSC_TRUE : PETSC_FALSE, shift, A, B, &reuse));
+    if (reuse) PetscFunctionReturn(0);
+  }
+
   PetscCall(PetscLogEventBegin(TS_JacobianEval, ts, U, A, B));
   if (ijacobian) {
     PetscCallBack("TS callback implicit Jacobian", (*ijacobian)(ts, t, U, Udot, shift, A, B, ctx));
@@ -976,6 +1041,7 @@ PetscErrorCode TSComputeIJacobian(TS ts, PetscReal t, Vec U, Vec Udot, PetscReal
     }
   }
   PetscCall(PetscLogEventEnd(TS_JacobianEval, ts, U, A, B));
+  if (lag) PetscCall(TSLagJacobianBuilt_Private(ts, shift, A));
   PetscFunctionReturn(0);
 }
 
@@ -1384,6 +1450,111 @@ PetscErrorCode TSRHSJacobianSetReuse(TS ts, PetscBool reuse)
   PetscFunctionReturn(0);
 }
 
+/*@
+   TSSetJacobianLag - Reuse the Jacobian, and its preconditioner, of the nonlinear solves across Newton iterations, stages and steps
+   as long as Newton's method converges fast with it
+
+   Logically Collective
+
+   Input Parameters:
++  ts - `TS` context obtained from `TSCreate()`
+-  flg - `PETSC_TRUE` to reuse the Jacobian
+
+   Options Database Key:
+.  -ts_jacobian_lag <bool> - reuse the Jacobian
+
+   Level: intermediate
+
+   Notes:
+   The Jacobian is rebuilt when a Newton iteration contracts the residual by less than the rate given with `TSSetJacobianLagTolerances()`,
+   after the number of steps given there, and when a nonlinear solve fails with a reused Jacobian; the step is then retried with a new
+   Jacobian before its size is reduced.
+
+   When only the shift of the IJacobian changes, for instance with the time step, the Jacobian is updated with `MatShift()` instead
+   of being assembled again if the mass matrix is the identity: the problem is given by `TSSetRHSJacobian()` only, or its
+   `TSEquationType` is `TS_EQ_ODE_EXPLICIT`. A separate preconditioning matrix is shifted with it and its preconditioner rebuilt.
+   Otherwise a change of the shift rebuilds the Jacobian.
+
+   The numbers of Jacobians built and reused are shown by `TSView()`.
+
+.seealso: [](chapter_ts), `TS`, `TSSetJacobianLagTolerances()`, `TSGetJacobianLagCounts()`, `SNESSetLagJacobian()`, `TSSetEquationType()`
+@*/
+PetscErrorCode TSSetJacobianLag(TS ts, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(ts, flg, 2);
+  ts->lagjacobian.on    = flg;
+  ts->lagjacobian.valid = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   TSSetJacobianLagTolerances - Sets when a Jacobian reused with `TSSetJacobianLag()` is rebuilt
+
+   Logically Collective
+
+   Input Parameters:
++  ts - `TS` context obtained from `TSCreate()`
+.  rate - the Jacobian is rebuilt when a Newton iteration contracts the residual by less than this, or `PETSC_DEFAULT` (0.1)
+-  maxsteps - the Jacobian is rebuilt after this many steps, -1 for never, or `PETSC_DEFAULT` (20)
+
+   Options Database Keys:
++  -ts_jacobian_lag_rate <rate> - the rate
+-  -ts_jacobian_lag_max_steps <maxsteps> - the number of steps
+
+   Level: intermediate
+
+.seealso: [](chapter_ts), `TS`, `TSSetJacobianLag()`, `TSGetJacobianLagCounts()`
+@*/
+PetscErrorCode TSSetJacobianLagTolerances(TS ts, PetscReal rate, PetscInt maxsteps)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveReal(ts, rate, 2);
+  PetscValidLogicalCollectiveInt(ts, maxsteps, 3);
+  if (rate == (PetscReal)PETSC_DEFAULT) ts->lagjacobian.rate = 0.1;
+  else {
+    PetscCheck(rate > 0 && rate < 1, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Rate %g must be in (0, 1)", (double)rate);
+    ts->lagjacobian.rate = rate;
+  }
+  if (maxsteps == PETSC_DEFAULT) ts->lagjacobian.maxsteps = 20;
+  else {
+    PetscCheck(maxsteps >= -1, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Number of steps %" PetscInt_FMT " must be nonnegative or -1", maxsteps);
+    ts->lagjacobian.maxsteps = maxsteps;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+   TSGetJacobianLagCounts - Gets how many Jacobians of the nonlinear solves were built and reused with `TSSetJacobianLag()`
+
+   Not Collective
+
+   Input Parameter:
+.  ts - `TS` context obtained from `TSCreate()`
+
+   Output Parameters:
++  nbuild - the number of Jacobians built
+.  nreuse - the number of times a Jacobian was reused as is
+.  nshift - the number of times a Jacobian was reused with a new shift
+-  nretry - the number of nonlinear solves that failed with a reused Jacobian and were retried with a new one
+
+   Level: intermediate
+
+.seealso: [](chapter_ts), `TS`, `TSSetJacobianLag()`, `TSSetJacobianLagTolerances()`
+@*/
+PetscErrorCode TSGetJacobianLagCounts(TS ts, PetscInt *nbuild, PetscInt *nreuse, PetscInt *nshift, PetscInt *nretry)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  if (nbuild) *nbuild = ts->lagjacobian.nbuild;
+  if (nreuse) *nreuse = ts->lagjacobian.nreuse;
+  if (nshift) *nshift = ts->lagjacobian.nshift;
+  if (nretry) *nretry = ts->lagjacobian.nretry;
+  PetscFunctionReturn(0);
+}
+
 /*@C
    TSSetI2Function - Set the function to compute F(t,U,U_t,U_tt) where F = 0 is the DAE to be solved.
 
@@ -1978,6 +2149,12 @@ PetscErrorCode TSView(TS ts, PetscViewer viewer)
       PetscCall(PetscViewerASCIIPrintf(viewer, "  total number of linear solver iterations=%" PetscInt_FMT "\n", ts->ksp_its));
       PetscCall(PetscObjectTypeCompareAny((PetscObject)ts->snes, &lin, SNESKSPONLY, SNESKSPTRANSPOSEONLY, ""));
       PetscCall(PetscViewerASCIIPrintf(viewer, "  total number of %slinear solve failures=%" PetscInt_FMT "\n", lin ? "" : "non", ts->num_snes_failures));
+      if (ts->lagjacobian.on) {
+        if (ts->lagjacobian.maxsteps >= 0) PetscCall(PetscViewerASCIIPrintf(viewer, "  Jacobian reused while Newton's method contracts the residual by %g, for at most %" PetscInt_FMT " steps\n", (double)ts->lagjacobian.rate, ts->lagjacobian.maxsteps));
+        else PetscCall(PetscViewerASCIIPrintf(viewer, "  Jacobian reused while Newton's method contracts the residual by %g\n", (double)ts->lagjacobian.rate));
+        PetscCall(PetscViewerASCIIPrintf(viewer, "  total number of Jacobians built=%" PetscInt_FMT ", reused=%" PetscInt_FMT ", reused with a new shift=%" PetscInt_FMT "\n", ts->lagjacobian.nbuild, ts->lagjacobian.nreuse, ts->lagjacobian.nshift));
+        PetscCall(PetscViewerASCIIPrintf(viewer, "  total number of nonlinear solves retried with a new Jacobian=%" PetscInt_FMT "\n", ts->lagjacobian.nretry));
+      }
     }
     PetscCall(PetscViewerASCIIPrintf(viewer, "  total number of rejected steps=%" PetscInt_FMT "\n", ts->reject));
     if (ts->vrtol) PetscCall(PetscViewerASCIIPrintf(viewer, "  using vector of relative error tolerances, "));
@@ -2624,6 +2801,7 @@ PetscErrorCode TSReset(TS ts)
   PetscCall(MatDestroy(&ts->Arhs));
   PetscCall(MatDestroy(&ts->Brhs));
   PetscCall(VecDestroy(&ts->Frhs));
+  ts->lagjacobian.valid = PETSC_FALSE;
   PetscCall(VecDestroy(&ts->vec_sol));
   PetscCall(VecDestroy(&ts->vec_dot));
   PetscCall(VecDestroy(&ts->vatol));
@@ -4233,7 +4411,20 @@ PetscErrorCode SNESTSFormJacobian(SNES snes, Vec U, Mat A, Mat B, void *ctx)
   PetscValidPointer(B, 4);
   PetscValidHeaderSpecific(B, MAT_CLASSID, 4);
   PetscValidHeaderSpecific(ts, TS_CLASSID, 5);
+  if (ts->lagjacobian.on) {
+    PetscInt  it;
+    PetscReal fnorm;
+
+    PetscCall(SNESGetIterationNumber(snes, &it));
+    PetscCall(SNESGetFunctionNorm(snes, &fnorm));
+    if (!it) ts->lagjacobian.used = PETSC_FALSE;
+    else if (fnorm > ts->lagjacobian.rate * ts->lagjacobian.fnorm) ts->lagjacobian.valid = PETSC_FALSE;
+    if (ts->lagjacobian.maxsteps >= 0 && ts->steps - ts->lagjacobian.step >= ts->lagjacobian.maxsteps) ts->lagjacobian.valid = PETSC_FALSE;
+    ts->lagjacobian.fnorm  = fnorm;
+    ts->lagjacobian.insnes = PETSC_TRUE;
+  }
   PetscCall((ts->ops->snesjacobian)(snes, U, A, B, ts));
+  ts->lagjacobian.insnes = PETSC_FALSE;
   PetscFunctionReturn(0);
 }
 
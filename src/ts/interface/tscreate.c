@@ -57,6 +57,9 @@ PetscErrorCode TSCreate(MPI_Comm comm, TS *ts)
   t->rhsjacobian.scale = 1.0;
   t->ijacobian.shift   = 1.0;
 
+  t->lagjacobian.rate     = 0.1;
+  t->lagjacobian.maxsteps = 20;
+
   /* All methods that do adaptivity should specify
    * its preferred adapt type in their constructor */
   t->default_adapt_type = TSADAPTNONE;
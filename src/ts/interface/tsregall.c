@@ -22,6 +22,9 @@ PETSC_EXTERN PetscErrorCode TSCreate_BasicSymplectic(TS);
 PETSC_EXTERN PetscErrorCode TSCreate_MPRK(TS);
 PETSC_EXTERN PetscErrorCode TSCreate_DiscGrad(TS);
 PETSC_EXTERN PetscErrorCode TSCreate_IRK(TS);
+PETSC_EXTERN PetscErrorCode TSCreate_Batch(TS);
+PETSC_EXTERN PetscErrorCode TSCreate_LTS(TS);
+PETSC_EXTERN PetscErrorCode TSCreate_Parareal(TS);
 
 /*@C
   TSRegisterAll - Registers all of the timesteppers in the `TS` package.
@@ -67,5 +70,8 @@ PetscErrorCode TSRegisterAll(void)
   PetscCall(TSRegister(TSMPRK, TSCreate_MPRK));
   PetscCall(TSRegister(TSDISCGRAD, TSCreate_DiscGrad));
   PetscCall(TSRegister(TSIRK, TSCreate_IRK));
+  PetscCall(TSRegister(TSBATCH, TSCreate_Batch));
+  PetscCall(TSRegister(TSLTS, TSCreate_LTS));
+  PetscCall(TSRegister(TSPARAREAL, TSCreate_Parareal));
   PetscFunctionReturn(0);
 }
@@ -1,5 +1,7 @@
 #include <petsc/private/tsimpl.h> /*I "petscts.h"  I*/
 #include <petscsys.h>
+#include <petscdevice.h>
+#include <errno.h>
 #if defined(PETSC_HAVE_REVOLVE)
   #include <revolve_c.h>
 
@@ -51,13 +53,28 @@ typedef enum {
 } TSTrajectoryMemoryType;
 static const char *const TSTrajectoryMemoryTypes[] = {"REVOLVE", "CAMS", "PETSC", "TSTrajectoryMemoryType", "TJ_", NULL};
 
+typedef enum {
+  TJ_COMPRESSION_NONE,
+  TJ_COMPRESSION_LOSSLESS,
+  TJ_COMPRESSION_LOSSY
+} TSTrajectoryMemoryCompression;
+static const char *const TSTrajectoryMemoryCompressions[] = {"NONE", "LOSSLESS", "LOSSY", "TSTrajectoryMemoryCompression", "TJ_COMPRESSION_", NULL};
+
 #define HaveSolution(m) ((m) == SOLUTIONONLY || (m) == SOLUTION_STAGES)
 #define HaveStages(m)   ((m) == STAGESONLY || (m) == SOLUTION_STAGES)
 
+/* the local entries of a vector, compressed */
+typedef struct {
+  size_t         size; /* in bytes */
+  unsigned char *data;
+} CompressedVec;
+
 typedef struct _StackElement {
   PetscInt       stepnum;
   Vec            X;
   Vec           *Y;
+  CompressedVec  cX; /* replace X and Y with compression */
+  CompressedVec *cY;
   PetscReal      time;
   PetscReal      timeprev; /* for no solution_only mode */
   PetscReal      timenext; /* for solution_only mode */
@@ -99,6 +116,13 @@ typedef struct _Stack {
   PetscInt      numY;
   PetscBool     solution_only;
   PetscBool     use_dram;
+
+  TSTrajectoryMemoryCompression compression;
+  PetscReal                     compression_tol; /* bound on the error of each entry with lossy compression */
+  unsigned char                *buffer;          /* room for a compressed vector */
+  size_t                        buffersize;
+  Vec                           workX, *workY;      /* the decompressed vectors written to disk */
+  PetscLogDouble                nbytes, ncompressed; /* sizes of the vectors compressed so far */
 } Stack;
 
 typedef struct _DiskStack {
@@ -107,6 +131,28 @@ typedef struct _DiskStack {
   PetscInt *container;
 } DiskStack;
 
+/* a transfer between a buffer and a file of this rank, run on the thread of a host device context */
+typedef struct {
+  char           filename[PETSC_MAX_PATH_LEN];
+  unsigned char *data;
+  size_t         size;
+  PetscBool      write;
+  PetscBool      inuse;
+  int            err; /* errno of a failed transfer */
+} AsyncIO;
+
+#define TJ_ASYNC_MAX_JOBS 3
+
+typedef struct _AsyncDisk {
+  PetscDevice        device;
+  PetscDeviceContext dctx;
+  AsyncIO            jobs[TJ_ASYNC_MAX_JOBS]; /* at most two writes behind and one prefetch */
+  size_t            *sizes[2];                /* of the files written, by kind (stack or single point) and id */
+  PetscInt           nsizes[2];
+  PetscInt           lastkind, lastid; /* the last file written, the first one read by the adjoint sweep */
+  PetscBool          reverse;
+} AsyncDisk;
+
 typedef struct _TJScheduler {
   SchedulerType          stype;
   TSTrajectoryMemoryType tj_memory_type;
@@ -130,6 +176,8 @@ typedef struct _TJScheduler {
   Stack       stack;
   DiskStack   diskstack;
   PetscViewer viewer;
+  PetscBool   async; /* write behind and prefetch the checkpoints on disk */
+  AsyncDisk   io;
 } TJScheduler;
 
 static PetscErrorCode TurnForwardWithStepsize(TS ts, PetscReal nextstepsize)
@@ -163,12 +211,298 @@ static PetscErrorCode TurnBackward(TS ts)
   PetscFunctionReturn(0);
 }
 
+/*
+   Compression of the checkpoints. The first byte of a compressed vector is the method, the second one the stride s,
+   the block size of the vector, so that the entries are predicted by the same field at the previous point:
+
+   XOR   - lossless, each entry is XORed with the entry s before it and only the bytes below the leading zero bytes of
+           the result are kept, with their number in a 4-bit header; the neighboring values of smooth fields share their
+           sign, exponent and leading bits of mantissa
+   QUANT - lossy, each entry is rounded to the nearest multiple of twice the tolerance, so that the error is at most
+           the tolerance (up to roundoff), and the differences with the multiple s entries before are stored as
+           variable length integers
+   RAW   - the entries as they are, when none of the above is smaller
+*/
+#define TJ_COMPRESS_RAW   0
+#define TJ_COMPRESS_XOR   1
+#define TJ_COMPRESS_QUANT 2
+
+#if defined(PETSC_USE_REAL_SINGLE) || defined(PETSC_USE_REAL_DOUBLE)
+static inline uint64_t RealBits(PetscReal v)
+{
+  #if defined(PETSC_USE_REAL_SINGLE)
+  uint32_t b;
+  #else
+  uint64_t b;
+  #endif
+
+  memcpy(&b, &v, sizeof(b));
+  return (uint64_t)b;
+}
+
+static inline PetscReal BitsReal(uint64_t bits)
+{
+  #if defined(PETSC_USE_REAL_SINGLE)
+  uint32_t b = (uint32_t)bits;
+  #else
+  uint64_t b = bits;
+  #endif
+  PetscReal v;
+
+  memcpy(&v, &b, sizeof(b));
+  return v;
+}
+#endif
+
+/* exact for the multiples of step too, as long as they are below 2^52 */
+static inline int64_t Quantize(PetscReal v, PetscReal step)
+{
+  return (int64_t)PetscFloorReal(v / step + (PetscReal)0.5);
+}
+
+/* the size of the buffer that can hold any compressed vector of m PetscReal */
+static inline size_t CompressBound(PetscInt m)
+{
+  return 2 + sizeof(PetscReal) + (size_t)m * PetscMax(sizeof(PetscReal) + 1, 10);
+}
+
+static size_t EncodeRaw(PetscInt m, const PetscReal *v, unsigned char *out)
+{
+  out[0] = TJ_COMPRESS_RAW;
+  out[1] = 1;
+  memcpy(out + 2, v, m * sizeof(PetscReal));
+  return 2 + m * sizeof(PetscReal);
+}
+
+static size_t EncodeXOR(PetscInt m, PetscInt s, const PetscReal *v, unsigned char *out)
+{
+#if defined(PETSC_USE_REAL_SINGLE) || defined(PETSC_USE_REAL_DOUBLE)
+  unsigned char *header = NULL;
+  size_t         pos    = 2;
+
+  out[0] = TJ_COMPRESS_XOR;
+  out[1] = (unsigned char)s;
+  for (PetscInt i = 0; i < m; i++) {
+    const uint64_t x  = RealBits(v[i]) ^ (i < s ? 0 : RealBits(v[i - s]));
+    unsigned char  nb = 0;
+
+    while (nb < sizeof(PetscReal) && (x >> (8 * nb))) nb++;
+    if (i % 2) *header |= (unsigned char)(nb << 4);
+    else {
+      header  = out + pos++;
+      *header = nb;
+    }
+    for (unsigned char k = 0; k < nb; k++) out[pos++] = (unsigned char)(x >> (8 * k));
+  }
+  return pos;
+#else
+  return EncodeRaw(m, v, out);
+#endif
+}
+
+/* 0 if an entry is too large for the tolerance */
+static size_t EncodeQuant(PetscInt m, PetscInt s, const PetscReal *v, PetscReal tol, unsigned char *out)
+{
+  const PetscReal step = 2 * tol;
+  size_t          pos  = 2 + sizeof(PetscReal);
+
+  out[0] = TJ_COMPRESS_QUANT;
+  out[1] = (unsigned char)s;
+  memcpy(out + 2, &step, sizeof(PetscReal));
+  for (PetscInt i = 0; i < m; i++) {
+    int64_t  d;
+    uint64_t z;
+
+    /* also catches Inf and NaN */
+    if (!(PetscAbsReal(v[i] / step) < (PetscReal)4.0e15)) return 0;
+    d = Quantize(v[i], step) - (i < s ? 0 : Quantize(v[i - s], step));
+    z = ((uint64_t)d << 1) ^ (uint64_t)(d >> 63);
+    do {
+      out[pos++] = (unsigned char)((z & 0x7f) | (z > 0x7f ? 0x80 : 0));
+      z >>= 7;
+    } while (z);
+  }
+  return pos;
+}
+
+static PetscErrorCode Decode(const unsigned char *in, size_t size, PetscInt m, PetscReal *v)
+{
+  const PetscInt s   = in[1];
+  size_t         pos = 2;
+
+  PetscFunctionBegin;
+  switch (in[0]) {
+  case TJ_COMPRESS_RAW:
+    PetscCall(PetscMemcpy(v, in + 2, m * sizeof(PetscReal)));
+    pos += m * sizeof(PetscReal);
+    break;
+#if defined(PETSC_USE_REAL_SINGLE) || defined(PETSC_USE_REAL_DOUBLE)
+  case TJ_COMPRESS_XOR: {
+    unsigned char header = 0;
+
+    for (PetscInt i = 0; i < m; i++) {
+      unsigned char nb;
+      uint64_t      x = 0;
+
+      if (i % 2) nb = header >> 4;
+      else {
+        header = in[pos++];
+        nb     = header & 0xf;
+      }
+      for (unsigned char k = 0; k < nb; k++) x |= (uint64_t)in[pos++] << (8 * k);
+      v[i] = BitsReal(x ^ (i < s ? 0 : RealBits(v[i - s])));
+    }
+  } break;
+#endif
+  case TJ_COMPRESS_QUANT: {
+    PetscReal step;
+
+    PetscCall(PetscMemcpy(&step, in + 2, sizeof(PetscReal)));
+    pos += sizeof(PetscReal);
+    for (PetscInt i = 0; i < m; i++) {
+      uint64_t z     = 0;
+      int      shift = 0;
+
+      do {
+        z |= (uint64_t)(in[pos] & 0x7f) << shift;
+        shift += 7;
+      } while (in[pos++] & 0x80);
+      v[i] = (PetscReal)(((int64_t)(z >> 1) ^ -(int64_t)(z & 1)) + (i < s ? 0 : Quantize(v[i - s], step))) * step;
+    }
+  } break;
+  default:
+    SETERRQ(PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Unknown compression method %d of checkpoint", (int)in[0]);
+  }
+  PetscCheck(pos == size, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Decoded %zu bytes of a compressed checkpoint of %zu bytes", pos, size);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CompressVec(Stack *stack, Vec X, CompressedVec *c)
+{
+  const PetscScalar *x;
+  PetscInt           n, m, bs;
+  size_t             size = 0;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(VecGetBlockSize(X, &bs));
+  m  = n * (PetscInt)(sizeof(PetscScalar) / sizeof(PetscReal));
+  bs = bs * (PetscInt)(sizeof(PetscScalar) / sizeof(PetscReal));
+  if (bs > 255) bs = 1;
+  if (stack->buffersize < CompressBound(m)) {
+    PetscCall(PetscFree(stack->buffer));
+    stack->buffersize = CompressBound(m);
+    PetscCall(PetscMalloc1(stack->buffersize, &stack->buffer));
+  }
+  PetscCall(VecGetArrayRead(X, &x));
+  if (stack->compression == TJ_COMPRESSION_LOSSY) size = EncodeQuant(m, bs, (const PetscReal *)x, stack->compression_tol, stack->buffer);
+  if (!size) size = EncodeXOR(m, bs, (const PetscReal *)x, stack->buffer);
+  if (size > 2 + m * sizeof(PetscReal)) size = EncodeRaw(m, (const PetscReal *)x, stack->buffer);
+  PetscCall(VecRestoreArrayRead(X, &x));
+  if (c->size != size) {
+    if (stack->use_dram) PetscCall(PetscMallocSetDRAM());
+    PetscCall(PetscFree(c->data));
+    PetscCall(PetscMalloc1(size, &c->data));
+    if (stack->use_dram) PetscCall(PetscMallocResetDRAM());
+    c->size = size;
+  }
+  PetscCall(PetscMemcpy(c->data, stack->buffer, size));
+  stack->nbytes += m * sizeof(PetscReal);
+  stack->ncompressed += size;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DecompressVec(const CompressedVec *c, Vec X)
+{
+  PetscScalar *x;
+  PetscInt     n;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(VecGetArrayWrite(X, &x));
+  PetscCall(Decode(c->data, c->size, n * (PetscInt)(sizeof(PetscScalar) / sizeof(PetscReal)), (PetscReal *)x));
+  PetscCall(VecRestoreArrayWrite(X, &x));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CompressedVecDestroy(Stack *stack, CompressedVec *c)
+{
+  PetscFunctionBegin;
+  if (stack->use_dram) PetscCall(PetscMallocSetDRAM());
+  PetscCall(PetscFree(c->data));
+  if (stack->use_dram) PetscCall(PetscMallocResetDRAM());
+  c->size = 0;
+  PetscFunctionReturn(0);
+}
+
+/* copy the solution and the stages into an element, compressing them if asked for */
+static PetscErrorCode ElementStore(Stack *stack, StackElement e, Vec X, Vec *Y)
+{
+  PetscFunctionBegin;
+  if (HaveSolution(e->cptype)) {
+    if (stack->compression) PetscCall(CompressVec(stack, X, &e->cX));
+    else PetscCall(VecCopy(X, e->X));
+  }
+  if (HaveStages(e->cptype)) {
+    for (PetscInt i = 0; i < stack->numY; i++) {
+      if (stack->compression) PetscCall(CompressVec(stack, Y[i], &e->cY[i]));
+      else PetscCall(VecCopy(Y[i], e->Y[i]));
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* the vectors of an element, decompressed into work vectors with compression */
+static PetscErrorCode ElementGetVecs(TS ts, Stack *stack, StackElement e, Vec *X, Vec **Y)
+{
+  Vec *Yts;
+
+  PetscFunctionBegin;
+  if (!stack->compression) {
+    *X = e->X;
+    *Y = e->Y;
+    PetscFunctionReturn(0);
+  }
+  if (!stack->workX) PetscCall(VecDuplicate(ts->vec_sol, &stack->workX));
+  PetscCall(TSGetStages(ts, &stack->numY, &Yts));
+  if (!stack->workY && stack->numY) PetscCall(VecDuplicateVecs(Yts[0], stack->numY, &stack->workY));
+  if (HaveSolution(e->cptype) && e->cX.data) PetscCall(DecompressVec(&e->cX, stack->workX));
+  if (HaveStages(e->cptype)) {
+    for (PetscInt i = 0; i < stack->numY; i++) {
+      if (e->cY[i].data) PetscCall(DecompressVec(&e->cY[i], stack->workY[i]));
+    }
+  }
+  *X = stack->workX;
+  *Y = stack->workY;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode ElementCreate(TS ts, CheckpointType cptype, Stack *stack, StackElement *e)
 {
   Vec  X;
   Vec *Y;
 
   PetscFunctionBegin;
+  if (stack->compression) {
+    /* the compressed vectors are allocated when stored */
+    if (stack->top < stack->stacksize - 1 && stack->container[stack->top + 1]) {
+      *e = stack->container[stack->top + 1];
+      if (cptype == STAGESONLY) PetscCall(CompressedVecDestroy(stack, &(*e)->cX));
+      if (cptype == SOLUTIONONLY && (*e)->cY) {
+        for (PetscInt i = 0; i < stack->numY; i++) PetscCall(CompressedVecDestroy(stack, &(*e)->cY[i]));
+        PetscCall(PetscFree((*e)->cY));
+      }
+    } else {
+      PetscCall(PetscNew(e));
+      stack->nallocated++;
+    }
+    if (HaveStages(cptype) && !(*e)->cY) {
+      PetscCall(TSGetStages(ts, &stack->numY, NULL));
+      PetscCall(PetscCalloc1(stack->numY, &(*e)->cY));
+    }
+    (*e)->cptype = cptype;
+    PetscFunctionReturn(0);
+  }
   if (stack->top < stack->stacksize - 1 && stack->container[stack->top + 1]) {
     *e = stack->container[stack->top + 1];
     if (HaveSolution(cptype) && !(*e)->X) {
@@ -203,15 +537,11 @@ static PetscErrorCode ElementCreate(TS ts, CheckpointType cptype, Stack *stack,
 static PetscErrorCode ElementSet(TS ts, Stack *stack, StackElement *e, PetscInt stepnum, PetscReal time, Vec X)
 {
   Vec      *Y;
-  PetscInt  i;
   PetscReal timeprev;
 
   PetscFunctionBegin;
-  if (HaveSolution((*e)->cptype)) PetscCall(VecCopy(X, (*e)->X));
-  if (HaveStages((*e)->cptype)) {
-    PetscCall(TSGetStages(ts, &stack->numY, &Y));
-    for (i = 0; i < stack->numY; i++) PetscCall(VecCopy(Y[i], (*e)->Y[i]));
-  }
+  PetscCall(TSGetStages(ts, &stack->numY, &Y));
+  PetscCall(ElementStore(stack, *e, X, Y));
   (*e)->stepnum = stepnum;
   (*e)->time    = time;
   /* for consistency */
@@ -230,6 +560,11 @@ static PetscErrorCode ElementDestroy(Stack *stack, StackElement e)
   if (stack->use_dram) PetscCall(PetscMallocSetDRAM());
   PetscCall(VecDestroy(&e->X));
   if (e->Y) PetscCall(VecDestroyVecs(stack->numY, &e->Y));
+  PetscCall(PetscFree(e->cX.data));
+  if (e->cY) {
+    for (PetscInt i = 0; i < stack->numY; i++) PetscCall(PetscFree(e->cY[i].data));
+    PetscCall(PetscFree(e->cY));
+  }
   PetscCall(PetscFree(e));
   if (stack->use_dram) PetscCall(PetscMallocResetDRAM());
   stack->nallocated--;
@@ -293,6 +628,13 @@ static PetscErrorCode StackDestroy(Stack *stack)
   PetscCheck(stack->top + 1 <= n, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Stack size does not match element counter %" PetscInt_FMT, n);
   for (PetscInt i = 0; i < n; i++) PetscCall(ElementDestroy(stack, stack->container[i]));
   PetscCall(PetscFree(stack->container));
+  if (stack->ncompressed > 0) PetscCall(PetscInfo(NULL, "Compressed %g MB of checkpoints into %g MB, ratio %g\n", stack->nbytes / 1048576, stack->ncompressed / 1048576, stack->nbytes / stack->ncompressed));
+  PetscCall(PetscFree(stack->buffer));
+  stack->buffersize  = 0;
+  stack->nbytes      = 0;
+  stack->ncompressed = 0;
+  PetscCall(VecDestroy(&stack->workX));
+  if (stack->workY) PetscCall(VecDestroyVecs(stack->numY, &stack->workY));
   PetscFunctionReturn(0);
 }
 
@@ -339,6 +681,402 @@ static PetscErrorCode ReadFromDisk(PetscBool stifflyaccurate, PetscInt *stepnum,
   PetscFunctionReturn(0);
 }
 
+/*
+   Asynchronous disk traffic. The checkpoints of a stack (or a single point) are copied into a buffer of the local
+   entries, in the order of WriteToDisk(), and the buffer is written to a file of each rank by a function launched on a
+   host device context, so the forward sweep goes on while the data is written. During the adjoint sweep the file
+   needed next, the one with the previous id, is read in the same way while the current one is used.
+   The functions launched only do file I/O, MPI and PETSc are only called on the main thread.
+*/
+#define TJ_ASYNC_STACK  0
+#define TJ_ASYNC_SINGLE 1
+
+static PetscErrorCode AsyncIOKernel(void *ctx)
+{
+  AsyncIO *job = (AsyncIO *)ctx;
+  FILE    *fp;
+
+  errno    = 0;
+  job->err = 0;
+  fp       = fopen(job->filename, job->write ? "wb" : "rb");
+  if (!fp) job->err = errno ? errno : EIO;
+  else {
+    if ((job->write ? fwrite(job->data, 1, job->size, fp) : fread(job->data, 1, job->size, fp)) != job->size) job->err = errno ? errno : EIO;
+    if (fclose(fp) && !job->err) job->err = errno ? errno : EIO;
+  }
+  return 0;
+}
+
+static PetscErrorCode AsyncFileName(TSTrajectory tj, PetscInt kind, PetscInt id, char filename[])
+{
+  PetscMPIInt rank;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)tj), &rank));
+  PetscCall(PetscSNPrintf(filename, PETSC_MAX_PATH_LEN, "%s/%s%06" PetscInt_FMT "-%d.bin", tj->dirname, kind == TJ_ASYNC_STACK ? "TS-STACK" : "TS-CPS", id, rank));
+  PetscFunctionReturn(0);
+}
+
+/* waits for all the transfers, the writes are then done and the data read is kept until taken */
+static PetscErrorCode AsyncWait(AsyncDisk *io)
+{
+  PetscBool pending = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < TJ_ASYNC_MAX_JOBS; i++) pending = (PetscBool)(pending || io->jobs[i].inuse);
+  if (!pending) PetscFunctionReturn(0);
+  PetscCall(PetscDeviceContextSynchronize(io->dctx));
+  for (PetscInt i = 0; i < TJ_ASYNC_MAX_JOBS; i++) {
+    AsyncIO *job = &io->jobs[i];
+
+    if (!job->inuse) continue;
+    if (job->err) {
+      const int err = job->err;
+
+      job->err = 0;
+      SETERRQ(PETSC_COMM_SELF, job->write ? PETSC_ERR_FILE_WRITE : PETSC_ERR_FILE_READ, "Unable to %s checkpoint file %s: %s", job->write ? "write" : "read", job->filename, strerror(err));
+    }
+    if (job->write) {
+      PetscCall(PetscFree(job->data));
+      job->inuse = PETSC_FALSE;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode AsyncPost(AsyncDisk *io, const char filename[], unsigned char *data, size_t size, PetscBool write)
+{
+  AsyncIO *job = NULL;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < TJ_ASYNC_MAX_JOBS; i++) {
+    PetscBool same;
+
+    if (!io->jobs[i].inuse) continue;
+    PetscCall(PetscStrcmp(io->jobs[i].filename, filename, &same));
+    /* a file written again makes the data read before stale */
+    if (same && write && !io->jobs[i].write) {
+      PetscCall(AsyncWait(io));
+      PetscCall(PetscFree(io->jobs[i].data));
+      io->jobs[i].inuse = PETSC_FALSE;
+    }
+  }
+  for (PetscInt k = 0; k < 2 && !job; k++) {
+    for (PetscInt i = 0; i < TJ_ASYNC_MAX_JOBS && !job; i++) {
+      if (!io->jobs[i].inuse) job = &io->jobs[i];
+    }
+    if (!job) PetscCall(AsyncWait(io)); /* the writes behind are too slow */
+  }
+  /* the transfers are done, a prefetch never taken (the adjoint sweep stopped or went elsewhere) gives its room */
+  for (PetscInt i = 0; i < TJ_ASYNC_MAX_JOBS && !job; i++) {
+    if (io->jobs[i].write) continue;
+    PetscCall(PetscFree(io->jobs[i].data));
+    io->jobs[i].inuse = PETSC_FALSE;
+    job               = &io->jobs[i];
+  }
+  PetscCheck(job, PETSC_COMM_SELF, PETSC_ERR_PLIB, "No room for another transfer of checkpoints");
+  PetscCall(PetscStrncpy(job->filename, filename, sizeof(job->filename)));
+  job->data  = data;
+  job->size  = size;
+  job->write = write;
+  job->inuse = PETSC_TRUE;
+  PetscCall(PetscDeviceContextLaunchHost(io->dctx, AsyncIOKernel, job));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode AsyncWrite(TSTrajectory tj, PetscInt kind, PetscInt id, unsigned char *data, size_t size)
+{
+  AsyncDisk *io = &((TJScheduler *)tj->data)->io;
+  char       filename[PETSC_MAX_PATH_LEN];
+
+  PetscFunctionBegin;
+  if (id >= io->nsizes[kind]) {
+    const PetscInt n = PetscMax(2 * io->nsizes[kind], id + 1);
+
+    PetscCall(PetscRealloc(n * sizeof(size_t), &io->sizes[kind]));
+    for (PetscInt i = io->nsizes[kind]; i < n; i++) io->sizes[kind][i] = 0;
+    io->nsizes[kind] = n;
+  }
+  io->sizes[kind][id] = size;
+  io->lastkind        = kind;
+  io->lastid          = id;
+  PetscCall(AsyncFileName(tj, kind, id, filename));
+  PetscCall(AsyncPost(io, filename, data, size, PETSC_TRUE));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode AsyncPrefetch(TSTrajectory tj, PetscInt kind, PetscInt id)
+{
+  AsyncDisk     *io = &((TJScheduler *)tj->data)->io;
+  char           filename[PETSC_MAX_PATH_LEN];
+  unsigned char *data;
+
+  PetscFunctionBegin;
+  if (id < 0 || id >= io->nsizes[kind] || !io->sizes[kind][id]) PetscFunctionReturn(0);
+  PetscCall(AsyncFileName(tj, kind, id, filename));
+  for (PetscInt i = 0; i < TJ_ASYNC_MAX_JOBS; i++) {
+    PetscBool same;
+
+    PetscCall(PetscStrcmp(io->jobs[i].filename, filename, &same));
+    if (io->jobs[i].inuse && !io->jobs[i].write && same) PetscFunctionReturn(0);
+  }
+  PetscCall(PetscInfo(tj, "Prefetching checkpoint file %s\n", filename));
+  PetscCall(PetscMalloc1(io->sizes[kind][id], &data));
+  PetscCall(AsyncPost(io, filename, data, io->sizes[kind][id], PETSC_FALSE));
+  PetscFunctionReturn(0);
+}
+
+/* the content of a file, prefetched or read now, the caller frees it */
+static PetscErrorCode AsyncRead(TSTrajectory tj, PetscInt kind, PetscInt id, unsigned char **data)
+{
+  AsyncDisk *io = &((TJScheduler *)tj->data)->io;
+  char       filename[PETSC_MAX_PATH_LEN];
+
+  PetscFunctionBegin;
+  PetscCheck(id >= 0 && id < io->nsizes[kind] && io->sizes[kind][id], PETSC_COMM_SELF, PETSC_ERR_PLIB, "Checkpoint file %" PetscInt_FMT " was not written", id);
+  PetscCall(AsyncFileName(tj, kind, id, filename));
+  PetscCall(AsyncWait(io));
+  for (PetscInt i = 0; i < TJ_ASYNC_MAX_JOBS; i++) {
+    AsyncIO  *job = &io->jobs[i];
+    PetscBool same;
+
+    PetscCall(PetscStrcmp(job->filename, filename, &same));
+    if (job->inuse && !job->write && same) {
+      *data      = job->data;
+      job->data  = NULL;
+      job->inuse = PETSC_FALSE;
+      PetscFunctionReturn(0);
+    }
+  }
+  /* not prefetched */
+  PetscCall(PetscInfo(tj, "Reading checkpoint file %s that was not prefetched\n", filename));
+  {
+    AsyncIO job;
+
+    PetscCall(PetscStrncpy(job.filename, filename, sizeof(job.filename)));
+    PetscCall(PetscMalloc1(io->sizes[kind][id], &job.data));
+    job.size  = io->sizes[kind][id];
+    job.write = PETSC_FALSE;
+    PetscCall(AsyncIOKernel(&job));
+    PetscCheck(!job.err, PETSC_COMM_SELF, PETSC_ERR_FILE_READ, "Unable to read checkpoint file %s: %s", filename, strerror(job.err));
+    *data = job.data;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode AsyncReset(AsyncDisk *io)
+{
+  PetscFunctionBegin;
+  PetscCall(AsyncWait(io));
+  for (PetscInt i = 0; i < TJ_ASYNC_MAX_JOBS; i++) {
+    PetscCall(PetscFree(io->jobs[i].data));
+    io->jobs[i].inuse = PETSC_FALSE;
+  }
+  for (PetscInt k = 0; k < 2; k++) {
+    PetscCall(PetscFree(io->sizes[k]));
+    io->nsizes[k] = 0;
+  }
+  io->reverse = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/* the number of local entries in a checkpoint written by WriteToDisk() */
+static size_t RecordSize(PetscBool stifflyaccurate, PetscInt n, PetscInt numY, CheckpointType cptype)
+{
+  PetscInt nv = HaveSolution(cptype) ? 1 : 0;
+
+  if (HaveStages(cptype)) nv += (stifflyaccurate && HaveSolution(cptype)) ? numY - 1 : numY;
+  return 2 * sizeof(PetscInt) + 2 * sizeof(PetscReal) + (size_t)nv * n * sizeof(PetscScalar);
+}
+
+static PetscErrorCode VecToBuffer(Vec X, unsigned char **p)
+{
+  const PetscScalar *x;
+  PetscInt           n;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(VecGetArrayRead(X, &x));
+  PetscCall(PetscMemcpy(*p, x, n * sizeof(PetscScalar)));
+  PetscCall(VecRestoreArrayRead(X, &x));
+  *p += n * sizeof(PetscScalar);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode BufferToVec(const unsigned char **p, Vec X)
+{
+  PetscScalar *x;
+  PetscInt     n;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(VecGetArrayWrite(X, &x));
+  PetscCall(PetscMemcpy(x, *p, n * sizeof(PetscScalar)));
+  PetscCall(VecRestoreArrayWrite(X, &x));
+  *p += n * sizeof(PetscScalar);
+  PetscFunctionReturn(0);
+}
+
+/* same as WriteToDisk() with the local entries, and the type of the checkpoint */
+static PetscErrorCode WriteToBuffer(PetscBool stifflyaccurate, PetscInt stepnum, PetscReal time, PetscReal timeprev, Vec X, Vec *Y, PetscInt numY, CheckpointType cptype, unsigned char **p)
+{
+  const PetscInt cptype_int = (PetscInt)cptype;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMemcpy(*p, &cptype_int, sizeof(PetscInt)));
+  PetscCall(PetscMemcpy(*p + sizeof(PetscInt), &stepnum, sizeof(PetscInt)));
+  *p += 2 * sizeof(PetscInt);
+  if (HaveSolution(cptype)) PetscCall(VecToBuffer(X, p));
+  if (HaveStages(cptype)) {
+    for (PetscInt i = 0; i < numY; i++) {
+      if (stifflyaccurate && i == numY - 1 && HaveSolution(cptype)) continue;
+      PetscCall(VecToBuffer(Y[i], p));
+    }
+  }
+  PetscCall(PetscMemcpy(*p, &time, sizeof(PetscReal)));
+  PetscCall(PetscMemcpy(*p + sizeof(PetscReal), &timeprev, sizeof(PetscReal)));
+  *p += 2 * sizeof(PetscReal);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ReadFromBuffer(PetscBool stifflyaccurate, PetscInt *stepnum, PetscReal *time, PetscReal *timeprev, Vec X, Vec *Y, PetscInt numY, CheckpointType cptype, const unsigned char **p)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscMemcpy(stepnum, *p + sizeof(PetscInt), sizeof(PetscInt)));
+  *p += 2 * sizeof(PetscInt);
+  if (HaveSolution(cptype)) PetscCall(BufferToVec(p, X));
+  if (HaveStages(cptype)) {
+    for (PetscInt i = 0; i < numY; i++) {
+      if (stifflyaccurate && i == numY - 1 && HaveSolution(cptype)) continue;
+      PetscCall(BufferToVec(p, Y[i]));
+    }
+  }
+  PetscCall(PetscMemcpy(time, *p, sizeof(PetscReal)));
+  PetscCall(PetscMemcpy(timeprev, *p + sizeof(PetscReal), sizeof(PetscReal)));
+  *p += 2 * sizeof(PetscReal);
+  PetscFunctionReturn(0);
+}
+
+static inline CheckpointType BufferPeekType(const unsigned char *p)
+{
+  PetscInt cptype_int;
+
+  memcpy(&cptype_int, p, sizeof(PetscInt));
+  return (CheckpointType)cptype_int;
+}
+
+/* the stack, and the current point, are copied into a buffer written behind */
+static PetscErrorCode StackDumpAllAsync(TSTrajectory tj, TS ts, Stack *stack, PetscInt id)
+{
+  const PetscInt ndumped = stack->top + 1;
+  Vec           *Y;
+  PetscInt       n;
+  size_t         size = sizeof(PetscInt);
+  unsigned char *data, *p;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(ts->vec_sol, &n));
+  PetscCall(TSGetStages(ts, &stack->numY, &Y));
+  for (PetscInt i = 0; i < ndumped; i++) size += RecordSize(ts->stifflyaccurate, n, stack->numY, stack->container[i]->cptype);
+  size += RecordSize(ts->stifflyaccurate, n, stack->numY, SOLUTION_STAGES);
+  PetscCall(PetscLogEventBegin(TSTrajectory_DiskWrite, tj, ts, 0, 0));
+  PetscCall(PetscMalloc1(size, &data));
+  PetscCall(PetscMemcpy(data, &ndumped, sizeof(PetscInt)));
+  p = data + sizeof(PetscInt);
+  for (PetscInt i = 0; i < ndumped; i++) {
+    StackElement e = stack->container[i];
+    Vec          X, *Ye;
+
+    PetscCall(ElementGetVecs(ts, stack, e, &X, &Ye));
+    PetscCall(WriteToBuffer(ts->stifflyaccurate, e->stepnum, e->time, e->timeprev, X, Ye, stack->numY, e->cptype, &p));
+    ts->trajectory->diskwrites++;
+  }
+  for (PetscInt i = 0; i < ndumped; i++) {
+    StackElement e;
+
+    PetscCall(StackPop(stack, &e));
+  }
+  PetscCall(WriteToBuffer(ts->stifflyaccurate, ts->steps, ts->ptime, ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, &p));
+  ts->trajectory->diskwrites++;
+  PetscCall(AsyncWrite(tj, TJ_ASYNC_STACK, id, data, size));
+  PetscCall(PetscLogEventEnd(TSTrajectory_DiskWrite, tj, ts, 0, 0));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode StackLoadAllAsync(TSTrajectory tj, TS ts, Stack *stack, PetscInt id)
+{
+  Vec                 *Y;
+  PetscInt             nloaded;
+  unsigned char       *data;
+  const unsigned char *p;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
+  PetscCall(AsyncRead(tj, TJ_ASYNC_STACK, id, &data));
+  PetscCall(AsyncPrefetch(tj, TJ_ASYNC_STACK, id - 1));
+  PetscCall(PetscMemcpy(&nloaded, data, sizeof(PetscInt)));
+  p = data + sizeof(PetscInt);
+  for (PetscInt i = 0; i < nloaded; i++) {
+    StackElement e;
+    Vec          X, *Ye;
+
+    PetscCall(ElementCreate(ts, BufferPeekType(p), stack, &e));
+    PetscCall(StackPush(stack, e));
+    PetscCall(ElementGetVecs(ts, stack, e, &X, &Ye));
+    PetscCall(ReadFromBuffer(ts->stifflyaccurate, &e->stepnum, &e->time, &e->timeprev, X, Ye, stack->numY, e->cptype, &p));
+    if (stack->compression) PetscCall(ElementStore(stack, e, X, Ye));
+    ts->trajectory->diskreads++;
+  }
+  PetscCall(TSGetStages(ts, &stack->numY, &Y));
+  PetscCall(ReadFromBuffer(ts->stifflyaccurate, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, &p));
+  ts->trajectory->diskreads++;
+  PetscCall(PetscFree(data));
+  PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
+  PetscCall(TurnBackward(ts));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DumpSingleAsync(TSTrajectory tj, TS ts, Stack *stack, PetscInt id)
+{
+  Vec           *Y;
+  PetscInt       n, stepnum;
+  size_t         size;
+  unsigned char *data, *p;
+
+  PetscFunctionBegin;
+  PetscCall(TSGetStepNumber(ts, &stepnum));
+  PetscCall(VecGetLocalSize(ts->vec_sol, &n));
+  PetscCall(TSGetStages(ts, &stack->numY, &Y));
+  size = RecordSize(ts->stifflyaccurate, n, stack->numY, SOLUTION_STAGES);
+  PetscCall(PetscLogEventBegin(TSTrajectory_DiskWrite, tj, ts, 0, 0));
+  PetscCall(PetscMalloc1(size, &data));
+  p = data;
+  PetscCall(WriteToBuffer(ts->stifflyaccurate, stepnum, ts->ptime, ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, &p));
+  PetscCall(AsyncWrite(tj, TJ_ASYNC_SINGLE, id, data, size));
+  PetscCall(PetscLogEventEnd(TSTrajectory_DiskWrite, tj, ts, 0, 0));
+  ts->trajectory->diskwrites++;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode LoadSingleAsync(TSTrajectory tj, TS ts, Stack *stack, PetscInt id)
+{
+  Vec                 *Y;
+  unsigned char       *data;
+  const unsigned char *p;
+
+  PetscFunctionBegin;
+  PetscCall(TSGetStages(ts, &stack->numY, &Y));
+  PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
+  PetscCall(AsyncRead(tj, TJ_ASYNC_SINGLE, id, &data));
+  PetscCall(AsyncPrefetch(tj, TJ_ASYNC_SINGLE, id - 1));
+  p = data;
+  PetscCall(ReadFromBuffer(ts->stifflyaccurate, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, &p));
+  PetscCall(PetscFree(data));
+  PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
+  ts->trajectory->diskreads++;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode StackDumpAll(TSTrajectory tj, TS ts, Stack *stack, PetscInt id)
 {
   Vec         *Y;
@@ -355,17 +1093,24 @@ static PetscErrorCode StackDumpAll(TSTrajectory tj, TS ts, Stack *stack, PetscIn
     PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Dump stack id %" PetscInt_FMT " to file\n", id));
     PetscCall(PetscViewerASCIIPopTab(tj->monitor));
   }
+  if (tjsch->async) {
+    PetscCall(StackDumpAllAsync(tj, ts, stack, id));
+    PetscFunctionReturn(0);
+  }
   PetscCall(PetscSNPrintf(filename, sizeof(filename), "%s/TS-STACK%06" PetscInt_FMT ".bin", tj->dirname, id));
   PetscCall(PetscViewerFileSetName(tjsch->viewer, filename));
   PetscCall(PetscViewerSetUp(tjsch->viewer));
   ndumped = stack->top + 1;
   PetscCall(PetscViewerBinaryWrite(tjsch->viewer, &ndumped, 1, PETSC_INT));
   for (PetscInt i = 0; i < ndumped; i++) {
+    Vec X, *Ye;
+
     e          = stack->container[i];
     cptype_int = (PetscInt)e->cptype;
     PetscCall(PetscViewerBinaryWrite(tjsch->viewer, &cptype_int, 1, PETSC_INT));
+    PetscCall(ElementGetVecs(ts, stack, e, &X, &Ye));
     PetscCall(PetscLogEventBegin(TSTrajectory_DiskWrite, tj, ts, 0, 0));
-    PetscCall(WriteToDisk(ts->stifflyaccurate, e->stepnum, e->time, e->timeprev, e->X, e->Y, stack->numY, e->cptype, tjsch->viewer));
+    PetscCall(WriteToDisk(ts->stifflyaccurate, e->stepnum, e->time, e->timeprev, X, Ye, stack->numY, e->cptype, tjsch->viewer));
     PetscCall(PetscLogEventEnd(TSTrajectory_DiskWrite, tj, ts, 0, 0));
     ts->trajectory->diskwrites++;
     PetscCall(StackPop(stack, &e));
@@ -393,18 +1138,26 @@ static PetscErrorCode StackLoadAll(TSTrajectory tj, TS ts, Stack *stack, PetscIn
     PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Load stack from file\n"));
     PetscCall(PetscViewerASCIISubtractTab(tj->monitor, ((PetscObject)tj)->tablevel));
   }
+  if (((TJScheduler *)tj->data)->async) {
+    PetscCall(StackLoadAllAsync(tj, ts, stack, id));
+    PetscFunctionReturn(0);
+  }
   PetscCall(PetscSNPrintf(filename, sizeof filename, "%s/TS-STACK%06" PetscInt_FMT ".bin", tj->dirname, id));
   PetscCall(PetscViewerBinaryOpen(PetscObjectComm((PetscObject)tj), filename, FILE_MODE_READ, &viewer));
   PetscCall(PetscViewerBinarySetSkipInfo(viewer, PETSC_TRUE));
   PetscCall(PetscViewerPushFormat(viewer, PETSC_VIEWER_NATIVE));
   PetscCall(PetscViewerBinaryRead(viewer, &nloaded, 1, NULL, PETSC_INT));
   for (i = 0; i < nloaded; i++) {
+    Vec X, *Ye;
+
     PetscCall(PetscViewerBinaryRead(viewer, &cptype_int, 1, NULL, PETSC_INT));
     PetscCall(ElementCreate(ts, (CheckpointType)cptype_int, stack, &e));
     PetscCall(StackPush(stack, e));
+    PetscCall(ElementGetVecs(ts, stack, e, &X, &Ye));
     PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
-    PetscCall(ReadFromDisk(ts->stifflyaccurate, &e->stepnum, &e->time, &e->timeprev, e->X, e->Y, stack->numY, e->cptype, viewer));
+    PetscCall(ReadFromDisk(ts->stifflyaccurate, &e->stepnum, &e->time, &e->timeprev, X, Ye, stack->numY, e->cptype, viewer));
     PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
+    if (stack->compression) PetscCall(ElementStore(stack, e, X, Ye));
     ts->trajectory->diskreads++;
   }
   /* load the last step into TS */
@@ -484,6 +1237,10 @@ static PetscErrorCode DumpSingle(TSTrajectory tj, TS ts, Stack *stack, PetscInt
     PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Dump a single point from file\n"));
     PetscCall(PetscViewerASCIISubtractTab(tj->monitor, ((PetscObject)tj)->tablevel));
   }
+  if (tjsch->async) {
+    PetscCall(DumpSingleAsync(tj, ts, stack, id));
+    PetscFunctionReturn(0);
+  }
   PetscCall(TSGetStepNumber(ts, &stepnum));
   PetscCall(PetscSNPrintf(filename, sizeof(filename), "%s/TS-CPS%06" PetscInt_FMT ".bin", tj->dirname, id));
   PetscCall(PetscViewerFileSetName(tjsch->viewer, filename));
@@ -509,6 +1266,10 @@ static PetscErrorCode LoadSingle(TSTrajectory tj, TS ts, Stack *stack, PetscInt
     PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Load a single point from file\n"));
     PetscCall(PetscViewerASCIISubtractTab(tj->monitor, ((PetscObject)tj)->tablevel));
   }
+  if (((TJScheduler *)tj->data)->async) {
+    PetscCall(LoadSingleAsync(tj, ts, stack, id));
+    PetscFunctionReturn(0);
+  }
   PetscCall(PetscSNPrintf(filename, sizeof filename, "%s/TS-CPS%06" PetscInt_FMT ".bin", tj->dirname, id));
   PetscCall(PetscViewerBinaryOpen(PetscObjectComm((PetscObject)tj), filename, FILE_MODE_READ, &viewer));
   PetscCall(PetscViewerBinarySetSkipInfo(viewer, PETSC_TRUE));
@@ -529,13 +1290,20 @@ static PetscErrorCode UpdateTS(TS ts, Stack *stack, StackElement e, PetscInt ste
 
   PetscFunctionBegin;
   /* In adjoint mode we do not need to copy solution if the stepnum is the same */
-  if (!adjoint_mode || (HaveSolution(e->cptype) && e->stepnum != stepnum)) PetscCall(VecCopy(e->X, ts->vec_sol));
+  if (!adjoint_mode || (HaveSolution(e->cptype) && e->stepnum != stepnum)) {
+    if (stack->compression) PetscCall(DecompressVec(&e->cX, ts->vec_sol));
+    else PetscCall(VecCopy(e->X, ts->vec_sol));
+  }
   if (HaveStages(e->cptype)) {
     PetscCall(TSGetStages(ts, &stack->numY, &Y));
     if (e->stepnum && e->stepnum == stepnum) {
-      for (i = 0; i < stack->numY; i++) PetscCall(VecCopy(e->Y[i], Y[i]));
+      for (i = 0; i < stack->numY; i++) {
+        if (stack->compression) PetscCall(DecompressVec(&e->cY[i], Y[i]));
+        else PetscCall(VecCopy(e->Y[i], Y[i]));
+      }
     } else if (ts->stifflyaccurate) {
-      PetscCall(VecCopy(e->Y[stack->numY - 1], ts->vec_sol));
+      if (stack->compression) PetscCall(DecompressVec(&e->cY[stack->numY - 1], ts->vec_sol));
+      else PetscCall(VecCopy(e->Y[stack->numY - 1], ts->vec_sol));
     }
   }
   if (adjoint_mode) {
@@ -1045,7 +1813,7 @@ static PetscErrorCode TSTrajectoryMemorySet_RON(TSTrajectory tj, TS ts, TJSchedu
 {
   Stack          *stack = &tjsch->stack;
   Vec            *Y;
-  PetscInt        i, store;
+  PetscInt        store;
   PetscReal       timeprev;
   StackElement    e;
   RevolveCTX     *rctx = tjsch->rctx;
@@ -1061,11 +1829,8 @@ static PetscErrorCode TSTrajectoryMemorySet_RON(TSTrajectory tj, TS ts, TJSchedu
   if (store == 1) {
     if (rctx->check != stack->top + 1) { /* overwrite some non-top checkpoint in the stack */
       PetscCall(StackFind(stack, &e, rctx->check));
-      if (HaveSolution(e->cptype)) PetscCall(VecCopy(X, e->X));
-      if (HaveStages(e->cptype)) {
-        PetscCall(TSGetStages(ts, &stack->numY, &Y));
-        for (i = 0; i < stack->numY; i++) PetscCall(VecCopy(Y[i], e->Y[i]));
-      }
+      PetscCall(TSGetStages(ts, &stack->numY, &Y));
+      PetscCall(ElementStore(stack, e, X, Y));
       e->stepnum = stepnum;
       e->time    = time;
       PetscCall(TSGetPrevTime(ts, &timeprev));
@@ -1755,6 +2520,11 @@ static PetscErrorCode TSTrajectoryGet_Memory(TSTrajectory tj, TS ts, PetscInt st
     PetscCall(TSTrajectoryReset(tj)); /* reset TSTrajectory so users do not need to reset TSTrajectory */
     PetscFunctionReturn(0);
   }
+  if (tjsch->async && !tjsch->io.reverse) {
+    /* the last file written is the first one needed */
+    tjsch->io.reverse = PETSC_TRUE;
+    PetscCall(AsyncPrefetch(tj, tjsch->io.lastkind, tjsch->io.lastid));
+  }
   switch (tjsch->stype) {
   case NONE:
     if (tj->adjoint_solve_mode) {
@@ -1921,9 +2691,17 @@ PetscErrorCode TSTrajectoryMemorySetType(TSTrajectory tj, TSTrajectoryMemoryType
   Output Parameter:
 .  max_cps_ram - maximum number of checkpoints in RAM
 
+  Options Database Key:
+. -ts_trajectory_max_cps_ram <max_cps_ram> - maximum number of checkpoints in RAM
+
   Level: intermediate
 
-.seealso: [](chapter_ts), `TSTrajectory`, `TSTrajectorySetMaxUnitsRAM()`
+  Note:
+  The schedulers count checkpoints, not bytes. Compressing the checkpoints with -ts_trajectory_memory_compression does not
+  change the number of checkpoints kept in RAM, only their size; to make use of the memory saved, multiply max_cps_ram by the
+  compression ratio, which -info reports when the trajectory is destroyed.
+
+.seealso: [](chapter_ts), `TSTrajectory`, `TSTrajectorySetMaxUnitsRAM()`, `TSTRAJECTORYMEMORY`
 @*/
 PetscErrorCode TSTrajectorySetMaxCpsRAM(TSTrajectory tj, PetscInt max_cps_ram)
 {
@@ -2024,6 +2802,9 @@ static PetscErrorCode TSTrajectorySetFromOptions_Memory(TSTrajectory tj, PetscOp
     PetscCall(PetscOptionsBool("-ts_trajectory_use_dram", "Use DRAM for checkpointing", "TSTrajectorySetUseDRAM", tjsch->stack.use_dram, &tjsch->stack.use_dram, NULL));
     PetscCall(PetscOptionsEnum("-ts_trajectory_memory_type", "Checkpointing scchedule software to use", "TSTrajectoryMemorySetType", TSTrajectoryMemoryTypes, (PetscEnum)(int)(tjsch->tj_memory_type), &etmp, &flg));
     if (flg) PetscCall(TSTrajectoryMemorySetType(tj, (TSTrajectoryMemoryType)etmp));
+    PetscCall(PetscOptionsBool("-ts_trajectory_memory_async", "Write the checkpoints to disk behind and read them ahead on another thread", "TSTrajectorySetFromOptions", tjsch->async, &tjsch->async, NULL));
+    PetscCall(PetscOptionsEnum("-ts_trajectory_memory_compression", "Compression of the checkpoints in memory", "TSTrajectorySetFromOptions", TSTrajectoryMemoryCompressions, (PetscEnum)tjsch->stack.compression, (PetscEnum *)&tjsch->stack.compression, NULL));
+    PetscCall(PetscOptionsReal("-ts_trajectory_memory_compression_tol", "Bound on the error of each entry with lossy compression, default is a tenth of the absolute tolerance of the TS", "TSTrajectorySetFromOptions", tjsch->stack.compression_tol, &tjsch->stack.compression_tol, NULL));
   }
   PetscOptionsHeadEnd();
   PetscFunctionReturn(0);
@@ -2052,6 +2833,15 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj, TS ts)
   if (fixedtimestep) tjsch->total_steps = PetscMin(ts->max_steps, total_steps);
 
   tjsch->stack.solution_only = tj->solution_only;
+  if (stack->compression == TJ_COMPRESSION_LOSSY) {
+    if (stack->compression_tol == (PetscReal)PETSC_DEFAULT) {
+      PetscReal atol;
+
+      PetscCall(TSGetTolerances(ts, &atol, NULL, NULL, NULL));
+      stack->compression_tol = 0.1 * atol;
+    }
+    PetscCheck(stack->compression_tol > 0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Tolerance of the lossy compression %g must be positive", (double)stack->compression_tol);
+  }
   PetscCall(TSGetStages(ts, &numY, PETSC_IGNORE));
   if (stack->solution_only) {
     if (tjsch->max_units_ram) tjsch->max_cps_ram = tjsch->max_units_ram;
@@ -2197,6 +2987,32 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj, TS ts)
   if ((tjsch->stype >= TWO_LEVEL_NOREVOLVE && tjsch->stype < REVOLVE_OFFLINE) || tjsch->stype == REVOLVE_MULTISTAGE) { /* these types need to use disk */
     PetscCall(TSTrajectorySetUp_Basic(tj, ts));
   }
+  if (tjsch->async && tjsch->stype == TWO_LEVEL_TWO_REVOLVE) {
+    /* StackLoadLast() seeks into the files in the format of the binary viewer */
+    PetscCall(PetscInfo(tj, "Asynchronous checkpoints on disk are not supported by the two-level two-revolve scheduler, using synchronous ones\n"));
+    tjsch->async = PETSC_FALSE;
+  }
+  if (tjsch->async) {
+    /* every rank writes its own files into the directory made by the first one */
+    MPI_Comm    comm = PetscObjectComm((PetscObject)tj);
+    PetscMPIInt rank;
+    char        dirname[PETSC_MAX_PATH_LEN] = "";
+
+    PetscCallMPI(MPI_Comm_rank(comm, &rank));
+    if (rank == 0 && tj->dirname) PetscCall(PetscStrncpy(dirname, tj->dirname, sizeof(dirname)));
+    PetscCallMPI(MPI_Bcast(dirname, sizeof(dirname), MPI_CHAR, 0, comm));
+    if (rank && dirname[0]) {
+      PetscCall(PetscFree(tj->dirname));
+      PetscCall(PetscStrallocpy(dirname, &tj->dirname));
+    }
+  }
+  if (tjsch->async && !tjsch->io.dctx) {
+    PetscCall(PetscDeviceCreate(PETSC_DEVICE_HOST, PETSC_DECIDE, &tjsch->io.device));
+    PetscCall(PetscDeviceConfigure(tjsch->io.device));
+    PetscCall(PetscDeviceContextCreate(&tjsch->io.dctx));
+    PetscCall(PetscDeviceContextSetDevice(tjsch->io.dctx, tjsch->io.device));
+    PetscCall(PetscDeviceContextSetUp(tjsch->io.dctx));
+  }
 
   stack->stacksize = PetscMax(stack->stacksize, 1);
   tjsch->recompute = PETSC_FALSE;
@@ -2206,11 +3022,10 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj, TS ts)
 
 static PetscErrorCode TSTrajectoryReset_Memory(TSTrajectory tj)
 {
-#if defined(PETSC_HAVE_REVOLVE) || defined(PETSC_HAVE_CAMS)
   TJScheduler *tjsch = (TJScheduler *)tj->data;
-#endif
 
   PetscFunctionBegin;
+  PetscCall(AsyncReset(&tjsch->io));
 #if defined(PETSC_HAVE_REVOLVE)
   if (tjsch->stype > TWO_LEVEL_NOREVOLVE) {
     revolve_reset();
@@ -2241,6 +3056,11 @@ static PetscErrorCode TSTrajectoryDestroy_Memory(TSTrajectory tj)
   PetscFunctionBegin;
   PetscCall(StackDestroy(&tjsch->stack));
   PetscCall(PetscViewerDestroy(&tjsch->viewer));
+  PetscCall(AsyncReset(&tjsch->io));
+  /* the first rank removes the directory after all the files are written */
+  if (tjsch->async) PetscCall(PetscBarrier((PetscObject)tj));
+  PetscCall(PetscDeviceContextDestroy(&tjsch->io.dctx));
+  PetscCall(PetscDeviceDestroy(&tjsch->io.device));
   PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectorySetMaxCpsRAM_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectorySetMaxCpsDisk_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectorySetMaxUnitsRAM_C", NULL));
@@ -2253,8 +3073,25 @@ static PetscErrorCode TSTrajectoryDestroy_Memory(TSTrajectory tj)
 /*MC
       TSTRAJECTORYMEMORY - Stores each solution of the ODE/ADE in memory
 
+  Options Database Keys:
++  -ts_trajectory_memory_async - write the checkpoints to disk behind and read them ahead on another thread
+.  -ts_trajectory_memory_compression <none,lossless,lossy> - compress the checkpoints kept in memory
+-  -ts_trajectory_memory_compression_tol <tol> - bound on the error of each entry with lossy compression, defaults to a tenth of the absolute tolerance of the `TS`
+
   Level: intermediate
 
+  Notes:
+  Compression reduces the memory of each checkpoint but not their number: the schedulers count checkpoints, not bytes, so
+  compression alone never changes the checkpointing schedule. Raise the maximum number of checkpoints in RAM with
+  `TSTrajectorySetMaxCpsRAM()` by the compression ratio reported by -info to make use of it. Checkpoints written to disk are
+  not compressed.
+
+  With -ts_trajectory_memory_async the two-level schemes write the checkpoints to disk while the forward sweep goes on, and
+  read the checkpoints needed next while the adjoint sweep goes on, so the time of the disk traffic is hidden behind the
+  computations. The transfers run on the threads of the host `PetscDeviceContext`, so -device_threads_host must be at least
+  one, otherwise they happen immediately. Each rank writes its own files, in the trajectory directory, which must be visible
+  to all ranks.
+
 .seealso: [](chapter_ts), `TSTrajectoryCreate()`, `TS`, `TSTrajectorySetType()`, `TSTrajectoryType`, `TSTrajectory`
 M*/
 PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Memory(TSTrajectory tj, TS ts)
@@ -2279,7 +3116,8 @@ PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Memory(TSTrajectory tj, TS ts)
 #endif
   tjsch->save_stack = PETSC_TRUE;
 
-  tjsch->stack.solution_only = tj->solution_only;
+  tjsch->stack.solution_only   = tj->solution_only;
+  tjsch->stack.compression_tol = PETSC_DEFAULT;
   PetscCall(PetscViewerCreate(PetscObjectComm((PetscObject)tj), &tjsch->viewer));
   PetscCall(PetscViewerSetType(tjsch->viewer, PETSCVIEWERBINARY));
   PetscCall(PetscViewerPushFormat(tjsch->viewer, PETSC_VIEWER_NATIVE));
@@ -10,6 +10,7 @@ static char help[] = "Demonstrates adjoint sensitivity analysis for Reaction-Dif
     -forwardonly  - run the forward simulation without adjoint
     -implicitform - provide IFunction and IJacobian to TS, if not set, RHSFunction and RHSJacobian will be used
     -aijpc        - set the preconditioner matrix to be aij (the Jacobian matrix can be of a different type such as ELL)
+    -adjoint_steps <n> - stop the adjoint run n steps back from the final time
 */
 #include "reaction_diffusion.h"
 #include <petscdm.h>
@@ -47,6 +48,7 @@ int main(int argc, char **argv)
   AppCtx    appctx;
   Vec       lambda[1];
   PetscBool forwardonly = PETSC_FALSE, implicitform = PETSC_TRUE;
+  PetscInt  adjointsteps = 0;
 
   PetscFunctionBeginUser;
   PetscCall(PetscInitialize(&argc, &argv, (char *)0, help));
@@ -54,6 +56,7 @@ int main(int argc, char **argv)
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-implicitform", &implicitform, NULL));
   appctx.aijpc = PETSC_FALSE;
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-aijpc", &appctx.aijpc, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-adjoint_steps", &adjointsteps, NULL));
 
   appctx.D1    = 8.0e-5;
   appctx.D2    = 4.0e-5;
@@ -135,6 +138,7 @@ int main(int argc, char **argv)
     /*   Reset initial conditions for the adjoint integration */
     PetscCall(InitializeLambda(da, lambda[0], 0.5, 0.5));
     PetscCall(TSSetCostGradients(ts, 1, lambda, NULL));
+    if (adjointsteps) PetscCall(TSAdjointSetSteps(ts, adjointsteps));
     PetscCall(TSAdjointSolve(ts));
     PetscCall(VecDestroy(&lambda[0]));
   }
@@ -226,6 +230,16 @@ PetscErrorCode InitialConditions(DM da, Vec U)
       args: -ts_max_steps 10 -implicitform 0 -ts_type rk -ts_rk_type 4 -ts_monitor -ts_adjoint_monitor -da_grid_x 20 -da_grid_y 20 -snes_fd_color
       output_file: output/ex5adj_1.out
 
+   testset:
+      nsize: 2
+      args: -ts_monitor -ts_adjoint_monitor -da_grid_x 20 -da_grid_y 20 -ts_trajectory_type memory -ts_trajectory_stride 5 -ts_trajectory_memory_async -device_threads_host 1
+      test:
+        suffix: async
+        args: -ts_max_steps 10
+      test:
+        suffix: async_partial
+        args: -ts_max_steps 20 -adjoint_steps 8
+
    test:
       suffix: knl
       args: -ts_max_steps 10 -ts_monitor -ts_adjoint_monitor -ts_trajectory_type memory -ts_trajectory_solution_only 0 -malloc_hbw -ts_trajectory_use_dram 1
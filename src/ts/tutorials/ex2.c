@@ -644,4 +644,9 @@ PetscErrorCode RHSJacobian(TS ts, PetscReal t, Vec global_in, Mat AA, Mat BB, vo
       nsize: 4
       args: -ts_max_steps 10 -ts_monitor -M 128
 
+    test:
+      suffix: lag
+      requires: !single
+      args: -nox -ts_dt 1 -ts_type bdf -ts_adapt_type basic -ts_max_time 100 -ts_jacobian_lag -ts_view
+
 TEST*/
@@ -24,6 +24,7 @@ typedef struct _n_User *User;
 struct _n_User {
   PetscReal mu;
   PetscReal next_output;
+  PetscInt  njac; /* number of Jacobian evaluations */
 };
 
 /*
@@ -71,6 +72,7 @@ static PetscErrorCode IJacobian(TS ts, PetscReal t, Vec X, Vec Xdot, PetscReal a
   PetscScalar        J[2][2];
 
   PetscFunctionBeginUser;
+  user->njac++;
   PetscCall(VecGetArrayRead(X, &x));
   J[0][0] = a;
   J[0][1] = -1.0;
@@ -119,7 +121,7 @@ int main(int argc, char **argv)
   Mat            A;  /* Jacobian matrix */
   PetscInt       steps;
   PetscReal      ftime   = 0.5;
-  PetscBool      monitor = PETSC_FALSE, implicitform = PETSC_TRUE;
+  PetscBool      monitor = PETSC_FALSE, implicitform = PETSC_TRUE, count_jacobian = PETSC_FALSE;
   PetscScalar   *x_ptr;
   PetscMPIInt    size;
   struct _n_User user;
@@ -137,7 +139,9 @@ int main(int argc, char **argv)
     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
   user.next_output = 0.0;
   user.mu          = 1.0e3;
+  user.njac        = 0;
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-monitor", &monitor, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-count_jacobian", &count_jacobian, NULL));
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-implicitform", &implicitform, NULL));
   PetscOptionsBegin(PETSC_COMM_WORLD, NULL, "Physical parameters", NULL);
   PetscCall(PetscOptionsReal("-mu", "Stiffness parameter", "<1.0e6>", user.mu, &user.mu, NULL));
@@ -190,6 +194,7 @@ int main(int argc, char **argv)
   PetscCall(TSGetSolveTime(ts, &ftime));
   PetscCall(TSGetStepNumber(ts, &steps));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD, "steps %" PetscInt_FMT ", ftime %g\n", steps, (double)ftime));
+  if (count_jacobian) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Jacobian evaluations %" PetscInt_FMT "\n", user.njac));
   PetscCall(VecView(x, PETSC_VIEWER_STDOUT_WORLD));
 
   /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -210,6 +215,11 @@ int main(int argc, char **argv)
       requires: !single
       args: -mu 1e6
 
+    test:
+      requires: !single
+      suffix: lag
+      args: -mu 1e6 -ts_jacobian_lag -count_jacobian
+
     test:
       requires: !single
       suffix: 2
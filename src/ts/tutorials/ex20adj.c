@@ -463,4 +463,19 @@ int main(int argc, char **argv)
       args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_max_units_ram 5 -ts_trajectory_solution_only 0 -ts_trajectory_monitor -ts_trajectory_memory_type cams
       output_file: output/ex20adj_6.out
 
+    test:
+      suffix: 25
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_stride 5 -ts_trajectory_solution_only {{0 1}} -ts_trajectory_save_stack -ts_trajectory_memory_compression lossless
+      output_file: output/ex20adj_2.out
+
+    test:
+      suffix: 26
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_solution_only 0 -ts_trajectory_memory_compression lossy -ts_trajectory_memory_compression_tol 1e-10
+      output_file: output/ex20adj_2.out
+
+    test:
+      suffix: 27
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_stride 5 -ts_trajectory_solution_only {{0 1}} -ts_trajectory_save_stack {{0 1}} -ts_trajectory_memory_async -device_threads_host 2
+      output_file: output/ex20adj_2.out
+
 TEST*/
@@ -376,4 +376,9 @@ int main(int argc, char **argv)
       suffix: o
       args: -rhs-form -ts_type rk -ts_rk_type 2b -ts_trajectory_dirname ex40_o_dir
       output_file: output/ex40.out
+
+    test:
+      requires: !single
+      suffix: p
+      args: -rhs-form -ts_type rk -ts_rk_type 5dp -test_adapthistory false -ts_event_interpolate -ts_event_monitor
 TEST*/
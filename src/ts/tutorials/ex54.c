@@ -0,0 +1,173 @@
+static char help[] = "Integrates an ensemble of Van der Pol oscillators with a sweep of the stiffness parameter with TSBATCH.\n\
+Each member is checked against an integration of it alone with TSRK.\n\
+Input parameters include:\n\
+  -nb <members>    : number of members on each process\n\
+  -mu_max <mu>     : the largest stiffness parameter of the sweep\n\
+  -user_jacobian   : provide the Jacobian of the members instead of finite differences\n\n";
+
+/*
+   Member i of the N members of the ensemble is the Van der Pol oscillator
+
+     u0' = u1
+     u1' = mu_i ((1 - u0^2) u1 - u0),    mu_i = mu_max (i+1)/N
+
+   which is stiff for large mu_i. The members are interleaved in the local part of the solution, component j of the
+   local member i at the entry j*nb+i.
+*/
+#include <petscts.h>
+
+typedef struct {
+  PetscInt   nb;
+  PetscReal *mu; /* of the local members */
+} AppCtx;
+
+static PetscErrorCode RHSFunctionBatch(TS ts, PetscInt n, PetscInt m, const PetscInt idx[], const PetscReal t[], const PetscScalar u[], PetscScalar f[], void *ctx)
+{
+  AppCtx *user = (AppCtx *)ctx;
+
+  PetscFunctionBeginUser;
+  for (PetscInt k = 0; k < n; k++) {
+    const PetscReal mu = user->mu[idx[k]];
+
+    f[k]     = u[n + k];
+    f[n + k] = mu * ((1.0 - u[k] * u[k]) * u[n + k] - u[k]);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode RHSJacobianBatch(TS ts, PetscInt n, PetscInt m, const PetscInt idx[], const PetscReal t[], const PetscScalar u[], PetscScalar J[], void *ctx)
+{
+  AppCtx *user = (AppCtx *)ctx;
+
+  PetscFunctionBeginUser;
+  for (PetscInt k = 0; k < n; k++) {
+    const PetscReal mu = user->mu[idx[k]];
+
+    J[0 * n + k] = 0.0;
+    J[1 * n + k] = 1.0;
+    J[2 * n + k] = -mu * (2.0 * u[k] * u[n + k] + 1.0);
+    J[3 * n + k] = mu * (1.0 - u[k] * u[k]);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* a single member for the check */
+static PetscErrorCode RHSFunction(TS ts, PetscReal t, Vec U, Vec F, void *ctx)
+{
+  const PetscReal    mu = *(PetscReal *)ctx;
+  const PetscScalar *u;
+  PetscScalar       *f;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecGetArrayRead(U, &u));
+  PetscCall(VecGetArray(F, &f));
+  f[0] = u[1];
+  f[1] = mu * ((1.0 - u[0] * u[0]) * u[1] - u[0]);
+  PetscCall(VecRestoreArrayRead(U, &u));
+  PetscCall(VecRestoreArray(F, &f));
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  TS                 ts, tsm;
+  Vec                U, Um;
+  AppCtx             user;
+  PetscInt           nb = 16, N, rstart;
+  PetscReal          mu_max = 10.0, tfinal, diff = 0.0;
+  PetscBool          user_jacobian = PETSC_FALSE;
+  PetscScalar       *u;
+  const PetscScalar *um;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nb", &nb, NULL));
+  PetscCall(PetscOptionsGetReal(NULL, NULL, "-mu_max", &mu_max, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-user_jacobian", &user_jacobian, NULL));
+
+  /* the members of this process and their parameters */
+  PetscCall(VecCreateMPI(PETSC_COMM_WORLD, 2 * nb, PETSC_DETERMINE, &U));
+  PetscCall(VecGetSize(U, &N));
+  N /= 2;
+  PetscCall(VecGetOwnershipRange(U, &rstart, NULL));
+  rstart /= 2;
+  user.nb = nb;
+  PetscCall(PetscMalloc1(nb, &user.mu));
+  for (PetscInt i = 0; i < nb; i++) user.mu[i] = mu_max * (rstart + i + 1) / N;
+  PetscCall(VecGetArray(U, &u));
+  for (PetscInt i = 0; i < nb; i++) {
+    u[i]      = 2.0;
+    u[nb + i] = -2.0 / 3.0;
+  }
+  PetscCall(VecRestoreArray(U, &u));
+
+  PetscCall(TSCreate(PETSC_COMM_WORLD, &ts));
+  PetscCall(TSSetType(ts, TSBATCH));
+  PetscCall(TSBatchSetRHSFunction(ts, 2, RHSFunctionBatch, &user));
+  if (user_jacobian) PetscCall(TSBatchSetRHSJacobian(ts, RHSJacobianBatch, &user));
+  PetscCall(TSSetTolerances(ts, 1.e-6, NULL, 1.e-6, NULL));
+  PetscCall(TSSetMaxTime(ts, 2.0));
+  PetscCall(TSSetTimeStep(ts, 0.5));
+  PetscCall(TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP));
+  PetscCall(TSSetFromOptions(ts));
+  PetscCall(TSSolve(ts, U));
+  PetscCall(TSGetTime(ts, &tfinal));
+
+  /* each member integrated alone */
+  PetscCall(VecCreateSeq(PETSC_COMM_SELF, 2, &Um));
+  PetscCall(VecGetArray(U, &u));
+  for (PetscInt i = 0; i < nb; i++) {
+    PetscCall(VecSetValue(Um, 0, 2.0, INSERT_VALUES));
+    PetscCall(VecSetValue(Um, 1, -2.0 / 3.0, INSERT_VALUES));
+    PetscCall(VecAssemblyBegin(Um));
+    PetscCall(VecAssemblyEnd(Um));
+    PetscCall(TSCreate(PETSC_COMM_SELF, &tsm));
+    PetscCall(TSSetOptionsPrefix(tsm, "check_"));
+    PetscCall(TSSetType(tsm, TSRK));
+    PetscCall(TSSetRHSFunction(tsm, NULL, RHSFunction, &user.mu[i]));
+    PetscCall(TSSetTolerances(tsm, 1.e-10, NULL, 1.e-10, NULL));
+    PetscCall(TSSetMaxTime(tsm, tfinal));
+    PetscCall(TSSetMaxSteps(tsm, 1000000));
+    PetscCall(TSSetTimeStep(tsm, 1.e-4));
+    PetscCall(TSSetExactFinalTime(tsm, TS_EXACTFINALTIME_MATCHSTEP));
+    PetscCall(TSSolve(tsm, Um));
+    PetscCall(VecGetArrayRead(Um, &um));
+    for (PetscInt j = 0; j < 2; j++) diff = PetscMax(diff, PetscAbsScalar(u[j * nb + i] - um[j]) / (1.0 + PetscAbsScalar(um[j])));
+    PetscCall(VecRestoreArrayRead(Um, &um));
+    PetscCall(TSDestroy(&tsm));
+  }
+  PetscCall(VecRestoreArray(U, &u));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &diff, 1, MPIU_REAL, MPIU_MAX, PETSC_COMM_WORLD));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%" PetscInt_FMT " members at time %g, %s\n", N, (double)tfinal, diff < 1.e-4 ? "in agreement with their separate integration" : "NOT in agreement with their separate integration"));
+  if (diff >= 1.e-4) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Largest relative difference %g\n", (double)diff));
+
+  PetscCall(VecDestroy(&Um));
+  PetscCall(VecDestroy(&U));
+  PetscCall(TSDestroy(&ts));
+  PetscCall(PetscFree(user.mu));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    suffix: explicit
+    requires: !single
+    args: -ts_batch_rk_type {{5dp 3bs}}
+    output_file: output/ex54_1.out
+
+  test:
+    suffix: implicit
+    requires: !single
+    args: -ts_batch_implicit -mu_max 1000 -user_jacobian {{0 1}}
+    output_file: output/ex54_1.out
+
+  test:
+    suffix: implicit_par
+    nsize: 2
+    requires: !single
+    args: -nb 8 -ts_batch_implicit -ts_batch_arkimex_type 4 -mu_max 1000
+    output_file: output/ex54_1.out
+
+TEST*/
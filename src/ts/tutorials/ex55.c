@@ -0,0 +1,242 @@
+static char help[] = "Advects a bump across a graded mesh with the local time stepping of TSLTS.\n\
+The solution is compared with forward Euler stepping all the cells with the step size of the smallest ones.\n\
+Input parameters include:\n\
+  -grading <g> : ratio of the widths of the largest and smallest cells\n\
+  -steps <n>   : number of steps of TSLTS\n\
+  -cfl <c>     : CFL number of the smallest cells\n\n";
+
+/*
+   The mesh is a box whose cells are graded along x, the widths growing geometrically from the left to the right. The
+   bump moves to the right with the wind, far from the boundaries, so that its mass does not change.
+*/
+#include <petscdmplex.h>
+#include <petscds.h>
+#include <petscts.h>
+
+typedef struct {
+  PetscReal wind[3];
+} AppCtx;
+
+static void Riemann(PetscInt dim, PetscInt Nf, const PetscReal x[], const PetscReal n[], const PetscScalar uL[], const PetscScalar uR[], PetscInt numConstants, const PetscScalar constants[], PetscScalar flux[], void *ctx)
+{
+  AppCtx   *user = (AppCtx *)ctx;
+  PetscReal wn   = 0.0;
+
+  for (PetscInt d = 0; d < dim; d++) wn += user->wind[d] * n[d];
+  flux[0] = wn * (wn > 0 ? uL[0] : uR[0]);
+}
+
+static PetscErrorCode BoundaryOutflow(PetscReal time, const PetscReal c[], const PetscReal n[], const PetscScalar xI[], PetscScalar xG[], void *ctx)
+{
+  PetscFunctionBeginUser;
+  xG[0] = xI[0];
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode GradeMesh(DM dm, PetscReal grading)
+{
+  Vec          coordinates;
+  PetscScalar *coords;
+  PetscInt     cdim, n;
+
+  PetscFunctionBeginUser;
+  if (grading == 1.0) PetscFunctionReturn(0);
+  PetscCall(DMGetCoordinateDim(dm, &cdim));
+  PetscCall(DMGetCoordinatesLocal(dm, &coordinates));
+  PetscCall(VecGetLocalSize(coordinates, &n));
+  PetscCall(VecGetArray(coordinates, &coords));
+  for (PetscInt i = 0; i < n; i += cdim) coords[i] = (PetscPowReal(grading, PetscRealPart(coords[i])) - 1.0) / (grading - 1.0);
+  PetscCall(VecRestoreArray(coordinates, &coords));
+  PetscCall(DMSetCoordinatesLocal(dm, coordinates));
+  PetscFunctionReturn(0);
+}
+
+/* The cells have different volumes, so the mass is the sum of the values weighted by the volumes */
+static PetscErrorCode ComputeMass(DM dm, Vec U, PetscReal *mass)
+{
+  DM                 dmCell;
+  Vec                cellGeometry;
+  const PetscScalar *cgeom, *u;
+  PetscInt           cStart, cEnd;
+
+  PetscFunctionBeginUser;
+  *mass = 0.0;
+  PetscCall(DMPlexGetGeometryFVM(dm, NULL, &cellGeometry, NULL));
+  PetscCall(VecGetDM(cellGeometry, &dmCell));
+  PetscCall(DMPlexGetSimplexOrBoxCells(dm, 0, &cStart, &cEnd));
+  PetscCall(VecGetArrayRead(cellGeometry, &cgeom));
+  PetscCall(VecGetArrayRead(U, &u));
+  for (PetscInt c = cStart; c < cEnd; c++) {
+    PetscFVCellGeom   *cg;
+    const PetscScalar *uc;
+
+    PetscCall(DMPlexPointGlobalRead(dm, c, u, &uc));
+    if (!uc) continue;
+    PetscCall(DMPlexPointLocalRead(dmCell, c, cgeom, &cg));
+    *mass += cg->volume * PetscRealPart(uc[0]);
+  }
+  PetscCall(VecRestoreArrayRead(U, &u));
+  PetscCall(VecRestoreArrayRead(cellGeometry, &cgeom));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, mass, 1, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject)dm)));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode SetInitialCondition(DM dm, Vec U)
+{
+  DM                 dmCell;
+  Vec                cellGeometry;
+  const PetscScalar *cgeom;
+  PetscScalar       *u;
+  PetscInt           cStart, cEnd;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMPlexGetGeometryFVM(dm, NULL, &cellGeometry, NULL));
+  PetscCall(VecGetDM(cellGeometry, &dmCell));
+  PetscCall(DMPlexGetSimplexOrBoxCells(dm, 0, &cStart, &cEnd));
+  PetscCall(VecGetArrayRead(cellGeometry, &cgeom));
+  PetscCall(VecGetArray(U, &u));
+  for (PetscInt c = cStart; c < cEnd; c++) {
+    PetscFVCellGeom *cg;
+    PetscScalar     *uc;
+    PetscReal        r;
+
+    PetscCall(DMPlexPointGlobalRef(dm, c, u, &uc));
+    if (!uc) continue;
+    PetscCall(DMPlexPointLocalRead(dmCell, c, cgeom, &cg));
+    r     = PetscAbsReal(cg->centroid[0] - 0.3) / 0.1;
+    uc[0] = r < 1.0 ? PetscSqr(PetscCosReal(0.5 * PETSC_PI * r)) : 0.0;
+  }
+  PetscCall(VecRestoreArray(U, &u));
+  PetscCall(VecRestoreArrayRead(cellGeometry, &cgeom));
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM          dm;
+  PetscFV     fv;
+  PetscDS     ds;
+  DMLabel     label;
+  TS          ts;
+  Vec         U, Uref;
+  AppCtx      user;
+  PetscInt    dim, nclasses, steps = 4, id = 1, nw = 3;
+  PetscReal   grading = 16.0, cfl = 0.5, rmin, speed = 0.0, dt, mass[2], diff, nrm;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  user.wind[0] = 1.0;
+  user.wind[1] = user.wind[2] = 0.0;
+  PetscOptionsBegin(PETSC_COMM_WORLD, "", "Local time stepping options", "TS");
+  PetscCall(PetscOptionsReal("-grading", "Ratio of the widths of the largest and smallest cells", "", grading, &grading, NULL));
+  PetscCall(PetscOptionsInt("-steps", "Number of steps of TSLTS", "", steps, &steps, NULL));
+  PetscCall(PetscOptionsReal("-cfl", "CFL number of the smallest cells", "", cfl, &cfl, NULL));
+  PetscCall(PetscOptionsRealArray("-wind", "Velocity", "", user.wind, &nw, NULL));
+  PetscOptionsEnd();
+
+  PetscCall(DMCreate(PETSC_COMM_WORLD, &dm));
+  PetscCall(DMSetType(dm, DMPLEX));
+  PetscCall(DMSetFromOptions(dm));
+  PetscCall(GradeMesh(dm, grading));
+  {
+    DM gdm;
+
+    PetscCall(DMPlexConstructGhostCells(dm, "marker", NULL, &gdm));
+    PetscCall(DMDestroy(&dm));
+    dm = gdm;
+  }
+  PetscCall(DMViewFromOptions(dm, NULL, "-dm_view"));
+  PetscCall(DMGetDimension(dm, &dim));
+  for (PetscInt d = 0; d < dim; d++) speed += PetscSqr(user.wind[d]);
+  speed = PetscSqrtReal(speed);
+
+  PetscCall(PetscFVCreate(PETSC_COMM_WORLD, &fv));
+  PetscCall(PetscFVSetFromOptions(fv));
+  PetscCall(PetscFVSetNumComponents(fv, 1));
+  PetscCall(PetscFVSetSpatialDimension(fv, dim));
+  PetscCall(PetscObjectSetName((PetscObject)fv, "u"));
+  PetscCall(DMAddField(dm, NULL, (PetscObject)fv));
+  PetscCall(DMCreateDS(dm));
+  PetscCall(DMGetDS(dm, &ds));
+  PetscCall(PetscDSSetRiemannSolver(ds, 0, Riemann));
+  PetscCall(PetscDSSetContext(ds, 0, &user));
+  PetscCall(DMGetLabel(dm, "marker", &label));
+  PetscCall(DMAddBoundary(dm, DM_BC_NATURAL_RIEMANN, "outflow", label, 1, &id, 0, 0, NULL, (void (*)(void))BoundaryOutflow, NULL, &user, NULL));
+  PetscCall(DMTSSetBoundaryLocal(dm, DMPlexTSComputeBoundary, &user));
+  PetscCall(DMTSSetRHSFunctionLocal(dm, DMPlexTSComputeRHSFunctionFVM, &user));
+
+  PetscCall(DMCreateGlobalVector(dm, &U));
+  PetscCall(VecDuplicate(U, &Uref));
+  PetscCall(SetInitialCondition(dm, U));
+  PetscCall(VecCopy(U, Uref));
+  PetscCall(ComputeMass(dm, U, &mass[0]));
+  PetscCall(DMPlexGetGeometryFVM(dm, NULL, NULL, &rmin));
+  dt = cfl * rmin / speed;
+
+  /* The step size of TSLTS is that of its coarsest class */
+  PetscCall(TSCreate(PETSC_COMM_WORLD, &ts));
+  PetscCall(TSSetDM(ts, dm));
+  PetscCall(TSSetType(ts, TSLTS));
+  PetscCall(TSSetMaxSteps(ts, steps));
+  PetscCall(TSSetMaxTime(ts, PETSC_MAX_REAL));
+  PetscCall(TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP));
+  PetscCall(TSSetFromOptions(ts));
+  PetscCall(TSSetSolution(ts, U));
+  PetscCall(TSSetUp(ts));
+  PetscCall(TSLTSGetNumClasses(ts, &nclasses));
+  PetscCall(TSSetTimeStep(ts, dt * (1 << (nclasses - 1))));
+  PetscCall(TSSolve(ts, U));
+  PetscCall(TSDestroy(&ts));
+
+  /* Forward Euler with the step size of the smallest cells */
+  PetscCall(TSCreate(PETSC_COMM_WORLD, &ts));
+  PetscCall(TSSetOptionsPrefix(ts, "ref_"));
+  PetscCall(TSSetDM(ts, dm));
+  PetscCall(TSSetType(ts, TSEULER));
+  PetscCall(TSSetMaxSteps(ts, steps * (1 << (nclasses - 1))));
+  PetscCall(TSSetMaxTime(ts, PETSC_MAX_REAL));
+  PetscCall(TSSetTimeStep(ts, dt));
+  PetscCall(TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP));
+  PetscCall(TSSetFromOptions(ts));
+  PetscCall(TSSolve(ts, Uref));
+  PetscCall(TSDestroy(&ts));
+
+  PetscCall(ComputeMass(dm, U, &mass[1]));
+  PetscCall(VecAXPY(Uref, -1.0, U));
+  PetscCall(VecNorm(Uref, NORM_INFINITY, &diff));
+  PetscCall(VecNorm(U, NORM_INFINITY, &nrm));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Classes %" PetscInt_FMT ", steps %" PetscInt_FMT "\n", nclasses, steps));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Mass %s\n", PetscAbsReal(mass[1] - mass[0]) < 1.e-10 * mass[0] ? "conserved" : "NOT conserved"));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Largest difference with forward Euler relative to the solution %.2f\n", (double)(diff / nrm)));
+
+  PetscCall(VecDestroy(&U));
+  PetscCall(VecDestroy(&Uref));
+  PetscCall(PetscFVDestroy(&fv));
+  PetscCall(DMDestroy(&dm));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  testset:
+    requires: !complex !single
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 64,2 -dm_plex_adj_cone -dm_plex_adj_closure 0 -ts_view
+
+    test:
+      suffix: 0
+
+    test:
+      suffix: 1
+      nsize: 2
+      args: -dm_distribute_overlap 1 -petscpartitioner_type simple
+
+    test:
+      suffix: uniform
+      args: -grading 1
+
+    test:
+      suffix: max_classes
+      args: -ts_lts_max_classes 2
+
+TEST*/
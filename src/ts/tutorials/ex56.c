@@ -0,0 +1,185 @@
+static char help[] = "Integrates the heat equation in parallel in time with TSPARAREAL.\n\
+The result is compared with the sequential integration by the fine propagator.\n\
+Input parameters include:\n\
+  -nt <slices> : number of time slices, dividing the number of processes\n\n";
+
+/*
+   The heat equation u_t = u_xx on (0,1) with u = 0 on the boundary is discretized by centered differences on a DMDA.
+   The processes of PETSC_COMM_WORLD are split into nt time slices of equally many processes for the space.
+*/
+#include <petscdmda.h>
+#include <petscts.h>
+
+static PetscErrorCode RHSFunction(TS ts, PetscReal t, Vec U, Vec F, void *ctx)
+{
+  DM                 da;
+  Vec                Ul;
+  const PetscScalar *u;
+  PetscScalar       *f;
+  PetscInt           xs, xm, M;
+  PetscReal          h2;
+
+  PetscFunctionBeginUser;
+  PetscCall(TSGetDM(ts, &da));
+  PetscCall(DMDAGetInfo(da, NULL, &M, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL));
+  PetscCall(DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL));
+  h2 = 1.0 / PetscSqr((PetscReal)(M - 1));
+  PetscCall(DMGetLocalVector(da, &Ul));
+  PetscCall(DMGlobalToLocal(da, U, INSERT_VALUES, Ul));
+  PetscCall(DMDAVecGetArrayRead(da, Ul, &u));
+  PetscCall(DMDAVecGetArray(da, F, &f));
+  for (PetscInt i = xs; i < xs + xm; i++) f[i] = (i == 0 || i == M - 1) ? 0.0 : (u[i - 1] - 2.0 * u[i] + u[i + 1]) / h2;
+  PetscCall(DMDAVecRestoreArray(da, F, &f));
+  PetscCall(DMDAVecRestoreArrayRead(da, Ul, &u));
+  PetscCall(DMRestoreLocalVector(da, &Ul));
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode RHSJacobian(TS ts, PetscReal t, Vec U, Mat J, Mat P, void *ctx)
+{
+  DM        da;
+  PetscInt  xs, xm, M;
+  PetscReal h2;
+
+  PetscFunctionBeginUser;
+  PetscCall(TSGetDM(ts, &da));
+  PetscCall(DMDAGetInfo(da, NULL, &M, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL));
+  PetscCall(DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL));
+  h2 = 1.0 / PetscSqr((PetscReal)(M - 1));
+  PetscCall(MatZeroEntries(P));
+  for (PetscInt i = xs; i < xs + xm; i++) {
+    MatStencil  row = {0}, col[3] = {{0}};
+    PetscScalar v[3] = {1.0 / h2, -2.0 / h2, 1.0 / h2};
+
+    if (i == 0 || i == M - 1) continue;
+    row.i = i;
+    for (PetscInt j = 0; j < 3; j++) col[j].i = i - 1 + j;
+    PetscCall(MatSetValuesStencil(P, 1, &row, 3, col, v, INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(P, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(P, MAT_FINAL_ASSEMBLY));
+  if (J != P) {
+    PetscCall(MatAssemblyBegin(J, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(J, MAT_FINAL_ASSEMBLY));
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode InitialSolution(DM da, Vec U)
+{
+  PetscScalar *u;
+  PetscInt     xs, xm, M;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMDAGetInfo(da, NULL, &M, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL));
+  PetscCall(DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL));
+  PetscCall(DMDAVecGetArray(da, U, &u));
+  for (PetscInt i = xs; i < xs + xm; i++) {
+    const PetscReal x = i / (PetscReal)(M - 1);
+
+    u[i] = PetscSinReal(PETSC_PI * x) + 0.5 * PetscSinReal(4 * PETSC_PI * x);
+  }
+  PetscCall(DMDAVecRestoreArray(da, U, &u));
+  PetscFunctionReturn(0);
+}
+
+/* a TS of the type given integrating the heat equation with steps dt until tf */
+static PetscErrorCode CreateTS(DM da, TSType type, PetscReal dt, PetscReal tf, TS *ts)
+{
+  PetscFunctionBeginUser;
+  PetscCall(TSCreate(PetscObjectComm((PetscObject)da), ts));
+  PetscCall(TSSetDM(*ts, da));
+  PetscCall(TSSetType(*ts, type));
+  PetscCall(TSSetProblemType(*ts, TS_LINEAR));
+  PetscCall(TSSetRHSFunction(*ts, NULL, RHSFunction, NULL));
+  PetscCall(TSSetRHSJacobian(*ts, NULL, NULL, RHSJacobian, NULL));
+  PetscCall(TSSetTimeStep(*ts, dt));
+  PetscCall(TSSetMaxTime(*ts, tf));
+  PetscCall(TSSetExactFinalTime(*ts, TS_EXACTFINALTIME_MATCHSTEP));
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  MPI_Comm    scomm, tcomm;
+  PetscMPIInt size, rank;
+  DM          da;
+  TS          ts, fine, ref;
+  TSType      finetype;
+  Vec         U, Uref;
+  PetscInt    nt = 1, its;
+  PetscReal   dt = 1.e-3, tf = 0.1, diff, norm;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nt", &nt, NULL));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCheck(nt > 0 && size % nt == 0, PETSC_COMM_WORLD, PETSC_ERR_ARG_OUTOFRANGE, "The number of time slices %" PetscInt_FMT " must divide the number of processes %d", nt, size);
+
+  /* the processes of a time slice, and the processes of the other time slices with the same rank in space */
+  PetscCallMPI(MPI_Comm_split(PETSC_COMM_WORLD, (PetscMPIInt)(rank / (size / nt)), rank, &scomm));
+  PetscCallMPI(MPI_Comm_split(PETSC_COMM_WORLD, (PetscMPIInt)(rank % (size / nt)), rank, &tcomm));
+
+  PetscCall(DMDACreate1d(scomm, DM_BOUNDARY_NONE, 65, 1, 1, NULL, &da));
+  PetscCall(DMSetFromOptions(da));
+  PetscCall(DMSetUp(da));
+  PetscCall(DMCreateGlobalVector(da, &U));
+  PetscCall(InitialSolution(da, U));
+
+  PetscCall(CreateTS(da, TSPARAREAL, dt, tf, &ts));
+  PetscCall(TSPararealSetTimeCommunicator(ts, tcomm));
+  PetscCall(TSSetFromOptions(ts));
+  PetscCall(TSSolve(ts, U));
+  PetscCall(TSPararealGetIterationNumber(ts, &its));
+
+  /* the fine propagator alone */
+  PetscCall(TSPararealGetFineTS(ts, &fine));
+  PetscCall(TSGetType(fine, &finetype));
+  PetscCall(VecDuplicate(U, &Uref));
+  PetscCall(InitialSolution(da, Uref));
+  PetscCall(CreateTS(da, finetype, dt, tf, &ref));
+  PetscCall(TSSetOptionsPrefix(ref, "ref_"));
+  PetscCall(TSSolve(ref, Uref));
+  PetscCall(VecNorm(Uref, NORM_2, &norm));
+  PetscCall(VecAXPY(Uref, -1.0, U));
+  PetscCall(VecNorm(Uref, NORM_2, &diff));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &diff, 1, MPIU_REAL, MPIU_MAX, tcomm));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%" PetscInt_FMT " time slices, %" PetscInt_FMT " iterations, %s\n", nt, its, diff < 1.e-5 * norm ? "in agreement with the sequential integration" : "NOT in agreement with the sequential integration"));
+
+  PetscCall(VecDestroy(&U));
+  PetscCall(VecDestroy(&Uref));
+  PetscCall(TSDestroy(&ts));
+  PetscCall(TSDestroy(&ref));
+  PetscCall(DMDestroy(&da));
+  PetscCallMPI(MPI_Comm_free(&scomm));
+  PetscCallMPI(MPI_Comm_free(&tcomm));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  testset:
+    requires: !single
+
+    test:
+      suffix: 0
+      args: -ts_view
+
+    test:
+      suffix: time
+      nsize: 4
+      args: -nt 4 -ts_parareal_monitor -ts_parareal_coarse_steps 5 -ts_parareal_rtol 1e-6 -parareal_fine_ts_type cn
+
+    test:
+      suffix: early_stop
+      nsize: 8
+      args: -nt 8 -ts_parareal_monitor -ts_parareal_coarse_steps 5 -ts_parareal_rtol 1e-4 -parareal_fine_ts_type cn
+
+    test:
+      suffix: space_time
+      nsize: 4
+      args: -nt 2
+
+TEST*/
@@ -607,6 +607,50 @@ PetscErrorCode FVRHSFunctionfast2(TS ts, PetscReal time, Vec X, Vec F, void *vct
   PetscFunctionReturn(0);
 }
 
+/* the stable step size of each cell for the multirate method to compute its rate level from, the smallest of the cells
+   within abwidth of it so that the faster levels include a buffer of the slower cells their stencil reaches; the wave
+   speeds are the characteristic speeds of the physics */
+PetscErrorCode FVStableTimeStep(TS ts, PetscReal t, Vec X, Vec Dt, void *vctx)
+{
+  FVCtx       *ctx = (FVCtx *)vctx;
+  DM           da;
+  Vec          Xloc;
+  PetscScalar *x, *dt;
+  PetscReal    hx, *a;
+  PetscInt     i, j, k, dof, sw, xs, xm, Mx;
+
+  PetscFunctionBeginUser;
+  PetscCall(TSGetDM(ts, &da));
+  PetscCall(DMDAGetInfo(da, 0, &Mx, 0, 0, 0, 0, 0, &dof, &sw, 0, 0, 0, 0));
+  PetscCheck(ctx->abwidth <= sw, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "The buffer width %" PetscInt_FMT " cannot be larger than the stencil width %" PetscInt_FMT, ctx->abwidth, sw);
+  PetscCall(DMDAGetCorners(da, &xs, 0, 0, &xm, 0, 0));
+  hx = (ctx->xmax - ctx->xmin) / Mx;
+  PetscCall(DMGetLocalVector(da, &Xloc));
+  PetscCall(DMGlobalToLocal(da, X, INSERT_VALUES, Xloc));
+  PetscCall(DMDAVecGetArray(da, Xloc, &x));
+  /* the fastest wave of the owned cells and of the ghost cells within abwidth of them */
+  PetscCall(PetscMalloc1(xm + 2 * ctx->abwidth, &a));
+  for (i = xs - ctx->abwidth; i < xs + xm + ctx->abwidth; i++) {
+    PetscInt c = (i + Mx) % Mx;
+
+    PetscCall((*ctx->physics.characteristic)(ctx->physics.user, dof, &x[i * dof], ctx->R, ctx->Rinv, ctx->speeds, ctx->xmin + (c + 0.5) * hx));
+    a[i - xs + ctx->abwidth] = 0;
+    for (j = 0; j < dof; j++) a[i - xs + ctx->abwidth] = PetscMax(a[i - xs + ctx->abwidth], PetscAbsReal(ctx->speeds[j]));
+  }
+  PetscCall(DMDAVecRestoreArray(da, Xloc, &x));
+  PetscCall(DMRestoreLocalVector(da, &Xloc));
+  PetscCall(VecGetArray(Dt, &dt));
+  for (i = 0; i < xm; i++) {
+    PetscReal amax = 0;
+
+    for (k = 0; k <= 2 * ctx->abwidth; k++) amax = PetscMax(amax, a[i + k]);
+    for (j = 0; j < dof; j++) dt[i * dof + j] = amax > 0 ? ctx->cfl * hx / amax : PETSC_MAX_REAL;
+  }
+  PetscCall(VecRestoreArray(Dt, &dt));
+  PetscCall(PetscFree(a));
+  PetscFunctionReturn(0);
+}
+
 int main(int argc, char *argv[])
 {
   char              lname[256] = "mc", physname[256] = "advect", final_fname[256] = "solution.m";
@@ -617,7 +661,7 @@ int main(int argc, char *argv[])
   Vec               X, X0, R;
   FVCtx             ctx;
   PetscInt          i, k, dof, xs, xm, Mx, draw = 0, *index_slow, *index_fast, islow = 0, ifast = 0;
-  PetscBool         view_final = PETSC_FALSE;
+  PetscBool         view_final = PETSC_FALSE, auto_split = PETSC_FALSE;
   PetscReal         ptime;
 
   PetscFunctionBeginUser;
@@ -648,11 +692,12 @@ int main(int argc, char *argv[])
   /* Register physical models to be available on the command line */
   PetscCall(PetscFunctionListAdd(&physics, "advect", PhysicsCreate_Advect));
 
-  ctx.comm   = comm;
-  ctx.cfl    = 0.9;
-  ctx.bctype = FVBC_PERIODIC;
-  ctx.xmin   = -1.0;
-  ctx.xmax   = 1.0;
+  ctx.comm    = comm;
+  ctx.cfl     = 0.9;
+  ctx.bctype  = FVBC_PERIODIC;
+  ctx.xmin    = -1.0;
+  ctx.xmax    = 1.0;
+  ctx.abwidth = 2; /* the stencil of the limited reconstruction */
   PetscOptionsBegin(comm, NULL, "Finite Volume solver options", "");
   PetscCall(PetscOptionsReal("-xmin", "X min", "", ctx.xmin, &ctx.xmin, NULL));
   PetscCall(PetscOptionsReal("-xmax", "X max", "", ctx.xmax, &ctx.xmax, NULL));
@@ -664,6 +709,8 @@ int main(int argc, char *argv[])
   PetscCall(PetscOptionsReal("-cfl", "CFL number to time step at", "", ctx.cfl, &ctx.cfl, NULL));
   PetscCall(PetscOptionsEnum("-bc_type", "Boundary condition", "", FVBCTypes, (PetscEnum)ctx.bctype, (PetscEnum *)&ctx.bctype, NULL));
   PetscCall(PetscOptionsBool("-recursive_split", "Split the domain recursively", "", ctx.recursive, &ctx.recursive, NULL));
+  PetscCall(PetscOptionsInt("-auto_split_buffer", "Number of slower cells around the faster ones that step with them", "", ctx.abwidth, &ctx.abwidth, NULL));
+  PetscCall(PetscOptionsBool("-auto_split", "Let the multirate method split the domain from the stable step sizes", "", auto_split, &auto_split, NULL));
   PetscOptionsEnd();
 
   /* Choose the limiter from the list of registered limiters */
@@ -754,6 +801,10 @@ int main(int argc, char *argv[])
   PetscCall(VecCopy(X0, X));                            /* The function value was not used so we set X=X0 again */
   PetscCall(TSSetTimeStep(ts, ctx.cfl / ctx.cfl_idt));
   PetscCall(TSSetFromOptions(ts)); /* Take runtime options */
+  if (auto_split) {
+    PetscCall(TSRKSetMultirateStability(ts, FVStableTimeStep, &ctx));
+    PetscCall(TSMPRKSetMultirateStability(ts, FVStableTimeStep, &ctx));
+  }
   PetscCall(SolutionStatsView(da, X, PETSC_VIEWER_STDOUT_WORLD));
   {
     PetscInt    steps;
@@ -864,4 +915,25 @@ int main(int argc, char *argv[])
     test:
       suffix: 6
       args: -da_grid_x 60 -initial 1 -xmin -1 -xmax 1 -limit mc -physics_advect_a1 1 -physics_advect_a2 2 -ts_dt 0.025 -ts_max_steps 24 -ts_type rk -ts_rk_type 2a -ts_rk_dtratio 2 -ts_rk_multirate -ts_use_splitrhsfunction 1 -recursive_split
+
+    test:
+      suffix: auto
+      args: -da_grid_x 60 -initial 1 -xmin -1 -xmax 1 -limit mc -physics_advect_a1 1 -physics_advect_a2 2 -ts_dt 0.025 -ts_max_steps 24 -ts_type rk -ts_rk_type 2a -ts_rk_dtratio 2 -ts_rk_multirate -ts_use_splitrhsfunction 0 -auto_split -auto_split_buffer 0
+      output_file: output/ex5_1.out
+
+    test:
+      suffix: auto_levels
+      nsize: {{1 2}}
+      args: -da_grid_x 60 -initial 1 -xmin -1 -xmax 1 -limit mc -physics_advect_a1 1 -physics_advect_a2 4 -ts_dt 0.05 -ts_max_steps 12 -ts_type rk -ts_rk_type 2a -ts_rk_dtratio 2 -ts_rk_multirate -ts_use_splitrhsfunction 0 -auto_split -ts_rk_multirate_max_levels 4
+      output_file: output/ex5_auto_levels.out
+
+    test:
+      suffix: mprk_auto
+      args: -da_grid_x 60 -initial 1 -xmin -1 -xmax 1 -limit mc -physics_advect_a1 1 -physics_advect_a2 2 -ts_dt 0.025 -ts_max_steps 24 -ts_type mprk -ts_mprk_type 2a22 -ts_use_splitrhsfunction 0 -auto_split -auto_split_buffer 0
+      output_file: output/ex5_3.out
+
+    test:
+      suffix: mprk_auto_buffer
+      args: -da_grid_x 60 -initial 1 -xmin -1 -xmax 1 -limit mc -physics_advect_a1 1 -physics_advect_a2 2 -ts_dt 0.025 -ts_max_steps 24 -ts_type mprk -ts_mprk_type 2a22 -ts_use_splitrhsfunction 0 -auto_split -ts_view
+      filter: grep -e "Solution range" -e "Final time" -e "Mass difference" -e "components"
 TEST*/
@@ -126,6 +126,7 @@ typedef struct {
   PetscInt    hratio; /* hratio = hslow/hfast */
   IS          isf, iss, isf2, iss2, ism, issb, ismb;
   PetscBool   recursive;
+  PetscInt    abwidth; /* width of the buffer around the faster cells in the automatic split */
   PetscInt    sm, mf, fm, ms;     /* positions (array index) for slow-medium, medium-fast, fast-medium, medium-slow interfaces */
   PetscInt    sf, fs;             /* slow-fast and fast-slow interfaces */
   PetscInt    lsbwidth, rsbwidth; /* left slow buffer width and right slow buffer width */
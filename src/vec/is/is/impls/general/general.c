@@ -182,19 +182,19 @@ static PetscErrorCode ISInvertPermutation_General(IS is, PetscInt nlocal, IS *is
 #if defined(PETSC_HAVE_HDF5)
 static PetscErrorCode ISView_General_HDF5(IS is, PetscViewer viewer)
 {
-  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
-  hid_t             filespace;  /* file dataspace identifier */
-  hid_t             chunkspace; /* chunk dataset property identifier */
-  hid_t             dset_id;    /* dataset identifier */
-  hid_t             memspace;   /* memory dataspace identifier */
-  hid_t             inttype;    /* int type (H5T_NATIVE_INT or H5T_NATIVE_LLONG) */
-  hid_t             file_id, group;
-  hsize_t           dim, maxDims[3], dims[3], chunkDims[3], count[3], offset[3];
-  PetscBool         timestepping;
-  PetscInt          bs, N, n, timestep = PETSC_MIN_INT, low;
-  hsize_t           chunksize;
-  const PetscInt   *ind;
-  const char       *isname;
+  hid_t            filespace;  /* file dataspace identifier */
+  hid_t            chunkspace; /* chunk dataset property identifier */
+  hid_t            dxpl;       /* transfer property identifier */
+  hid_t            dset_id;    /* dataset identifier */
+  hid_t            memspace;   /* memory dataspace identifier */
+  hid_t            inttype;    /* int type (H5T_NATIVE_INT or H5T_NATIVE_LLONG) */
+  hid_t            file_id, group;
+  hsize_t          dim, vdim, maxDims[3], dims[3], chunkDims[3], rankChunkDims[3], count[3], offset[3];
+  PetscBool        timestepping;
+  PetscInt         bs, N, n, timestep = PETSC_MIN_INT, low;
+  hsize_t          chunksize;
+  const PetscInt  *ind;
+  const char      *isname;
 
   PetscFunctionBegin;
   PetscCall(ISGetBlockSize(is, &bs));
@@ -224,6 +224,7 @@ static PetscErrorCode ISView_General_HDF5(IS is, PetscViewer viewer)
   }
   PetscCall(ISGetSize(is, &N));
   PetscCall(ISGetLocalSize(is, &n));
+  vdim = dim;
   PetscCall(PetscHDF5IntCast(N / bs, dims + dim));
 
   maxDims[dim]   = dims[dim];
@@ -246,6 +247,9 @@ static PetscErrorCode ISView_General_HDF5(IS is, PetscViewer viewer)
       chunkDims[dim - 1] = PETSC_HDF5_MAX_CHUNKSIZE / 64;
     }
   }
+  /* The chunk aligned with the parallel layout, used when the chunk size is PETSC_DECIDE */
+  PetscCall(PetscArraycpy(rankChunkDims, chunkDims, dim));
+  PetscCall(PetscViewerHDF5GetRankChunk_Internal(is->map->size, is->map->range, bs, rankChunkDims + vdim));
   PetscCallHDF5Return(filespace, H5Screate_simple, (dim, dims, maxDims));
 
   #if defined(PETSC_USE_64BIT_INDICES)
@@ -258,8 +262,7 @@ static PetscErrorCode ISView_General_HDF5(IS is, PetscViewer viewer)
   PetscCall(PetscObjectGetName((PetscObject)is, &isname));
   if (!H5Lexists(group, isname, H5P_DEFAULT)) {
     /* Create chunk */
-    PetscCallHDF5Return(chunkspace, H5Pcreate, (H5P_DATASET_CREATE));
-    PetscCallHDF5(H5Pset_chunk, (chunkspace, dim, chunkDims));
+    PetscCall(PetscViewerHDF5CreateDatasetProperties_Internal(viewer, (int)dim, rankChunkDims, chunkDims, &chunkspace));
 
     PetscCallHDF5Return(dset_id, H5Dcreate2, (group, isname, inttype, filespace, H5P_DEFAULT, chunkspace, H5P_DEFAULT));
     PetscCallHDF5(H5Pclose, (chunkspace));
@@ -310,7 +313,9 @@ static PetscErrorCode ISView_General_HDF5(IS is, PetscViewer viewer)
   }
 
   PetscCall(ISGetIndices(is, &ind));
-  PetscCallHDF5(H5Dwrite, (dset_id, inttype, memspace, filespace, hdf5->dxpl_id, ind));
+  PetscCall(PetscViewerHDF5CreateTransferProperties_Internal(viewer, dset_id, &dxpl));
+  PetscCallHDF5(H5Dwrite, (dset_id, inttype, memspace, filespace, dxpl, ind));
+  PetscCallHDF5(H5Pclose, (dxpl));
   PetscCallHDF5(H5Fflush, (file_id, H5F_SCOPE_GLOBAL));
   PetscCall(ISRestoreIndices(is, &ind));
 
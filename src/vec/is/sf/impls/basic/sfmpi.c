@@ -38,6 +38,18 @@ static PetscErrorCode PetscSFLinkStartRequests_MPI(PetscSF sf, PetscSFLink link,
     }
     PetscCall(PetscSFLinkSyncStreamBeforeCallMPI(sf, link, direction));
     PetscCallMPI(MPI_Startall_isend(buflen, link->unit, nreqs, reqs));
+#if defined(PETSC_USE_LOG)
+    /* the persistent requests do not go through the MPI_Isend() logging, so tell -log_comm where they went */
+    if (PetscLogCommOn) {
+      MPI_Comm comm = PetscObjectComm((PetscObject)sf);
+
+      if (direction == PETSCSF_ROOT2LEAF) {
+        for (PetscMPIInt i = bas->ndiranks; i < bas->niranks; i++) PetscCall(PetscLogCommSend_Internal(comm, bas->iranks[i], bas->ioffset[i + 1] - bas->ioffset[i], link->unit));
+      } else {
+        for (PetscInt i = sf->ndranks; i < sf->nranks; i++) PetscCall(PetscLogCommSend_Internal(comm, sf->ranks[i], sf->roffset[i + 1] - sf->roffset[i], link->unit));
+      }
+    }
+#endif
   }
   PetscFunctionReturn(0);
 }
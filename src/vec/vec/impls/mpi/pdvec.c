@@ -553,10 +553,10 @@ PetscErrorCode VecView_MPI_ADIOS(Vec xin, PetscViewer viewer)
 #if defined(PETSC_HAVE_HDF5)
 PetscErrorCode VecView_MPI_HDF5(Vec xin, PetscViewer viewer)
 {
-  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
   /* TODO: It looks like we can remove the H5Sclose(filespace) and H5Dget_space(dset_id). Why do we do this? */
   hid_t              filespace;  /* file dataspace identifier */
   hid_t              chunkspace; /* chunk dataset property identifier */
+  hid_t              dxpl;       /* transfer property identifier */
   hid_t              dset_id;    /* dataset identifier */
   hid_t              memspace;   /* memory dataspace identifier */
   hid_t              file_id;
@@ -564,8 +564,8 @@ PetscErrorCode VecView_MPI_HDF5(Vec xin, PetscViewer viewer)
   hid_t              memscalartype;  /* scalar type for mem (H5T_NATIVE_FLOAT or H5T_NATIVE_DOUBLE) */
   hid_t              filescalartype; /* scalar type for file (H5T_NATIVE_FLOAT or H5T_NATIVE_DOUBLE) */
   PetscInt           bs = PetscAbs(xin->map->bs);
-  hsize_t            dim;
-  hsize_t            maxDims[4], dims[4], chunkDims[4], count[4], offset[4];
+  hsize_t            dim, vdim;
+  hsize_t            maxDims[4], dims[4], chunkDims[4], rankChunkDims[4], count[4], offset[4];
   PetscBool          timestepping, dim2, spoutput;
   PetscInt           timestep = PETSC_MIN_INT, low;
   hsize_t            chunksize;
@@ -598,6 +598,7 @@ PetscErrorCode VecView_MPI_HDF5(Vec xin, PetscViewer viewer)
     chunkDims[dim] = 1;
     ++dim;
   }
+  vdim = dim;
   PetscCall(PetscHDF5IntCast(xin->map->N / bs, dims + dim));
 
   maxDims[dim]   = dims[dim];
@@ -637,6 +638,9 @@ PetscErrorCode VecView_MPI_HDF5(Vec xin, PetscViewer viewer)
     }
   }
   #endif
+  /* The chunk aligned with the parallel layout, used when the chunk size is PETSC_DECIDE */
+  PetscCall(PetscArraycpy(rankChunkDims, chunkDims, dim));
+  PetscCall(PetscViewerHDF5GetRankChunk_Internal(xin->map->size, xin->map->range, bs, rankChunkDims + vdim));
 
   PetscCallHDF5Return(filespace, H5Screate_simple, (dim, dims, maxDims));
 
@@ -657,8 +661,7 @@ PetscErrorCode VecView_MPI_HDF5(Vec xin, PetscViewer viewer)
   PetscCall(PetscObjectGetName((PetscObject)xin, &vecname));
   if (H5Lexists(group, vecname, H5P_DEFAULT) < 1) {
     /* Create chunk */
-    PetscCallHDF5Return(chunkspace, H5Pcreate, (H5P_DATASET_CREATE));
-    PetscCallHDF5(H5Pset_chunk, (chunkspace, dim, chunkDims));
+    PetscCall(PetscViewerHDF5CreateDatasetProperties_Internal(viewer, (int)dim, rankChunkDims, chunkDims, &chunkspace));
 
     PetscCallHDF5Return(dset_id, H5Dcreate2, (group, vecname, filescalartype, filespace, H5P_DEFAULT, chunkspace, H5P_DEFAULT));
     PetscCallHDF5(H5Pclose, (chunkspace));
@@ -717,7 +720,9 @@ PetscErrorCode VecView_MPI_HDF5(Vec xin, PetscViewer viewer)
   }
 
   PetscCall(VecGetArrayRead(xin, &x));
-  PetscCallHDF5(H5Dwrite, (dset_id, memscalartype, memspace, filespace, hdf5->dxpl_id, x));
+  PetscCall(PetscViewerHDF5CreateTransferProperties_Internal(viewer, dset_id, &dxpl));
+  PetscCallHDF5(H5Dwrite, (dset_id, memscalartype, memspace, filespace, dxpl, x));
+  PetscCallHDF5(H5Pclose, (dxpl));
   PetscCallHDF5(H5Fflush, (file_id, H5F_SCOPE_GLOBAL));
   PetscCall(VecRestoreArrayRead(xin, &x));
 
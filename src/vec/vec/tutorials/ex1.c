@@ -195,6 +195,11 @@ int main(int argc, char **argv)
         suffix: 2
         nsize: 2
 
+    test:
+        suffix: 2_numa
+        nsize: 2
+        args: -malloc_numa_policy interleave -malloc_hugepages -malloc_large_threshold 64
+
     test:
         suffix: 2_cuda
         nsize: 2
@@ -184,4 +184,11 @@ int main(int argc, char **args)
        nsize: 4
        args: -hdf5 -sizes_set
 
+     test:
+       suffix: 7
+       requires: hdf5
+       nsize: 2
+       args: -hdf5 -viewer_hdf5_chunk_size decide -viewer_hdf5_compress 4 -viewer_hdf5_shuffle
+       output_file: output/ex10_4.out
+
 TEST*/